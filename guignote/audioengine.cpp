@@ -0,0 +1,235 @@
+/**
+ * @file audioengine.cpp
+ * @brief Implementación de las clases AudioEngine y EffectMixer.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ */
+
+#include "audioengine.h"
+#include <QAudioBuffer>
+#include <QAudioDecoder>
+#include <QAudioDevice>
+#include <QAudioOutput>
+#include <QAudioSink>
+#include <QFile>
+#include <QMediaDevices>
+#include <QMediaPlayer>
+#include <QMutexLocker>
+#include <QSettings>
+#include <QDebug>
+#include <cstring>
+#include <memory>
+
+/**
+ * @brief Constructor de EffectMixer.
+ */
+EffectMixer::EffectMixer(int maxVoices, QObject *parent)
+    : QIODevice(parent),
+      maxVoices(maxVoices)
+{
+}
+
+/**
+ * @brief Añade una voz; si no quedan libres, sustituye a la más antigua.
+ */
+void EffectMixer::trigger(const QByteArray &pcm, qreal gain) {
+    if (pcm.isEmpty())
+        return;
+    QMutexLocker lock(&mutex);
+    if (voices.size() >= maxVoices)
+        voices.removeFirst();
+    Voice voice;
+    voice.pcm = pcm;
+    voice.gain = gain;
+    voices.append(voice);
+}
+
+/**
+ * @brief Número de voces activas.
+ */
+int EffectMixer::activeVoices() const {
+    QMutexLocker lock(&mutex);
+    return voices.size();
+}
+
+/**
+ * @brief Sin límite: el mezclador produce silencio cuando no suena nada.
+ */
+qint64 EffectMixer::bytesAvailable() const {
+    return (1 << 16) + QIODevice::bytesAvailable();
+}
+
+/**
+ * @brief Suma las voces activas con saturación a 16 bits.
+ */
+qint64 EffectMixer::readData(char *data, qint64 maxlen) {
+    const qint64 samples = maxlen / qint64(sizeof(qint16));
+    qint16 *out = reinterpret_cast<qint16 *>(data);
+    std::memset(data, 0, size_t(samples * sizeof(qint16)));
+
+    QMutexLocker lock(&mutex);
+    for (int v = voices.size() - 1; v >= 0; --v) {
+        Voice &voice = voices[v];
+        const qint16 *in = reinterpret_cast<const qint16 *>(voice.pcm.constData());
+        const qint64 total = voice.pcm.size() / qint64(sizeof(qint16));
+        qint64 pos = voice.pos / qint64(sizeof(qint16));
+        const qint64 n = qMin(samples, total - pos);
+
+        for (qint64 i = 0; i < n; ++i) {
+            int mixed = out[i] + int(in[pos + i] * voice.gain);
+            out[i] = qint16(qBound(-32768, mixed, 32767));
+        }
+        pos += n;
+        voice.pos = pos * qint64(sizeof(qint16));
+        if (pos >= total)
+            voices.removeAt(v);
+    }
+    return samples * qint64(sizeof(qint16));
+}
+
+/**
+ * @brief Instancia compartida (vive hasta el final del proceso).
+ */
+AudioEngine &AudioEngine::instance() {
+    static AudioEngine *engine = new AudioEngine();
+    return *engine;
+}
+
+/**
+ * @brief Constructor de AudioEngine.
+ *
+ * Los efectos se decodifican a 44,1 kHz, estéreo, 16 bits; si la salida no lo
+ * admite se usa su frecuencia y canales preferidos con muestras de 16 bits.
+ */
+AudioEngine::AudioEngine(QObject *parent)
+    : QObject(parent),
+      music(new QMediaPlayer(this)),
+      musicOutput(new QAudioOutput(this)),
+      mixer(new EffectMixer(kVoices, this))
+{
+    music->setAudioOutput(musicOutput);
+    music->setLoops(QMediaPlayer::Infinite);
+    musicOutput->setVolume(m_musicVolume / 100.0);
+
+    m_format.setSampleRate(44100);
+    m_format.setChannelCount(2);
+    m_format.setSampleFormat(QAudioFormat::Int16);
+
+    const QAudioDevice device = QMediaDevices::defaultAudioOutput();
+    if (!device.isNull() && !device.isFormatSupported(m_format)) {
+        const QAudioFormat preferred = device.preferredFormat();
+        m_format.setSampleRate(preferred.sampleRate());
+        m_format.setChannelCount(preferred.channelCount());
+    }
+}
+
+/**
+ * @brief Decodifica el efecto en segundo plano; se ignora si ya está cargado.
+ */
+void AudioEngine::preload(const QString &name, const QString &resource) {
+    if (effects.contains(name) || decoding.contains(name))
+        return;
+
+    QFile *file = new QFile(resource);
+    if (!file->open(QIODevice::ReadOnly)) {
+        qWarning() << "[AUDIO] No se puede abrir" << resource;
+        delete file;
+        return;
+    }
+
+    QAudioDecoder *decoder = new QAudioDecoder(this);
+    file->setParent(decoder);
+    decoder->setAudioFormat(m_format);
+    decoder->setSourceDevice(file);
+    decoding.insert(name, decoder);
+
+    auto pcm = std::make_shared<QByteArray>();
+    connect(decoder, &QAudioDecoder::bufferReady, this, [decoder, pcm]() {
+        const QAudioBuffer buffer = decoder->read();
+        pcm->append(buffer.constData<char>(), buffer.byteCount());
+    });
+    connect(decoder, &QAudioDecoder::finished, this, [this, name, decoder, pcm]() {
+        decoding.remove(name);
+        effects.insert(name, *pcm);
+        decoder->deleteLater();
+        emit effectLoaded(name);
+    });
+    connect(decoder, qOverload<QAudioDecoder::Error>(&QAudioDecoder::error), this,
+            [this, name, decoder](QAudioDecoder::Error) {
+        qWarning() << "[AUDIO] Error al decodificar" << name << ":" << decoder->errorString();
+        decoding.remove(name);
+        decoder->deleteLater();
+    });
+
+    decoder->start();
+    startEffectsOutput();
+}
+
+/**
+ * @brief Abre la salida de efectos, que lee del mezclador sin pausa.
+ */
+void AudioEngine::startEffectsOutput() {
+    if (effectsSink)
+        return;
+    effectsSink = new QAudioSink(QMediaDevices::defaultAudioOutput(), m_format, this);
+    effectsSink->setBufferSize(m_format.bytesForDuration(kBufferMs * 1000));
+    effectsSink->setVolume(m_effectsVolume / 100.0);
+    mixer->open(QIODevice::ReadOnly | QIODevice::Unbuffered);  // sin búfer propio: no adelantar audio
+    effectsSink->start(mixer);
+}
+
+/**
+ * @brief Reproduce un efecto cargado; si aún no lo está, no suena.
+ */
+void AudioEngine::play(const QString &name, qreal gain) {
+    auto it = effects.constFind(name);
+    if (it == effects.constEnd()) {
+        qDebug() << "[AUDIO] Efecto aún no cargado:" << name;
+        return;
+    }
+    mixer->trigger(*it, gain);
+}
+
+/**
+ * @brief Cambia de pista solo si es otra; la salida de música no se recrea.
+ */
+void AudioEngine::playMusic(const QUrl &source) {
+    if (music->source() != source)
+        music->setSource(source);
+    if (music->playbackState() != QMediaPlayer::PlayingState)
+        music->play();
+}
+
+/**
+ * @brief Detiene la música.
+ */
+void AudioEngine::stopMusic() {
+    music->stop();
+}
+
+/**
+ * @brief Ajusta el volumen de la música.
+ */
+void AudioEngine::setMusicVolume(int percent) {
+    m_musicVolume = qBound(0, percent, 100);
+    musicOutput->setVolume(m_musicVolume / 100.0);
+}
+
+/**
+ * @brief Ajusta el volumen de los efectos.
+ */
+void AudioEngine::setEffectsVolume(int percent) {
+    m_effectsVolume = qBound(0, percent, 100);
+    if (effectsSink)
+        effectsSink->setVolume(m_effectsVolume / 100.0);
+}
+
+/**
+ * @brief Lee "sound/volume" y "sound/effectsVolume" del usuario (por defecto 50).
+ */
+void AudioEngine::loadVolumes(const QString &usr) {
+    QSettings settings("Grace Hopper", "Sota, Caballo y Rey_" + usr);
+    setMusicVolume(settings.value("sound/volume", 50).toInt());
+    setEffectsVolume(settings.value("sound/effectsVolume", 50).toInt());
+}
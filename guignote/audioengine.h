@@ -0,0 +1,174 @@
+/**
+ * @file audioengine.h
+ * @brief Declaración de las clases AudioEngine y EffectMixer.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * AudioEngine es el único punto de salida de sonido de la aplicación: una pista
+ * de música que sigue sonando al pasar del menú a la partida y unos efectos
+ * cortos decodificados a PCM una sola vez, que se mezclan en una salida siempre
+ * abierta para que empiecen a sonar sin esperar al decodificador.
+ */
+
+#ifndef AUDIOENGINE_H
+#define AUDIOENGINE_H
+
+#include <QObject>
+#include <QIODevice>
+#include <QAudioFormat>
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QUrl>
+
+class QMediaPlayer;
+class QAudioOutput;
+class QAudioSink;
+class QAudioDecoder;
+
+/**
+ * @class EffectMixer
+ * @brief Fuente PCM (16 bits con signo) que suma las voces activas.
+ *
+ * La salida de efectos la lee sin parar; sin voces devuelve silencio. Cada
+ * trigger() ocupa una voz; si están todas ocupadas se reutiliza la más antigua.
+ */
+class EffectMixer : public QIODevice {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor.
+     * @param maxVoices Voces simultáneas.
+     * @param parent Objeto padre.
+     */
+    explicit EffectMixer(int maxVoices, QObject *parent = nullptr);
+
+    /**
+     * @brief Empieza a reproducir un efecto.
+     * @param pcm Muestras del efecto (se comparten, no se copian).
+     * @param gain Ganancia de esta reproducción (0.0 a 1.0).
+     */
+    void trigger(const QByteArray &pcm, qreal gain = 1.0);
+
+    /** @brief Voces sonando ahora mismo. */
+    int activeVoices() const;
+
+    /** @brief La salida lee de forma continua. */
+    bool isSequential() const override { return true; }
+
+    /** @brief Siempre hay datos (silencio si no suena nada). */
+    qint64 bytesAvailable() const override;
+
+protected:
+    qint64 readData(char *data, qint64 maxlen) override;
+    qint64 writeData(const char *, qint64) override { return -1; }
+
+private:
+    /**
+     * @struct Voice
+     * @brief Efecto en reproducción.
+     */
+    struct Voice {
+        QByteArray pcm;    ///< Muestras.
+        qint64 pos = 0;    ///< Siguiente byte a leer.
+        qreal gain = 1.0;  ///< Ganancia.
+    };
+
+    mutable QMutex mutex;  ///< La salida puede leer desde su propio hilo.
+    QList<Voice> voices;   ///< Voces activas, de la más antigua a la más nueva.
+    int maxVoices;         ///< Tamaño del conjunto de voces.
+};
+
+/**
+ * @class AudioEngine
+ * @brief Música y efectos de toda la aplicación.
+ *
+ * - Música: un QMediaPlayer persistente. playMusic() con la pista que ya suena
+ *   no la reinicia, así que la transición entre ventanas no corta el sonido.
+ * - Efectos: preload() decodifica el fichero a PCM en el formato de la salida;
+ *   play() solo añade una voz al mezclador, que ya está sonando.
+ *
+ * Los volúmenes son los de los ajustes "sound/volume" y "sound/effectsVolume".
+ */
+class AudioEngine : public QObject {
+    Q_OBJECT
+
+public:
+    /** @brief Instancia compartida por toda la aplicación. */
+    static AudioEngine &instance();
+
+    /**
+     * @brief Decodifica un efecto y lo guarda en memoria.
+     * @param name Nombre con el que se reproducirá.
+     * @param resource Ruta del fichero (p. ej. ":/bgm/card_draw.mp3").
+     */
+    void preload(const QString &name, const QString &resource);
+
+    /** @brief true si el efecto ya está decodificado. */
+    bool isLoaded(const QString &name) const { return effects.contains(name); }
+
+    /**
+     * @brief Reproduce un efecto ya cargado.
+     * @param name Nombre del efecto.
+     * @param gain Ganancia relativa al volumen de efectos.
+     */
+    void play(const QString &name, qreal gain = 1.0);
+
+    /**
+     * @brief Pone una pista de música en bucle (no hace nada si ya suena).
+     * @param source URL de la pista.
+     */
+    void playMusic(const QUrl &source);
+
+    /** @brief Detiene la música. */
+    void stopMusic();
+
+    /** @brief Volumen de la música (0-100). */
+    void setMusicVolume(int percent);
+    int musicVolume() const { return m_musicVolume; }
+
+    /** @brief Volumen de los efectos (0-100). */
+    void setEffectsVolume(int percent);
+    int effectsVolume() const { return m_effectsVolume; }
+
+    /**
+     * @brief Aplica los volúmenes guardados en los ajustes del usuario.
+     * @param usr Nombre del usuario.
+     */
+    void loadVolumes(const QString &usr);
+
+    /** @brief Formato de los efectos decodificados y de su salida. */
+    QAudioFormat format() const { return m_format; }
+
+    /** @brief Voces de efecto simultáneas. */
+    static constexpr int kVoices = 8;
+    /** @brief Búfer (ms) de la salida de efectos: retardo máximo al empezar un efecto. */
+    static constexpr int kBufferMs = 8;
+
+signals:
+    /**
+     * @brief Un efecto ha terminado de decodificarse.
+     * @param name Nombre del efecto.
+     */
+    void effectLoaded(const QString &name);
+
+private:
+    explicit AudioEngine(QObject *parent = nullptr);
+
+    void startEffectsOutput();
+
+    QMediaPlayer *music;                       ///< Reproductor de música.
+    QAudioOutput *musicOutput;                 ///< Salida de la música.
+    QAudioSink *effectsSink = nullptr;         ///< Salida de efectos (siempre abierta).
+    EffectMixer *mixer;                        ///< Mezclador de efectos.
+    QAudioFormat m_format;                     ///< Formato PCM de los efectos.
+    QHash<QString, QByteArray> effects;        ///< Efectos decodificados.
+    QHash<QString, QAudioDecoder *> decoding;  ///< Decodificaciones en curso.
+    int m_musicVolume = 50;                    ///< Volumen de música (0-100).
+    int m_effectsVolume = 50;                  ///< Volumen de efectos (0-100).
+};
+
+#endif // AUDIOENGINE_H
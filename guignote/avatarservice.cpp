@@ -0,0 +1,423 @@
+/**
+ * @file avatarservice.cpp
+ * @brief Implementación de la clase AvatarService.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * Contiene la descarga deduplicada, la persistencia en disco y el recorte
+ * circular en segundo plano de las fotos de perfil.
+ */
+
+#include "avatarservice.h"
+#include "icon.h"
+#include <QNetworkAccessManager>
+#include <QNetworkRequest>
+#include <QNetworkReply>
+#include <QCryptographicHash>
+#include <QStandardPaths>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QPainter>
+#include <QPainterPath>
+#include <QFile>
+#include <QDir>
+#include <QDebug>
+
+/**
+ * @brief Devuelve la instancia compartida.
+ */
+AvatarService &AvatarService::instance() {
+    static AvatarService *service = new AvatarService();
+    return *service;
+}
+
+/**
+ * @brief Constructor de AvatarService.
+ * @param directory Carpeta de persistencia (vacía = CacheLocation/avatars).
+ * @param parent Objeto padre.
+ */
+AvatarService::AvatarService(const QString &directory, QObject *parent)
+    : QObject(parent),
+      manager(new QNetworkAccessManager(this)),
+      directory(directory)
+{
+    // ~16 MB de avatares ya recortados
+    memory.setMaxCost(16 * 1024);
+    workers.setMaxThreadCount(2);
+
+    if (this->directory.isEmpty())
+        this->directory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/avatars";
+    QDir().mkpath(this->directory);
+}
+
+/**
+ * @brief Recorta una imagen en un círculo de diámetro dado.
+ *
+ * Escala a un cuadrado de “size × size”, recorta el exceso y enmascara con una elipse.
+ */
+QImage AvatarService::circularImage(const QImage &src, int size) {
+    QImage scaled = src.scaled(size, size,
+                               Qt::KeepAspectRatioByExpanding,
+                               Qt::SmoothTransformation);
+    QImage circular(size, size, QImage::Format_ARGB32_Premultiplied);
+    circular.fill(Qt::transparent);
+
+    QPainter painter(&circular);
+    painter.setRenderHint(QPainter::Antialiasing);
+    QPainterPath path;
+    path.addEllipse(0, 0, size, size);
+    painter.setClipPath(path);
+    painter.drawImage(QRect(0, 0, size, size), scaled,
+                      QRect((scaled.width() - size) / 2, (scaled.height() - size) / 2, size, size));
+    painter.end();
+
+    return circular;
+}
+
+/**
+ * @brief Avatar por defecto recortado; se calcula una vez por tamaño.
+ */
+QPixmap AvatarService::placeholder(int size) {
+    const QString key = keyFor(QStringLiteral("placeholder"), size);
+    if (QPixmap *cached = memory.object(key))
+        return *cached;
+
+    QPixmap circular = QPixmap::fromImage(circularImage(QImage(":/icons/profile.png"), size));
+    memory.insert(key, new QPixmap(circular), size * size * 4 / 1024);
+    return circular;
+}
+
+/**
+ * @brief Clave de memoria: URL y diámetro.
+ */
+QString AvatarService::keyFor(const QString &url, int size) const {
+    return url + '@' + QString::number(size);
+}
+
+/**
+ * @brief Ruta en disco de la imagen original de una URL.
+ */
+QString AvatarService::pathFor(const QString &url) const {
+    QByteArray name = QCryptographicHash::hash(url.toUtf8(), QCryptographicHash::Sha1).toHex();
+    return directory + '/' + QString::fromLatin1(name) + ".img";
+}
+
+/**
+ * @brief Ruta en disco de los validadores (ETag y Last-Modified) de una URL.
+ */
+QString AvatarService::metaPathFor(const QString &url) const {
+    QString path = pathFor(url);
+    path.chop(4);
+    return path + ".meta";
+}
+
+/**
+ * @brief Recorta la imagen original a cada uno de los diámetros.
+ */
+QHash<int, QImage> AvatarService::crop(const QImage &source, const QList<int> &sizes) {
+    QHash<int, QImage> circles;
+    if (source.isNull())
+        return circles;
+    for (int size : sizes)
+        circles.insert(size, circularImage(source, size));
+    return circles;
+}
+
+/**
+ * @brief Guarda los bytes originales y sus validadores (desde un hilo de trabajo).
+ */
+void AvatarService::save(const QString &path, const QString &metaPath, const QByteArray &data,
+                         const QByteArray &etag, const QByteArray &lastModified) {
+    QSaveFile file(path);
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(data);
+        file.commit();
+    }
+
+    QSaveFile meta(metaPath);
+    if (meta.open(QIODevice::WriteOnly)) {
+        QDataStream out(&meta);
+        out << etag << lastModified;
+        meta.commit();
+    }
+}
+
+/**
+ * @brief Pide un avatar.
+ *
+ * Orden de búsqueda: memoria (respuesta inmediata), carga ya en curso de la
+ * misma URL (se añade a la lista de espera de su diámetro), disco y, por
+ * último, red.
+ */
+void AvatarService::request(const QString &url, int size, QObject *context, Handler onReady) {
+    if (url.isEmpty() || !QUrl(url).isValid()) {
+        qDebug() << "imagen perfil: la URL de la imagen es inválida o está vacía:" << url;
+        return;
+    }
+
+    Waiter waiter;
+    waiter.context = context;
+    waiter.hasContext = (context != nullptr);
+    waiter.onReady = onReady;
+
+    if (QPixmap *cached = memory.object(keyFor(url, size))) {
+        // Si la copia de disco se está revalidando, también recibirá la nueva
+        auto watching = watchers.find(url);
+        if (watching != watchers.end())
+            (*watching)[size].append(waiter);
+        if (onReady) onReady(*cached);
+        return;
+    }
+
+    auto it = pending.find(url);
+    if (it != pending.end()) {
+        (*it)[size].append(waiter);
+        return;
+    }
+    pending[url][size].append(waiter);
+
+    // Copia en disco: se lee, decodifica y recorta en un hilo de trabajo
+    const QString path = pathFor(url);
+    if (QFile::exists(path)) {
+        const QList<int> sizes = {size};
+        workers.start([this, url, path, sizes]() {
+            QFile file(path);
+            QImage source;
+            if (file.open(QIODevice::ReadOnly))
+                source.loadFromData(file.readAll());
+            const QHash<int, QImage> circles = crop(source, sizes);
+            QMetaObject::invokeMethod(this, [this, url, source, circles]() {
+                deliver(url, source, circles, true);
+            }, Qt::QueuedConnection);
+        });
+        return;
+    }
+
+    QNetworkReply *reply = manager->get(QNetworkRequest(QUrl(url)));
+    connect(reply, &QNetworkReply::finished, this, [this, reply, url]() {
+        reply->deleteLater();
+        if (reply->error() != QNetworkReply::NoError) {
+            qDebug() << "Error al descargar la imagen" << url << ":" << reply->errorString();
+            pending.remove(url);
+            return;
+        }
+        decode(url, reply->readAll(), reply->rawHeader("ETag"), reply->rawHeader("Last-Modified"));
+    });
+}
+
+/**
+ * @brief Consulta solo la memoria; pensado para delegados que pintan en cada repintado.
+ */
+QPixmap AvatarService::cached(const QString &url, int size) const {
+    if (QPixmap *p = memory.object(keyFor(url, size)))
+        return *p;
+    return QPixmap();
+}
+
+/**
+ * @brief Guarda los bytes descargados y los recorta a los diámetros en espera, en un hilo de trabajo.
+ */
+void AvatarService::decode(const QString &url, const QByteArray &data,
+                           const QByteArray &etag, const QByteArray &lastModified) {
+    const QList<int> sizes = pending.value(url).keys();
+    const QString path = pathFor(url);
+    const QString metaPath = metaPathFor(url);
+    workers.start([this, url, data, etag, lastModified, sizes, path, metaPath]() {
+        QImage source;
+        if (source.loadFromData(data))
+            save(path, metaPath, data, etag, lastModified);
+        const QHash<int, QImage> circles = crop(source, sizes);
+        QMetaObject::invokeMethod(this, [this, url, source, circles]() {
+            deliver(url, source, circles, false);
+        }, Qt::QueuedConnection);
+    });
+}
+
+/**
+ * @brief Guarda en memoria un avatar recortado.
+ */
+QPixmap AvatarService::remember(const QString &url, int size, const QImage &circle) {
+    QPixmap pixmap = QPixmap::fromImage(circle);
+    memory.insert(keyFor(url, size), new QPixmap(pixmap), circle.width() * circle.height() * 4 / 1024);
+    return pixmap;
+}
+
+/**
+ * @brief Avisa a las vistas que siguen vivas.
+ */
+void AvatarService::notify(const QList<Waiter> &waiters, const QPixmap &pixmap) {
+    for (const Waiter &w : waiters) {
+        if (w.hasContext && !w.context) continue;
+        if (w.onReady) w.onReady(pixmap);
+    }
+}
+
+/**
+ * @brief Entrega cada diámetro recortado (hilo de interfaz).
+ *
+ * Los diámetros pedidos mientras se recortaba vuelven a recortarse de la misma
+ * imagen, sin otra descarga. Si venía de disco, las vistas quedan a la espera
+ * de la revalidación.
+ */
+void AvatarService::deliver(const QString &url, const QImage &source,
+                            const QHash<int, QImage> &circles, bool fromDisk) {
+    Waiting waiting = pending.take(url);
+    if (source.isNull()) {
+        qDebug() << "Error al cargar la imagen de avatar" << url;
+        if (fromDisk)
+            QFile::remove(pathFor(url));     // copia dañada: la próxima vez se descarga
+        return;
+    }
+
+    Waiting late;
+    for (auto it = waiting.begin(); it != waiting.end();) {
+        if (circles.contains(it.key())) {
+            ++it;
+        } else {
+            late.insert(it.key(), it.value());
+            it = waiting.erase(it);
+        }
+    }
+    if (!late.isEmpty()) {
+        pending.insert(url, late);
+        const QList<int> sizes = late.keys();
+        workers.start([this, url, source, sizes, fromDisk]() {
+            const QHash<int, QImage> more = crop(source, sizes);
+            QMetaObject::invokeMethod(this, [this, url, source, more, fromDisk]() {
+                deliver(url, source, more, fromDisk);
+            }, Qt::QueuedConnection);
+        });
+    }
+
+    // Copia de disco: la primera vez en la sesión se revalida, y mientras
+    // tanto las vistas servidas quedan a la espera de una posible foto nueva
+    const bool checking = watchers.contains(url);
+    if (fromDisk && (checking || !revalidated.contains(url))) {
+        Waiting &watching = watchers[url];
+        for (auto it = waiting.cbegin(); it != waiting.cend(); ++it)
+            watching[it.key()].append(it.value());
+        if (!checking) {
+            revalidated.insert(url);
+            revalidate(url);
+        }
+    }
+
+    for (auto it = waiting.cbegin(); it != waiting.cend(); ++it)
+        notify(it.value(), remember(url, it.key(), circles.value(it.key())));
+}
+
+/**
+ * @brief Petición condicional de una imagen servida desde disco.
+ *
+ * Con 304 (o sin red) la copia sigue valiendo. Si llega otra imagen se guarda,
+ * se recorta a los diámetros de las vistas que esperan y se les entrega.
+ */
+void AvatarService::revalidate(const QString &url) {
+    QNetworkRequest request{QUrl(url)};
+    QFile meta(metaPathFor(url));
+    if (meta.open(QIODevice::ReadOnly)) {
+        QDataStream in(&meta);
+        QByteArray etag, lastModified;
+        in >> etag >> lastModified;
+        if (!etag.isEmpty())
+            request.setRawHeader("If-None-Match", etag);
+        if (!lastModified.isEmpty())
+            request.setRawHeader("If-Modified-Since", lastModified);
+    }
+
+    QNetworkReply *reply = manager->get(request);
+    connect(reply, &QNetworkReply::finished, this, [this, reply, url]() {
+        reply->deleteLater();
+        const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        if (reply->error() != QNetworkReply::NoError || status == 304) {
+            watchers.remove(url);
+            return;
+        }
+
+        const QByteArray data = reply->readAll();
+        const QByteArray etag = reply->rawHeader("ETag");
+        const QByteArray lastModified = reply->rawHeader("Last-Modified");
+        const QList<int> sizes = watchers.value(url).keys();
+        const QString path = pathFor(url);
+        const QString metaPath = metaPathFor(url);
+        workers.start([this, url, data, etag, lastModified, sizes, path, metaPath]() {
+            QFile file(path);
+            const bool same = file.open(QIODevice::ReadOnly) && file.readAll() == data;
+            file.close();
+
+            // Sin validadores el servidor responde 200 aunque no haya cambios
+            QImage source;
+            if (same || !source.loadFromData(data)) {
+                if (same)
+                    save(path, metaPath, data, etag, lastModified);
+                QMetaObject::invokeMethod(this, [this, url]() {
+                    watchers.remove(url);
+                }, Qt::QueuedConnection);
+                return;
+            }
+            save(path, metaPath, data, etag, lastModified);
+            const QHash<int, QImage> circles = crop(source, sizes);
+            QMetaObject::invokeMethod(this, [this, url, source, circles]() {
+                refresh(url, source, circles);
+            }, Qt::QueuedConnection);
+        });
+    });
+}
+
+/**
+ * @brief Sustituye en memoria una foto que ha cambiado y vuelve a avisar a las vistas.
+ *
+ * Los diámetros pedidos durante el recorte (pocos y pequeños) se recortan aquí.
+ */
+void AvatarService::refresh(const QString &url, const QImage &source,
+                            const QHash<int, QImage> &circles) {
+    const Waiting waiting = watchers.take(url);
+    forget(url);
+    for (auto it = waiting.cbegin(); it != waiting.cend(); ++it) {
+        const QImage circle = circles.contains(it.key()) ? circles.value(it.key())
+                                                         : circularImage(source, it.key());
+        notify(it.value(), remember(url, it.key(), circle));
+    }
+}
+
+/**
+ * @brief Olvida en memoria todos los diámetros de una URL.
+ */
+void AvatarService::forget(const QString &url) {
+    const QString prefix = url + '@';
+    const QStringList keys = memory.keys();
+    for (const QString &key : keys) {
+        if (key.startsWith(prefix))
+            memory.remove(key);
+    }
+}
+
+/**
+ * @brief Muestra el avatar por defecto y lo sustituye cuando llega el real.
+ */
+void AvatarService::setAvatar(Icon *icon, const QString &url, int size) {
+    if (!icon) {
+        qDebug() << "imagen perfil: avatarIcon es nullptr.";
+        return;
+    }
+    if (url.isEmpty() || !memory.contains(keyFor(url, size)))
+        icon->setPixmapImg(placeholder(size), size, size);
+    if (url.isEmpty())
+        return;
+
+    QPointer<Icon> target = icon;
+    request(url, size, icon, [target, size](const QPixmap &avatar) {
+        if (target) target->setPixmapImg(avatar, size, size);
+    });
+}
+
+/**
+ * @brief Olvida una URL en memoria (todos los tamaños) y en disco.
+ */
+void AvatarService::invalidate(const QString &url) {
+    forget(url);
+    QFile::remove(pathFor(url));
+    QFile::remove(metaPathFor(url));
+    revalidated.remove(url);
+}
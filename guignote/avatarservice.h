@@ -0,0 +1,150 @@
+/**
+ * @file avatarservice.h
+ * @brief Declaración de la clase AvatarService, servicio compartido de fotos de perfil.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * La clase AvatarService descarga, recorta en círculo y guarda en caché las fotos
+ * de perfil que muestran la ventana de amigos y las ventanas de perfil.
+ */
+
+#ifndef AVATARSERVICE_H
+#define AVATARSERVICE_H
+
+#include <QObject>
+#include <QCache>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QImage>
+#include <QPixmap>
+#include <QPointer>
+#include <QThreadPool>
+#include <functional>
+
+class QNetworkAccessManager;
+class Icon;
+
+/**
+ * @class AvatarService
+ * @brief Caché LRU de avatares circulares con persistencia en disco.
+ *
+ * Los avatares se indexan por URL y tamaño. Si varias vistas piden la misma
+ * URL a la vez, aunque sea a diámetros distintos, solo se hace una descarga y
+ * de ella se recortan todos los diámetros. La decodificación y el recorte
+ * circular se hacen en hilos de trabajo; el hilo de la interfaz solo convierte
+ * el resultado a QPixmap y lo entrega.
+ *
+ * Junto a cada imagen en disco se guardan su ETag y su Last-Modified. La
+ * primera vez que se usa una copia de disco en la sesión se revalida en
+ * segundo plano; si el amigo ha cambiado la foto, las vistas que recibieron la
+ * copia vieja reciben la nueva.
+ */
+class AvatarService : public QObject {
+    Q_OBJECT
+
+public:
+    /// Recibe el avatar ya recortado.
+    using Handler = std::function<void(const QPixmap &avatar)>;
+
+    /**
+     * @brief Devuelve la instancia compartida por toda la aplicación.
+     */
+    static AvatarService &instance();
+
+    /**
+     * @brief Constructor.
+     * @param directory Carpeta donde guardar las imágenes originales (vacía = CacheLocation/avatars).
+     * @param parent Objeto padre.
+     */
+    explicit AvatarService(const QString &directory = QString(), QObject *parent = nullptr);
+
+    /**
+     * @brief Recorta una imagen en un círculo de diámetro dado.
+     * @param src Imagen original.
+     * @param size Diámetro del círculo.
+     * @return Imagen ARGB con el exterior transparente.
+     *
+     * Trabaja sobre QImage, por lo que puede llamarse desde cualquier hilo.
+     */
+    static QImage circularImage(const QImage &src, int size);
+
+    /**
+     * @brief Avatar por defecto (:/icons/profile.png) recortado al tamaño pedido.
+     * @param size Diámetro del círculo.
+     */
+    QPixmap placeholder(int size);
+
+    /**
+     * @brief Pide un avatar.
+     * @param url URL de la imagen en el servidor.
+     * @param size Diámetro del círculo.
+     * @param context Objeto cuyo ciclo de vida limita el callback (puede ser nullptr).
+     * @param onReady Se invoca con el avatar; de forma inmediata si ya estaba en memoria,
+     *                y de nuevo si la revalidación trae una foto distinta.
+     */
+    void request(const QString &url, int size, QObject *context, Handler onReady);
+
+    /**
+     * @brief Avatar ya recortado en memoria, sin lanzar ninguna carga.
+     * @param url URL de la imagen.
+     * @param size Diámetro del círculo.
+     * @return El avatar, o un QPixmap nulo si no está en memoria.
+     */
+    QPixmap cached(const QString &url, int size) const;
+
+    /**
+     * @brief Muestra el avatar por defecto en el icono y lo sustituye cuando llega el real.
+     * @param icon Icono destino.
+     * @param url URL de la imagen (vacía = solo avatar por defecto).
+     * @param size Diámetro del círculo.
+     */
+    void setAvatar(Icon *icon, const QString &url, int size);
+
+    /**
+     * @brief Olvida la copia en memoria y en disco de una URL (p. ej. tras cambiar la foto).
+     * @param url URL de la imagen.
+     */
+    void invalidate(const QString &url);
+
+private:
+    /**
+     * @struct Waiter
+     * @brief Vista que espera un avatar en curso.
+     */
+    struct Waiter {
+        QPointer<QObject> context; ///< Objeto que limita el callback.
+        bool hasContext = false;   ///< false si se pidió sin contexto.
+        Handler onReady;           ///< Callback a invocar.
+    };
+
+    /// Vistas en espera por diámetro.
+    using Waiting = QHash<int, QList<Waiter>>;
+
+    QString keyFor(const QString &url, int size) const;
+    QString pathFor(const QString &url) const;
+    QString metaPathFor(const QString &url) const;
+    static QHash<int, QImage> crop(const QImage &source, const QList<int> &sizes);
+    static void save(const QString &path, const QString &metaPath, const QByteArray &data,
+                     const QByteArray &etag, const QByteArray &lastModified);
+    void decode(const QString &url, const QByteArray &data,
+                const QByteArray &etag, const QByteArray &lastModified);
+    void deliver(const QString &url, const QImage &source,
+                 const QHash<int, QImage> &circles, bool fromDisk);
+    void revalidate(const QString &url);
+    void refresh(const QString &url, const QImage &source, const QHash<int, QImage> &circles);
+    void forget(const QString &url);
+    QPixmap remember(const QString &url, int size, const QImage &circle);
+    static void notify(const QList<Waiter> &waiters, const QPixmap &pixmap);
+
+    QCache<QString, QPixmap> memory;         ///< LRU de avatares recortados (coste en KB).
+    QHash<QString, Waiting> pending;         ///< Cargas en curso por URL.
+    QHash<QString, Waiting> watchers;        ///< Vistas con la copia de disco mientras se revalida.
+    QSet<QString> revalidated;               ///< URLs ya revalidadas en esta sesión.
+    QNetworkAccessManager *manager;          ///< Gestor de descargas compartido.
+    QThreadPool workers;                     ///< Hilos de decodificación.
+    QString directory;                       ///< Carpeta de persistencia.
+};
+
+#endif // AVATARSERVICE_H
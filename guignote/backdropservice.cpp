@@ -0,0 +1,156 @@
+/**
+ * @file backdropservice.cpp
+ * @brief Implementación de la clase BackdropService.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * Contiene la composición del gradiente y los ornamentos de cada tapete y su
+ * almacenamiento en QPixmapCache.
+ */
+
+#include "backdropservice.h"
+#include <QPixmapCache>
+#include <QRadialGradient>
+#include <QPainter>
+#include <QWidget>
+#include <QDebug>
+
+namespace {
+/**
+ * @struct Tapete
+ * @brief Colores y ornamento de un tapete.
+ */
+struct Tapete {
+    const char *centro;    ///< Color en el centro del gradiente.
+    const char *borde;     ///< Color en el borde del gradiente.
+    const char *ornamento; ///< Recurso del ornamento de esquina.
+};
+
+/// Los mismos colores que usaban las hojas de estilo de cada ventana.
+bool tapetePorId(int tapeteId, Tapete &out) {
+    switch (tapeteId) {
+    case 1: out = {"#1f5a1f", "#0a2a08", ":/images/set-golden-border-ornaments/gold_ornaments.png"};   return true;
+    case 2: out = {"#5a1f1f", "#2a0808", ":/images/set-golden-border-ornaments/black_ornaments.png"};  return true;
+    case 3: out = {"#0055AA", "#2a0808", ":/images/set-golden-border-ornaments/silver_ornaments.png"}; return true;
+    case 4: out = {"#2f2f2f", "#000000", ":/images/set-golden-border-ornaments/god_ornaments.png"};    return true;
+    default: return false;
+    }
+}
+}
+
+/**
+ * @brief Devuelve la instancia compartida.
+ */
+BackdropService &BackdropService::instance() {
+    static BackdropService *service = new BackdropService();
+    return *service;
+}
+
+/**
+ * @brief Constructor de BackdropService.
+ */
+BackdropService::BackdropService(QObject *parent)
+    : QObject(parent)
+{
+    workers.setMaxThreadCount(1);
+}
+
+/**
+ * @brief Clave en QPixmapCache: tapete, tamaño y relación de píxeles.
+ */
+QString BackdropService::keyFor(int tapeteId, const QSize &size, qreal dpr) {
+    return QStringLiteral("backdrop:%1:%2x%3@%4")
+        .arg(tapeteId).arg(size.width()).arg(size.height()).arg(dpr);
+}
+
+/**
+ * @brief Compone gradiente y ornamentos.
+ *
+ * El gradiente usa coordenadas relativas al rectángulo, igual que
+ * "qradialgradient(cx:0.5, cy:0.5, radius:1, ...)" en una hoja de estilo. El
+ * ornamento se escala una vez; las otras tres esquinas son reflejos, que no
+ * necesitan interpolación.
+ */
+QImage BackdropService::render(int tapeteId, const QSize &size, qreal dpr) {
+    Tapete tapete;
+    if (!tapetePorId(tapeteId, tapete) || size.isEmpty())
+        return QImage();
+
+    QImage image(size * dpr, QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(dpr);
+
+    QPainter painter(&image);
+    QRadialGradient gradient(0.5, 0.5, 1, 0.5, 0.5);
+    gradient.setCoordinateMode(QGradient::ObjectBoundingMode);
+    gradient.setColorAt(0, QColor(tapete.centro));
+    gradient.setColorAt(1, QColor(tapete.borde));
+    painter.fillRect(QRect(QPoint(0, 0), size), gradient);
+
+    QImage source(tapete.ornamento);
+    if (source.isNull()) {
+        qWarning() << "[FONDO] No se puede cargar" << tapete.ornamento;
+        return image;
+    }
+    const QImage topLeft = source.scaled(ornamentSize() * dpr, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    const QSize o = topLeft.size() / dpr;
+    const int w = size.width();
+    const int h = size.height();
+
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, false);
+    painter.drawImage(QRect(0, 0, o.width(), o.height()), topLeft);
+    painter.drawImage(QRect(w - o.width(), 0, o.width(), o.height()), topLeft.mirrored(true, false));
+    painter.drawImage(QRect(0, h - o.height(), o.width(), o.height()), topLeft.mirrored(false, true));
+    painter.drawImage(QRect(w - o.width(), h - o.height(), o.width(), o.height()), topLeft.mirrored(true, true));
+    painter.end();
+    return image;
+}
+
+/**
+ * @brief Copia en caché o, si falta, composición inmediata.
+ */
+QPixmap BackdropService::pixmap(int tapeteId, const QSize &size, qreal dpr) {
+    const QString key = keyFor(tapeteId, size, dpr);
+    QPixmap cached;
+    if (QPixmapCache::find(key, &cached))
+        return cached;
+
+    QImage image = render(tapeteId, size, dpr);
+    if (image.isNull())
+        return QPixmap();
+    cached = QPixmap::fromImage(std::move(image));
+    QPixmapCache::insert(key, cached);
+    return cached;
+}
+
+/**
+ * @brief Compone el fondo en segundo plano; se ignora si ya está o se está componiendo.
+ */
+void BackdropService::prerender(int tapeteId, const QSize &size, qreal dpr) {
+    const QString key = keyFor(tapeteId, size, dpr);
+    QPixmap cached;
+    if (pending.contains(key) || QPixmapCache::find(key, &cached))
+        return;
+    pending.insert(key);
+
+    workers.start([this, key, tapeteId, size, dpr]() {
+        QImage image = render(tapeteId, size, dpr);
+        QMetaObject::invokeMethod(this, [this, key, tapeteId, size, image]() {
+            pending.remove(key);
+            if (image.isNull()) return;
+            QPixmapCache::insert(key, QPixmap::fromImage(image));
+            emit ready(tapeteId, size);
+        }, Qt::QueuedConnection);
+    });
+}
+
+/**
+ * @brief Pinta el fondo sobre todo el widget.
+ */
+void BackdropService::paint(QWidget *widget, int tapeteId) {
+    const QPixmap backdrop = instance().pixmap(tapeteId, widget->size(), widget->devicePixelRatioF());
+    if (backdrop.isNull())
+        return;
+    QPainter painter(widget);
+    painter.drawPixmap(0, 0, backdrop);
+}
@@ -0,0 +1,99 @@
+/**
+ * @file backdropservice.h
+ * @brief Declaración de la clase BackdropService, fondos de tapete pre-renderizados.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * El fondo de la ventana principal, del menú y de la mesa es siempre el mismo
+ * dibujo: el gradiente radial del tapete y los cuatro ornamentos dorados (o del
+ * color del tapete) reflejados en las esquinas. BackdropService lo compone una
+ * sola vez por tapete y tamaño de ventana, y las ventanas solo copian el
+ * resultado en su paintEvent().
+ */
+
+#ifndef BACKDROPSERVICE_H
+#define BACKDROPSERVICE_H
+
+#include <QObject>
+#include <QImage>
+#include <QPixmap>
+#include <QSet>
+#include <QSize>
+#include <QThreadPool>
+
+class QWidget;
+
+/**
+ * @class BackdropService
+ * @brief Compone y guarda en QPixmapCache el fondo de cada tapete.
+ *
+ * - render() trabaja sobre QImage, así que puede llamarse desde un hilo de
+ *   trabajo (prerender()).
+ * - pixmap() devuelve la copia en caché; si aún no existe la compone en el
+ *   momento, de modo que una ventana nunca se queda sin fondo.
+ */
+class BackdropService : public QObject {
+    Q_OBJECT
+
+public:
+    /** @brief Instancia compartida por toda la aplicación. */
+    static BackdropService &instance();
+
+    /**
+     * @brief Constructor.
+     * @param parent Objeto padre.
+     */
+    explicit BackdropService(QObject *parent = nullptr);
+
+    /**
+     * @brief Compone el fondo de un tapete.
+     * @param tapeteId Tapete (1 verde, 2 rojo, 3 azul, 4 negro).
+     * @param size Tamaño lógico de la ventana.
+     * @param dpr Relación de píxeles de la pantalla.
+     * @return Imagen del fondo, o nula si el tapete no existe.
+     */
+    static QImage render(int tapeteId, const QSize &size, qreal dpr = 1.0);
+
+    /**
+     * @brief Fondo ya compuesto (se compone aquí si no estaba en caché).
+     * @param tapeteId Tapete.
+     * @param size Tamaño lógico de la ventana.
+     * @param dpr Relación de píxeles de la pantalla.
+     */
+    QPixmap pixmap(int tapeteId, const QSize &size, qreal dpr = 1.0);
+
+    /**
+     * @brief Compone el fondo en un hilo de trabajo, antes de que haga falta.
+     * @param tapeteId Tapete.
+     * @param size Tamaño lógico de la ventana.
+     * @param dpr Relación de píxeles de la pantalla.
+     */
+    void prerender(int tapeteId, const QSize &size, qreal dpr = 1.0);
+
+    /**
+     * @brief Pinta el fondo de un tapete sobre todo el widget (para paintEvent()).
+     * @param widget Widget destino.
+     * @param tapeteId Tapete; si no existe no se pinta nada.
+     */
+    static void paint(QWidget *widget, int tapeteId);
+
+    /** @brief Tamaño de cada ornamento de esquina. */
+    static QSize ornamentSize() { return QSize(300, 299); }
+
+signals:
+    /**
+     * @brief Un fondo pre-renderizado ya está en caché.
+     * @param tapeteId Tapete.
+     * @param size Tamaño lógico.
+     */
+    void ready(int tapeteId, const QSize &size);
+
+private:
+    static QString keyFor(int tapeteId, const QSize &size, qreal dpr);
+
+    QThreadPool workers;    ///< Hilo de composición.
+    QSet<QString> pending;  ///< Fondos que se están componiendo.
+};
+
+#endif // BACKDROPSERVICE_H
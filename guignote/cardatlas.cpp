@@ -0,0 +1,253 @@
+/**
+ * @file cardatlas.cpp
+ * @brief Implementación de la clase CardAtlas.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * Contiene la escritura del archivo de cartas en un hilo de trabajo y su
+ * lectura con QFile::map().
+ */
+
+#include "cardatlas.h"
+#include "carta.h"
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QPixmapCache>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QtEndian>
+#include <QDebug>
+#include <cstring>
+
+namespace {
+/// Marca de los archivos de cartas.
+constexpr char kMagic[4] = {'G', 'C', 'A', 'T'};
+/// Marca, versión y tamaño del índice.
+constexpr qint64 kHeaderBytes = 12;
+/// Alineación de los píxeles de cada imagen (una línea de caché).
+constexpr qint64 kAlignment = 64;
+
+qint64 aligned(qint64 bytes) {
+    return (bytes + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+/// Imagen lista para guardar, con su clave de ImageLoader.
+struct Entry {
+    QString key;
+    QImage image;
+};
+}
+
+/**
+ * @brief Devuelve la instancia compartida.
+ */
+CardAtlas &CardAtlas::instance() {
+    static CardAtlas *atlas = new CardAtlas();
+    return *atlas;
+}
+
+/**
+ * @brief Constructor de CardAtlas.
+ * @param directory Carpeta de los archivos (vacía = CacheLocation/cartas).
+ * @param parent Objeto padre.
+ */
+CardAtlas::CardAtlas(const QString &directory, QObject *parent)
+    : QObject(parent),
+      directory(directory)
+{
+    if (this->directory.isEmpty())
+        this->directory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/cartas";
+    QDir().mkpath(this->directory);
+    writer.setMaxThreadCount(1);
+}
+
+/**
+ * @brief Destructor de CardAtlas.
+ */
+CardAtlas::~CardAtlas() {
+    writer.waitForDone();
+    for (const QString &key : std::as_const(residentKeys))
+        ImageLoader::instance().removeResident(key);
+    qDeleteAll(mapped);
+}
+
+/**
+ * @brief Huella: versión, claves, relación de píxeles y tamaño y fecha de cada recurso.
+ */
+QByteArray CardAtlas::fingerprint(const QList<ImageLoader::Request> &requests, qreal dpr) {
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QByteArray::number(kVersion));
+    hash.addData(QByteArray::number(dpr, 'f', 3));
+    for (const ImageLoader::Request &request : requests) {
+        const QFileInfo info(request.path);
+        hash.addData(ImageLoader::keyFor(request.path, request.size, request.mode,
+                                         request.filter.name).toUtf8());
+        hash.addData(QByteArray::number(info.size()));
+        hash.addData(QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+    }
+    return hash.result();
+}
+
+/**
+ * @brief Ruta del archivo de un skin.
+ */
+QString CardAtlas::pathFor(int skin) const {
+    return QString("%1/skin%2.atlas").arg(directory).arg(skin);
+}
+
+/**
+ * @brief Proyecta el archivo y crea los QPixmap directamente sobre sus píxeles.
+ *
+ * Se valida todo el índice antes de tocar QPixmapCache: un archivo truncado o
+ * de otra pantalla se borra entero y no deja la caché a medias.
+ */
+bool CardAtlas::restore(int skin, qreal dpr) {
+    if (mapped.contains(skin))
+        return true;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    auto *file = new QFile(pathFor(skin));
+    if (!file->open(QIODevice::ReadOnly)) {
+        delete file;
+        return false;
+    }
+    const qint64 fileSize = file->size();
+    uchar *base = fileSize > kHeaderBytes ? file->map(0, fileSize) : nullptr;
+
+    auto discard = [file](const char *reason) {
+        qDebug() << "[CARTAS] Se descarta" << file->fileName() << ":" << reason;
+        file->close();
+        QFile::remove(file->fileName());
+        delete file;
+        return false;
+    };
+
+    if (!base)
+        return discard("no se puede proyectar");
+    if (std::memcmp(base, kMagic, sizeof(kMagic)) != 0
+        || qFromLittleEndian<quint32>(base + 4) != kVersion)
+        return discard("versión distinta");
+
+    const qint64 indexBytes = qFromLittleEndian<quint32>(base + 8);
+    const qint64 dataStart = aligned(kHeaderBytes + indexBytes);
+    if (dataStart > fileSize)
+        return discard("índice incompleto");
+
+    QDataStream in(QByteArray::fromRawData(reinterpret_cast<const char *>(base + kHeaderBytes),
+                                           int(indexBytes)));
+    in.setVersion(QDataStream::Qt_5_15);
+    in.setByteOrder(QDataStream::LittleEndian);
+
+    const QList<ImageLoader::Request> requests = Carta::imagenesPartida(skin);
+    QByteArray print;
+    quint32 count = 0;
+    in >> print >> count;
+    if (print != fingerprint(requests, dpr))
+        return discard("pantalla o recursos distintos");
+    if (count != quint32(requests.size()))
+        return discard("número de imágenes distinto");
+
+    QList<QPair<QString, QImage>> images;
+    images.reserve(int(count));
+    for (quint32 i = 0; i < count; ++i) {
+        QString key;
+        qint32 width = 0, height = 0, bytesPerLine = 0, format = 0;
+        quint64 offset = 0, bytes = 0;
+        in >> key >> width >> height >> bytesPerLine >> format >> offset >> bytes;
+        if (in.status() != QDataStream::Ok
+            || width <= 0 || height <= 0
+            || format <= QImage::Format_Invalid || format >= QImage::NImageFormats
+            || bytes < quint64(bytesPerLine) * quint64(height)
+            || quint64(dataStart) + offset + bytes > quint64(fileSize))
+            return discard("índice dañado");
+        // Constructor de solo lectura: la proyección no admite escrituras
+        const uchar *pixels = base + dataStart + offset;
+        images.append({key, QImage(pixels, width, height, bytesPerLine, QImage::Format(format))});
+    }
+
+    for (const auto &image : images) {
+        QPixmapCache::insert(image.first, QPixmap::fromImage(image.second));
+        ImageLoader::instance().addResident(image.first, image.second);
+        residentKeys.append(image.first);
+    }
+    mapped.insert(skin, file);
+
+    qDebug().noquote() << QString("[CARTAS] %1 imágenes del skin %2 desde disco en %3 ms (%4 KB)")
+                              .arg(count).arg(skin).arg(timer.elapsed()).arg(fileSize / 1024);
+    return true;
+}
+
+/**
+ * @brief Recoge de QPixmapCache las imágenes del skin y las escribe en un hilo de trabajo.
+ */
+void CardAtlas::store(int skin, qreal dpr) {
+    const QList<ImageLoader::Request> requests = Carta::imagenesPartida(skin);
+
+    QList<Entry> entries;
+    entries.reserve(requests.size());
+    for (const ImageLoader::Request &request : requests) {
+        const QString key = ImageLoader::keyFor(request.path, request.size, request.mode,
+                                                request.filter.name);
+        QPixmap pixmap;
+        if (!QPixmapCache::find(key, &pixmap)) {
+            qDebug() << "[CARTAS] Falta" << key << "en caché; no se guarda el skin" << skin;
+            return;
+        }
+        entries.append({key, pixmap.toImage()});
+    }
+
+    const QByteArray print = fingerprint(requests, dpr);
+    const QString path = pathFor(skin);
+    writer.start([entries, print, path]() {
+        QElapsedTimer timer;
+        timer.start();
+
+        QByteArray index;
+        QDataStream out(&index, QIODevice::WriteOnly);
+        out.setVersion(QDataStream::Qt_5_15);
+        out.setByteOrder(QDataStream::LittleEndian);
+        out << print << quint32(entries.size());
+        quint64 offset = 0;
+        for (const Entry &entry : entries) {
+            const QImage &image = entry.image;
+            out << entry.key << qint32(image.width()) << qint32(image.height())
+                << qint32(image.bytesPerLine()) << qint32(image.format())
+                << offset << quint64(image.sizeInBytes());
+            offset = aligned(offset + image.sizeInBytes());
+        }
+
+        char header[kHeaderBytes];
+        std::memcpy(header, kMagic, sizeof(kMagic));
+        qToLittleEndian<quint32>(kVersion, header + 4);
+        qToLittleEndian<quint32>(quint32(index.size()), header + 8);
+
+        QSaveFile file(path);
+        if (!file.open(QIODevice::WriteOnly)) {
+            qWarning() << "[CARTAS] No se puede escribir" << path << ":" << file.errorString();
+            return;
+        }
+        file.write(header, kHeaderBytes);
+        file.write(index);
+        qint64 written = kHeaderBytes + index.size();
+        for (const Entry &entry : entries) {
+            file.write(QByteArray(int(aligned(written) - written), '\0'));
+            written = aligned(written);
+            file.write(reinterpret_cast<const char *>(entry.image.constBits()), entry.image.sizeInBytes());
+            written += entry.image.sizeInBytes();
+        }
+        if (!file.commit()) {
+            qWarning() << "[CARTAS] No se puede guardar" << path << ":" << file.errorString();
+            return;
+        }
+        qDebug().noquote() << QString("[CARTAS] %1 imágenes guardadas en %2 ms (%3 KB)")
+                                  .arg(entries.size()).arg(timer.elapsed()).arg(written / 1024);
+    });
+}
@@ -0,0 +1,101 @@
+/**
+ * @file cardatlas.h
+ * @brief Declaración de la clase CardAtlas, caché en disco de las cartas escaladas.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * QPixmapCache se pierde al cerrar la aplicación, así que cada arranque volvía
+ * a decodificar y escalar la baraja entera. CardAtlas guarda en un único
+ * archivo por skin las cartas ya escaladas, giradas y premultiplicadas para la
+ * pantalla actual; el siguiente arranque lo proyecta en memoria con un solo
+ * mmap y deja las imágenes en QPixmapCache sin decodificar ningún PNG. Además
+ * las registra como residentes en ImageLoader, así que una carta que
+ * QPixmapCache expulse vuelve de la proyección y no del PNG.
+ */
+
+#ifndef CARDATLAS_H
+#define CARDATLAS_H
+
+#include "imageloader.h"
+#include <QObject>
+#include <QHash>
+#include <QThreadPool>
+
+class QFile;
+
+/**
+ * @class CardAtlas
+ * @brief Archivo proyectable en memoria con las imágenes de una partida.
+ *
+ * Formato del archivo (todo en orden de bytes little-endian):
+ * - Cabecera: "GCAT", versión y tamaño del índice (3 × 4 bytes).
+ * - Índice (QDataStream): huella, número de imágenes y, por imagen, su clave de
+ *   ImageLoader, ancho, alto, bytes por línea, formato, desplazamiento y tamaño.
+ * - Píxeles de cada imagen, alineados a 64 bytes, tal y como los usa QImage.
+ *
+ * La huella cubre la versión del formato, las claves (que ya llevan el tamaño
+ * de carta, que depende de la resolución), la relación de píxeles y el tamaño
+ * y la fecha de cada recurso. Si no coincide, el archivo se descarta y la
+ * partida se vuelve a preparar con ImageLoader.
+ */
+class CardAtlas : public QObject {
+    Q_OBJECT
+
+public:
+    /// Versión del formato; subirla invalida todos los archivos guardados.
+    static constexpr quint32 kVersion = 1;
+
+    /** @brief Instancia compartida por toda la aplicación. */
+    static CardAtlas &instance();
+
+    /**
+     * @brief Constructor.
+     * @param directory Carpeta de los archivos (vacía = CacheLocation/cartas).
+     * @param parent Objeto padre.
+     */
+    explicit CardAtlas(const QString &directory = QString(), QObject *parent = nullptr);
+
+    /** @brief Destructor: espera a la escritura, retira las residentes y libera las proyecciones. */
+    ~CardAtlas();
+
+    /**
+     * @brief Huella de un conjunto de imágenes para una pantalla.
+     * @param requests Imágenes (Carta::imagenesPartida()).
+     * @param dpr Relación de píxeles de la pantalla.
+     */
+    static QByteArray fingerprint(const QList<ImageLoader::Request> &requests, qreal dpr);
+
+    /** @brief Ruta del archivo de un skin. */
+    QString pathFor(int skin) const;
+
+    /**
+     * @brief Proyecta el archivo del skin y deja sus imágenes en QPixmapCache.
+     * @param skin Identificador del skin (0: base, 1: poker, 2: paint).
+     * @param dpr Relación de píxeles de la pantalla.
+     * @return true si el archivo existía y seguía siendo válido.
+     *
+     * Los QPixmap pueden compartir los píxeles de la proyección, así que esta
+     * se mantiene mientras viva el CardAtlas.
+     */
+    bool restore(int skin, qreal dpr);
+
+    /**
+     * @brief Guarda en disco las imágenes del skin que ya están en QPixmapCache.
+     * @param skin Identificador del skin.
+     * @param dpr Relación de píxeles de la pantalla.
+     *
+     * La escritura se hace en un hilo de trabajo y con QSaveFile, así que un
+     * cierre a medias nunca deja un archivo corrupto. Si falta alguna imagen
+     * en caché no se guarda nada.
+     */
+    void store(int skin, qreal dpr);
+
+private:
+    QString directory;               ///< Carpeta de los archivos.
+    QHash<int, QFile *> mapped;      ///< Archivos proyectados por skin.
+    QStringList residentKeys;        ///< Claves registradas en ImageLoader.
+    QThreadPool writer;              ///< Hilo de escritura.
+};
+
+#endif // CARDATLAS_H
@@ -96,21 +96,69 @@ void Carta::setOrientacion(Orientacion orientacion) {
  * Se aplican transformaciones para obtener imágenes verticales y horizontales.
  */
 void Carta::cargarImagen() {
+    QString ruta = rutaImagen(skin, valor, palo);
+    QSize tam = tamanoImagen();
+
+    // La pantalla de carga deja la baraja ya escalada (y girada) en la caché de ImageLoader
+    img[0] = ImageLoader::instance().pixmap(ruta, tam, Qt::KeepAspectRatioByExpanding);
+    img[1] = ImageLoader::instance().pixmap(ruta, tam, Qt::KeepAspectRatioByExpanding, girada());
+
+    this->setPixmap(img[orientacion % 2]);
+    this->resize(img[orientacion % 2].size());
+}
+
+/**
+ * @brief Ruta del recurso de una carta según skin, valor y palo.
+ */
+QString Carta::rutaImagen(int skin, const QString& valor, const QString& palo) {
     QString _skin = "base";
-    if (Carta::skin == 1) _skin = "poker";
-    if (Carta::skin == 2) _skin = "paint";
+    if (skin == 1) _skin = "poker";
+    if (skin == 2) _skin = "paint";
+    return ":/decks/" + _skin + "/" + valor + palo + ".png";
+}
 
+/**
+ * @brief Tamaño de las cartas: 5 % del ancho y 10 % del alto disponibles.
+ */
+QSize Carta::tamanoImagen() {
     QSize screenSize = QGuiApplication::primaryScreen()->availableGeometry().size();
+    return QSize(screenSize.width() * .05f, screenSize.height() * .1f);
+}
 
-    img[0] = QPixmap(":/decks/" + _skin + "/" + valor + palo + ".png")
-                 .scaled(screenSize.width() * .05f, screenSize.height() * .1f, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+/**
+ * @brief Giro de 90° aplicado en el hilo de ImageLoader.
+ */
+ImageLoader::Filter Carta::girada() {
+    return {QStringLiteral("girada"), [](const QImage &img) {
+        return img.transformed(QTransform().rotate(90));
+    }};
+}
 
-    QTransform transform;
-    transform.rotate(90);
-    img[1] = img[0].transformed(transform);
+/**
+ * @brief Baraja completa de un skin más reverso y zona de juego, en las dos orientaciones.
+ */
+QList<ImageLoader::Request> Carta::imagenesPartida(int skin) {
+    const QSize tam = tamanoImagen();
+    QStringList rutas;
+    const QStringList palos = {"Oros", "Copas", "Espadas", "Bastos"};
+    const QStringList valores = {"1", "2", "3", "4", "5", "6", "7", "10", "11", "12"};
+    // Cada Carta se construye con el skin base y recibe el suyo después
+    for (int s : {skin, 0}) {
+        for (const QString &palo : palos) {
+            for (const QString &valor : valores)
+                rutas.append(rutaImagen(s, valor, palo));
+        }
+        rutas.append(rutaImagen(s, "", "Back"));
+        rutas.append(rutaImagen(s, "", "area"));
+    }
+    rutas.removeDuplicates();
 
-    this->setPixmap(img[orientacion % 2]);
-    this->resize(img[orientacion % 2].size());
+    QList<ImageLoader::Request> peticiones;
+    for (const QString &ruta : rutas) {
+        peticiones.append({ruta, tam, Qt::KeepAspectRatioByExpanding});
+        peticiones.append({ruta, tam, Qt::KeepAspectRatioByExpanding, girada()});
+    }
+    return peticiones;
 }
 
 /**
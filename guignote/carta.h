@@ -13,6 +13,7 @@
 #define CARTA_H
 
 #include "orientacion.h"
+#include "imageloader.h"
 #include <QString>
 #include <QLabel>
 #include <QEnterEvent>
@@ -74,6 +75,35 @@ public:
 
     void setSkin(int skinId);
 
+    /**
+     * @brief Ruta del recurso de una carta.
+     * @param skin Identificador del skin (0: base, 1: poker, 2: paint).
+     * @param valor Valor de la carta (vacío para el reverso).
+     * @param palo Palo de la carta ("Back" para el reverso).
+     * @return Ruta dentro de los recursos de Qt.
+     */
+    static QString rutaImagen(int skin, const QString& valor, const QString& palo);
+
+    /**
+     * @brief Tamaño al que se escalan las cartas en la pantalla principal.
+     */
+    static QSize tamanoImagen();
+
+    /**
+     * @brief Variante girada 90° (cartas en horizontal), para ImageLoader.
+     */
+    static ImageLoader::Filter girada();
+
+    /**
+     * @brief Imágenes que necesita una partida con el skin dado.
+     * @param skin Identificador del skin (0: base, 1: poker, 2: paint).
+     * @return Las 40 cartas, el reverso y la zona de juego, en vertical y en horizontal.
+     *
+     * Incluye también las del skin base, que es con el que se construye cada
+     * carta antes de recibir su setSkin().
+     */
+    static QList<ImageLoader::Request> imagenesPartida(int skin);
+
     /**
      * @brief Establece la orientación de la carta.
      * @param orientacion Valor de tipo Orientacion (por ejemplo, vertical u horizontal).
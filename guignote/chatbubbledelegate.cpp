@@ -0,0 +1,105 @@
+/**
+ * @file chatbubbledelegate.cpp
+ * @brief Implementación de la clase ChatBubbleDelegate.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ */
+
+#include "chatbubbledelegate.h"
+#include "chatmodel.h"
+#include <QAbstractItemView>
+#include <QFontMetrics>
+#include <QPainter>
+#include <QPainterPath>
+
+/**
+ * @brief Constructor de ChatBubbleDelegate.
+ * @param parent Objeto padre.
+ */
+ChatBubbleDelegate::ChatBubbleDelegate(QObject *parent)
+    : QStyledItemDelegate(parent)
+{
+    font.setPixelSize(16);
+    captionFont.setPixelSize(12);
+    // Cada entrada es un QSize: basta con limitar el número de textos recordados
+    layouts.setMaxCost(20000);
+}
+
+/**
+ * @brief Ancho útil de la vista (el del viewport si se conoce).
+ */
+int ChatBubbleDelegate::viewWidth(const QStyleOptionViewItem &option) {
+    if (auto *view = qobject_cast<const QAbstractItemView *>(option.widget))
+        return view->viewport()->width();
+    return option.rect.width() > 0 ? option.rect.width() : kMaxBubbleWidth;
+}
+
+/**
+ * @brief Mide el texto ajustado a la burbuja; la medida se reutiliza mientras no cambie el ancho.
+ */
+QSize ChatBubbleDelegate::textSize(const QString &text, int viewWidth) const {
+    const QString key = QString::number(viewWidth) + '|' + text;
+    if (QSize *cached = layouts.object(key))
+        return *cached;
+
+    int available = qMin(kMaxBubbleWidth, viewWidth - 2 * kMargin) - 2 * kPadding;
+    available = qMax(available, 40);
+    QSize size = QFontMetrics(font)
+                     .boundingRect(QRect(0, 0, available, INT_MAX), Qt::TextWordWrap, text)
+                     .size();
+    layouts.insert(key, new QSize(size));
+    return size;
+}
+
+/**
+ * @brief Alto de la fila: texto más márgenes; ocupa todo el ancho de la vista.
+ */
+QSize ChatBubbleDelegate::sizeHint(const QStyleOptionViewItem &option,
+                                   const QModelIndex &index) const {
+    int width = viewWidth(option);
+    QSize text = textSize(index.data(Qt::DisplayRole).toString(), width);
+    int caption = index.data(ChatModel::FailedRole).toBool() ? kCaptionHeight : 0;
+    return QSize(width, text.height() + 2 * kPadding + 2 * kMargin + caption);
+}
+
+/**
+ * @brief Pinta la burbuja y su texto.
+ */
+void ChatBubbleDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
+                               const QModelIndex &index) const {
+    const QString text = index.data(Qt::DisplayRole).toString();
+    const bool own = index.data(ChatModel::OwnRole).toBool();
+    const bool failed = index.data(ChatModel::FailedRole).toBool();
+    QSize size = textSize(text, viewWidth(option));
+
+    int w = size.width() + 2 * kPadding;
+    int h = size.height() + 2 * kPadding;
+    int x = own ? option.rect.right() - kMargin - w + 1 : option.rect.left() + kMargin;
+    QRect bubble(x, option.rect.top() + kMargin, w, h);
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+
+    QPainterPath path;
+    path.addRoundedRect(bubble, 10, 10);
+    QColor fill = own ? QColor(Qt::white) : QColor("#1D4536");
+    if (failed)
+        fill = QColor("#F4D6D6");
+    painter->fillPath(path, fill);
+
+    painter->setFont(font);
+    painter->setPen(own ? QColor(Qt::black) : QColor("#F9F9F4"));
+    painter->drawText(bubble.adjusted(kPadding, kPadding, -kPadding, -kPadding),
+                      Qt::TextWordWrap | Qt::AlignLeft | Qt::AlignTop, text);
+
+    if (failed) {
+        QRect caption(option.rect.left() + kMargin, bubble.bottom() + 1,
+                      option.rect.width() - 2 * kMargin, kCaptionHeight);
+        painter->setFont(captionFont);
+        painter->setPen(QColor("#E57373"));
+        painter->drawText(caption, Qt::AlignRight | Qt::AlignVCenter,
+                          QStringLiteral("No entregado · pulsa para reintentar"));
+    }
+    painter->restore();
+}
@@ -0,0 +1,64 @@
+/**
+ * @file chatbubbledelegate.h
+ * @brief Declaración de la clase ChatBubbleDelegate, que pinta las burbujas de chat.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * ChatBubbleDelegate dibuja cada mensaje de un ChatModel directamente sobre la
+ * vista, sin crear widgets por fila.
+ */
+
+#ifndef CHATBUBBLEDELEGATE_H
+#define CHATBUBBLEDELEGATE_H
+
+#include <QStyledItemDelegate>
+#include <QCache>
+#include <QFont>
+
+/**
+ * @class ChatBubbleDelegate
+ * @brief Delegado que pinta los mensajes como burbujas redondeadas.
+ *
+ * Los mensajes propios se alinean a la derecha en blanco y los del resto a la
+ * izquierda en verde. Un mensaje propio no entregado se pinta en rojo claro con
+ * un aviso debajo para reintentarlo. El tamaño del texto ajustado se guarda por ancho de la
+ * vista, de modo que solo se vuelve a medir al cambiar ese ancho.
+ */
+class ChatBubbleDelegate : public QStyledItemDelegate {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor.
+     * @param parent Objeto padre (normalmente la vista).
+     */
+    explicit ChatBubbleDelegate(QObject *parent = nullptr);
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option,
+               const QModelIndex &index) const override;
+    QSize sizeHint(const QStyleOptionViewItem &option,
+                   const QModelIndex &index) const override;
+
+private:
+    /**
+     * @brief Tamaño del texto ajustado al ancho disponible (con caché).
+     * @param text Texto del mensaje.
+     * @param viewWidth Ancho de la vista.
+     */
+    QSize textSize(const QString &text, int viewWidth) const;
+
+    /** @brief Ancho de la vista en la que se pinta. */
+    static int viewWidth(const QStyleOptionViewItem &option);
+
+    static constexpr int kMaxBubbleWidth = 500;  ///< Ancho máximo de una burbuja.
+    static constexpr int kPadding = 10;          ///< Margen interior de la burbuja.
+    static constexpr int kMargin = 5;            ///< Separación entre burbujas y con el borde.
+    static constexpr int kCaptionHeight = 18;    ///< Alto del aviso de mensaje no entregado.
+
+    QFont font;                                  ///< Fuente de los mensajes (16 px).
+    QFont captionFont;                           ///< Fuente del aviso de no entregado (12 px).
+    mutable QCache<QString, QSize> layouts;      ///< "<ancho>|<texto>" → tamaño del texto.
+};
+
+#endif // CHATBUBBLEDELEGATE_H
@@ -0,0 +1,215 @@
+/**
+ * @file chathistoryloader.cpp
+ * @brief Implementación de ChatStreamParser y ChatHistoryLoader.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * Contiene el análisis incremental de la lista de mensajes y la entrega
+ * paginada del historial a las ventanas de chat.
+ */
+
+#include "chathistoryloader.h"
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QDebug>
+#include <algorithm>
+
+/**
+ * @brief Convierte un objeto JSON de mensaje en ChatMessage.
+ *
+ * El emisor puede venir como id numérico o como objeto con campo "id".
+ */
+static ChatMessage toMessage(const QJsonObject &o) {
+    ChatMessage m;
+    if (o.contains("id"))
+        m.id = o["id"].toVariant().toString();
+    QJsonValue emisor = o["emisor"];
+    m.senderId = emisor.isObject() ? QString::number(emisor.toObject()["id"].toInt())
+                                   : QString::number(emisor.toInt());
+    m.content = o["contenido"].toString();
+    m.sentAt = o["fecha_envio"].toString();
+    return m;
+}
+
+/**
+ * @brief Analiza los bytes nuevos y devuelve los mensajes que se han completado.
+ */
+QList<ChatMessage> ChatStreamParser::feed(const QByteArray &chunk) {
+    QList<ChatMessage> out;
+    if (done) return out;
+    buffer.append(chunk);
+
+    // 1) Buscar el comienzo de la lista "mensajes"
+    if (!inArray) {
+        int key = buffer.indexOf("\"mensajes\"");
+        if (key < 0) return out;
+        int open = buffer.indexOf('[', key);
+        if (open < 0) return out;
+        inArray = true;
+        buffer.remove(0, open + 1);
+        scanPos = 0;
+    }
+
+    // 2) Recorrer la lista separando los objetos de primer nivel
+    for (; scanPos < buffer.size(); ++scanPos) {
+        char c = buffer.at(scanPos);
+        if (inString) {
+            if (escape) escape = false;
+            else if (c == '\\') escape = true;
+            else if (c == '"') inString = false;
+            continue;
+        }
+        if (c == '"') {
+            inString = true;
+        } else if (c == '{') {
+            if (depth++ == 0) objStart = scanPos;
+        } else if (c == '}') {
+            if (--depth == 0 && objStart >= 0) {
+                QJsonObject o = QJsonDocument::fromJson(buffer.mid(objStart, scanPos - objStart + 1)).object();
+                if (!o.isEmpty()) out.append(toMessage(o));
+                objStart = -1;
+            }
+        } else if (c == ']' && depth == 0) {
+            done = true;
+            buffer.clear();
+            scanPos = 0;
+            return out;
+        }
+    }
+
+    // 3) Descartar lo ya analizado, conservando el objeto a medias
+    int keepFrom = (objStart >= 0) ? objStart : scanPos;
+    buffer.remove(0, keepFrom);
+    scanPos -= keepFrom;
+    if (objStart >= 0) objStart = 0;
+    return out;
+}
+
+/**
+ * @brief Constructor de ChatHistoryLoader.
+ */
+ChatHistoryLoader::ChatHistoryLoader(const QNetworkRequest &request, bool newestFirst,
+                                     int pageSize, QObject *parent)
+    : QObject(parent),
+      request(request),
+      newestFirst(newestFirst),
+      pageSize(pageSize),
+      manager(new QNetworkAccessManager(this))
+{
+    parsePool.setMaxThreadCount(1);
+}
+
+/**
+ * @brief Destructor: corta la descarga y espera al hilo de análisis.
+ */
+ChatHistoryLoader::~ChatHistoryLoader() {
+    if (reply) {
+        reply->disconnect(this);
+        reply->abort();
+    }
+    parsePool.waitForDone();
+}
+
+/**
+ * @brief Lanza la descarga; cada fragmento recibido se analiza en segundo plano.
+ */
+void ChatHistoryLoader::start() {
+    reply = manager->get(request);
+
+    connect(reply, &QNetworkReply::readyRead, this, [this]() {
+        QByteArray chunk = reply->readAll();
+        parsePool.start([this, chunk]() {
+            QList<ChatMessage> messages = parser.feed(chunk);
+            if (messages.isEmpty()) return;
+            QMetaObject::invokeMethod(this, [this, messages]() {
+                onParsed(messages);
+            }, Qt::QueuedConnection);
+        });
+    });
+
+    connect(reply, &QNetworkReply::finished, this, [this]() {
+        QNetworkReply *r = reply;
+        reply = nullptr;
+        r->deleteLater();
+
+        if (r->error() != QNetworkReply::NoError) {
+            int status = r->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+            qDebug() << "ChatHistoryLoader: error al cargar historial:" << r->errorString();
+            if (r->error() != QNetworkReply::OperationCanceledError)
+                emit failed(status, r->errorString());
+        }
+
+        // Tarea final en la misma cola: se ejecuta tras analizar todos los fragmentos
+        QByteArray tail = r->readAll();
+        parsePool.start([this, tail]() {
+            QList<ChatMessage> messages = parser.feed(tail);
+            QMetaObject::invokeMethod(this, [this, messages]() {
+                if (!messages.isEmpty()) onParsed(messages);
+                onDownloadFinished();
+            }, Qt::QueuedConnection);
+        });
+    });
+}
+
+/**
+ * @brief Acumula los mensajes analizados y entrega una página si ya está completa.
+ */
+void ChatHistoryLoader::onParsed(const QList<ChatMessage> &messages) {
+    pending.append(messages);
+    if (newestFirst) deliverPage();
+}
+
+/**
+ * @brief Fin de la descarga: entrega lo que quede pendiente de la página pedida.
+ */
+void ChatHistoryLoader::onDownloadFinished() {
+    downloadDone = true;
+    // Si el servidor devuelve el más antiguo primero, se invierte una sola vez al final
+    if (!newestFirst)
+        std::reverse(pending.begin(), pending.end());
+    deliverPage();
+}
+
+/**
+ * @brief Pide la siguiente página de mensajes antiguos.
+ */
+void ChatHistoryLoader::fetchOlder() {
+    if (delivered == 0 || olderRequested) return;
+    olderRequested = true;
+    deliverPage();
+}
+
+/**
+ * @brief true si quedan mensajes por entregar o la descarga sigue en curso.
+ */
+bool ChatHistoryLoader::hasMore() const {
+    return !pending.isEmpty() || !downloadDone;
+}
+
+/**
+ * @brief Entrega una página si hay una pedida (la primera siempre lo está) y está completa.
+ */
+void ChatHistoryLoader::deliverPage() {
+    const bool first = (delivered == 0);
+    if (!first && !olderRequested) return;
+    if (!newestFirst && !downloadDone) return;
+    if (pending.size() < pageSize && !downloadDone) return;
+
+    int n = qMin(pageSize, int(pending.size()));
+    if (n == 0 && !first) {
+        olderRequested = false;
+        return;
+    }
+
+    QList<ChatMessage> page = pending.mid(0, n);
+    pending.remove(0, n);
+    std::reverse(page.begin(), page.end());   // orden cronológico para la vista
+
+    ++delivered;
+    olderRequested = false;
+    emit pageReady(page, first);
+}
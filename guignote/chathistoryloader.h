@@ -0,0 +1,137 @@
+/**
+ * @file chathistoryloader.h
+ * @brief Declaración de ChatHistoryLoader, cargador asíncrono del historial de chat.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * ChatHistoryLoader descarga el historial de un chat sin bloquear la interfaz,
+ * lo analiza por fragmentos en un hilo de trabajo y lo entrega por páginas,
+ * de la más reciente a la más antigua.
+ */
+
+#ifndef CHATHISTORYLOADER_H
+#define CHATHISTORYLOADER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QList>
+#include <QMetaType>
+#include <QNetworkRequest>
+#include <QThreadPool>
+
+class QNetworkAccessManager;
+class QNetworkReply;
+
+/**
+ * @struct ChatMessage
+ * @brief Mensaje de chat tal y como lo devuelve el servidor.
+ */
+struct ChatMessage {
+    QString id;        ///< Identificador del mensaje (vacío si el servidor no lo envía).
+    QString senderId;  ///< Id del emisor.
+    QString content;   ///< Texto del mensaje.
+    QString sentAt;    ///< Fecha de envío ("yyyy-MM-dd HH:mm:ss"), si existe.
+};
+Q_DECLARE_METATYPE(ChatMessage)
+
+/**
+ * @class ChatStreamParser
+ * @brief Extrae de forma incremental los objetos de la lista "mensajes" de una respuesta JSON.
+ *
+ * Recibe la respuesta en fragmentos arbitrarios y devuelve cada mensaje en cuanto
+ * su objeto está completo, sin esperar al final del cuerpo.
+ */
+class ChatStreamParser {
+public:
+    /**
+     * @brief Añade un fragmento de la respuesta.
+     * @param chunk Bytes recibidos.
+     * @return Mensajes completados con este fragmento, en el orden de la respuesta.
+     */
+    QList<ChatMessage> feed(const QByteArray &chunk);
+
+    /** @brief true cuando ya se ha cerrado la lista "mensajes". */
+    bool isDone() const { return done; }
+
+private:
+    QByteArray buffer;    ///< Bytes pendientes de analizar.
+    int scanPos = 0;      ///< Posición de análisis dentro de buffer.
+    int objStart = -1;    ///< Inicio del objeto en curso.
+    int depth = 0;        ///< Profundidad de llaves dentro de la lista.
+    bool inArray = false; ///< Se ha encontrado la lista "mensajes".
+    bool inString = false;///< Dentro de una cadena JSON.
+    bool escape = false;  ///< El carácter anterior era una barra invertida.
+    bool done = false;    ///< Lista cerrada.
+};
+
+/**
+ * @class ChatHistoryLoader
+ * @brief Carga paginada y asíncrona del historial de un chat.
+ *
+ * La respuesta se lee según llega (sin truncarla) y se analiza en un hilo de
+ * trabajo. La primera página (los mensajes más recientes) se entrega en cuanto
+ * está completa; las anteriores se piden con fetchOlder(), normalmente al
+ * desplazarse hacia arriba.
+ */
+class ChatHistoryLoader : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor.
+     * @param request Petición del historial (con cabecera Auth).
+     * @param newestFirst true si el servidor devuelve los mensajes del más reciente al más antiguo.
+     * @param pageSize Mensajes por página.
+     * @param parent Objeto padre.
+     */
+    ChatHistoryLoader(const QNetworkRequest &request, bool newestFirst,
+                      int pageSize = 30, QObject *parent = nullptr);
+
+    /** @brief Destructor: espera a que termine el análisis en curso. */
+    ~ChatHistoryLoader();
+
+    /** @brief Lanza la descarga. */
+    void start();
+
+    /** @brief Pide la siguiente página de mensajes más antiguos. */
+    void fetchOlder();
+
+    /** @brief true si quedan mensajes antiguos por entregar (o por llegar). */
+    bool hasMore() const;
+
+signals:
+    /**
+     * @brief Página de mensajes, en orden cronológico (el más antiguo primero).
+     * @param messages Mensajes a insertar encima de los ya mostrados.
+     * @param first true para la primera página (la más reciente).
+     */
+    void pageReady(const QList<ChatMessage> &messages, bool first);
+
+    /**
+     * @brief La descarga ha fallado.
+     * @param httpStatus Código HTTP (0 si no hubo respuesta).
+     * @param error Descripción del error.
+     */
+    void failed(int httpStatus, const QString &error);
+
+private:
+    void onParsed(const QList<ChatMessage> &messages);
+    void onDownloadFinished();
+    void deliverPage();
+
+    QNetworkRequest request;          ///< Petición del historial.
+    bool newestFirst;                 ///< Orden de la respuesta.
+    int pageSize;                     ///< Mensajes por página.
+    QNetworkAccessManager *manager;   ///< Gestor HTTP.
+    QNetworkReply *reply = nullptr;   ///< Descarga en curso.
+    QThreadPool parsePool;            ///< Un único hilo: los fragmentos se analizan en orden.
+    ChatStreamParser parser;          ///< Estado del análisis (solo se usa desde parsePool).
+
+    QList<ChatMessage> pending;       ///< Mensajes recibidos sin entregar, del más reciente al más antiguo.
+    int delivered = 0;                ///< Páginas entregadas.
+    bool olderRequested = false;      ///< Se pidió una página que aún no ha llegado entera.
+    bool downloadDone = false;        ///< Descarga y análisis terminados.
+};
+
+#endif // CHATHISTORYLOADER_H
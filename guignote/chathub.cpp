@@ -0,0 +1,294 @@
+/**
+ * @file chathub.cpp
+ * @brief Implementación de la clase ChatHub.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ */
+
+#include "chathub.h"
+#include "session.h"
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QTimer>
+#include <QUrl>
+#include <QWebSocket>
+#include <QDebug>
+#include <limits>
+
+/**
+ * @brief Conjuntos de conexiones, por clave de usuario; viven hasta el final del proceso.
+ */
+static QHash<QString, ChatHub *> &hubs() {
+    static QHash<QString, ChatHub *> registry;
+    return registry;
+}
+
+/**
+ * @brief Conexiones de un usuario.
+ */
+ChatHub &ChatHub::forUser(const QString &userKey) {
+    ChatHub *&hub = hubs()[userKey];
+    if (!hub)
+        hub = new ChatHub(userKey);
+    return *hub;
+}
+
+/**
+ * @brief Ruta WebSocket del chat con un amigo.
+ */
+QString ChatHub::friendChannel(const QString &friendId) {
+    return QString("/ws/chat/%1/").arg(friendId);
+}
+
+/**
+ * @brief Ruta WebSocket del chat de una partida.
+ */
+QString ChatHub::gameChannel(const QString &chatId) {
+    return QString("/ws/chat_partida/%1/").arg(chatId);
+}
+
+/**
+ * @brief Constructor de ChatHub.
+ */
+ChatHub::ChatHub(const QString &userKey, QObject *parent)
+    : QObject(parent),
+      userKey(userKey),
+      heartbeatTimer(new QTimer(this))
+{
+    heartbeatTimer->setInterval(kHeartbeatMs);
+    connect(heartbeatTimer, &QTimer::timeout, this, &ChatHub::heartbeat);
+}
+
+/**
+ * @brief Crea el canal si hace falta y abre su conexión.
+ */
+void ChatHub::open(const QString &channel) {
+    Channel &c = channels[channel];
+    c.lastActivity = QDateTime::currentMSecsSinceEpoch();
+    if (!c.socket)
+        connectChannel(channel);
+}
+
+/**
+ * @brief Registra una ventana que muestra el canal.
+ */
+void ChatHub::attach(const QString &channel) {
+    open(channel);
+    ++channels[channel].views;
+    markRead(channel);
+}
+
+/**
+ * @brief Quita el registro de una ventana.
+ */
+void ChatHub::detach(const QString &channel) {
+    auto it = channels.find(channel);
+    if (it != channels.end() && it->views > 0)
+        --it->views;
+}
+
+/**
+ * @brief Escribe en el canal si está conectado.
+ */
+bool ChatHub::send(const QString &channel, const QString &frame) {
+    auto it = channels.find(channel);
+    if (it == channels.end() || !it->socket || !it->socket->isValid())
+        return false;
+    it->socket->sendTextMessage(frame);
+    it->lastActivity = QDateTime::currentMSecsSinceEpoch();
+    return true;
+}
+
+/**
+ * @brief Estado de la conexión del canal.
+ */
+bool ChatHub::isConnected(const QString &channel) const {
+    auto it = channels.constFind(channel);
+    return it != channels.constEnd() && it->socket && it->socket->isValid();
+}
+
+/**
+ * @brief No leídos del canal.
+ */
+int ChatHub::unread(const QString &channel) const {
+    return channels.value(channel).unread;
+}
+
+/**
+ * @brief Suma de no leídos.
+ */
+int ChatHub::totalUnread() const {
+    int total = 0;
+    for (const Channel &c : channels)
+        total += c.unread;
+    return total;
+}
+
+/**
+ * @brief Marca el canal como leído.
+ */
+void ChatHub::markRead(const QString &channel) {
+    auto it = channels.find(channel);
+    if (it == channels.end() || it->unread == 0)
+        return;
+    it->unread = 0;
+    emit unreadChanged(channel, 0);
+}
+
+/**
+ * @brief Cierra y olvida todos los canales.
+ */
+void ChatHub::closeAll() {
+    const QStringList open = channels.keys();
+    for (const QString &channel : open)
+        closeChannel(channel);
+    channels.clear();
+    heartbeatTimer->stop();
+}
+
+/**
+ * @brief Abre el WebSocket del canal con el token de la sesión.
+ */
+void ChatHub::connectChannel(const QString &channel) {
+    const QString token = Session::forUser(userKey).token();
+    if (token.isEmpty()) {
+        qWarning() << "[CHAT] Token vacío, no se abre" << channel;
+        return;
+    }
+    evictIfFull();
+
+    QWebSocket *socket = new QWebSocket(QString(), QWebSocketProtocol::VersionLatest, this);
+    channels[channel].socket = socket;
+
+    connect(socket, &QWebSocket::connected, this, [this, channel]() {
+        Channel &c = channels[channel];
+        c.reconnectMs = kMinReconnectMs;
+        c.lastPong = QDateTime::currentMSecsSinceEpoch();
+        emit connected(channel);
+    });
+    connect(socket, &QWebSocket::disconnected, this, [this, channel, socket]() {
+        auto it = channels.find(channel);
+        if (it == channels.end() || it->socket != socket)
+            return;                 // canal cerrado a propósito
+        it->socket = nullptr;
+        socket->deleteLater();
+        scheduleReconnect(channel);
+    });
+    connect(socket, &QWebSocket::textMessageReceived, this, [this, channel](const QString &raw) {
+        route(channel, raw);
+    });
+    connect(socket, &QWebSocket::pong, this, [this, channel](quint64, const QByteArray &) {
+        auto it = channels.find(channel);
+        if (it != channels.end())
+            it->lastPong = QDateTime::currentMSecsSinceEpoch();
+    });
+
+    QUrl url;
+    url.setScheme("ws");
+    url.setHost("188.165.76.134");
+    url.setPort(8000);
+    url.setPath(channel);
+    url.setQuery(QString("token=%1").arg(token));
+    socket->open(url);
+
+    if (!heartbeatTimer->isActive())
+        heartbeatTimer->start();
+}
+
+/**
+ * @brief Cierra la conexión del canal sin reconectar; conserva sus no leídos.
+ */
+void ChatHub::closeChannel(const QString &channel) {
+    auto it = channels.find(channel);
+    if (it == channels.end() || !it->socket)
+        return;
+    QWebSocket *socket = it->socket;
+    it->socket = nullptr;
+    socket->disconnect(this);
+    socket->close();
+    socket->deleteLater();
+}
+
+/**
+ * @brief Reabre el canal tras una espera que se duplica en cada intento.
+ */
+void ChatHub::scheduleReconnect(const QString &channel) {
+    Channel &c = channels[channel];
+    const int delay = c.reconnectMs;
+    c.reconnectMs = qMin(c.reconnectMs * 2, kMaxReconnectMs);
+
+    QTimer::singleShot(delay, this, [this, channel]() {
+        auto it = channels.find(channel);
+        if (it != channels.end() && !it->socket)
+            connectChannel(channel);
+    });
+}
+
+/**
+ * @brief Reparte un mensaje recibido: a las ventanas y, si no hay, a los no leídos.
+ */
+void ChatHub::route(const QString &channel, const QString &raw) {
+    auto it = channels.find(channel);
+    if (it == channels.end())
+        return;
+    it->lastActivity = QDateTime::currentMSecsSinceEpoch();
+
+    QJsonDocument doc = QJsonDocument::fromJson(raw.toUtf8());
+    if (!doc.isObject())
+        return;
+    const QJsonObject message = doc.object();
+
+    // El chat de amigos manda el id del emisor; el de partida, un objeto
+    const QJsonValue emisor = message.value("emisor");
+    const QString senderId = QString::number(emisor.isObject() ? emisor.toObject().value("id").toInt()
+                                                               : emisor.toInt());
+
+    if (it->views == 0 && !message.contains("error")
+        && senderId != Session::forUser(userKey).userId()) {
+        ++it->unread;
+        emit unreadChanged(channel, it->unread);
+    }
+    emit messageReceived(channel, message);
+}
+
+/**
+ * @brief Ping a las conexiones vivas, reapertura de las mudas y cierre de las inactivas.
+ */
+void ChatHub::heartbeat() {
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    for (auto it = channels.begin(); it != channels.end(); ++it) {
+        if (!it->socket || !it->socket->isValid())
+            continue;
+
+        if (it->views == 0 && now - it->lastActivity > kIdleMs) {
+            qDebug() << "[CHAT] Cerrando canal inactivo" << it.key();
+            closeChannel(it.key());
+        } else if (now - it->lastPong > 2 * kHeartbeatMs) {
+            qWarning() << "[CHAT] Sin respuesta al ping en" << it.key() << ", reconectando.";
+            it->socket->abort();    // disconnected → scheduleReconnect()
+        } else {
+            it->socket->ping();
+        }
+    }
+}
+
+/**
+ * @brief Si se ha llegado a kMaxChannels, cierra el canal sin ventana menos activo.
+ */
+void ChatHub::evictIfFull() {
+    int open = 0;
+    QString oldest;
+    qint64 oldestActivity = std::numeric_limits<qint64>::max();
+    for (auto it = channels.cbegin(); it != channels.cend(); ++it) {
+        if (!it->socket)
+            continue;
+        ++open;
+        if (it->views == 0 && it->lastActivity < oldestActivity) {
+            oldest = it.key();
+            oldestActivity = it->lastActivity;
+        }
+    }
+    if (open >= kMaxChannels && !oldest.isEmpty())
+        closeChannel(oldest);
+}
@@ -0,0 +1,152 @@
+/**
+ * @file chathub.h
+ * @brief Declaración de la clase ChatHub, conexiones de chat compartidas.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * ChatHub mantiene abiertos los WebSockets de chat (con amigos y de partida)
+ * aunque las ventanas se cierren: abrir una conversación ya conectada no repite
+ * el handshake y los mensajes de las conversaciones sin ventana se cuentan como
+ * no leídos en lugar de perderse.
+ */
+
+#ifndef CHATHUB_H
+#define CHATHUB_H
+
+#include <QObject>
+#include <QHash>
+#include <QJsonObject>
+#include <QString>
+
+class QWebSocket;
+class QTimer;
+
+/**
+ * @class ChatHub
+ * @brief Conjunto de conexiones de chat de un usuario.
+ *
+ * Cada conversación es un canal identificado por su ruta WebSocket
+ * (friendChannel(), gameChannel()). open() crea la conexión si no existe; las
+ * ventanas se registran con attach()/detach() mientras se muestran. Los
+ * mensajes se reenvían con messageReceived(); si ninguna ventana muestra el
+ * canal, cuentan como no leídos.
+ *
+ * Un único temporizador manda un ping a cada conexión cada kHeartbeatMs y
+ * reabre las que no responden; las que se caen se reabren con espera
+ * creciente. Los canales sin ventana y sin tráfico durante kIdleMs se cierran,
+ * y como máximo hay kMaxChannels conexiones abiertas.
+ */
+class ChatHub : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Conexiones de un usuario (se crean la primera vez).
+     * @param userKey Clave del usuario (nombre o correo).
+     */
+    static ChatHub &forUser(const QString &userKey);
+
+    /** @brief Canal del chat con un amigo. */
+    static QString friendChannel(const QString &friendId);
+
+    /** @brief Canal del chat de una partida. */
+    static QString gameChannel(const QString &chatId);
+
+    /**
+     * @brief Abre el canal si no lo está (no hace nada si ya está conectado).
+     * @param channel Ruta del canal.
+     */
+    void open(const QString &channel);
+
+    /**
+     * @brief Una ventana empieza a mostrar el canal: se abre y se marca como leído.
+     * @param channel Ruta del canal.
+     */
+    void attach(const QString &channel);
+
+    /**
+     * @brief La ventana deja de mostrar el canal; la conexión sigue abierta.
+     * @param channel Ruta del canal.
+     */
+    void detach(const QString &channel);
+
+    /**
+     * @brief Envía una trama por el canal.
+     * @return false si el canal no está conectado.
+     */
+    bool send(const QString &channel, const QString &frame);
+
+    /** @brief true si el canal tiene la conexión abierta. */
+    bool isConnected(const QString &channel) const;
+
+    /** @brief Mensajes no leídos del canal. */
+    int unread(const QString &channel) const;
+
+    /** @brief Mensajes no leídos de todos los canales. */
+    int totalUnread() const;
+
+    /** @brief Pone a cero los no leídos del canal. */
+    void markRead(const QString &channel);
+
+    /** @brief Cierra todas las conexiones (al cerrar sesión). */
+    void closeAll();
+
+    /** @brief Intervalo (ms) entre pings. */
+    static constexpr int kHeartbeatMs = 20000;
+    /** @brief Tiempo (ms) sin tráfico tras el que se cierra un canal sin ventana. */
+    static constexpr int kIdleMs = 10 * 60 * 1000;
+    /** @brief Conexiones abiertas como máximo. */
+    static constexpr int kMaxChannels = 16;
+    /** @brief Espera mínima (ms) antes de reconectar. */
+    static constexpr int kMinReconnectMs = 1000;
+    /** @brief Espera máxima (ms) antes de reconectar. */
+    static constexpr int kMaxReconnectMs = 30000;
+
+signals:
+    /**
+     * @brief Ha llegado un mensaje por un canal.
+     * @param channel Ruta del canal.
+     * @param message Objeto JSON recibido.
+     */
+    void messageReceived(const QString &channel, const QJsonObject &message);
+
+    /** @brief El canal se ha (re)conectado. */
+    void connected(const QString &channel);
+
+    /**
+     * @brief Han cambiado los no leídos de un canal.
+     * @param channel Ruta del canal.
+     * @param count No leídos del canal.
+     */
+    void unreadChanged(const QString &channel, int count);
+
+private:
+    /**
+     * @struct Channel
+     * @brief Estado de una conversación.
+     */
+    struct Channel {
+        QWebSocket *socket = nullptr;     ///< Conexión; nula si está cerrada.
+        int views = 0;                    ///< Ventanas que la muestran.
+        int unread = 0;                   ///< Mensajes recibidos sin ventana.
+        qint64 lastActivity = 0;          ///< Último tráfico (ms desde epoch).
+        qint64 lastPong = 0;              ///< Última respuesta al ping.
+        int reconnectMs = kMinReconnectMs; ///< Espera de la próxima reconexión.
+    };
+
+    explicit ChatHub(const QString &userKey, QObject *parent = nullptr);
+
+    void connectChannel(const QString &channel);
+    void closeChannel(const QString &channel);
+    void scheduleReconnect(const QString &channel);
+    void route(const QString &channel, const QString &raw);
+    void heartbeat();
+    void evictIfFull();
+
+    QString userKey;                   ///< Clave del usuario.
+    QHash<QString, Channel> channels;  ///< Canales por ruta.
+    QTimer *heartbeatTimer;            ///< Pings y cierre de canales inactivos.
+};
+
+#endif // CHATHUB_H
@@ -0,0 +1,128 @@
+/**
+ * @file chatmodel.cpp
+ * @brief Implementación de la clase ChatModel.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ */
+
+#include "chatmodel.h"
+
+/**
+ * @brief Constructor de ChatModel.
+ * @param ownId Id del usuario local.
+ * @param parent Objeto padre.
+ */
+ChatModel::ChatModel(const QString &ownId, QObject *parent)
+    : QAbstractListModel(parent),
+      ownId(ownId)
+{
+}
+
+/**
+ * @brief Número de mensajes.
+ */
+int ChatModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : rows.size();
+}
+
+/**
+ * @brief Datos de un mensaje según el rol pedido.
+ */
+QVariant ChatModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= rows.size())
+        return QVariant();
+
+    const Row &row = rows.at(index.row());
+    const ChatMessage &m = row.message;
+    switch (role) {
+    case Qt::DisplayRole: return m.content;
+    case SenderRole:      return m.senderId;
+    case OwnRole:         return m.senderId == ownId;
+    case ClientIdRole:    return row.clientId;
+    case FailedRole:      return row.failed;
+    default:              return QVariant();
+    }
+}
+
+/**
+ * @brief Añade un mensaje al final.
+ */
+void ChatModel::append(const QString &senderId, const QString &content) {
+    ChatMessage m;
+    m.senderId = senderId;
+    m.content = content;
+    append(QList<ChatMessage>{m});
+}
+
+/**
+ * @brief Añade varios mensajes al final.
+ */
+void ChatModel::append(const QList<ChatMessage> &messages) {
+    if (messages.isEmpty()) return;
+    beginInsertRows(QModelIndex(), rows.size(), rows.size() + messages.size() - 1);
+    for (const ChatMessage &m : messages)
+        rows.append({m, QString(), false});
+    endInsertRows();
+}
+
+/**
+ * @brief Inserta varios mensajes al principio.
+ */
+void ChatModel::prepend(const QList<ChatMessage> &messages) {
+    if (messages.isEmpty()) return;
+    beginInsertRows(QModelIndex(), 0, messages.size() - 1);
+    QList<Row> older;
+    older.reserve(messages.size() + rows.size());
+    for (const ChatMessage &m : messages)
+        older.append({m, QString(), false});
+    rows = older + rows;
+    endInsertRows();
+}
+
+/**
+ * @brief Añade un mensaje propio pendiente de confirmación.
+ */
+void ChatModel::appendOutgoing(const QString &content, const QString &clientId) {
+    ChatMessage m;
+    m.senderId = ownId;
+    m.content = content;
+    beginInsertRows(QModelIndex(), rows.size(), rows.size());
+    rows.append({m, clientId, false});
+    endInsertRows();
+}
+
+/**
+ * @brief Fila de un mensaje enviado desde aquí (se busca desde el final: suele ser reciente).
+ */
+int ChatModel::rowFor(const QString &clientId) const {
+    if (clientId.isEmpty()) return -1;
+    for (int i = rows.size() - 1; i >= 0; --i) {
+        if (rows.at(i).clientId == clientId)
+            return i;
+    }
+    return -1;
+}
+
+/**
+ * @brief Cambia el estado de entrega y avisa a la vista si cambia.
+ */
+bool ChatModel::setFailed(const QString &clientId, bool failed) {
+    int row = rowFor(clientId);
+    if (row < 0) return false;
+    if (rows[row].failed != failed) {
+        rows[row].failed = failed;
+        emit dataChanged(index(row), index(row), {FailedRole});
+    }
+    return true;
+}
+
+/**
+ * @brief Vuelve a dejar el mensaje en espera con el identificador del nuevo envío.
+ */
+void ChatModel::markRetried(int row, const QString &clientId) {
+    if (row < 0 || row >= rows.size()) return;
+    rows[row].clientId = clientId;
+    rows[row].failed = false;
+    emit dataChanged(index(row), index(row), {ClientIdRole, FailedRole});
+}
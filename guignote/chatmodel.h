@@ -0,0 +1,106 @@
+/**
+ * @file chatmodel.h
+ * @brief Declaración de la clase ChatModel, modelo de mensajes de una conversación.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * ChatModel guarda los mensajes que muestran las ventanas de chat (amigos y
+ * partida) y los expone a un QListView pintado por ChatBubbleDelegate.
+ */
+
+#ifndef CHATMODEL_H
+#define CHATMODEL_H
+
+#include <QAbstractListModel>
+#include <QList>
+#include "chathistoryloader.h"
+
+/**
+ * @class ChatModel
+ * @brief Lista de mensajes en orden cronológico.
+ *
+ * Cada fila es un mensaje; el texto se expone con Qt::DisplayRole y el delegado
+ * consulta OwnRole para decidir el color y el lado de la burbuja.
+ */
+class ChatModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    /** @brief Roles adicionales de cada fila. */
+    enum Roles {
+        SenderRole = Qt::UserRole + 1,  ///< Id del emisor.
+        OwnRole,                        ///< true si el mensaje es del usuario local.
+        ClientIdRole,                   ///< Id de cliente de un mensaje enviado desde aquí.
+        FailedRole                      ///< true si el envío se dio por perdido.
+    };
+
+    /**
+     * @brief Constructor.
+     * @param ownId Id del usuario local.
+     * @param parent Objeto padre.
+     */
+    explicit ChatModel(const QString &ownId, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    /**
+     * @brief Añade un mensaje al final.
+     * @param senderId Id del emisor.
+     * @param content Texto del mensaje.
+     */
+    void append(const QString &senderId, const QString &content);
+
+    /**
+     * @brief Añade varios mensajes al final en una sola inserción.
+     * @param messages Mensajes en orden cronológico.
+     */
+    void append(const QList<ChatMessage> &messages);
+
+    /**
+     * @brief Inserta varios mensajes al principio (historial más antiguo).
+     * @param messages Mensajes en orden cronológico.
+     */
+    void prepend(const QList<ChatMessage> &messages);
+
+    /**
+     * @brief Añade al final un mensaje propio que aún espera confirmación.
+     * @param content Texto del mensaje.
+     * @param clientId Identificador que le asignó ChatOutbox.
+     */
+    void appendOutgoing(const QString &content, const QString &clientId);
+
+    /**
+     * @brief Marca un mensaje propio como no entregado (o entregado, si llega un eco tardío).
+     * @param clientId Identificador de cliente.
+     * @param failed true si el envío se dio por perdido.
+     * @return false si no hay ninguna fila con ese identificador.
+     */
+    bool setFailed(const QString &clientId, bool failed);
+
+    /**
+     * @brief Vuelve a poner en espera un mensaje no entregado, con su nuevo identificador.
+     * @param row Fila del mensaje.
+     * @param clientId Identificador del nuevo envío.
+     */
+    void markRetried(int row, const QString &clientId);
+
+private:
+    /**
+     * @struct Row
+     * @brief Mensaje mostrado y, si salió de aquí, su estado de entrega.
+     */
+    struct Row {
+        ChatMessage message;     ///< Mensaje.
+        QString clientId;        ///< Id de cliente (vacío si no se envió desde esta ventana).
+        bool failed = false;     ///< El envío agotó los reintentos.
+    };
+
+    int rowFor(const QString &clientId) const;
+
+    QString ownId;               ///< Id del usuario local.
+    QList<Row> rows;             ///< Mensajes mostrados.
+};
+
+#endif // CHATMODEL_H
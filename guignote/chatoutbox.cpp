@@ -0,0 +1,132 @@
+/**
+ * @file chatoutbox.cpp
+ * @brief Implementación de las clases ChatOutbox y RecentIds.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ */
+
+#include "chatoutbox.h"
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QTimer>
+#include <QUuid>
+#include <QDebug>
+
+/**
+ * @brief Constructor de RecentIds.
+ */
+RecentIds::RecentIds(int capacity)
+    : capacity(capacity)
+{
+}
+
+/**
+ * @brief Inserta el identificador y expulsa el más antiguo si se supera la capacidad.
+ */
+bool RecentIds::insert(const QString &id) {
+    if (ids.contains(id))
+        return false;
+    ids.insert(id);
+    order.enqueue(id);
+    while (order.size() > capacity)
+        ids.remove(order.dequeue());
+    return true;
+}
+
+/**
+ * @brief Consulta sin modificar.
+ */
+bool RecentIds::contains(const QString &id) const {
+    return ids.contains(id);
+}
+
+/**
+ * @brief Constructor de ChatOutbox.
+ * @param send Función de envío.
+ * @param parent Objeto padre.
+ */
+ChatOutbox::ChatOutbox(SendFunction send, QObject *parent)
+    : QObject(parent),
+      send(std::move(send)),
+      retryTimer(new QTimer(this))
+{
+    retryTimer->setInterval(kAckTimeoutMs / 2);
+    connect(retryTimer, &QTimer::timeout, this, &ChatOutbox::checkTimeouts);
+}
+
+/**
+ * @brief Añade el mensaje a la cola y lo envía si hay canal.
+ */
+QString ChatOutbox::enqueue(const QString &content) {
+    Pending message;
+    message.clientId = QUuid::createUuid().toString(QUuid::WithoutBraces);
+    message.content = content;
+    pending.append(message);
+    transmit(pending.last());
+    retryTimer->start();
+    return message.clientId;
+}
+
+/**
+ * @brief Escribe la trama de un mensaje y cuenta el intento.
+ */
+void ChatOutbox::transmit(Pending &message) {
+    QJsonObject frame{{"contenido", message.content}, {"client_id", message.clientId}};
+    if (!send(QString::fromUtf8(QJsonDocument(frame).toJson(QJsonDocument::Compact))))
+        return;  // Sin canal: se enviará en flush() al reconectar
+    ++message.attempts;
+    message.sentAt = QDateTime::currentMSecsSinceEpoch();
+}
+
+/**
+ * @brief Confirma el mensaje pendiente al que corresponde el eco.
+ */
+bool ChatOutbox::acknowledge(const QJsonObject &echo) {
+    const QString clientId = echo.value("client_id").toString();
+    const QString content = echo.value("contenido").toString();
+
+    for (int i = 0; i < pending.size(); ++i) {
+        const Pending &p = pending.at(i);
+        bool match = clientId.isEmpty() ? p.content == content : p.clientId == clientId;
+        if (!match) continue;
+
+        QString id = p.clientId;
+        pending.removeAt(i);
+        if (pending.isEmpty())
+            retryTimer->stop();
+        emit delivered(id);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Reenvía lo pendiente; lo llama la ventana al (re)conectar el WebSocket.
+ */
+void ChatOutbox::flush() {
+    for (Pending &p : pending)
+        transmit(p);
+}
+
+/**
+ * @brief Reenvía lo no confirmado a tiempo y descarta lo que agota los intentos.
+ */
+void ChatOutbox::checkTimeouts() {
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    for (int i = pending.size() - 1; i >= 0; --i) {
+        Pending &p = pending[i];
+        if (p.sentAt == 0 || now - p.sentAt < kAckTimeoutMs)
+            continue;
+
+        if (p.attempts >= kMaxAttempts) {
+            qWarning() << "[CHAT] Mensaje sin confirmar tras" << p.attempts << "envíos:" << p.clientId;
+            Pending lost = pending.takeAt(i);
+            emit failed(lost.clientId, lost.content);
+            continue;
+        }
+        transmit(p);
+    }
+    if (pending.isEmpty())
+        retryTimer->stop();
+}
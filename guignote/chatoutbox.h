@@ -0,0 +1,143 @@
+/**
+ * @file chatoutbox.h
+ * @brief Declaración de las clases ChatOutbox y RecentIds.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * ChatOutbox es la única vía de envío de FriendsMessageWindow: cada mensaje
+ * sale por el WebSocket con un identificador de cliente y se reenvía hasta que
+ * el servidor lo confirma. RecentIds recuerda los últimos mensajes mostrados
+ * para descartar duplicados sin crecer sin límite.
+ */
+
+#ifndef CHATOUTBOX_H
+#define CHATOUTBOX_H
+
+#include <QObject>
+#include <QJsonObject>
+#include <QList>
+#include <QQueue>
+#include <QSet>
+#include <functional>
+
+class QTimer;
+
+/**
+ * @class RecentIds
+ * @brief Conjunto acotado de identificadores: al llenarse olvida los más antiguos.
+ */
+class RecentIds {
+public:
+    /**
+     * @brief Constructor.
+     * @param capacity Número máximo de identificadores recordados.
+     */
+    explicit RecentIds(int capacity = 512);
+
+    /**
+     * @brief Añade un identificador.
+     * @param id Identificador.
+     * @return false si ya estaba (duplicado).
+     */
+    bool insert(const QString &id);
+
+    /** @brief true si el identificador está recordado. */
+    bool contains(const QString &id) const;
+
+    /** @brief Número de identificadores recordados. */
+    int size() const { return ids.size(); }
+
+private:
+    int capacity;           ///< Tamaño máximo.
+    QSet<QString> ids;      ///< Identificadores recordados.
+    QQueue<QString> order;  ///< Orden de llegada, para expulsar el más antiguo.
+};
+
+/**
+ * @class ChatOutbox
+ * @brief Cola de mensajes salientes con confirmación y reintentos.
+ *
+ * enqueue() asigna un "client_id" y envía {"contenido", "client_id"} por la
+ * función de envío. El servidor difunde el mensaje a toda la conversación,
+ * incluido el emisor: ese eco es la confirmación (acknowledge()). Lo que no se
+ * confirma en kAckTimeoutMs se reenvía, hasta kMaxAttempts veces; al
+ * reconectar se reenvía todo lo pendiente con flush().
+ */
+class ChatOutbox : public QObject {
+    Q_OBJECT
+
+public:
+    /** @brief Envía una trama; devuelve false si el canal no está abierto. */
+    using SendFunction = std::function<bool(const QString &frame)>;
+
+    /**
+     * @brief Constructor.
+     * @param send Función que escribe en el WebSocket.
+     * @param parent Objeto padre.
+     */
+    explicit ChatOutbox(SendFunction send, QObject *parent = nullptr);
+
+    /**
+     * @brief Pone un mensaje en la cola y lo intenta enviar.
+     * @param content Texto del mensaje.
+     * @return Identificador de cliente asignado.
+     */
+    QString enqueue(const QString &content);
+
+    /**
+     * @brief Procesa el eco de un mensaje propio.
+     * @param echo Mensaje recibido del servidor.
+     * @return true si confirmaba un mensaje pendiente.
+     *
+     * Se busca primero por "client_id"; si el servidor no lo devuelve, se
+     * confirma el pendiente más antiguo con el mismo contenido.
+     */
+    bool acknowledge(const QJsonObject &echo);
+
+    /** @brief Reenvía todo lo pendiente (p. ej. al reconectar). */
+    void flush();
+
+    /** @brief Mensajes aún sin confirmar. */
+    int pendingCount() const { return pending.size(); }
+
+    /** @brief Tiempo (ms) que se espera la confirmación antes de reenviar. */
+    static constexpr int kAckTimeoutMs = 5000;
+    /** @brief Envíos como máximo de un mismo mensaje. */
+    static constexpr int kMaxAttempts = 3;
+
+signals:
+    /**
+     * @brief El servidor ha confirmado un mensaje.
+     * @param clientId Identificador de cliente.
+     */
+    void delivered(const QString &clientId);
+
+    /**
+     * @brief Un mensaje se ha descartado tras agotar los reintentos.
+     * @param clientId Identificador de cliente.
+     * @param content Texto del mensaje.
+     */
+    void failed(const QString &clientId, const QString &content);
+
+private:
+    /**
+     * @struct Pending
+     * @brief Mensaje a la espera de confirmación.
+     */
+    struct Pending {
+        QString clientId;   ///< Identificador de cliente.
+        QString content;    ///< Texto.
+        int attempts = 0;   ///< Envíos realizados.
+        qint64 sentAt = 0;  ///< Último envío (ms desde epoch); 0 = no enviado.
+    };
+
+    void transmit(Pending &message);
+    void checkTimeouts();
+
+    SendFunction send;       ///< Escritura en el canal.
+    QList<Pending> pending;  ///< Cola en orden de envío.
+    QTimer *retryTimer;      ///< Revisa los pendientes caducados.
+};
+
+#endif // CHATOUTBOX_H
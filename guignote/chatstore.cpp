@@ -0,0 +1,184 @@
+/**
+ * @file chatstore.cpp
+ * @brief Implementación de la clase ChatStore.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * Contiene la lectura y escritura en segundo plano de los ficheros de
+ * conversación y la fusión con las respuestas del servidor.
+ */
+
+#include "chatstore.h"
+#include <QStandardPaths>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QFile>
+#include <QPointer>
+#include <QDir>
+#include <QDebug>
+#include <algorithm>
+
+/**
+ * @brief Devuelve la instancia compartida.
+ */
+ChatStore &ChatStore::instance() {
+    static ChatStore *store = new ChatStore();
+    return *store;
+}
+
+/**
+ * @brief Constructor de ChatStore.
+ * @param directory Carpeta de persistencia (vacía = AppDataLocation/chats).
+ * @param parent Objeto padre.
+ */
+ChatStore::ChatStore(const QString &directory, QObject *parent)
+    : QObject(parent),
+      directory(directory)
+{
+    io.setMaxThreadCount(1);
+
+    if (this->directory.isEmpty())
+        this->directory = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/chats";
+    QDir().mkpath(this->directory);
+}
+
+/**
+ * @brief Destructor: deja terminar las tareas en curso.
+ */
+ChatStore::~ChatStore() {
+    io.waitForDone();
+}
+
+/**
+ * @brief Clave de un mensaje; es la misma que usa la ventana para descartar duplicados.
+ */
+QString ChatStore::keyFor(const ChatMessage &message) {
+    return message.sentAt + "|" + message.senderId + "|" + message.content;
+}
+
+/**
+ * @brief Ruta del fichero de una conversación.
+ */
+QString ChatStore::pathFor(const QString &conversation) const {
+    return directory + "/" + conversation + ".jsonl";
+}
+
+/**
+ * @brief Lee el fichero completo y actualiza las claves conocidas (hilo io).
+ * @return Mensajes en orden cronológico.
+ */
+QList<ChatMessage> ChatStore::readAll(const QString &conversation) {
+    QList<ChatMessage> messages;
+    QSet<QString> &keys = known[conversation];
+    keys.clear();
+
+    QFile file(pathFor(conversation));
+    if (!file.open(QIODevice::ReadOnly))
+        return messages;
+
+    while (!file.atEnd()) {
+        QJsonObject o = QJsonDocument::fromJson(file.readLine()).object();
+        if (o.isEmpty()) continue;   // línea cortada por un cierre brusco
+
+        ChatMessage m;
+        m.senderId = o["emisor"].toString();
+        m.content = o["contenido"].toString();
+        m.sentAt = o["fecha_envio"].toString();
+        QString key = keyFor(m);
+        if (keys.contains(key)) continue;
+        keys.insert(key);
+        messages.append(m);
+    }
+
+    // Un mensaje propio puede haberse guardado después de la respuesta del amigo
+    std::stable_sort(messages.begin(), messages.end(),
+                     [](const ChatMessage &a, const ChatMessage &b) { return a.sentAt < b.sentAt; });
+    return messages;
+}
+
+/**
+ * @brief Añade mensajes al final del fichero (hilo io).
+ */
+void ChatStore::write(const QString &conversation, const QList<ChatMessage> &messages) {
+    if (messages.isEmpty()) return;
+
+    QFile file(pathFor(conversation));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qWarning() << "ChatStore: no se puede escribir" << file.fileName();
+        return;
+    }
+
+    QByteArray lines;
+    for (const ChatMessage &m : messages) {
+        QJsonObject o{{"emisor", m.senderId},
+                      {"contenido", m.content},
+                      {"fecha_envio", m.sentAt}};
+        lines += QJsonDocument(o).toJson(QJsonDocument::Compact) + '\n';
+    }
+    file.write(lines);
+}
+
+/**
+ * @brief Carga la conversación en segundo plano.
+ */
+void ChatStore::load(const QString &conversation, QObject *context, MessagesHandler onLoaded) {
+    // El contexto puede destruirse mientras el hilo io trabaja: se vigila con
+    // QPointer y el resultado se entrega a través del propio almacén
+    QPointer<QObject> target = context;
+    const bool hasContext = (context != nullptr);
+    io.start([this, conversation, target, hasContext, onLoaded]() {
+        QList<ChatMessage> messages = readAll(conversation);
+        QMetaObject::invokeMethod(this, [target, hasContext, onLoaded, messages]() {
+            if (hasContext && !target) return;
+            onLoaded(messages);
+        }, Qt::QueuedConnection);
+    });
+}
+
+/**
+ * @brief Fusiona la respuesta del servidor con lo guardado y devuelve solo lo nuevo.
+ */
+void ChatStore::merge(const QString &conversation, const QByteArray &serverBody,
+                      QObject *context, MessagesHandler onNew) {
+    QPointer<QObject> target = context;
+    const bool hasContext = (context != nullptr);
+    io.start([this, conversation, serverBody, target, hasContext, onNew]() {
+        if (!known.contains(conversation))
+            readAll(conversation);
+        QSet<QString> &keys = known[conversation];
+
+        ChatStreamParser parser;
+        QList<ChatMessage> fresh;
+        for (const ChatMessage &m : parser.feed(serverBody)) {
+            QString key = keyFor(m);
+            if (keys.contains(key)) continue;
+            keys.insert(key);
+            fresh.append(m);
+        }
+
+        std::stable_sort(fresh.begin(), fresh.end(),
+                         [](const ChatMessage &a, const ChatMessage &b) { return a.sentAt < b.sentAt; });
+        write(conversation, fresh);
+
+        QMetaObject::invokeMethod(this, [target, hasContext, onNew, fresh]() {
+            if (hasContext && !target) return;
+            onNew(fresh);
+        }, Qt::QueuedConnection);
+    });
+}
+
+/**
+ * @brief Guarda un mensaje recibido por WebSocket.
+ */
+void ChatStore::append(const QString &conversation, const ChatMessage &message) {
+    io.start([this, conversation, message]() {
+        if (!known.contains(conversation))
+            readAll(conversation);
+        QSet<QString> &keys = known[conversation];
+        QString key = keyFor(message);
+        if (keys.contains(key)) return;
+        keys.insert(key);
+        write(conversation, {message});
+    });
+}
@@ -0,0 +1,94 @@
+/**
+ * @file chatstore.h
+ * @brief Declaración de la clase ChatStore, almacén local de conversaciones.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * ChatStore guarda en disco, de forma incremental, los mensajes de cada
+ * conversación con un amigo, para poder abrirla al instante y sincronizar
+ * con el servidor solo lo que falta.
+ */
+
+#ifndef CHATSTORE_H
+#define CHATSTORE_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QThreadPool>
+#include <functional>
+#include "chathistoryloader.h"
+
+/**
+ * @class ChatStore
+ * @brief Almacén de mensajes por conversación, de solo añadido.
+ *
+ * Cada conversación es un fichero con un mensaje JSON por línea al que solo se
+ * añaden líneas. Toda la E/S y el análisis se hacen en un único hilo de trabajo
+ * (las escrituras quedan en orden) y los resultados vuelven al hilo de la
+ * interfaz; si el objeto de contexto se ha destruido entretanto, se descartan.
+ */
+class ChatStore : public QObject {
+    Q_OBJECT
+
+public:
+    /// Recibe mensajes en orden cronológico.
+    using MessagesHandler = std::function<void(const QList<ChatMessage> &messages)>;
+
+    /**
+     * @brief Devuelve la instancia compartida por toda la aplicación.
+     */
+    static ChatStore &instance();
+
+    /**
+     * @brief Constructor.
+     * @param directory Carpeta de los ficheros (vacía = AppDataLocation/chats).
+     * @param parent Objeto padre.
+     */
+    explicit ChatStore(const QString &directory = QString(), QObject *parent = nullptr);
+
+    /** @brief Destructor: espera a que terminen las escrituras pendientes. */
+    ~ChatStore();
+
+    /**
+     * @brief Lee de disco todos los mensajes guardados de una conversación.
+     * @param conversation Identificador de la conversación.
+     * @param context Objeto cuyo ciclo de vida limita el callback.
+     * @param onLoaded Recibe los mensajes guardados, del más antiguo al más reciente.
+     */
+    void load(const QString &conversation, QObject *context, MessagesHandler onLoaded);
+
+    /**
+     * @brief Incorpora la respuesta de /mensajes/obtener/ y guarda solo los mensajes nuevos.
+     * @param conversation Identificador de la conversación.
+     * @param serverBody Cuerpo de la respuesta del servidor.
+     * @param context Objeto cuyo ciclo de vida limita el callback.
+     * @param onNew Recibe los mensajes que no estaban guardados (puede estar vacío).
+     */
+    void merge(const QString &conversation, const QByteArray &serverBody,
+               QObject *context, MessagesHandler onNew);
+
+    /**
+     * @brief Añade un mensaje recibido en tiempo real (se ignora si ya estaba).
+     * @param conversation Identificador de la conversación.
+     * @param message Mensaje con la fecha del servidor.
+     */
+    void append(const QString &conversation, const ChatMessage &message);
+
+    /**
+     * @brief Clave que identifica un mensaje ("<fecha>|<emisor>|<texto>").
+     */
+    static QString keyFor(const ChatMessage &message);
+
+private:
+    QString pathFor(const QString &conversation) const;
+    QList<ChatMessage> readAll(const QString &conversation);
+    void write(const QString &conversation, const QList<ChatMessage> &messages);
+
+    QString directory;                      ///< Carpeta de persistencia.
+    QThreadPool io;                         ///< Un único hilo para lecturas y escrituras.
+    QHash<QString, QSet<QString>> known;    ///< Claves guardadas por conversación (solo desde io).
+};
+
+#endif // CHATSTORE_H
@@ -10,6 +10,7 @@
  */
 
 #include "crearcustomgame.h"
+#include "session.h"
 #include "estadopartida.h"
 #include "menuwindow.h"
 #include <QListWidget>
@@ -51,7 +52,7 @@ CrearCustomGame::CrearCustomGame(QString &userKey, QString usr, int fondo, QDial
     this->fondo = fondo;
     networkManager = new QNetworkAccessManager(this);
 
-    token = loadAuthToken(userKey);
+    token = Session::forUser(userKey).token();
     setupUI();
 }
 
@@ -218,38 +219,6 @@ void CrearCustomGame::setupUI(){
     par->setStyleSheet(checkboxStyle);
 }
 
-/**
- * @brief Carga el token de autenticación desde el archivo de configuración.
- *
- * Busca el archivo de configuración asociado al usuario y extrae la línea que contiene el token.
- * Este token se utiliza luego para autenticar la conexión WebSocket al servidor.
- *
- * @param userKey Clave única del usuario utilizada para localizar el archivo de configuración.
- * @return Cadena con el token JWT si se encuentra; cadena vacía en caso contrario.
- */
-QString CrearCustomGame::loadAuthToken(const QString &userKey) {
-    QString configPath = QStandardPaths::writableLocation(QStandardPaths::ConfigLocation)
-    + QString("/Grace Hopper/Sota, Caballo y Rey_%1.conf").arg(userKey);
-    QFile configFile(configPath);
-    if (!configFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qDebug() << "No se pudo cargar el archivo de configuración.";
-        return "";
-    }
-    QString token;
-    while (!configFile.atEnd()) {
-        QString line = configFile.readLine().trimmed();
-        if (line.startsWith("token=")) {
-            token = line.mid(QString("token=").length()).trimmed();
-            break;
-        }
-    }
-    configFile.close();
-    if (token.isEmpty()) {
-        qDebug() << "No se encontró el token en el archivo de configuración.";
-    }
-    return token;
-}
-
 /**
  * @brief Crea y lanza la partida personalizada con los parámetros seleccionados por el usuario.
  *
@@ -92,13 +92,6 @@ private:
      */
     void crearPartida();
 
-    /**
-     * @brief Carga el token de autenticación usando la clave del usuario.
-     * @param userKey Clave del usuario.
-     * @return Token de autenticación.
-     */
-    QString loadAuthToken(const QString &userKey);
-
     QString token; ///< Token JWT de autenticación.
     QNetworkAccessManager *networkManager; ///< Gestor de red para operaciones HTTP.
 };
@@ -19,10 +19,14 @@
 #include <QLabel>
 #include <QVBoxLayout>
 #include <QCheckBox>
-#include <QListWidget>
+#include <QListView>
 #include <QDialog>
 #include <QNetworkAccessManager>
 #include <QWebSocket>
+#include <QJsonArray>
+
+class UserListModel;
+class LobbyFeed;
 
 /**
  * @class CustomGamesWindow
@@ -46,13 +50,28 @@ public:
      */
     CustomGamesWindow(const QString &userKey, QString usr, int fondo, QWidget *parent);
 
+protected:
+    /**
+     * @brief Empieza a seguir las salas al mostrarse la ventana.
+     * @param event Evento de muestra.
+     */
+    void showEvent(QShowEvent *event) override;
+
+    /**
+     * @brief Deja de seguir las salas al ocultarse la ventana.
+     * @param event Evento de ocultación.
+     */
+    void hideEvent(QHideEvent *event) override;
+
 private:
     // Elementos de interfaz
     QVBoxLayout *mainLayout; ///< Diseño vertical principal de la ventana.
     QLabel *titleLabel; ///< Etiqueta con el título de la ventana.
     QPushButton *closeButton; ///< Botón para cerrar la ventana.
     QCheckBox *soloAmigosCheck; ///< CheckBox para filtrar solo partidas de amigos.
-    QListWidget *gamesListWidget; ///< Lista de partidas disponibles.
+    QListView *gamesListView; ///< Lista de partidas disponibles.
+    UserListModel *gamesModel; ///< Salas mostradas, indexadas por id.
+    LobbyFeed *lobbyFeed; ///< Avisos de cambios en las salas.
 
     QString userKey; ///< Clave de usuario para autenticación.
     QString token; ///< Token JWT autenticado.
@@ -63,32 +82,26 @@ private:
     int fondo; ///< ID del fondo o tema visual.
     QDialog *searchingDialog = nullptr; ///< Diálogo mientras se conecta a una partida.
     QLabel *countLabel = nullptr; ///< Etiqueta para mostrar número de jugadores en cola.
-    int capacidad; ///< Capacidad máxima de la partida a unirse.
     int jugadoresCola; ///< Jugadores actualmente en la cola.
     QString usr; ///< Nombre del usuario actual.
     int id; ///< ID de la partida seleccionada.
 
-    /**
-     * @brief Carga el token de autenticación desde la clave de usuario.
-     * @param userKey Clave del usuario.
-     * @return Token JWT válido.
-     */
-    QString loadAuthToken(const QString &userKey);
-
     /**
      * @brief Configura la interfaz gráfica de la ventana.
      */
     void setupUI();
 
     /**
-     * @brief Obtiene todas las partidas disponibles desde el servidor.
+     * @brief Ruta de la lista de salas según el filtro "Solo Amigos".
+     * @return Ruta relativa al servidor.
      */
-    void fetchAllGames();
+    QString roomsPath() const;
 
     /**
-     * @brief Obtiene solo las partidas disponibles de amigos.
+     * @brief Aplica una nueva lista de salas al modelo.
+     * @param salas Salas recibidas del servidor.
      */
-    void fetchFriendGames();
+    void showRooms(const QJsonArray &salas);
 
     /**
      * @brief Intenta unirse a una partida específica.
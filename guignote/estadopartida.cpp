@@ -25,75 +25,35 @@
 #include "settingswindow.h"
 #include "ventanasalirpartida.h"
 #include "gamemessagewindow.h"
+#include "audioengine.h"
+#include "playerprofiles.h"
+#include "backdropservice.h"
+#include "theme.h"
 
-void EstadoPartida::cargarSkinsJugadores(const QVector<Jugador*>& jugadores, QNetworkAccessManager* netMgr, std::function<void()> onComplete) {
-    if (jugadores.isEmpty()) {
-        if (onComplete) onComplete();
-        return;
-    }
-
-    int* pendientes = new int(jugadores.size());
-
+/**
+ * @brief Resuelve las barajas de todos los jugadores antes de pintar la mesa.
+ *
+ * Los ids llegan en el propio estado de la partida, así que basta una consulta
+ * de objetos equipados por jugador, todas en paralelo; las que ya están en
+ * PlayerProfiles (p. ej. precargadas con "player_joined") no tocan la red.
+ */
+void EstadoPartida::cargarSkinsJugadores(const QVector<Jugador*>& jugadores, std::function<void()> onComplete) {
+    QList<QPair<QString, int>> pendientes;
     for (Jugador* jugador : jugadores) {
-        if (!jugador) {
-            (*pendientes)--;
-            if (*pendientes == 0 && onComplete) onComplete();
-            continue;
-        }
-
-        QUrl urlId(QStringLiteral("http://188.165.76.134:8000/usuarios/usuarios/id/%1/").arg(jugador->nombre));
-        QNetworkReply* replyId = netMgr->get(QNetworkRequest(urlId));
-
-        QObject::connect(replyId, &QNetworkReply::finished, this, [=]() {
-            if (replyId->error() != QNetworkReply::NoError) {
-                qWarning() << "[SKIN] Error ID para" << jugador->nombre;
-                replyId->deleteLater();
-                (*pendientes)--;
-                if (*pendientes == 0 && onComplete) onComplete();
-                return;
-            }
+        if (jugador)
+            pendientes.append({jugador->nombre, jugador->id});
+    }
 
-            QJsonDocument doc = QJsonDocument::fromJson(replyId->readAll());
-            replyId->deleteLater();
-            int userId = doc.object().value("user_id").toInt(-1);
-            if (userId < 0) {
-                (*pendientes)--;
-                if (*pendientes == 0 && onComplete) onComplete();
-                return;
+    PlayerProfiles::instance().resolveAll(pendientes, this,
+        [this, onComplete](const QHash<QString, PlayerProfiles::Profile>& perfiles) {
+        for (const PlayerProfiles::Profile& perfil : perfiles) {
+            if (perfil.skinId > 0) {
+                this->mapaSkinsJugadores[perfil.name] = perfil.skinId - 1;
+                qDebug() << "[SKIN] Guardado:" << perfil.name << "→" << perfil.skinId - 1;
             }
-
-            QUrl urlEq(QStringLiteral("http://188.165.76.134:8000/usuarios/get_equipped_items/%1/").arg(userId));
-            QNetworkReply* replyEq = netMgr->get(QNetworkRequest(urlEq));
-
-            QObject::connect(replyEq, &QNetworkReply::finished, this, [=]() {
-                if (replyEq->error() != QNetworkReply::NoError) {
-                    qWarning() << "[SKIN] Error skin para" << jugador->nombre;
-                    replyEq->deleteLater();
-                    (*pendientes)--;
-                    if (*pendientes == 0 && onComplete) onComplete();
-                    return;
-                }
-
-                QJsonDocument doc = QJsonDocument::fromJson(replyEq->readAll());
-                replyEq->deleteLater();
-                if (!doc.isObject()) {
-                    (*pendientes)--;
-                    if (*pendientes == 0 && onComplete) onComplete();
-                    return;
-                }
-
-                int skinRawId = doc.object().value("equipped_skin").toObject().value("id").toInt(-1);
-                if (skinRawId > 0) {
-                    int skinId = skinRawId - 1;
-                    this->mapaSkinsJugadores[jugador->nombre] = skinId;
-                    qDebug() << "[SKIN] Guardado:" << jugador->nombre << "→" << skinId;
-                }
-
-                (*pendientes)--;
-                if (*pendientes == 0 && onComplete) onComplete();
-            });
-        });
-    }
+        }
+        if (onComplete) onComplete();
+    });
 }
 
 
@@ -115,29 +75,15 @@ EstadoPartida::EstadoPartida(QString miNombre, const QString& token, const QStri
     : QWidget(parent), miNombre(miNombre), onSalir(onSalir), wsUrl(wsUrl), miToken(token) {
 
     //
-    // ——— BGM DE PARTIDA ———
-    //
-    audioOutput      = new QAudioOutput(this);
-    backgroundPlayer = new QMediaPlayer(this);
-    backgroundPlayer->setAudioOutput(audioOutput);
-
-    QSettings cfg("Grace Hopper", QString("Sota, Caballo y Rey_%1").arg(miNombre));
-    int bgmVol = cfg.value("sound/volume", 50).toInt();
-    int sfxVol = cfg.value("sound/effectsVolume", 50).toInt();
-
-    audioOutput->setVolume(bgmVol / 100.0);
-    backgroundPlayer->setSource(QUrl("qrc:/bgm/partida.mp3"));
-    backgroundPlayer->setLoops(QMediaPlayer::Infinite);
-    backgroundPlayer->play();
-
-    //
-    // ——— SFX DE ROBA CARTA ———
+    // ——— BGM Y SFX DE PARTIDA ———
     //
-    effectOutput = new QAudioOutput(this);
-    effectPlayer = new QMediaPlayer(this);
-    effectPlayer->setAudioOutput(effectOutput);
-    effectOutput->setVolume(sfxVol / 100.0);
-    effectPlayer->setSource(QUrl("qrc:/bgm/card_draw.mp3"));
+    // La salida de música es la misma del menú: solo cambia la pista. Los efectos
+    // se decodifican una vez por proceso (las partidas siguientes ya los tienen).
+    AudioEngine &audio = AudioEngine::instance();
+    audio.loadVolumes(miNombre);
+    audio.playMusic(QUrl("qrc:/bgm/partida.mp3"));
+    audio.preload("card_draw", ":/bgm/card_draw.mp3");
+    audio.preload("ticktack", ":/bgm/ticktack.mp3");
 
     //
     // ——— INICIALIZACIÓN DEL TEMPORIZADOR VISUAL ———
@@ -146,51 +92,30 @@ EstadoPartida::EstadoPartida(QString miNombre, const QString& token, const QStri
     connect(turnoTimer, &QTimer::timeout, this, &EstadoPartida::actualizarTimer);
 
     labelTimer = new QLabel(this);
-    labelTimer->setStyleSheet(R"(
-        QLabel {
-            font-size: 48px;
-            font-weight: bold;
-            color: gold;
-            background-color: rgba(0, 0, 0, 128);
-            border-radius: 12px;
-            padding: 8px 16px;
-        }
-    )");
+    Theme::setRole(labelTimer, "timer");
     labelTimer->setAlignment(Qt::AlignCenter);
     labelTimer->hide();
 
     labelTimerTexto = new QLabel("Tiempo restante", this);
-    labelTimerTexto->setStyleSheet(R"(
-        QLabel {
-            font-size: 24px;
-            color: white;
-            background-color: transparent;
-        }
-    )");
+    Theme::setRole(labelTimerTexto, "timerCaption");
     labelTimerTexto->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
     labelTimerTexto->hide();
 
-    //
-    // ——— SFX TICKTACK ÚLTIMOS 10S ———
-    //
-    tickOutput = new QAudioOutput(this);
-    tickPlayer = new QMediaPlayer(this);
-    tickPlayer->setAudioOutput(tickOutput);
-    tickOutput->setVolume(sfxVol * 0.5/ 100.0);
-    tickPlayer->setSource(QUrl("qrc:/bgm/ticktack.mp3"));
-
     //
     // ——— Obtener skin equipada al arrancar ———
     //
     m_equippedSkinId = -1;
-    m_netMgr = new QNetworkAccessManager(this);
-    {
-        QUrl urlId(QStringLiteral("http://188.165.76.134:8000/usuarios/usuarios/id/%1/").arg(miNombre));
-        auto* replyId = m_netMgr->get(QNetworkRequest(urlId));
-        connect(replyId, &QNetworkReply::finished, this, [this, replyId]() {
-            onGotUserId(replyId);
-        });
-    }
+    PlayerProfiles &perfiles = PlayerProfiles::instance();
+    perfiles.lookup(miNombre, this, [this](const PlayerProfiles::Profile& perfil) {
+        aplicarEquipados(perfil);
+    });
+    // Si una copia caducada se refresca durante la partida, las barajas se actualizan
+    connect(&perfiles, &PlayerProfiles::profileUpdated, this, [this](const PlayerProfiles::Profile& perfil) {
+        if (perfil.name == this->miNombre)
+            aplicarEquipados(perfil);
+        else if (perfil.skinId > 0 && mapaSkinsJugadores.contains(perfil.name))
+            mapaSkinsJugadores[perfil.name] = perfil.skinId - 1;
+    });
 }
 
 
@@ -224,132 +149,26 @@ void EstadoPartida::init() {
     websocket->open(QUrl(wsUrl));
 }
 
-void EstadoPartida::onGotUserId(QNetworkReply* reply)
+/**
+ * @brief Aplica la baraja y el tapete equipados por el jugador local.
+ * @param perfil Perfil del jugador (sin objetos si no se pudieron obtener).
+ */
+void EstadoPartida::aplicarEquipados(const PlayerProfiles::Profile& perfil)
 {
-    if (reply->error() != QNetworkReply::NoError) {
-        reply->deleteLater();
-        return;
-    }
-    auto doc = QJsonDocument::fromJson(reply->readAll());
-    reply->deleteLater();
-    int userId = doc.object().value("user_id").toInt(-1);
-    if (userId < 0) return;
-
-    // 2) Con el ID, pedimos los equipped_items
-    QUrl urlEq(QStringLiteral(
-                   "http://188.165.76.134:8000/usuarios/get_equipped_items/%1/")
-                   .arg(userId));
-    auto* replyEq = m_netMgr->get(QNetworkRequest(urlEq));
-    connect(replyEq, &QNetworkReply::finished, this, [this, replyEq]() {
-        onGotEquippedItems(replyEq);
-    });
+    if (!perfil.hasItems()) return;
 
-}
-
-void EstadoPartida::onGotEquippedItems(QNetworkReply* reply)
-{
-    if (reply->error() != QNetworkReply::NoError) {
-        reply->deleteLater();
-        return;
+    if (perfil.skinId > 0) {
+        m_equippedSkinId = perfil.skinId - 1;
     }
 
-    // 1) Leemos el payload crudo y lo imprimimos para depurar
-    QByteArray raw = reply->readAll();
-    qDebug() << "get_equipped_items RAW:" << QString::fromUtf8(raw);
+    int tapeteId = perfil.tapeteId;
+    qDebug() << "Parsed tapeteId =" << tapeteId;
 
-    // 2) Parseamos el JSON
-    auto doc = QJsonDocument::fromJson(raw);
-    reply->deleteLater();
-    if (!doc.isObject()) return;
-    QJsonObject obj = doc.object();
-
-    // 3) Skin equipada (sin cambios)
-    int rawSkinId = obj.value("equipped_skin")
-                        .toObject()
-                        .value("id").toInt(-1);
-    if (rawSkinId > 0) {
-        m_equippedSkinId = rawSkinId - 1;
-    }
-
-    // === A PARTIR DE AQUÍ: parseo "a prueba de balas" de equipped_tapete ===
-
-    // 4) Cogemos el valor de "equipped_tapete" (puede ser objeto o entero)
-    QJsonValue tapV = obj.value("equipped_tapete");
-    int tapeteId = -1;
-    if      (tapV.isObject()) tapeteId = tapV.toObject().value("id").toInt(-1);
-    else if (tapV.isDouble()) tapeteId = tapV.toInt(-1);
-    qDebug() << "Parsed tapeteId =" << tapeteId;  // ¡Aquí ya NO debe salir -1!
-
-    // 5) Aplicamos el gradiente y, solo en el caso "verde", retrasamos la ornamentación
-    if (tapeteId == 1) {
-        // Fondo verde
-        this->setStyleSheet(R"(
-            QWidget {
-                background: qradialgradient(
-                    cx:0.5, cy:0.5, radius:1,
-                    fx:0.5, fy:0.5,
-                    stop:0 #1f5a1f,
-                    stop:1 #0a2a08
-                );
-            }
-        )");
-        // Retrasamos la creación de las esquinas hasta el próximo ciclo de eventos,
-        // asegurándonos de que `this->width()` y `height()` ya estén inicializados.
-        QTimer::singleShot(0, this, [this,tapeteId]() {
-            crearEsquinas(tapeteId);
-        });
-
-    } else if (tapeteId == 2) {
-        // Fondo rojo
-        this->setStyleSheet(R"(
-            QWidget {
-                background: qradialgradient(
-                    cx:0.5, cy:0.5, radius:1,
-                    fx:0.5, fy:0.5,
-                    stop:0 #5a1f1f,
-                    stop:1 #2a0808
-                );
-            }
-        )");
-        // Retrasamos la creación de las esquinas hasta el próximo ciclo de eventos,
-        // asegurándonos de que `this->width()` y `height()` ya estén inicializados.
-        QTimer::singleShot(0, this, [this,tapeteId]() {
-            crearEsquinas(tapeteId);
-        });
-    } else if (tapeteId == 3) {
-        // Fondo Azul
-        this->setStyleSheet(R"(
-            QWidget {
-                background: qradialgradient(
-                    cx:0.5, cy:0.5, radius:1,
-                    fx:0.5, fy:0.5,
-                    stop:0 #0055AA,
-                    stop:1 #2a0808
-                );
-            }
-        )");
-        // Retrasamos la creación de las esquinas hasta el próximo ciclo de eventos,
-        // asegurándonos de que `this->width()` y `height()` ya estén inicializados.
-        QTimer::singleShot(0, this, [this,tapeteId]() {
-            crearEsquinas(tapeteId);
-        });
-    } else if (tapeteId == 4) {
-        // Fondo Negro
-        this->setStyleSheet(R"(
-            QWidget {
-                background: qradialgradient(
-                    cx:0.5, cy:0.5, radius:1,
-                    fx:0.5, fy:0.5,
-                    stop:0 #2f2f2f,
-                    stop:1 #000000
-                );
-            }
-        )");
-        // Retrasamos la creación de las esquinas hasta el próximo ciclo de eventos,
-        // asegurándonos de que `this->width()` y `height()` ya estén inicializados.
-        QTimer::singleShot(0, this, [this,tapeteId]() {
-            crearEsquinas(tapeteId);
-        });
+    // Gradiente y ornamentos: paintEvent() copia el fondo ya compuesto
+    if (tapeteId != tapeteActual) {
+        tapeteActual = tapeteId;
+        BackdropService::instance().prerender(tapeteActual, size(), devicePixelRatioF());
+        update();
     }
 
     // Si la partida ya estaba en marcha, redibujamos
@@ -366,21 +185,10 @@ void EstadoPartida::onGotEquippedItems(QNetworkReply* reply)
  */
 EstadoPartida::~EstadoPartida() {
     qDebug() << "[DEBUG] EstadoPartida destruido.";
+    qDebug() << "[PARTIDA] Cola de eventos bloqueada" << msColaBloqueada << "ms en"
+             << eventosProcesados << "eventos (máximo" << msBloqueoMax << "ms)";
 
-    // Parar y liberar BGM
-    if (backgroundPlayer) {
-        backgroundPlayer->stop();
-        backgroundPlayer->deleteLater();
-        backgroundPlayer = nullptr;
-    }
-    // Parar y liberar SFX
-    if (effectPlayer) {
-        effectPlayer->stop();
-        effectPlayer->deleteLater();
-        effectPlayer = nullptr;
-    }
-    // Los QAudioOutput se borran automáticamente como hijos de this
-
+    // La música sigue en AudioEngine: el menú al que se vuelve cambia la pista
     this->limpiar();
 }
 
@@ -417,13 +225,8 @@ void EstadoPartida::limpiar() {
         mazo = nullptr;
     }
 
-    // Limpiar overlay
-    if (overlay) {
-        overlay->hide();
-        overlay->deleteLater();
-        overlay = nullptr;
-        overlayMsg = nullptr;
-    }
+    // Limpiar avisos (la capa se reutiliza)
+    if (banner) banner->clear();
     for (auto lbl : m_labelJugadores.values()) {
         lbl->deleteLater();
     }
@@ -453,15 +256,7 @@ void EstadoPartida::cargarJugadoresDesdeJson(const QJsonObject& data) {
         mapJugadores[j->id] = j;
 
         QLabel* nameLabel = new QLabel(j->nombre, this);
-        nameLabel->setStyleSheet(R"(
-            QLabel {
-                color: white;
-                font-size: 16px;
-                background-color: rgba(0, 0, 0, 128);
-                border-radius: 4px;
-                padding: 2px 6px;
-            }
-        )");
+        Theme::setRole(nameLabel, "playerName");
         nameLabel->adjustSize();
         nameLabel->hide();        // lo mostraremos en dibujarEstado()
         m_labelJugadores[j] = nameLabel;
@@ -649,14 +444,14 @@ void EstadoPartida::dibujarEstado() {
     puntosEquipo1Title->show();
 
     puntosEquipo1Label->move(2 * width/6 - puntosEquipo1Label->width()/2, height/2 - puntosEquipo1Label->height()/2);
-    puntosEquipo1Label->setText(QString::number(this->puntosEquipo1));
+    puntosEquipo1Label->setScore(this->puntosEquipo1);
     puntosEquipo1Label->show();
 
     puntosEquipo2Title->move(4 * width/6 - puntosEquipo2Title->width()/2, height/2 - puntosEquipo2Title->height()/2 - puntosEquipo2Label->height());
     puntosEquipo2Title->show();
 
     puntosEquipo2Label->move(4 * width/6 - puntosEquipo2Label->width()/2, height/2 - puntosEquipo2Label->height()/2);
-    puntosEquipo2Label->setText(QString::number(this->puntosEquipo2));
+    puntosEquipo2Label->setScore(this->puntosEquipo2);
     puntosEquipo2Label->show();
 
     // Botones cantar y cambiar siete
@@ -733,43 +528,20 @@ void EstadoPartida::dibujarEstado() {
 /**
  * @brief Anima y actualiza la puntuación de un equipo.
  *
- * Muestra una transición numérica hasta el nuevo valor.
+ * El valor se actualiza al momento y la etiqueta lo alcanza en paralelo, en
+ * como mucho ScoreLabel::maxDuration(): la cola de eventos no espera al recuento.
  *
  * @param equipo Número de equipo (1 o 2).
  * @param nuevoValor Valor destino de la puntuación.
- * @param callback Llamada al finalizar la animación.
+ * @param callback Llamada en cuanto el valor está actualizado.
  */
 void EstadoPartida::actualizarPuntuacion(int equipo, int nuevoValor, std::function<void()> callback) {
-    QSize screenSize = QGuiApplication::primaryScreen()->availableGeometry().size();
-    int width = screenSize.width(), height = screenSize.height();
-
-    QLabel* label = (equipo == 1) ? puntosEquipo1Label : puntosEquipo2Label;
+    ScoreLabel* label = (equipo == 1) ? puntosEquipo1Label : puntosEquipo2Label;
     int* valorPtr = (equipo == 1) ? &puntosEquipo1 : &puntosEquipo2;
 
-    if(!label || nuevoValor == *valorPtr) {
-        if (callback) callback();
-        return;
-    }
-
-    int paso = (nuevoValor > *valorPtr) ? 1 : -1;
-    QTimer* timer = new QTimer(this);
-    timer->setInterval(100);
-    connect(timer, &QTimer::timeout, this, [=]() mutable {
-        *valorPtr += paso;
-        label->setText(QString::number(*valorPtr));
-        label->adjustSize();
-        if (equipo == 1) label->move(2 * width / 6 - label->width() / 2, height / 2 - label->height() / 2);
-        else label->move(4 * width / 6 - label->width() / 2, height / 2 - label->height() / 2);
-        if (*valorPtr == nuevoValor) {
-            timer->stop();
-            timer->deleteLater();
-            if(equipo == 1) puntosEquipo1 = nuevoValor;
-            else puntosEquipo2 = nuevoValor;
-            if (callback) callback();
-        }
-    });
-
-    timer->start();
+    *valorPtr = nuevoValor;
+    if (label) label->animateTo(nuevoValor);
+    if (callback) callback();
 }
 
 //////////////////////////////////////////////////////////////////////////////////////
@@ -893,6 +665,7 @@ void EstadoPartida::procesarSiguienteEvento() {
         return;
 
     enEjecucion = true;
+    relojEvento.start();
     QJsonObject evento = colaEventos.dequeue();
     QString tipo = evento["type"].toString();
     QJsonObject data = evento["data"].toObject();
@@ -903,53 +676,43 @@ void EstadoPartida::procesarSiguienteEvento() {
         procesarStartGame(data);
     } else if (tipo == "card_played") {
         procesarCardPlayed(data, [this]() {
-            enEjecucion = false;
-            procesarSiguienteEvento();
+            terminarEvento();
         });
     } else if (tipo == "card_drawn") {
         procesarCardDrawn(data, [this]() {
-            enEjecucion = false;
-            procesarSiguienteEvento();
+            terminarEvento();
         });
     } else if (tipo == "turn_update") {
         procesarTurnUpdate(data, [this]() {
-            enEjecucion = false;
-            procesarSiguienteEvento();
+            terminarEvento();
         });
     } else if (tipo == "round_result") {
         procesarRoundResult(data, [this]() {
-            enEjecucion = false;
-            procesarSiguienteEvento();
+            terminarEvento();
         });
     } else if (tipo == "phase_update") {
         procesarPhaseUpdate(data, [this]() {
-            enEjecucion = false;
-            procesarSiguienteEvento();
+            terminarEvento();
         });
     } else if (tipo == "pause") {
         procesarPause(data, [this]() {
-            enEjecucion = false;
-            procesarSiguienteEvento();
+            terminarEvento();
         });
     } else if(tipo == "resume") {
         procesarResume(data, [this]() {
-            enEjecucion = false;
-            procesarSiguienteEvento();
+            terminarEvento();
         });
     } else if(tipo == "cambio_siete") {
         procesarCambioSiete(data, [this]() {
-            enEjecucion = false;
-            procesarSiguienteEvento();
+            terminarEvento();
         });
     } else if(tipo == "canto") {
         procesarCanto(data, [this]() {
-            enEjecucion = false;
-            procesarSiguienteEvento();
+            terminarEvento();
         });
     } else if(tipo == "player_joined") {
         procesarPlayerJoined(data, [this]() {
-            enEjecucion = false;
-            procesarSiguienteEvento();
+            terminarEvento();
         });
     } else if (tipo == "end_game") {
         procesarEndGame(data, nullptr);
@@ -957,15 +720,26 @@ void EstadoPartida::procesarSiguienteEvento() {
         procesarAllPause(data, nullptr);
     } else if(tipo == "error") {
         procesarError(data, [this]() {
-            enEjecucion = false;
-            procesarSiguienteEvento();
+            terminarEvento();
         });
     } else {
-        enEjecucion = false;
-        procesarSiguienteEvento();
+        terminarEvento();
     }
 }
 
+/**
+ * @brief Cierra el evento en curso, anota cuánto ha bloqueado la cola y pasa al siguiente.
+ */
+void EstadoPartida::terminarEvento() {
+    const qint64 ms = relojEvento.isValid() ? relojEvento.elapsed() : 0;
+    msColaBloqueada += ms;
+    msBloqueoMax = qMax(msBloqueoMax, ms);
+    ++eventosProcesados;
+
+    enEjecucion = false;
+    procesarSiguienteEvento();
+}
+
 //////////////////////////////////////////////////////////////////////////////////////
 /// Procesar mensajes
 //////////////////////////////////////////////////////////////////////////////////////
@@ -1142,11 +916,8 @@ void EstadoPartida::procesarCardDrawn(QJsonObject data, std::function<void()> ca
         if (callback) callback();
     }
 
-    // 5) Sonido de efecto
-    if (effectPlayer) {
-        effectPlayer->stop();
-        effectPlayer->play();
-    }
+    // 5) Sonido de efecto (una voz más: puede solaparse con el anterior)
+    AudioEngine::instance().play("card_draw");
 }
 
 
@@ -1157,10 +928,8 @@ void EstadoPartida::procesarCardDrawn(QJsonObject data, std::function<void()> ca
  * @param callback Función tras actualizar puntuaciones.
  */
 void EstadoPartida::procesarPhaseUpdate(QJsonObject data, std::function<void()> callback) {
-    this->mostrarMensaje("Cambio a fase de arrastre", [=]() {
-        if(callback) callback();
-        return;
-    });
+    // Cambian las reglas: los eventos siguientes esperan a que se haya visto
+    this->mostrarMensaje("Cambio a fase de arrastre", callback);
 }
 
 
@@ -1170,19 +939,19 @@ void EstadoPartida::procesarPhaseUpdate(QJsonObject data, std::function<void()>
 void EstadoPartida::iniciarBotonesYEtiquetas() {
     // Puntuaciones
     puntosEquipo1Title = new QLabel("Pt. Equipo 1", this);
-    puntosEquipo1Title->setStyleSheet("font-size: 32px; color: white; background-color: transparent; border: none;");
+    Theme::setRole(puntosEquipo1Title, "scoreTitle");
     puntosEquipo1Title->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
 
-    puntosEquipo1Label = new QLabel(this);
-    puntosEquipo1Label->setStyleSheet("font-size: 64px; font-weight: bold; color: white; background-color: transparent; border: none;");
+    puntosEquipo1Label = new ScoreLabel(this);
+    Theme::setRole(puntosEquipo1Label, "scoreValue");
     puntosEquipo1Label->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
 
     puntosEquipo2Title = new QLabel("Pt. Equipo 2", this);
-    puntosEquipo2Title->setStyleSheet("font-size: 32px; color: white; background-color: transparent; border: none;");
+    Theme::setRole(puntosEquipo2Title, "scoreTitle");
     puntosEquipo2Title->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
 
-    puntosEquipo2Label = new QLabel(this);
-    puntosEquipo2Label->setStyleSheet("font-size: 64px; font-weight: bold; color: white; background-color: transparent; border: none;");
+    puntosEquipo2Label = new ScoreLabel(this);
+    Theme::setRole(puntosEquipo2Label, "scoreValue");
     puntosEquipo2Label->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
 
     // Botones acciones
@@ -1202,31 +971,14 @@ void EstadoPartida::iniciarBotonesYEtiquetas() {
 
     pausadosLabel = new QLabel("0/0", this);
     pausadosLabel->setFixedSize(68, 68);
-    pausadosLabel->setStyleSheet(
-        "QLabel {"
-        "   background-color: #1f1f1f;"
-        "   color: white;"
-        "   border-radius: 34px;"
-        "   font-size: 24px;"
-        "   border: 2px solid #666;"
-        "   qproperty-alignment: AlignCenter;"
-        "}"
-        );
+    Theme::setRole(pausadosLabel, "pauseCounter");
     pausadosLabel->setAlignment(Qt::AlignCenter);
 
     this->crearMenu();
 
     // ——— Label fijo de Turno ———
     turnoPermanenteLabel = new QLabel(this);
-    turnoPermanenteLabel->setStyleSheet(R"(
-        QLabel {
-            font-size: 24px;
-            color: white;
-            background-color: rgba(0, 0, 0, 150);
-            padding: 4px 8px;
-            border-radius: 4px;
-        }
-    )");
+    Theme::setRole(turnoPermanenteLabel, "turn");
     turnoPermanenteLabel->setText("Esperando turno...");
     turnoPermanenteLabel->adjustSize();
     // Posicionar justo a la derecha del botón de menú (32 + 44 + 16 = 92)
@@ -1256,7 +1008,7 @@ void EstadoPartida::procesarStartGame(QJsonObject data) {
     this->jugadoresPausa = data.value("pausados").toInt();
     this->arrastre = data.value("fase_arrastre").toBool();
 
-    cargarSkinsJugadores(jugadores, m_netMgr, [=]() {
+    cargarSkinsJugadores(jugadores, [=]() {
         this->actualizarEstado(data);  // ahora sí dibujará con las skins
         this->dibujarEstado();
 
@@ -1265,8 +1017,7 @@ void EstadoPartida::procesarStartGame(QJsonObject data) {
 
         QTimer::singleShot(500, this, [=]() {
             this->dibujarEstado();
-            enEjecucion = false;
-            procesarSiguienteEvento();
+            terminarEvento();
         });
     });
 
@@ -1305,11 +1056,9 @@ void EstadoPartida::procesarTurnUpdate(QJsonObject data, std::function<void()> c
     }
     // Reiniciamos el temporizador para que empiece justo al llegar el turno
     iniciarTimerVisual(tiempoTurnoDefault);
-    // Mostramos el overlay, pero ya con el timer corriendo de fondo
-    this->mostrarMensaje(mensaje, [=]() {
-        // Cuando el overlay desaparezca, seguimos con el siguiente evento
-        callback();
-    });
+    // El aviso no retiene la cola: un turno posterior sustituye al que no llegó a verse
+    this->mostrarMensaje(mensaje, nullptr, "turno");
+    callback();
 }
 
 /**
@@ -1380,8 +1129,7 @@ void EstadoPartida::actualizarTimer() {
     // Si quedan <=10s, hacemos un “pop” animado
     if (segundosRestantes <= 10) {
         // reproducir sonido de cuenta atrás
-        tickPlayer->stop();
-        tickPlayer->play();
+        AudioEngine::instance().play("ticktack", 0.5);
         QRect geom = labelTimer->geometry();
         QRect bigger = geom.adjusted(-5, -5, 5, 5);
         auto *pulse = new QPropertyAnimation(labelTimer, "geometry", this);
@@ -1460,16 +1208,6 @@ void EstadoPartida::procesarRoundResult(QJsonObject data, std::function<void()>
     int puntos1 = data.value("puntos_equipo_1").toInt();
     int puntos2 = data.value("puntos_equipo_2").toInt();
 
-    mostrarMensaje(mensaje, [=]() {
-        auto onDone = [this, callback]() {
-            if (callback) callback();
-        };
-        if (puntos1 != puntosEquipo1)
-            actualizarPuntuacion(1, puntos1, onDone);
-        else
-            actualizarPuntuacion(2, puntos2, onDone);
-    });
-
     // Animación de las cartas jugadas
     for (Jugador* j : jugadores) {
         if (!j || !j->mano) continue;
@@ -1499,6 +1237,18 @@ void EstadoPartida::procesarRoundResult(QJsonObject data, std::function<void()>
         });
         fade->start(QAbstractAnimation::DeleteWhenStopped);
     }
+
+    // El marcador ya cuenta la baza: el aviso y la animación van en paralelo.
+    // Las cartas se recogen antes de liberar la cola, y la cola se libera en la
+    // siguiente vuelta del bucle de eventos: el evento siguiente nunca ve la baza a medias
+    mostrarMensaje(mensaje);
+    auto liberarCola = [this, callback]() {
+        if (callback) QTimer::singleShot(0, this, callback);
+    };
+    if (puntos1 != puntosEquipo1)
+        actualizarPuntuacion(1, puntos1, liberarCola);
+    else
+        actualizarPuntuacion(2, puntos2, liberarCola);
 }
 
 
@@ -1518,7 +1268,8 @@ void EstadoPartida::procesarPause(QJsonObject data, std::function<void()> callba
     }
     pausadosLabel->setText(QString("%1/%2").arg(jugadoresPausa).arg(jugadores.size()));
     QString msg = QString("%1 ha solicitado pausa").arg(nombre);
-    mostrarMensaje(msg, callback);
+    mostrarMensaje(msg);
+    if (callback) callback();
 }
 
 /**
@@ -1537,7 +1288,8 @@ void EstadoPartida::procesarResume(QJsonObject data, std::function<void()> callb
     }
     pausadosLabel->setText(QString("%1/%2").arg(jugadoresPausa).arg(jugadores.size()));
     QString msg = QString("%1 ha anulado su solicitud de pausa").arg(nombre);
-    mostrarMensaje(msg, callback);
+    mostrarMensaje(msg);
+    if (callback) callback();
 }
 
 void EstadoPartida::procesarPlayerJoined(QJsonObject data, std::function<void()> callback) {
@@ -1550,7 +1302,8 @@ void EstadoPartida::procesarPlayerJoined(QJsonObject data, std::function<void()>
     }
     pausadosLabel->setText(QString("%1/%2").arg(jugadoresPausa).arg(jugadores.size()));
     QString msg = QString("%1 ha anulado su solicitud de pausa").arg(nombre);
-    mostrarMensaje(msg, callback);
+    mostrarMensaje(msg);
+    if (callback) callback();
 }
 
 /**
@@ -1575,12 +1328,7 @@ void EstadoPartida::procesarAllPause(QJsonObject data, std::function<void()> cal
  */
 void EstadoPartida::procesarError(QJsonObject data, std::function<void()> callback) {
     auto *popup = new QLabel(data.value("message").toString("Error desconocido"), this);
-    popup->setStyleSheet("QLabel {"
-                         "background: rgba(50,50,50,220);"
-                         "color: white; font-size: 18px;"
-                         "padding: 6px 12px;"
-                         "border-radius: 6px; border: 1px solid #888; }"
-                         );
+    Theme::setRole(popup, "errorPopup");
     popup->adjustSize();
     popup->move(this->mapFromGlobal(QCursor::pos()));
     popup->show();
@@ -1637,14 +1385,9 @@ void EstadoPartida::procesarCanto(QJsonObject data, std::function<void()> callba
                       .arg(puntos)
                       .arg(cantos.join("\n"));
 
-    this->mostrarMensaje(msg, [=]() {
-        int completados = 0;
-        auto onDone = [this, callback]() {
-            if (callback) callback();
-        };
-        if (puntos1 != puntosEquipo1) this->actualizarPuntuacion(1, puntos1, onDone);
-        else this->actualizarPuntuacion(2, puntos2, onDone);
-    });
+    this->mostrarMensaje(msg);
+    if (puntos1 != puntosEquipo1) this->actualizarPuntuacion(1, puntos1, callback);
+    else this->actualizarPuntuacion(2, puntos2, callback);
 }
 
 /**
@@ -1676,7 +1419,7 @@ void EstadoPartida::procesarCambioSiete(QJsonObject data, std::function<void()>
 
     this->cartaTriunfo->setPaloValor(cartaTriunfo->getPalo(), valor);
 
-    // Mostrar mensaje
+    // Mostrar mensaje: el triunfo ha cambiado, se espera a que se haya leído
     QString msg = QString("%1 ha cambiado su 7 de triunfo por la carta de triunfo")
                       .arg(jugadorNombre);
     this->mostrarMensaje(msg, callback);
@@ -1687,76 +1430,20 @@ void EstadoPartida::procesarCambioSiete(QJsonObject data, std::function<void()>
 //////////////////////////////////////////////////////////////////////////////////////
 
 /**
- * @brief Muestra un mensaje superpuesto con opacidad animada.
+ * @brief Publica un aviso en la capa de avisos de la partida.
+ *
+ * La capa se crea una vez y se reutiliza; el aviso se encola y la llamada
+ * vuelve al momento.
  *
  * @param msg Texto a mostrar.
- * @param callback Función tras desaparecer el mensaje.
- * @param duracion Tiempo de visualización en milisegundos (por defecto).
+ * @param alVerse Función tras desaparecer el mensaje; solo la pasan los eventos
+ *        que deben esperar a que se vea.
+ * @param clave Si no está vacía, sustituye al aviso pendiente con la misma clave.
  */
-void EstadoPartida::mostrarMensaje(const QString& msg, std::function<void()> callback, int duracion) {
-    // Si ya existe un overlay, lo eliminamos
-    if (overlay) {
-        delete overlay;
-        overlay = nullptr;
-        overlayMsg = nullptr;
-    }
-
-    // Creamos el overlay como hijo directo de this
-    overlay = new QWidget(this);
-    overlay->setGeometry(this->rect());
-    overlay->setStyleSheet("QWidget { background-color: black; }");
-    // Lo ponemos en el tope de la pila de widgets:
-    overlay->raise();
-
-    // Mensaje
-    overlayMsg = new QLabel(msg, overlay);
-    overlayMsg->setAlignment(Qt::AlignCenter);
-    overlayMsg->setStyleSheet("QLabel { color: white; font-size: 64px; font-weight: bold; }");
-
-    QVBoxLayout* layout = new QVBoxLayout(overlay);
-    layout->addWidget(overlayMsg, 0, Qt::AlignCenter);
-    layout->setContentsMargins(0, 0, 0, 0);
-
-    // Efecto de opacidad
-    QGraphicsOpacityEffect* opacityEffect = new QGraphicsOpacityEffect(overlay);
-    opacityEffect->setOpacity(0.0);
-    overlay->setGraphicsEffect(opacityEffect);
-
-    overlay->show();
-    // Aseguramos que texteOverlay también esté al tope
-    overlayMsg->raise();
-
-    // Animación: fade in → pausa → fade out
-    QSequentialAnimationGroup* group = new QSequentialAnimationGroup(this);
-
-    QPropertyAnimation* fadeInAnim = new QPropertyAnimation(opacityEffect, "opacity", group);
-    fadeInAnim->setDuration(500);
-    fadeInAnim->setStartValue(0.0);
-    fadeInAnim->setEndValue(0.8);
-    fadeInAnim->setEasingCurve(QEasingCurve::OutCubic);
-
-    QPauseAnimation* holdAnim = new QPauseAnimation(duracion, group);
-
-    QPropertyAnimation* fadeOutAnim = new QPropertyAnimation(opacityEffect, "opacity", group);
-    fadeOutAnim->setDuration(500);
-    fadeOutAnim->setStartValue(0.8);
-    fadeOutAnim->setEndValue(0.0);
-    fadeOutAnim->setEasingCurve(QEasingCurve::InCubic);
-
-    group->addAnimation(fadeInAnim);
-    group->addAnimation(holdAnim);
-    group->addAnimation(fadeOutAnim);
-
-    connect(group, &QSequentialAnimationGroup::finished, this, [this, callback]() {
-        if (overlay) {
-            delete overlay;
-            overlay = nullptr;
-            overlayMsg = nullptr;
-        }
-        if (callback) callback();
-    });
-
-    group->start(QAbstractAnimation::DeleteWhenStopped);
+void EstadoPartida::mostrarMensaje(const QString& msg, std::function<void()> alVerse, const QString& clave) {
+    if (!banner)
+        banner = new MessageBanner(this);
+    banner->post(msg, alVerse, clave);
 }
 
 
@@ -1875,6 +1562,8 @@ void EstadoPartida::manejarEventoPrePartida(const QString& tipo, const QJsonObje
             if(nom == miNombre) {
                 this->setMiIdToken(id, data.value("chat_id").toString());
             }
+            // Baraja del jugador que entra, antes de que empiece la partida
+            PlayerProfiles::instance().prefetch(nom, id);
         }
 
         if (!overlayEspera) {
@@ -1907,9 +1596,7 @@ void EstadoPartida::procesarMensajeWebSocket(const QString& mensaje) {
 }
 
 void EstadoPartida::setVolume(int volumePercentage) {
-    if (audioOutput) {
-        audioOutput->setVolume(volumePercentage / 100.0);
-    }
+    AudioEngine::instance().setMusicVolume(volumePercentage);
 }
 
 //////////////////////////////////////////////////////////////////////////////////////
@@ -1978,13 +1665,7 @@ void EstadoPartida::crearMenu() {
         settingsWin->setModal(true);
         // Al cerrarla, recargamos volúmenes:
         connect(settingsWin, &QDialog::finished, this, [this](int) {
-            QSettings cfg("Grace Hopper",
-                          QString("Sota, Caballo y Rey_%1").arg(miNombre));
-            int bgmVol  = cfg.value("sound/volume",        50).toInt();
-            int sfxVol  = cfg.value("sound/effectsVolume", 50).toInt();
-            if (audioOutput) audioOutput->setVolume(bgmVol / 100.0);
-            if (effectOutput) effectOutput->setVolume(sfxVol / 100.0);
-            if (tickOutput)   tickOutput->setVolume(sfxVol * 0.5 / 100.0);
+            AudioEngine::instance().loadVolumes(miNombre);
         });
         settingsWin->exec();
     });
@@ -2056,72 +1737,10 @@ void EstadoPartida::crearMenu() {
     button->show();
 }
 
-void EstadoPartida::crearEsquinas(int tapeteId) {
-    if (esquinasCreadas) return;
-    esquinasCreadas = true;
-
-    QString img;
-    if(tapeteId == 1){
-        img = ":/images/set-golden-border-ornaments/gold_ornaments.png";
-    } else if(tapeteId == 2) {
-        img = ":/images/set-golden-border-ornaments/black_ornaments.png";
-    } else if(tapeteId == 3) {
-        img = ":/images/set-golden-border-ornaments/silver_ornaments.png";
-    } else {
-        img = ":/images/set-golden-border-ornaments/god_ornaments.png";
-    }
-
-    QPixmap ornamentPixmap(img);
-
-    QLabel *cornerTopLeft = new QLabel(this);
-    QLabel *cornerTopRight = new QLabel(this);
-    QLabel *cornerBottomLeft = new QLabel(this);
-    QLabel *cornerBottomRight = new QLabel(this);
-    QSize ornamentSize = QSize(300, 299);
-
-    cornerTopLeft->setPixmap(ornamentPixmap.scaled(ornamentSize, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-
-    QTransform transformH;
-    transformH.scale(-1, 1);
-    cornerTopRight->setPixmap(
-        ornamentPixmap.transformed(transformH, Qt::SmoothTransformation)
-            .scaled(ornamentSize, Qt::KeepAspectRatio, Qt::SmoothTransformation)
-        );
-
-    QTransform transformV;
-    transformV.scale(1, -1);
-    cornerBottomLeft->setPixmap(
-        ornamentPixmap.transformed(transformV, Qt::SmoothTransformation)
-            .scaled(ornamentSize, Qt::KeepAspectRatio, Qt::SmoothTransformation)
-        );
-
-    QTransform transformHV;
-    transformHV.scale(-1, -1);
-    cornerBottomRight->setPixmap(
-        ornamentPixmap.transformed(transformHV, Qt::SmoothTransformation)
-            .scaled(ornamentSize, Qt::KeepAspectRatio, Qt::SmoothTransformation)
-        );
-
-    QList<QLabel*> corners = {cornerTopLeft, cornerTopRight, cornerBottomLeft, cornerBottomRight};
-    for (QLabel* corner : corners) {
-        corner->setFixedSize(ornamentSize);
-        corner->setAttribute(Qt::WA_TransparentForMouseEvents);
-        corner->setAttribute(Qt::WA_TranslucentBackground);
-        corner->setStyleSheet("background: transparent;");
-        corner->raise();
-    }
-
-    int w = this->width();
-    int h = this->height();
-    int topOffset = 0;
-
-    cornerTopLeft->move(0, topOffset);
-    cornerTopRight->move(w - cornerTopRight->width(), topOffset);
-    cornerBottomLeft->move(0, h - cornerBottomLeft->height());
-    cornerBottomRight->move(w - cornerBottomRight->width(), h - cornerBottomRight->height());
-
-    cornerTopLeft->show();
-    cornerTopRight->show();
-    cornerBottomLeft->show();
-    cornerBottomRight->show();
+/**
+ * @brief Pinta el tapete equipado con sus ornamentos (BackdropService).
+ */
+void EstadoPartida::paintEvent(QPaintEvent *event) {
+    Q_UNUSED(event);
+    BackdropService::paint(this, tapeteActual);
 }
@@ -16,15 +16,17 @@
 #include "carta.h"
 #include "mano.h"
 #include "botonaccion.h"
+#include "scorelabel.h"
+#include "messagebanner.h"
+#include "playerprofiles.h"
 #include <QWidget>
 #include <QMap>
 #include <QJsonObject>
 #include <functional>
 #include <QTimer>
-#include <QMediaPlayer>
-#include <QAudioOutput>
 #include <QtWebSockets/QWebSocket>
 #include <QQueue>
+#include <QElapsedTimer>
 #include <QNetworkReply>
 
 /**
@@ -133,7 +135,7 @@ public:
     void actualizarOverlayEspera(int jugadoresCola, int jugadoresMax);
     void ocultarOverlayEspera();
 
-    void mostrarMensaje(const QString& msg, std::function<void()> callback, int duracion = 1250);
+    void mostrarMensaje(const QString& msg, std::function<void()> alVerse = nullptr, const QString& clave = QString());
 
     void actualizarPuntuacion(int equipo, int nuevoValor, std::function<void()> callback);
 
@@ -142,6 +144,7 @@ public:
     // Cola de eventos
     void recibirEvento(const QJsonObject& evento);
     void procesarSiguienteEvento();
+    void terminarEvento();
 
     void setVolume(int volumePercentage);
 
@@ -175,19 +178,23 @@ public slots:
      */
     void onAnularPausa();
 
-    void onGotUserId         (QNetworkReply* reply);
-    void onGotEquippedItems  (QNetworkReply* reply);
+    void aplicarEquipados(const PlayerProfiles::Profile& perfil);
 
-    void cargarSkinsJugadores(const QVector<Jugador*>& jugadores, QNetworkAccessManager* netMgr, std::function<void()> onComplete);
+    void cargarSkinsJugadores(const QVector<Jugador*>& jugadores, std::function<void()> onComplete);
     void cargarJugadoresDesdeJson(const QJsonObject& data);
 
 
+protected:
+    /**
+     * @brief Pinta el fondo del tapete (BackdropService).
+     */
+    void paintEvent(QPaintEvent *event) override;
+
 private:
     QMap<int, int> mapaSkinsPorJugador;
 
     int bg;
-    bool esquinasCreadas = false;
-    void crearEsquinas(int tapeteId);
+    int tapeteActual = 0;   ///< Tapete del fondo (0 = aún sin tapete).
 
     // Métodos auxiliares
     void limpiar();
@@ -212,7 +219,6 @@ private:
     bool partidaIniciada = false;
     bool arrastre = false;
 
-    QNetworkAccessManager* m_netMgr;        // ya lo usas para WS, reutilízalo aquí
     int                  m_equippedSkinId;  // guardará el ID que venga del backend
 
 
@@ -221,14 +227,18 @@ private:
     // WebSocket y eventos
     QQueue<QJsonObject> colaEventos;
     bool enEjecucion = false;
+    QElapsedTimer relojEvento;        // tiempo que lleva bloqueada la cola por el evento actual
+    qint64 msColaBloqueada = 0;       // total de la partida
+    qint64 msBloqueoMax = 0;          // evento que más la ha bloqueado
+    int eventosProcesados = 0;
     QWebSocket* websocket = nullptr;
 
-    // UI: overlays, botones, puntuaciones
-    QWidget* overlay = nullptr;
-    QLabel* overlayMsg = nullptr;
+    // UI: avisos, botones, puntuaciones
+    MessageBanner* banner = nullptr;
 
-    QLabel *puntosEquipo1Label = nullptr, *puntosEquipo1Title = nullptr;
-    QLabel *puntosEquipo2Label = nullptr, *puntosEquipo2Title = nullptr;
+    ScoreLabel *puntosEquipo1Label = nullptr;
+    ScoreLabel *puntosEquipo2Label = nullptr;
+    QLabel *puntosEquipo1Title = nullptr, *puntosEquipo2Title = nullptr;
 
     BotonAccion* botonCantar = nullptr;
     BotonAccion* botonCambiarSiete = nullptr;
@@ -239,13 +249,6 @@ private:
     QLabel* labelEspera = nullptr;
     int jugadoresCola = 0, jugadoresMax = 0;
 
-    QMediaPlayer*    backgroundPlayer = nullptr;
-    QAudioOutput*    audioOutput      = nullptr;
-
-    // SFX de efectos (roba carta, etc.)
-    QMediaPlayer* effectPlayer     = nullptr;
-    QAudioOutput* effectOutput     = nullptr;
-
     QString wsUrl; ///< URL del servidor WebSocket.
 
     // Chat partida
@@ -262,8 +265,6 @@ private:
     /** Etiqueta con el texto fijo "Tiempo restante" */
     QLabel* labelTimerTexto;
 
-    QAudioOutput*    tickOutput;
-    QMediaPlayer*    tickPlayer;
     QMap<Jugador*, QLabel*> m_labelJugadores;
     QLabel* turnoPermanenteLabel = nullptr;
 
@@ -0,0 +1,221 @@
+/**
+ * @file friendcarddelegate.cpp
+ * @brief Implementación de la clase FriendCardDelegate.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ */
+
+#include "friendcarddelegate.h"
+#include "userlistmodel.h"
+#include "avatarservice.h"
+#include <QAbstractItemView>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPainterPath>
+#include <QFontMetrics>
+
+/**
+ * @brief Constructor de FriendCardDelegate.
+ * @param mode Tipo de lista.
+ * @param parent Vista que usa el delegado.
+ */
+FriendCardDelegate::FriendCardDelegate(Mode mode, QObject *parent)
+    : QStyledItemDelegate(parent),
+      mode(mode)
+{
+}
+
+/**
+ * @brief "Victorias: X   Derrotas: Y   Ratio: Z%".
+ */
+QString FriendCardDelegate::statsText(const QJsonObject &item) {
+    int wins = item.contains("victorias") ? item["victorias"].toInt() : 0;
+    int losses = item.contains("derrotas") ? item["derrotas"].toInt() : 0;
+    double ratio = (wins + losses > 0) ? (wins * 100.0 / (wins + losses)) : 0.0;
+    return QString("Victorias: %1   Derrotas: %2   Ratio: %3%")
+        .arg(wins).arg(losses).arg(ratio, 0, 'f', 2);
+}
+
+/**
+ * @brief Todas las tarjetas tienen el mismo alto.
+ */
+QSize FriendCardDelegate::sizeHint(const QStyleOptionViewItem &option,
+                                   const QModelIndex &) const {
+    return QSize(qMax(option.rect.width(), 300), kRowHeight);
+}
+
+/**
+ * @brief Botones de la tarjeta, alineados a la derecha y centrados en vertical.
+ */
+QList<FriendCardDelegate::Button> FriendCardDelegate::buttons(const QRect &row,
+                                                              const QModelIndex &index) const {
+    const QColor green("#1D4536"), greenHover("#2A5C45");
+    const QColor red("#8B3A3A"), redHover("#C9B170");
+
+    QList<Button> list;
+    QSize size;
+    switch (mode) {
+    case Friends:
+        size = QSize(70, 30);
+        list.append({"perfil", "Perfil", {}, green, greenHover, QColor("#F9F9F4")});
+        list.append({"mensajes", "Mensajes", {}, green, greenHover, QColor("#F9F9F4")});
+        list.append({"eliminar", "Eliminar", {}, red, redHover, QColor("#F1F1F1")});
+        break;
+    case Requests:
+        size = QSize(110, 44);
+        list.append({"aceptar", "Aceptar", {}, green, greenHover, QColor("#F9F9F4")});
+        list.append({"rechazar", "Rechazar", {}, red, redHover, QColor("#F1F1F1")});
+        break;
+    case Search: {
+        size = QSize(180, 44);
+        QJsonObject item = index.data(UserListModel::PayloadRole).toJsonObject();
+        if (item["solicitud_enviada"].toBool())
+            list.append({"agregar", "Solicitud Enviada", {}, QColor("#C2C7B0"), QColor("#C2C7B0"),
+                         QColor("#203F31"), false});
+        else
+            list.append({"agregar", "Agregar amigo", {}, green, greenHover, QColor("#F9F9F4")});
+        break;
+    }
+    }
+
+    const int spacing = 10;
+    int x = row.right() - 15 - (list.size() * size.width() + (list.size() - 1) * spacing);
+    int y = row.center().y() - size.height() / 2;
+    for (Button &b : list) {
+        b.rect = QRect(QPoint(x, y), size);
+        x += size.width() + spacing;
+    }
+    return list;
+}
+
+/**
+ * @brief Avatar en memoria o, mientras llega, el de por defecto.
+ *
+ * Solo se piden los avatares de las filas que se pintan; al recibir uno se
+ * repinta la vista.
+ */
+QPixmap FriendCardDelegate::avatar(const QString &url) const {
+    AvatarService &service = AvatarService::instance();
+    if (url.isEmpty())
+        return service.placeholder(kAvatarSize);
+
+    QPixmap pixmap = service.cached(url, kAvatarSize);
+    if (!pixmap.isNull())
+        return pixmap;
+
+    if (!waiting.contains(url)) {
+        waiting.insert(url);
+        auto *self = const_cast<FriendCardDelegate *>(this);
+        service.request(url, kAvatarSize, self, [self, url](const QPixmap &) {
+            self->waiting.remove(url);
+            if (auto *view = qobject_cast<QAbstractItemView *>(self->parent()))
+                view->viewport()->update();
+        });
+    }
+    return service.placeholder(kAvatarSize);
+}
+
+/**
+ * @brief Pinta la tarjeta: fondo, avatar, textos y botones.
+ */
+void FriendCardDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
+                               const QModelIndex &index) const {
+    const QRect card = option.rect.adjusted(0, 5, 0, -5);
+    const QJsonObject item = index.data(UserListModel::PayloadRole).toJsonObject();
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+
+    if (mode == Search) {
+        QPainterPath path;
+        path.addRoundedRect(QRectF(card).adjusted(0.5, 0.5, -0.5, -0.5), 10, 10);
+        painter->fillPath(path, QColor("#2a2a2a"));
+        painter->setPen(QColor("#444"));
+        painter->drawPath(path);
+    }
+
+    // Avatar
+    QRect avatarRect(card.left() + 10, card.center().y() - kAvatarSize / 2, kAvatarSize, kAvatarSize);
+    painter->drawPixmap(avatarRect, avatar(item["imagen"].toString()));
+
+    // Textos, hasta el primer botón
+    QList<Button> list = buttons(card, index);
+    int textLeft = avatarRect.right() + 15;
+    int textRight = (list.isEmpty() ? card.right() : list.first().rect.left()) - 15;
+    int textWidth = qMax(0, textRight - textLeft);
+
+    QFont nameFont = option.font;
+    nameFont.setPixelSize(mode == Friends ? 18 : 20);
+    nameFont.setBold(true);
+    QFont statsFont = option.font;
+    statsFont.setPixelSize(mode == Friends ? 16 : 18);
+
+    painter->setPen(Qt::white);
+    painter->setFont(nameFont);
+    QString name = QFontMetrics(nameFont).elidedText(UserListModel::displayName(item), Qt::ElideRight, textWidth);
+    if (mode == Requests) {
+        painter->drawText(QRect(textLeft, card.top(), textWidth, card.height()),
+                          Qt::AlignLeft | Qt::AlignVCenter, name);
+    } else {
+        int lineHeight = card.height() / 2 - 10;
+        painter->drawText(QRect(textLeft, card.top() + 10, textWidth, lineHeight),
+                          Qt::AlignLeft | Qt::AlignBottom, name);
+        painter->setFont(statsFont);
+        painter->drawText(QRect(textLeft, card.center().y() + 5, textWidth, lineHeight),
+                          Qt::AlignLeft | Qt::AlignTop,
+                          QFontMetrics(statsFont).elidedText(statsText(item), Qt::ElideRight, textWidth));
+    }
+
+    // Botones
+    QFont buttonFont = option.font;
+    buttonFont.setPixelSize(mode == Friends ? 14 : 18);
+    painter->setFont(buttonFont);
+    for (const Button &b : list) {
+        bool hovered = b.enabled && hoverIndex == index && hoverAction == b.action;
+        QPainterPath path;
+        path.addRoundedRect(b.rect, 10, 10);
+        painter->fillPath(path, hovered ? b.hover : b.background);
+        painter->setPen(hovered && b.hover == QColor("#C9B170") ? QColor("#1C1C1C") : b.foreground);
+        painter->drawText(b.rect, Qt::AlignCenter, b.text);
+    }
+
+    painter->restore();
+}
+
+/**
+ * @brief Detecta el botón bajo el ratón (resaltado) y las pulsaciones.
+ */
+bool FriendCardDelegate::editorEvent(QEvent *event, QAbstractItemModel *,
+                                     const QStyleOptionViewItem &option, const QModelIndex &index) {
+    if (event->type() != QEvent::MouseMove && event->type() != QEvent::MouseButtonRelease)
+        return false;
+
+    const QPoint pos = static_cast<QMouseEvent *>(event)->position().toPoint();
+    const QRect card = option.rect.adjusted(0, 5, 0, -5);
+    QString under;
+    bool enabled = false;
+    for (const Button &b : buttons(card, index)) {
+        if (b.rect.contains(pos)) {
+            under = b.action;
+            enabled = b.enabled;
+            break;
+        }
+    }
+
+    if (event->type() == QEvent::MouseMove) {
+        if (hoverIndex != index || hoverAction != under) {
+            hoverIndex = index;
+            hoverAction = under;
+            if (auto *view = qobject_cast<QAbstractItemView *>(parent()))
+                view->viewport()->update();
+        }
+        return false;
+    }
+
+    if (static_cast<QMouseEvent *>(event)->button() == Qt::LeftButton && !under.isEmpty() && enabled) {
+        emit actionTriggered(under, index);
+        return true;
+    }
+    return false;
+}
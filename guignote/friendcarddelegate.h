@@ -0,0 +1,98 @@
+/**
+ * @file friendcarddelegate.h
+ * @brief Declaración de la clase FriendCardDelegate, que pinta las tarjetas de usuario.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * FriendCardDelegate dibuja las filas de las pestañas de amigos, solicitudes y
+ * búsqueda (avatar, nombre, estadísticas y botones) sin crear widgets por fila.
+ */
+
+#ifndef FRIENDCARDDELEGATE_H
+#define FRIENDCARDDELEGATE_H
+
+#include <QStyledItemDelegate>
+#include <QPersistentModelIndex>
+#include <QColor>
+#include <QJsonObject>
+#include <QSet>
+
+/**
+ * @class FriendCardDelegate
+ * @brief Delegado de tarjetas de usuario con botones pintados.
+ *
+ * Los botones se dibujan en paint() y se detectan en editorEvent(); al pulsar
+ * uno se emite actionTriggered() con su acción ("perfil", "mensajes",
+ * "eliminar", "aceptar", "rechazar" o "agregar"). Los avatares se piden a
+ * AvatarService solo para las filas que se pintan.
+ */
+class FriendCardDelegate : public QStyledItemDelegate {
+    Q_OBJECT
+
+public:
+    /** @brief Tipo de lista que pinta el delegado. */
+    enum Mode {
+        Friends,   ///< Amigos: Perfil, Mensajes y Eliminar.
+        Requests,  ///< Solicitudes: Aceptar y Rechazar.
+        Search     ///< Búsqueda: Agregar amigo.
+    };
+
+    /**
+     * @brief Constructor.
+     * @param mode Tipo de lista.
+     * @param parent Vista que usa el delegado.
+     */
+    explicit FriendCardDelegate(Mode mode, QObject *parent = nullptr);
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option,
+               const QModelIndex &index) const override;
+    QSize sizeHint(const QStyleOptionViewItem &option,
+                   const QModelIndex &index) const override;
+
+    /**
+     * @brief Texto de estadísticas de un usuario.
+     * @param item Objeto JSON con "victorias" y "derrotas".
+     */
+    static QString statsText(const QJsonObject &item);
+
+signals:
+    /**
+     * @brief Se ha pulsado un botón de una tarjeta.
+     * @param action Acción del botón.
+     * @param index Fila de la tarjeta.
+     */
+    void actionTriggered(const QString &action, const QModelIndex &index);
+
+protected:
+    bool editorEvent(QEvent *event, QAbstractItemModel *model,
+                     const QStyleOptionViewItem &option, const QModelIndex &index) override;
+
+private:
+    /**
+     * @struct Button
+     * @brief Botón pintado dentro de una tarjeta.
+     */
+    struct Button {
+        QString action;      ///< Acción que emite.
+        QString text;        ///< Texto visible.
+        QRect rect;          ///< Posición dentro de la fila.
+        QColor background;   ///< Color de fondo.
+        QColor hover;        ///< Color de fondo con el ratón encima.
+        QColor foreground;   ///< Color del texto.
+        bool enabled = true; ///< false si no se puede pulsar.
+    };
+
+    QList<Button> buttons(const QRect &row, const QModelIndex &index) const;
+    QPixmap avatar(const QString &url) const;
+
+    static constexpr int kAvatarSize = 100;  ///< Diámetro del avatar.
+    static constexpr int kRowHeight = 140;   ///< Alto de cada tarjeta (con separación).
+
+    Mode mode;                               ///< Tipo de lista.
+    QPersistentModelIndex hoverIndex;        ///< Fila bajo el ratón.
+    QString hoverAction;                     ///< Botón bajo el ratón.
+    mutable QSet<QString> waiting;           ///< Avatares pedidos y aún no recibidos.
+};
+
+#endif // FRIENDCARDDELEGATE_H
@@ -6,11 +6,17 @@
  * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
  *
  * Contiene la definición de la clase FriendsMessageWindow, encargada de
- * gestionar la interfaz de chat entre usuarios, la conexión WebSocket y
- * el envío/recepción de mensajes.
+ * gestionar la interfaz de chat entre usuarios, su canal en ChatHub,
+ * el envío/recepción de mensajes y la sincronización con el almacén local.
  */
 
 #include "friendsmessagewindow.h"
+#include "theme.h"
+#include "session.h"
+#include "chathub.h"
+#include "chatstore.h"
+#include "chatmodel.h"
+#include "chatbubbledelegate.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QLabel>
@@ -20,15 +26,12 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QSettings>
-#include <QListWidgetItem>
 #include <QNetworkAccessManager>
-#include <QEventLoop>
 #include <QNetworkReply>
-#include <QWebSocket>
 #include <QTimer>
+#include <QShowEvent>
+#include <QHideEvent>
 #include <QDebug>
-#include <QJsonDocument>
-#include <QJsonObject>
 #include <QByteArray>
 
 
@@ -45,23 +48,40 @@ FriendsMessageWindow::FriendsMessageWindow(const QString &userKey,
                                            QWidget *parent)
     : QWidget(parent),
     friendID(friendId),
-    usr(friendName)
+    usr(friendName),
+    m_userKey(userKey)
 {
     // Ventana sin borde y estilo
     setWindowFlags(Qt::FramelessWindowHint | Qt::Dialog);
     setAttribute(Qt::WA_StyledBackground, true);
-    setStyleSheet("background-color: #171718; border-radius: 30px; padding: 20px;");
+    Theme::setRole(this, "panel");
     setFixedSize(600, 680);
 
     networkManager = new QNetworkAccessManager(this);
+    channel = ChatHub::friendChannel(friendId);
+    ChatHub &hub = ChatHub::forUser(userKey);
+
+    // Única vía de envío: el canal compartido, con reintento hasta recibir el eco
+    outbox = new ChatOutbox([this](const QString &frame) {
+        return ChatHub::forUser(m_userKey).send(channel, frame);
+    }, this);
+    // Agotados los reintentos, la burbuja (ya pintada) pasa a "no entregado"
+    connect(outbox, &ChatOutbox::failed, this, [this](const QString &clientId, const QString &content) {
+        qWarning() << "FriendsMessageWindow: no se pudo entregar el mensaje:" << content;
+        messagesModel->setFailed(clientId, true);
+    });
 
+    // Al (re)conectar se manda lo que quedó pendiente
+    connect(&hub, &ChatHub::connected, this, [this](const QString &ch) {
+        if (ch == channel)
+            outbox->flush();
+    });
+    connect(&hub, &ChatHub::messageReceived, this, &FriendsMessageWindow::onChatMessage);
 
-
-
-    ownID = loadOwnId(userKey);
+    ownID = Session::forUser(userKey).userId();
     setupUI(userKey);
     loadMessages(userKey);
-    setupWebSocketConnection(userKey);
+    hub.open(channel);
 }
 
 /**
@@ -78,15 +98,12 @@ void FriendsMessageWindow::setupUI(const QString &userKey)
     // — Header —
     QHBoxLayout *headerLayout = new QHBoxLayout();
     titleLabel = new QLabel(usr, this);
-    titleLabel->setStyleSheet("color: white; font-size: 28px; font-weight: bold;");
+    Theme::setRole(titleLabel, "title");
     closeButton = new QPushButton(this);
     closeButton->setIcon(QIcon(":/icons/cross.png"));
     closeButton->setIconSize(QSize(22,22));
     closeButton->setFixedSize(35,35);
-    closeButton->setStyleSheet(
-        "QPushButton { background-color: #c2c2c3; border: none; border-radius: 17px; }"
-        "QPushButton:hover { background-color: #9b9b9b; }"
-        );
+    Theme::setRole(closeButton, "close");
     connect(closeButton, &QPushButton::clicked, this, &QWidget::hide);
 
     headerLayout->addWidget(titleLabel);
@@ -94,23 +111,23 @@ void FriendsMessageWindow::setupUI(const QString &userKey)
     headerLayout->addWidget(closeButton);
     mainLayout->addLayout(headerLayout);
 
-    // — Lista de mensajes —
-    messagesListWidget = new QListWidget(this);
-    messagesListWidget->setStyleSheet(
-        "background-color: #292A2D; color: white; font-size: 16px; padding: 10px; "
-        "border-radius: 10px; border: 1px solid #444;"
-        );
-    messagesListWidget->setSelectionMode(QAbstractItemView::NoSelection);
-    mainLayout->addWidget(messagesListWidget);
+    // — Lista de mensajes (las burbujas las pinta el delegado) —
+    messagesModel = new ChatModel(ownID, this);
+    messagesView = new QListView(this);
+    Theme::setRole(messagesView, "chatView");
+    messagesView->setModel(messagesModel);
+    messagesView->setItemDelegate(new ChatBubbleDelegate(messagesView));
+    messagesView->setSelectionMode(QAbstractItemView::NoSelection);
+    messagesView->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    messagesView->setResizeMode(QListView::Adjust);
+    connect(messagesView, &QListView::clicked, this, &FriendsMessageWindow::retryMessage);
+    mainLayout->addWidget(messagesView);
 
     // — Entrada + botón enviar —
     QHBoxLayout *inputLayout = new QHBoxLayout();
     messageInput = new QLineEdit(this);
     messageInput->setPlaceholderText("Escribe un mensaje...");
-    messageInput->setStyleSheet(
-        "background-color: #292A2D; color: white; font-size: 16px; padding: 10px; "
-        "border-radius: 10px; border: 1px solid #444;"
-        );
+    Theme::setRole(messageInput, "chatInput");
     messageInput->setFixedHeight(40);
     connect(messageInput, &QLineEdit::returnPressed, this, [=]() {
         this->sendMessage(userKey);
@@ -118,11 +135,7 @@ void FriendsMessageWindow::setupUI(const QString &userKey)
 
     sendButton = new QPushButton("Enviar", this);
     sendButton->setFixedHeight(40);
-    sendButton->setStyleSheet(
-        "QPushButton { background-color: #1D4536; color: #F9F9F4; font-size: 16px;"
-        "padding: 8px 15px; border-radius: 10px; }"
-        "QPushButton:hover { background-color: #2A5C45; }"
-        );
+    Theme::setRole(sendButton, "send");
     connect(sendButton, &QPushButton::clicked, this, [=]() {
         this->sendMessage(userKey);
     });
@@ -133,324 +146,198 @@ void FriendsMessageWindow::setupUI(const QString &userKey)
 }
 
 /**
- * @brief Establece la conexión WebSocket y sus callbacks.
- * @param userKey Clave del usuario para obtener token de autenticación.
+ * @brief Registra la ventana visible en ChatHub.
  */
-void FriendsMessageWindow::setupWebSocketConnection(const QString &userKey)
+void FriendsMessageWindow::showEvent(QShowEvent *event)
 {
-    webSocket = new QWebSocket();
-    QString token = loadAuthToken(userKey);
-    if (token.isEmpty()) {
-        qWarning() << "FriendsMessageWindow: Token vacío, no se conecta WebSocket.";
-        return;
+    if (!attached) {
+        ChatHub::forUser(m_userKey).attach(channel);
+        attached = true;
     }
-
-    QUrl url;
-    url.setScheme("ws");
-    url.setHost("188.165.76.134");
-    url.setPort(8000);
-    url.setPath(QString("/ws/chat/%1/").arg(friendID));
-    url.setQuery(QString("token=%1").arg(token));
-
-    webSocket->open(url);
-
-    connect(webSocket, &QWebSocket::connected,    this, &FriendsMessageWindow::onConnected);
-    connect(webSocket, &QWebSocket::disconnected, this, &FriendsMessageWindow::onDisconnected);
-    connect(webSocket, &QWebSocket::textMessageReceived,
-            this, &FriendsMessageWindow::onTextMessageReceived);
-}
-
-/**
- * @brief Callback cuando el WebSocket se conecta correctamente.
- */
-void FriendsMessageWindow::onConnected()
-{
-    qDebug() << "WebSocket conectado.";
+    QWidget::showEvent(event);
 }
 
 /**
- * @brief Callback cuando el WebSocket se desconecta.
+ * @brief Quita el registro al ocultarse; los mensajes pasan a contar como no leídos.
  */
-void FriendsMessageWindow::onDisconnected()
+void FriendsMessageWindow::hideEvent(QHideEvent *event)
 {
-    qDebug() << "WebSocket desconectado.";
+    if (attached) {
+        ChatHub::forUser(m_userKey).detach(channel);
+        attached = false;
+    }
+    QWidget::hideEvent(event);
 }
 
 /**
- * @brief Maneja la recepción de un nuevo mensaje vía WebSocket.
- * @param rawMessage Cadena JSON del mensaje recibido.
+ * @brief Maneja la recepción de un nuevo mensaje por el canal de la conversación.
+ * @param ch Canal por el que llega (se ignoran los de otras conversaciones).
+ * @param obj Mensaje recibido.
  */
-void FriendsMessageWindow::onTextMessageReceived(const QString &rawMessage)
+void FriendsMessageWindow::onChatMessage(const QString &ch, const QJsonObject &obj)
 {
-    // 1) Parsear el JSON recibido
-    QJsonDocument doc = QJsonDocument::fromJson(rawMessage.toUtf8());
-    if (!doc.isObject())                 // no era un objeto JSON → descarta
+    // 1) Solo interesa el canal de esta conversación
+    if (ch != channel)
         return;
 
-    QJsonObject obj = doc.object();
     if (obj.contains("error")) {         // el servidor manda un error
         qWarning() << "Error WS:" << obj["error"].toString();
         return;
     }
 
-    // 2) Extraer los campos que ya tenías
-    QString senderId = QString::number(obj["emisor"].toInt());
-    QString content  = obj["contenido"].toString();
-    QString ts       = obj["fecha_envio"].toString();   // AAAA-MM-DD HH:MM:SS
-
-    // (opcional) no muestres tu propio eco
-    if (senderId == ownID)
+    // 2) Extraer los campos
+    ChatMessage m;
+    m.id       = obj.contains("id") ? obj["id"].toVariant().toString() : QString();
+    m.senderId = QString::number(obj["emisor"].toInt());
+    m.content  = obj["contenido"].toString();
+    m.sentAt   = obj["fecha_envio"].toString();   // AAAA-MM-DD HH:MM:SS
+
+    // 3) El eco de un mensaje enviado desde aquí es la confirmación de entrega;
+    //    ya se pintó al enviarlo (si llega tarde, la burbuja deja de estar en rojo)
+    const bool own = (m.senderId == ownID);
+    if (own && (outbox->acknowledge(obj)
+                || messagesModel->setFailed(obj.value("client_id").toString(), false))) {
+        if (markShown(m))
+            ChatStore::instance().append(conversation, m);
         return;
+    }
+    // Los propios que no son de esta ventana vienen de otra sesión: se muestran igual
 
-    // 3) Construir la clave única y filtrar duplicados
-    QString key = ts + "|" + senderId + "|" + content;  // ← clave compuesta
-    if (m_shownKeys.contains(key))
+    if (!markShown(m))
         return;                         // ya se mostró → ignora
 
-    m_shownKeys.insert(key);            // marca como nuevo
+    ChatStore::instance().append(conversation, m);
 
     // 4) Mostrar el mensaje y disparar la señal
-    appendMessage(senderId, content);
-    emit newMessageReceived(senderId);
+    appendMessage(m.senderId, m.content);
+    if (!own)
+        emit newMessageReceived(m.senderId);
 }
 
 /**
- * @brief Envía un mensaje tanto por WebSocket como por REST.
- * @param userKey Clave de usuario para token y conexión.
+ * @brief Envía un mensaje a través de la cola de salida.
+ * @param userKey Clave de usuario para reabrir la conexión si hace falta.
+ *
+ * El mensaje se pinta al momento; ChatOutbox lo manda por el WebSocket y lo
+ * reenvía hasta que llega el eco del servidor.
  */
 void FriendsMessageWindow::sendMessage(const QString &userKey)
 {
     const QString textoAEnviar = messageInput->text().trimmed();
     if (textoAEnviar.isEmpty()) return;
 
-    // 2) Mostrar en UI
-    appendMessage(ownID, textoAEnviar);
     messageInput->clear();
 
-    // 3) Enviar por WS
-    // 3) Enviar por WS
-    if (!webSocket->isValid())
-        setupWebSocketConnection(userKey);
-
-    // Construye explícitamente un objeto JSON
-    QJsonObject wsJson;
-    wsJson["contenido"] = textoAEnviar;
-
-    // Ahora ya no hay ambigüedad: pasas un QJsonObject
-    QJsonDocument wsDoc(wsJson);
-    webSocket->sendTextMessage(wsDoc.toJson());
-
-
-    // 4) POST REST
-    QString token = loadAuthToken(userKey);
-    QNetworkRequest postReq(QUrl("http://188.165.76.134:8000/mensajes/enviar/"));
-    postReq.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-    postReq.setRawHeader("Auth", token.toUtf8());
-    QJsonObject body{{"receptor_id", friendID},
-                     {"contenido", textoAEnviar}};
-    auto *postReply = networkManager->post(postReq, QJsonDocument(body).toJson());
-    connect(postReply, &QNetworkReply::finished, this, [=]() {
-        if (postReply->error() != QNetworkReply::NoError)
-            qWarning() << "Error al guardar mensaje:" << postReply->errorString();
-        postReply->deleteLater();
-    });
+    // Si el canal está caído, la cola lo reenvía al reconectar
+    ChatHub::forUser(userKey).open(channel);
+    messagesModel->appendOutgoing(textoAEnviar, outbox->enqueue(textoAEnviar));
+    messagesView->scrollToBottom();
+}
+
+/**
+ * @brief Reenvía un mensaje marcado como no entregado (clic sobre su burbuja).
+ * @param index Fila pulsada.
+ */
+void FriendsMessageWindow::retryMessage(const QModelIndex &index)
+{
+    if (!index.data(ChatModel::FailedRole).toBool())
+        return;
+
+    ChatHub::forUser(m_userKey).open(channel);
+    const QString clientId = outbox->enqueue(index.data(Qt::DisplayRole).toString());
+    messagesModel->markRetried(index.row(), clientId);
 }
 
 
 /**
- * @brief Descarga y muestra el historial de mensajes.
+ * @brief Muestra el historial guardado y lo sincroniza con el servidor.
  * @param userKey Clave del usuario para autenticación REST.
+ *
+ * La copia local se lee en segundo plano y se pinta en cuanto está disponible;
+ * de la respuesta del servidor solo se guardan y se añaden los mensajes nuevos.
  */
 void FriendsMessageWindow::loadMessages(const QString &userKey)
 {
-    QString token = loadAuthToken(userKey);
+    QString token = Session::forUser(userKey).token();
     if (token.isEmpty()) return;
 
-    struct Msg {
-        QDateTime ts;
-        QString   sender;
-        QString   text;
-        QString   key;        //  "<ts>|<sender>|<text>"
-    };
-    QVector<Msg> mensajes;
+    conversation = QString("%1_%2").arg(ownID.isEmpty() ? userKey : ownID, friendID);
 
-    /* --- 1. Descarga REST ------------------------------------------------ */
+    /* --- 1. Copia local ------------------------------------------------- */
+    ChatStore::instance().load(conversation, this, [this](const QList<ChatMessage> &stored) {
+        showStoredMessages(stored);
+    });
+
+    /* --- 2. Sincronización con el servidor ------------------------------ */
     QUrl url(QString("http://188.165.76.134:8000/mensajes/obtener/?receptor_id=%1")
                  .arg(friendID));
     QNetworkRequest req(url);
     req.setRawHeader("Auth", token.toUtf8());
 
     QNetworkReply *r = networkManager->get(req);
-    QEventLoop loop;
-    connect(r, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-    loop.exec();
-
-    if (r->error() == QNetworkReply::NoError) {
-        QJsonArray arr = QJsonDocument::fromJson(r->readAll())
-        .object()["mensajes"].toArray();
-
-        for (auto v : arr) {
-            auto  o   = v.toObject();
-            QString tsStr   = o["fecha_envio"].toString();            // "AAAA-MM-DD HH:MM:SS"
-            QDateTime ts    = QDateTime::fromString(tsStr,
-                                                 "yyyy-MM-dd HH:mm:ss");
-            QString sender  = QString::number(o["emisor"].toInt());
-            QString text    = o["contenido"].toString();
-            QString key     = tsStr + "|" + sender + "|" + text;
-
-            mensajes.append({ts, sender, text, key});
+    connect(r, &QNetworkReply::finished, this, [this, r]() {
+        r->deleteLater();
+        if (r->error() != QNetworkReply::NoError) {
+            qWarning() << "Error al cargar mensajes:" << r->errorString();
+            return;
         }
-    }
-    r->deleteLater();
-
-    /* --- 2. Ordenar por fecha ------------------------------------------- */
-    std::sort(mensajes.begin(), mensajes.end(),
-              [](const Msg &a, const Msg &b){ return a.ts < b.ts; });
-
-    /* --- 3. Poblar la UI, filtrando duplicados -------------------------- */
-    messagesListWidget->clear();          // borramos la lista actual
 
-    for (const Msg &m : mensajes)
-    {
-        if (m_shownKeys.contains(m.key))
-            continue;                     // ya estaba (raro, pero por si acaso)
+        // La fusión va detrás de la lectura en la cola del almacén: llega después
+        ChatStore::instance().merge(conversation, r->readAll(), this,
+                                    [this](const QList<ChatMessage> &fresh) {
+            for (const ChatMessage &m : fresh) {
+                if (!markShown(m))
+                    continue;                 // ya llegó por WebSocket
+                appendMessage(m.senderId, m.content);
+            }
+        });
+    });
+}
 
-        m_shownKeys.insert(m.key);
-        appendMessage(m.sender, m.text);  // tu burbuja
-    }
+/**
+ * @brief Muestra la copia local de la conversación.
+ * @param stored Mensajes guardados, en orden cronológico.
+ *
+ * Se insertan de una vez en el modelo: la vista solo pinta las filas visibles.
+ */
+void FriendsMessageWindow::showStoredMessages(const QList<ChatMessage> &stored)
+{
+    for (const ChatMessage &m : stored)
+        markShown(m);
 
-    messagesListWidget->scrollToBottom();
+    messagesModel->append(stored);
+    messagesView->scrollToBottom();
 }
 
 /**
- * @brief Añade un mensaje a la interfaz.
+ * @brief Añade un mensaje al final de la conversación.
  * @param senderId ID del remitente del mensaje.
  * @param content Contenido textual del mensaje.
  */
 void FriendsMessageWindow::appendMessage(const QString &senderId,
                                          const QString &content)
 {
-    QLabel *lbl = new QLabel(content);
-    lbl->setWordWrap(true);
-    lbl->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
-
-    QWidget *container = new QWidget();
-    // <-- Aquí quitas cualquier borde/blanco
-    container->setStyleSheet("background: transparent; border: none;");
-
-    QVBoxLayout *lay = new QVBoxLayout(container);
-    lay->setContentsMargins(5,5,5,5);
-    lay->addWidget(lbl);
-
-    if (senderId == ownID) {
-        lbl->setStyleSheet(
-            "background-color: white; color: black; padding: 8px; font-size: 16px;"
-            "border-radius: 10px; max-width: 400px;"
-            );
-        lay->setAlignment(lbl, Qt::AlignRight);
-    } else {
-        lbl->setStyleSheet(
-            "background-color: #1D4536; color: #F9F9F4; padding: 8px; font-size: 16px;"
-            "border-radius: 10px; max-width: 400px;"
-            );
-        lay->setAlignment(lbl, Qt::AlignLeft);
-    }
-
-    auto *item = new QListWidgetItem();
-    messagesListWidget->addItem(item);
-    messagesListWidget->setItemWidget(item, container);
-
-    QTimer::singleShot(0, this, [=]() {
-        const int bubbleMaxWidth = 500;   // sube o baja a tu gusto
-
-        // ①  Estilo común para ambas burbujas
-        QString common = QString(
-                             "padding: 10px; font-size: 16px; border-radius: 10px; "
-                             "max-width: %1px;").arg(bubbleMaxWidth);
-
-        // ②  Color según quién envía
-        if (senderId == ownID) {
-            lbl->setStyleSheet("background-color: white; color: black; " + common);
-            lay->setAlignment(lbl, Qt::AlignRight);
-        } else {
-            lbl->setStyleSheet("background-color: #1D4536; color: #F9F9F4; " + common);
-            lay->setAlignment(lbl, Qt::AlignLeft);
-        }
-
-        // ③  Calcular tamaño óptimo sin factor 0.35
-        lbl->adjustSize();
-        int h = lbl->sizeHint().height();                       // alto real
-        int listW   = messagesListWidget->viewport()->width();  // ancho disponible
-        int targetW = qMin(bubbleMaxWidth, listW - 40);         // deja 20 px de margen a cada lado
-
-        item->setSizeHint(QSize(targetW, h + 10));
-        messagesListWidget->scrollToBottom();
-    });
+    messagesModel->append(senderId, content);
+    messagesView->scrollToBottom();
 }
 
 
 /**
- * @brief Obtiene el token de autenticación almacenado localmente.
- * @param userKey Clave del usuario.
- * @return Token JWT como cadena.
- */
-QString FriendsMessageWindow::loadAuthToken(const QString &userKey)
-{
-    QString appName = QString("Sota, Caballo y Rey_%1").arg(userKey);
-    QSettings settings("Grace Hopper", appName);
-    return settings.value("auth/token").toString();
-}
-
-/**
- * @brief Extrae el ID propio del usuario desde el token JWT.
- * @param userKey Clave del usuario.
- * @return ID del usuario como cadena.
+ * @brief Registra el mensaje en el conjunto acotado de mostrados.
+ *
+ * Se usa el id del servidor; si no viene, la clave fecha|emisor|contenido.
  */
-QString FriendsMessageWindow::loadOwnId(const QString &userKey)
+bool FriendsMessageWindow::markShown(const ChatMessage &message)
 {
-    // 1) Obtener el token
-    QString token = loadAuthToken(userKey);
-    if (token.isEmpty())
-        return QString();
-
-    // 2) Separar las tres partes del JWT
-    const QStringList parts = token.split('.');
-    if (parts.size() < 2)
-        return QString();
-
-    // 3) Decodificar la parte del payload (Base64URL → Base64)
-    QByteArray payload = parts.at(1).toUtf8();
-    payload.replace('-', '+');
-    payload.replace('_', '/');
-    switch (payload.size() % 4) {
-    case 2: payload.append("=="); break;
-    case 3: payload.append('=');  break;
-    default: break;
-    }
-
-    // 4) Base64 → JSON
-    QByteArray decoded = QByteArray::fromBase64(payload);
-    QJsonDocument doc = QJsonDocument::fromJson(decoded);
-    if (!doc.isObject())
-        return QString();
-
-    QJsonObject obj = doc.object();
-
-    // 5) Extraer el campo correcto (ajusta el nombre si tu JWT usa otro claim)
-    if (obj.contains("user_id"))
-        return QString::number(obj.value("user_id").toInt());
-    else if (obj.contains("id"))
-        return QString::number(obj.value("id").toInt());
-
-    return QString();
+    return shownIds.insert(message.id.isEmpty() ? ChatStore::keyFor(message) : message.id);
 }
 
 /**
- * @brief Destructor de FriendsMessageWindow. Libera recursos.
+ * @brief Destructor de FriendsMessageWindow. La conexión queda en ChatHub.
  */
 FriendsMessageWindow::~FriendsMessageWindow()
 {
-    webSocket->close();
-    delete webSocket;
+    if (attached)
+        ChatHub::forUser(m_userKey).detach(channel);
     qDebug() << "FriendsMessageWindow destruida";
 }
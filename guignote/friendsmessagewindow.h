@@ -6,7 +6,7 @@
  * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
  *
  * La clase FriendsMessageWindow proporciona una interfaz gráfica para enviar y recibir mensajes
- * entre usuarios, utilizando WebSockets y peticiones de red.
+ * entre usuarios, utilizando la conexión compartida de ChatHub y peticiones de red.
  */
 
 #ifndef FRIENDSMESSAGEWINDOW_H
@@ -16,17 +16,20 @@
 #include <QLabel>
 #include <QPushButton>
 #include <QLineEdit>
-#include <QListWidget>
-#include <QListWidgetItem>
+#include <QListView>
 #include <QNetworkAccessManager>
-#include <QWebSocket>
 #include <QBoxLayout>
+#include "chathistoryloader.h"
+#include "chatoutbox.h"
+
+class ChatModel;
 
 /**
  * @class FriendsMessageWindow
  * @brief Ventana de chat entre el usuario actual y un amigo.
  *
- * Esta clase permite enviar, recibir y mostrar mensajes entre usuarios a través de una conexión WebSocket.
+ * Esta clase permite enviar, recibir y mostrar mensajes entre usuarios. La conexión WebSocket
+ * es del ChatHub del usuario y sigue abierta aunque la ventana se oculte.
  */
 class FriendsMessageWindow : public QWidget
 {
@@ -55,18 +58,20 @@ signals:
      */
     void newMessageReceived(const QString& fromFriendId);
 
-private slots:
-    /** @brief Slot llamado al conectar el WebSocket. */
-    void onConnected();
+protected:
+    /** @brief Registra la ventana en ChatHub: sus mensajes dejan de contar como no leídos. */
+    void showEvent(QShowEvent *event) override;
 
-    /** @brief Slot llamado al desconectar el WebSocket. */
-    void onDisconnected();
+    /** @brief Quita el registro; la conexión sigue abierta. */
+    void hideEvent(QHideEvent *event) override;
 
+private slots:
     /**
-     * @brief Slot llamado al recibir un mensaje en bruto desde el WebSocket.
-     * @param rawMessage Cadena JSON con el contenido del mensaje.
+     * @brief Slot llamado al recibir un mensaje por un canal de ChatHub.
+     * @param ch Canal por el que llega.
+     * @param obj Mensaje recibido.
      */
-    void onTextMessageReceived(const QString &rawMessage);
+    void onChatMessage(const QString &ch, const QJsonObject &obj);
 
 private:
     /**
@@ -75,24 +80,30 @@ private:
      */
     void setupUI(const QString &userKey);
 
-    /**
-     * @brief Establece la conexión WebSocket con el servidor.
-     * @param userKey Clave del usuario para autenticación.
-     */
-    void setupWebSocketConnection(const QString &userKey);
-
     /**
      * @brief Carga mensajes anteriores entre el usuario y el amigo.
      * @param userKey Clave del usuario.
      */
     void loadMessages(const QString &userKey);
 
+    /**
+     * @brief Muestra la copia local de la conversación.
+     * @param stored Mensajes guardados en orden cronológico.
+     */
+    void showStoredMessages(const QList<ChatMessage> &stored);
+
     /**
      * @brief Envía el mensaje introducido por el usuario.
      * @param userKey Clave del usuario.
      */
     void sendMessage(const QString &userKey);
 
+    /**
+     * @brief Reenvía un mensaje no entregado.
+     * @param index Fila del mensaje en el modelo.
+     */
+    void retryMessage(const QModelIndex &index);
+
     /**
      * @brief Añade un mensaje a la lista mostrada en la UI.
      * @param senderId ID del remitente.
@@ -101,31 +112,30 @@ private:
     void appendMessage(const QString &senderId, const QString &content);
 
     /**
-     * @brief Recupera el token de autenticación desde almacenamiento local.
-     * @param userKey Clave del usuario.
-     * @return Token de autenticación.
+     * @brief Marca un mensaje como mostrado.
+     * @param message Mensaje recibido o guardado.
+     * @return false si ya se había mostrado.
      */
-    QString loadAuthToken(const QString &userKey);
+    bool markShown(const ChatMessage &message);
 
-    /**
-     * @brief Recupera el identificador del usuario desde almacenamiento local.
-     * @param userKey Clave del usuario.
-     * @return ID del usuario.
-     */
-    QString loadOwnId(const QString &userKey);
+    /** @brief Mensajes recientes que se recuerdan para descartar duplicados. */
+    static constexpr int kShownIdsCapacity = 512;
 
     // --- Componentes de red ---
-    QWebSocket               *webSocket;        ///< Cliente WebSocket para mensajes en tiempo real.
     QNetworkAccessManager    *networkManager;   ///< Gestor de peticiones HTTP.
+    QString                   channel;          ///< Canal de la conversación en ChatHub.
+    bool                      attached = false; ///< true mientras la ventana está registrada en ChatHub.
 
     // --- Interfaz de usuario ---
     QVBoxLayout  *mainLayout;           ///< Diseño vertical principal.
     QLabel       *titleLabel;           ///< Etiqueta con el nombre del amigo.
     QPushButton  *closeButton;          ///< Botón para cerrar la ventana.
-    QListWidget  *messagesListWidget;   ///< Lista de mensajes mostrados.
+    QListView    *messagesView;         ///< Vista de los mensajes mostrados.
+    ChatModel    *messagesModel;        ///< Mensajes de la conversación.
     QLineEdit    *messageInput;         ///< Campo de texto para escribir mensajes.
     QPushButton  *sendButton;           ///< Botón para enviar mensajes.
-    QSet<QString> m_shownKeys;          ///< Conjunto de claves de mensajes ya mostrados (evita duplicados).
+    RecentIds     shownIds{kShownIdsCapacity}; ///< Últimos mensajes mostrados (evita duplicados).
+    ChatOutbox   *outbox;               ///< Cola de envío con confirmación del servidor.
     QDateTime     wsIgnoreUntil;        ///< Tiempo hasta el cual se ignoran mensajes WebSocket (por reconexión).
 
     // --- Datos del chat ---
@@ -133,6 +143,7 @@ private:
     QString usr;          ///< Nombre de usuario (posible alias).
     QString ownID;        ///< ID del usuario local.
     QString m_userKey;    ///< Clave del usuario para autenticación.
+    QString conversation; ///< Identificador de la conversación en ChatStore.
 };
 
 #endif // FRIENDSMESSAGEWINDOW_H
@@ -13,6 +13,8 @@
 
 
 #include "friendswindow.h"
+#include "theme.h"
+#include "session.h"
 #include <QHBoxLayout>
 #include <QVBoxLayout>
 #include <QTabWidget>
@@ -29,14 +31,21 @@
 #include <QGraphicsDropShadowEffect>
 #include <QLabel>
 #include <QPushButton>
-#include <QListWidget>
+#include <QListView>
 #include <QLineEdit>
 #include <QDebug>
 #include <QPointer>
-#include <QPainter>
-#include <QPainterPath>
+#include <QTimer>
 #include "friendsmessagewindow.h"
 #include "userprofilewindow.h"
+#include "avatarservice.h"
+#include "userlistmodel.h"
+#include "friendcarddelegate.h"
+
+namespace {
+/// Pausa tras la última pulsación antes de consultar al servidor.
+constexpr int kSearchDebounceMs = 250;
+}
 
 /**
  * @brief Crea un diálogo modal personalizado con mensaje.
@@ -98,7 +107,7 @@ static QDialog* createDialog(QWidget *parent, const QString &message, bool exitA
 friendswindow::friendswindow(const QString &userKey, QWidget *parent) : QDialog(parent) {
     setWindowFlags(Qt::FramelessWindowHint | Qt::Dialog);
     setAttribute(Qt::WA_StyledBackground, true);
-    setStyleSheet("background-color: #171718; border-radius: 30px; padding: 20px;");
+    Theme::setRole(this, "panel");
     setFixedSize(900, 650);
 
     this->userKey = userKey;
@@ -125,16 +134,13 @@ void friendswindow::setupUI() {
     QHBoxLayout *headerLayout = new QHBoxLayout();
     titleLabel = new QLabel("Menú de Amigos", this);
     titleLabel->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-    titleLabel->setStyleSheet("color: white; font-size: 28px; font-weight: bold;");
+    Theme::setRole(titleLabel, "title");
 
     closeButton = new QPushButton(this);
     closeButton->setIcon(QIcon(":/icons/cross.png"));
     closeButton->setIconSize(QSize(22, 22));
     closeButton->setFixedSize(35, 35);
-    closeButton->setStyleSheet(
-        "QPushButton { background-color: #c2c2c3; border: none; border-radius: 17px; }"
-        "QPushButton:hover { background-color: #9b9b9b; }"
-        );
+    Theme::setRole(closeButton, "close");
     connect(closeButton, &QPushButton::clicked, this, &QDialog::close);
 
     headerLayout->addWidget(titleLabel);
@@ -177,12 +183,12 @@ QWidget* friendswindow::createFriendsTab() {
     QWidget *page = new QWidget();
     QVBoxLayout *layout = new QVBoxLayout(page);
 
-    friendsListWidget = new QListWidget(page);
-    friendsListWidget->setStyleSheet(
-        "QListWidget { background-color: #222; color: white; border-radius: 10px; padding: 8px; font-size: 18px; }"
+    friendsModel = new UserListModel(this);
+    friendsListView = createCardList(friendsModel, FriendCardDelegate::Friends, page);
+    friendsListView->setStyleSheet(
+        "QListView { background-color: #222; color: white; border-radius: 10px; padding: 8px; font-size: 18px; }"
         );
-    friendsListWidget->setSpacing(50);
-    layout->addWidget(friendsListWidget);
+    layout->addWidget(friendsListView);
     page->setLayout(layout);
     return page;
 }
@@ -196,12 +202,12 @@ QWidget* friendswindow::createRequestsTab() {
     QWidget *page = new QWidget();
     QVBoxLayout *layout = new QVBoxLayout(page);
 
-    requestsListWidget = new QListWidget(page);
-    requestsListWidget->setStyleSheet(
-        "QListWidget { background-color: #222; border-radius: 10px; padding: 8px; }"
+    requestsModel = new UserListModel(this);
+    requestsListView = createCardList(requestsModel, FriendCardDelegate::Requests, page);
+    requestsListView->setStyleSheet(
+        "QListView { background-color: #222; border-radius: 10px; padding: 8px; }"
         );
-    requestsListWidget->setSpacing(50);
-    layout->addWidget(requestsListWidget);
+    layout->addWidget(requestsListView);
     page->setLayout(layout);
     return page;
 }
@@ -223,16 +229,20 @@ QWidget* friendswindow::createSearchTab() {
         "QLineEdit:focus { border: 1px solid #888; }"
         );
     searchLineEdit->setMinimumHeight(45);
-    connect(searchLineEdit, &QLineEdit::textChanged, this, &friendswindow::searchUsers);
+    searchDebounce = new QTimer(this);
+    searchDebounce->setSingleShot(true);
+    searchDebounce->setInterval(kSearchDebounceMs);
+    connect(searchDebounce, &QTimer::timeout, this, &friendswindow::searchUsers);
+    connect(searchLineEdit, &QLineEdit::textChanged, this, &friendswindow::onSearchTextChanged);
     searchLayout->addWidget(searchLineEdit);
     layout->addLayout(searchLayout);
 
-    searchResultsListWidget = new QListWidget(page);
-    searchResultsListWidget->setStyleSheet(
-        "QListWidget { background-color: #222; border-radius: 10px; padding: 8px; }"
+    searchModel = new UserListModel(this);
+    searchResultsListView = createCardList(searchModel, FriendCardDelegate::Search, page);
+    searchResultsListView->setStyleSheet(
+        "QListView { background-color: #222; border-radius: 10px; padding: 8px; }"
         );
-    searchResultsListWidget->setSpacing(50);
-    layout->addWidget(searchResultsListWidget);
+    layout->addWidget(searchResultsListView);
     layout->setContentsMargins(20, 0, 20, 12);
     page->setLayout(layout);
 
@@ -244,43 +254,33 @@ QWidget* friendswindow::createSearchTab() {
 
 
 /**
- * @brief Obtiene el token de autenticación desde el archivo de configuración.
- * @return Token como QString, o cadena vacía si falla.
+ * @brief Crea una vista de tarjetas: las filas las pinta FriendCardDelegate y solo existen mientras se ven.
+ * @param model Modelo de la lista.
+ * @param mode Tipo de tarjetas (FriendCardDelegate::Mode).
+ * @param parent Página de la pestaña.
+ * @return Vista configurada.
  */
 
-QString friendswindow::loadAuthToken() {
-
-    qDebug() << "VALOR DE userKey EN loadAuthToken: " << userKey;
-
-    QString configPath = QStandardPaths::writableLocation(QStandardPaths::ConfigLocation)
-    + QString("/Grace Hopper/Sota, Caballo y Rey_%1.conf").arg(userKey);
-
-    QFile configFile(configPath);
-    if (!configFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        createDialog(this, "No se pudo cargar el archivo de configuración. usrKey = " + userKey)->show();
-        return "";
-    }
-    QString token;
-    while (!configFile.atEnd()) {
-        QString line = configFile.readLine().trimmed();
-        if (line.startsWith("token=")) {
-            token = line.mid(QString("token=").length()).trimmed();
-            break;
-        }
-    }
-    configFile.close();
-    if (token.isEmpty()) {
-        createDialog(this, "No se encontró el token en el archivo de configuración.")->show();
-    }
-    return token;
+QListView* friendswindow::createCardList(UserListModel *model, int mode, QWidget *parent) {
+    QListView *view = new QListView(parent);
+    view->setModel(model);
+    auto *delegate = new FriendCardDelegate(static_cast<FriendCardDelegate::Mode>(mode), view);
+    view->setItemDelegate(delegate);
+    view->setSelectionMode(QAbstractItemView::NoSelection);
+    view->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    view->setUniformItemSizes(true);
+    view->setMouseTracking(true);
+    connect(delegate, &FriendCardDelegate::actionTriggered, this, &friendswindow::onCardAction);
+    return view;
 }
 
+
 /**
  * @brief Descarga la lista de amigos desde el servidor y la muestra.
  */
 
 void friendswindow::fetchFriends() {
-    QString token = loadAuthToken();
+    QString token = Session::forUser(userKey).token();
     if (token.isEmpty()) return;
 
     QNetworkRequest request(QUrl("http://188.165.76.134:8000/usuarios/obtener_amigos/"));
@@ -298,16 +298,10 @@ void friendswindow::fetchFriends() {
         if (doc.isObject()) {
             QJsonObject obj = doc.object();
             if (obj.contains("amigos")) {
-                friendsListWidget->clear();
-                QJsonArray amigos = obj["amigos"].toArray();
-                for (const QJsonValue &value : amigos) {
-                    QJsonObject amigo = value.toObject();
-                    QWidget *friendCard = createFriendWidget(amigo);
-                    QListWidgetItem *item = new QListWidgetItem(friendsListWidget);
-                    item->setSizeHint(friendCard->sizeHint());
-                    friendsListWidget->addItem(item);
-                    friendsListWidget->setItemWidget(item, friendCard);
-                }
+                QList<QJsonObject> amigos;
+                for (const QJsonValue &value : obj["amigos"].toArray())
+                    amigos.append(value.toObject());
+                friendsModel->setItems(amigos);
             }
         }
         reply->deleteLater();
@@ -315,219 +309,125 @@ void friendswindow::fetchFriends() {
 }
 
 /**
- * @brief Crea el widget de tarjeta de un amigo.
- * @param amigo Objeto JSON con datos del amigo.
- * @return Puntero al QWidget que representa la tarjeta.
+ * @brief Atiende los botones pintados en las tarjetas de las tres pestañas.
+ * @param action Acción del botón.
+ * @param index Fila de la tarjeta.
  */
 
-QWidget* friendswindow::createFriendWidget(const QJsonObject &amigo) {
-    QWidget *widget = new QWidget();
-    widget->setMinimumSize(300, 130);  // Tamaño mínimo fijo
-    widget->setStyleSheet("border-radius: 10px;");
+void friendswindow::onCardAction(const QString &action, const QModelIndex &index) {
+    const QString id = index.data(UserListModel::KeyRole).toString();
+    const QString nombre = index.data(Qt::DisplayRole).toString();
 
-    QHBoxLayout *layout = new QHBoxLayout(widget);
-    layout->setContentsMargins(10, 2, 10, 2);
-    layout->setSpacing(15);
+    if (action == "perfil") {
+        UserProfileWindow *profileWin = new UserProfileWindow(this, userKey, id);
+        profileWin->setWindowModality(Qt::ApplicationModal);
+        profileWin->move(this->geometry().center() - profileWin->rect().center());
+        profileWin->show();
+    } else if (action == "mensajes") {
+        openChat(id, nombre);
+    } else if (action == "eliminar") {
+        confirmRemoveFriend(id);
+    } else if (action == "aceptar") {
+        acceptRequest(id);
+    } else if (action == "rechazar") {
+        rejectRequest(id);
+    } else if (action == "agregar") {
+        sendFriendRequest(id);
+    }
+}
 
-    // Layout para la foto de perfil y el nombre
-    QHBoxLayout *leftLayout = new QHBoxLayout();
-    leftLayout->setSpacing(5);  // Reducir el espacio entre la foto y el nombre
+/**
+ * @brief Abre el chat con un amigo; cada chat se crea una sola vez y se reutiliza.
+ * @param friendId ID del amigo.
+ * @param nombre Nombre del amigo.
+ */
 
-    // Icon placeholder
-    int pfpSize = 100;
-    QString avatarUrl = amigo["imagen"].toString();  // Obtener la URL de la imagen
-    Icon *avatarIcon = new Icon(this);
-    avatarIcon->setHoverEnabled(false);
+void friendswindow::openChat(const QString &friendId, const QString &nombre) {
+    static QMap<QString, FriendsMessageWindow*> openChats;
 
-    // Descargar la imagen de perfil y asignarla al Icon
-    if (!avatarUrl.isEmpty()) {
-        downloadAndSetAvatar(avatarUrl, avatarIcon);
+    FriendsMessageWindow *w;
+    if (!openChats.contains(friendId)) {
+        w = new FriendsMessageWindow(userKey, friendId, nombre, this);
+        openChats.insert(friendId, w);
     } else {
-        // Si no se proporciona imagen, usar una imagen predeterminada
-        QString imagePath = ":/icons/profile.png";
-        QPixmap circularImage = createCircularImage(imagePath, pfpSize);
-        avatarIcon->setPixmapImg(circularImage, pfpSize, pfpSize);
+        w = openChats.value(friendId);
     }
+    w->show();    // si estaba oculta, la muestra
+    w->raise();   // y la pone encima
+}
+
+/**
+ * @brief Muestra el diálogo de confirmación para eliminar a un amigo.
+ * @param friendId ID del amigo.
+ */
 
-    leftLayout->addWidget(avatarIcon);
-    leftLayout->addSpacing(5);  // Reducir la distancia entre la imagen y el nombre
-
-    // Información del amigo
-    QVBoxLayout *infoLayout = new QVBoxLayout();
-    QString nombre = "Nombre no disponible";
-    if (amigo.contains("nombre"))
-        nombre = amigo["nombre"].toString();
-    else if (amigo.contains("Nombre"))
-        nombre = amigo["Nombre"].toString();
-    else if (amigo.contains("username"))
-        nombre = amigo["username"].toString();
-    qDebug() << "El nombre del usuario es" << nombre;
-    QLabel *nameLabel = new QLabel(nombre, widget);
-    nameLabel->setWordWrap(true);  // Permite el ajuste de texto en varias líneas
-    nameLabel->setStyleSheet("color: white; font-size: 18px; font-weight: bold;");
-    infoLayout->addWidget(nameLabel);
-
-    int wins = amigo.contains("victorias") ? amigo["victorias"].toInt() : 0;
-    int losses = amigo.contains("derrotas") ? amigo["derrotas"].toInt() : 0;
-    double ratio = (wins + losses > 0) ? (wins * 100.0 / (wins + losses)) : 0.0;
-    QLabel *statsLabel = new QLabel(
-        QString("Victorias: %1   Derrotas: %2   Ratio: %3%")
-            .arg(wins).arg(losses).arg(ratio, 0, 'f', 2),
-        widget
+void friendswindow::confirmRemoveFriend(const QString &friendId) {
+    QDialog *confirmDialog = new QDialog(this);
+    confirmDialog->setWindowFlags(Qt::FramelessWindowHint | Qt::Dialog);
+    confirmDialog->setModal(true);
+    confirmDialog->setStyleSheet(
+        "QDialog {"
+        "  background-color: #171718;"
+        "  border-radius: 5px;"
+        "  padding: 20px;"
+        "}"
         );
-    statsLabel->setStyleSheet("color: white; font-size: 16px;");
-    infoLayout->addWidget(statsLabel);
-
-    leftLayout->addLayout(infoLayout);
-    layout->addLayout(leftLayout);
-    layout->addStretch();
-
-    QString friendId;
-    if (amigo.contains("id"))
-        friendId = QString::number(amigo["id"].toInt());
-    else if (amigo.contains("ID"))
-        friendId = QString::number(amigo["ID"].toInt());
-
-    // Botones en horizontal con más separación
-    QHBoxLayout *buttonLayout = new QHBoxLayout();
-    buttonLayout->setSpacing(10);  // Más espacio entre botones
-    buttonLayout->setContentsMargins(10, 5, 10, 5);  // Ajustar márgenes de los botones
-
-    // Botones más pequeños
-    QPushButton *profileButton = new QPushButton("Perfil", widget);
-    QPushButton *messageButton = new QPushButton("Mensajes", widget);
-    QPushButton *deleteButton = new QPushButton("Eliminar", widget);
-
-    // Establecer tamaño más pequeño de los botones
-    profileButton->setFixedSize(70, 30);
-    messageButton->setFixedSize(70, 30);
-    deleteButton->setFixedSize(70, 30);
-
-    // Estilos para los botones pequeños
-    QString buttonStyle =
+
+    QGraphicsDropShadowEffect *dialogShadow = new QGraphicsDropShadowEffect(confirmDialog);
+    dialogShadow->setBlurRadius(10);
+    dialogShadow->setColor(QColor(0, 0, 0, 80));
+    dialogShadow->setOffset(4, 4);
+    confirmDialog->setGraphicsEffect(dialogShadow);
+
+    QVBoxLayout *dialogLayout = new QVBoxLayout(confirmDialog);
+    QLabel *confirmLabel = new QLabel("¿Está seguro que desea eliminar a este amigo?", confirmDialog);
+    confirmLabel->setWordWrap(true);
+    confirmLabel->setStyleSheet("color: white; font-size: 16px;");
+    confirmLabel->setAlignment(Qt::AlignCenter);
+    dialogLayout->addWidget(confirmLabel);
+
+    QHBoxLayout *dialogButtonLayout = new QHBoxLayout();
+    QPushButton *yesButton = new QPushButton("Sí", confirmDialog);
+    QPushButton *noButton = new QPushButton("No", confirmDialog);
+    yesButton->setStyleSheet(
         "QPushButton {"
         "  background-color: #1D4536;"
         "  color: #F9F9F4;"
-        "  font-size: 14px;"
-        "  padding: 5px 10px;"
+        "  padding: 10px 25px;"
         "  border-radius: 10px;"
-        "  min-width: 70px;"
         "}"
-        "QPushButton:hover { background-color: #2A5C45; }";
-
-    QString deleteButtonStyle =
+        );
+    noButton->setStyleSheet(
         "QPushButton {"
         "  background-color: #8B3A3A;"
         "  color: #F1F1F1;"
-        "  font-size: 14px;"
-        "  padding: 5px 10px;"
+        "  padding: 10px 25px;"
         "  border-radius: 10px;"
-        "  min-width: 70px;"
         "}"
-        "QPushButton:hover { background-color: #C9B170; color: #1C1C1C; }";
-
-    profileButton->setStyleSheet(buttonStyle);
-    messageButton->setStyleSheet(buttonStyle);
-    deleteButton->setStyleSheet(deleteButtonStyle);
-
-    buttonLayout->addWidget(profileButton);
-    buttonLayout->addWidget(messageButton);
-    buttonLayout->addWidget(deleteButton);
-
-    layout->addLayout(buttonLayout);
-
-    // Conexiones para los botones
-    connect(profileButton, &QPushButton::clicked, [this, friendId]() {
-        UserProfileWindow *profileWin = new UserProfileWindow(this, userKey, friendId);
-        profileWin->setWindowModality(Qt::ApplicationModal);
-        profileWin->move(this->geometry().center() - profileWin->rect().center());
-        profileWin->show();
-    });
-
-    static QMap<QString, FriendsMessageWindow*> openChats;
-
-    connect(messageButton, &QPushButton::clicked, [this, friendId, nombre]() {
-        FriendsMessageWindow *w;
-        if (!openChats.contains(friendId)) {
-            w = new FriendsMessageWindow(userKey, friendId, nombre, this);
-            openChats.insert(friendId, w);
-        } else {
-            w = openChats.value(friendId);
-        }
-        w->show();    // si estaba oculta, la muestra
-        w->raise();   // y la pone encima
-    });
+        );
+    dialogButtonLayout->addWidget(yesButton);
+    dialogButtonLayout->addWidget(noButton);
+    dialogLayout->addLayout(dialogButtonLayout);
 
-    connect(deleteButton, &QPushButton::clicked, [this, friendId]() {
-        QDialog *confirmDialog = new QDialog(this);
-        confirmDialog->setWindowFlags(Qt::FramelessWindowHint | Qt::Dialog);
-        confirmDialog->setModal(true);
-        confirmDialog->setStyleSheet(
-            "QDialog {"
-            "  background-color: #171718;"
-            "  border-radius: 5px;"
-            "  padding: 20px;"
-            "}"
-            );
-
-        QGraphicsDropShadowEffect *dialogShadow = new QGraphicsDropShadowEffect(confirmDialog);
-        dialogShadow->setBlurRadius(10);
-        dialogShadow->setColor(QColor(0, 0, 0, 80));
-        dialogShadow->setOffset(4, 4);
-        confirmDialog->setGraphicsEffect(dialogShadow);
-
-        QVBoxLayout *dialogLayout = new QVBoxLayout(confirmDialog);
-        QLabel *confirmLabel = new QLabel("¿Está seguro que desea eliminar a este amigo?", confirmDialog);
-        confirmLabel->setWordWrap(true);
-        confirmLabel->setStyleSheet("color: white; font-size: 16px;");
-        confirmLabel->setAlignment(Qt::AlignCenter);
-        dialogLayout->addWidget(confirmLabel);
-
-        QHBoxLayout *dialogButtonLayout = new QHBoxLayout();
-        QPushButton *yesButton = new QPushButton("Sí", confirmDialog);
-        QPushButton *noButton = new QPushButton("No", confirmDialog);
-        yesButton->setStyleSheet(
-            "QPushButton {"
-            "  background-color: #1D4536;"
-            "  color: #F9F9F4;"
-            "  padding: 10px 25px;"
-            "  border-radius: 10px;"
-            "}"
-            );
-        noButton->setStyleSheet(
-            "QPushButton {"
-            "  background-color: #8B3A3A;"
-            "  color: #F1F1F1;"
-            "  padding: 10px 25px;"
-            "  border-radius: 10px;"
-            "}"
-            );
-        dialogButtonLayout->addWidget(yesButton);
-        dialogButtonLayout->addWidget(noButton);
-        dialogLayout->addLayout(dialogButtonLayout);
-
-        connect(yesButton, &QPushButton::clicked, [this, confirmDialog, friendId]() {
-            removeFriend(friendId);
-            confirmDialog->close();
-        });
-        connect(noButton, &QPushButton::clicked, confirmDialog, &QDialog::close);
-
-        confirmDialog->adjustSize();
-        confirmDialog->move(this->geometry().center() - confirmDialog->rect().center());
-        confirmDialog->show();
+    connect(yesButton, &QPushButton::clicked, [this, confirmDialog, friendId]() {
+        removeFriend(friendId);
+        confirmDialog->close();
     });
+    connect(noButton, &QPushButton::clicked, confirmDialog, &QDialog::close);
 
-    widget->setLayout(layout);
-    return widget;
+    confirmDialog->adjustSize();
+    confirmDialog->move(this->geometry().center() - confirmDialog->rect().center());
+    confirmDialog->show();
 }
 
+
 /**
  * @brief Envía petición para eliminar a un amigo.
  * @param friendId ID del amigo a eliminar.
  */
 
 void friendswindow::removeFriend(const QString &friendId) {
-    QString token = loadAuthToken();
+    QString token = Session::forUser(userKey).token();
     if (token.isEmpty()) {
         qDebug() << "removeFriend: token vacío.";
         return;
@@ -564,7 +464,7 @@ void friendswindow::removeFriend(const QString &friendId) {
  */
 
 void friendswindow::fetchRequests() {
-    QString token = loadAuthToken();
+    QString token = Session::forUser(userKey).token();
     if (token.isEmpty()) return;
 
     QNetworkRequest request(QUrl("http://188.165.76.134:8000/usuarios/listar_solicitudes_amistad/"));
@@ -583,16 +483,11 @@ void friendswindow::fetchRequests() {
         if (doc.isObject()) {
             QJsonObject obj = doc.object();
             if (obj.contains("solicitudes")) {
-                requestsListWidget->clear();
                 QJsonArray solicitudes = obj["solicitudes"].toArray();
-                for (const QJsonValue &value : solicitudes) {
-                    QJsonObject solicitud = value.toObject();
-                    QListWidgetItem *item = new QListWidgetItem(requestsListWidget);
-                    QWidget *widget = createRequestWidget(solicitud);
-                    item->setSizeHint(widget->sizeHint());
-                    requestsListWidget->addItem(item);
-                    requestsListWidget->setItemWidget(item, widget);
-                }
+                QList<QJsonObject> items;
+                for (const QJsonValue &value : solicitudes)
+                    items.append(value.toObject());
+                requestsModel->setItems(items);
                 int solicitudesCount = solicitudes.size();
                 emit friendRequestsCountChanged(solicitudesCount);
             }
@@ -601,26 +496,47 @@ void friendswindow::fetchRequests() {
     });
 }
 
+/**
+ * @brief Cada pulsación cancela la búsqueda en curso; si la caché la resuelve
+ * se muestra al momento y, si no, se espera a que el usuario deje de escribir.
+ */
+
+void friendswindow::onSearchTextChanged() {
+    if (searchReply)
+        searchReply->abort();
+
+    QString searchText = searchLineEdit->text().trimmed();
+    QList<QJsonObject> cached;
+    if (searchCache.lookup(searchText, &cached)) {
+        searchDebounce->stop();
+        currentSearchQuery = searchText;
+        searchModel->setItems(cached);
+        return;
+    }
+    searchDebounce->start();
+}
+
 /**
  * @brief Realiza búsqueda de usuarios según el texto ingresado.
  * Dispara REST y actualiza la lista de resultados.
  */
 
 void friendswindow::searchUsers() {
-    qDebug() << "VALOR DE USERKEY EN searchUsers:" << userKey;
     QString searchText = searchLineEdit->text().trimmed();
     qDebug() << "searchUsers triggered with text:" << searchText;
     currentSearchQuery = searchText;
 
-    // Se elimina el siguiente bloque para que, aun cuando searchText esté vacío, se realice la búsqueda:
-    // if (searchText.isEmpty()) {
-    //     searchResultsListWidget->clear();
-    //     return;
-    // }
-
-    searchResultsListWidget->clear();
+    // Aun cuando searchText esté vacío se realiza la búsqueda (lista completa).
+    // Los resultados anteriores se mantienen hasta que llega la respuesta y se aplica el diff.
+    QList<QJsonObject> cached;
+    if (searchCache.lookup(searchText, &cached)) {
+        searchModel->setItems(cached);
+        return;
+    }
+    if (searchReply)
+        searchReply->abort();
 
-    QString token = loadAuthToken();
+    QString token = Session::forUser(userKey).token();
     if (token.isEmpty()) return;
 
     QUrl url("http://188.165.76.134:8000/usuarios/buscar_usuarios/");
@@ -634,7 +550,12 @@ void friendswindow::searchUsers() {
     QNetworkRequest request(url);
     request.setRawHeader("Auth", token.toUtf8());
     QNetworkReply *reply = networkManager->get(request);
+    searchReply = reply;
     connect(reply, &QNetworkReply::finished, [this, reply, queryText = searchText]() {
+        if (reply->error() == QNetworkReply::OperationCanceledError) {
+            reply->deleteLater();
+            return;
+        }
         int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
         if (statusCode == 401) {
             createDialog(this, "Su sesión ha caducado, por favor, vuelva a iniciar sesión.", true)->show();
@@ -645,271 +566,33 @@ void friendswindow::searchUsers() {
             reply->deleteLater();
             return;
         }
-        searchResultsListWidget->clear();
         QByteArray response = reply->readAll();
-        qDebug() << "searchUsers response:" << response;
         QJsonDocument doc = QJsonDocument::fromJson(response);
         if (doc.isObject()) {
             QJsonObject obj = doc.object();
             if (obj.contains("usuarios")) {
-                QJsonArray usuarios = obj["usuarios"].toArray();
-                for (const QJsonValue &value : usuarios) {
-                    QJsonObject usuario = value.toObject();
-                    qDebug() << "Usuario recibido:" << usuario;
-                    QWidget *widget = createSearchResultWidget(usuario);
-                    QListWidgetItem *item = new QListWidgetItem(searchResultsListWidget);
-                    item->setSizeHint(widget->sizeHint());
-                    searchResultsListWidget->addItem(item);
-                    searchResultsListWidget->setItemWidget(item, widget);
-                }
-            }
-        }
-        reply->deleteLater();
-    });
-}
-
-/**
- * @brief Crea el widget de resultado de búsqueda de usuario.
- * @param usuario Objeto JSON con datos del usuario.
- * @return Puntero al QWidget de resultado.
- */
-
-QWidget* friendswindow::createSearchResultWidget(const QJsonObject &usuario) {
-    QWidget *widget = new QWidget();
-    widget->setMinimumSize(300, 130);
-    widget->setStyleSheet("background-color: #2a2a2a; border: 1px solid #444; border-radius: 10px;");
-
-    QHBoxLayout *layout = new QHBoxLayout(widget);
-    layout->setContentsMargins(10, 10, 10, 10);
-    layout->setSpacing(15);
-
-    // Icon placeholder
-    int pfpSize = 100;
-    QString imagePath = ":/icons/profile.png";
-    QPixmap circularImage = createCircularImage(imagePath, pfpSize);
-
-    Icon *avatarIcon = new Icon(this);
-    avatarIcon->setHoverEnabled(false);
-    avatarIcon->setPixmapImg(circularImage, pfpSize, pfpSize);
-    layout->addWidget(avatarIcon);
-
-    // Información del usuario
-    QVBoxLayout *infoLayout = new QVBoxLayout();
-    infoLayout->setContentsMargins(5, 5, 5, 5);
-
-    QString nombre;
-    if (usuario.contains("nombre"))
-        nombre = usuario["nombre"].toString();
-    else if (usuario.contains("Nombre"))
-        nombre = usuario["Nombre"].toString();
-    else if (usuario.contains("username"))
-        nombre = usuario["username"].toString();
-    else
-        nombre = "Nombre no disponible";
-
-    QLabel *nameLabel = new QLabel(nombre, widget);
-    nameLabel->setStyleSheet("color: white; font-size: 20px; font-weight: bold; padding-top: 5px; padding-bottom: 5px;");
-    infoLayout->addWidget(nameLabel);
-
-    int wins = usuario.contains("victorias") ? usuario["victorias"].toInt() : 0;
-    int losses = usuario.contains("derrotas") ? usuario["derrotas"].toInt() : 0;
-    double ratio = (wins + losses > 0) ? (wins * 100.0 / (wins + losses)) : 0.0;
-    QLabel *statsLabel = new QLabel(
-        QString("Victorias: %1   Derrotas: %2   Ratio: %3%")
-            .arg(wins).arg(losses).arg(ratio, 0, 'f', 2),
-        widget
-        );
-    statsLabel->setStyleSheet("color: white; font-size: 18px; padding-top: 5px; padding-bottom: 5px;");
-    infoLayout->addWidget(statsLabel);
-
-    layout->addLayout(infoLayout);
-    layout->addStretch();
-
-    // Botón para agregar amigo
-    QPushButton *addButton = new QPushButton("Agregar amigo", widget);
-    addButton->setStyleSheet("background-color: #1D4536; color: #F9F9F4; font-size: 18px; padding: 10px; border-radius: 10px;");
-    QString userId;
-    if (usuario.contains("id"))
-        userId = QString::number(usuario["id"].toInt());
-    else if (usuario.contains("ID"))
-        userId = QString::number(usuario["ID"].toInt());
-    else
-        userId = "";
-    addButton->setProperty("userId", userId);
-    connect(addButton, &QPushButton::clicked, this, [=]() {
-        this->sendFriendRequest();
-    });
-    layout->addWidget(addButton);
-
-    // Descargar la imagen de avatar y asignarla al Icon
-    QString avatarUrl = usuario.contains("imagen") ? usuario["imagen"].toString() : "";
-    if (!avatarUrl.isEmpty()) {
-        downloadAndSetAvatar(avatarUrl, avatarIcon);
-    }
-
-    return widget;
-}
-
-/**
- * @brief Descarga una imagen y la asigna recortada como avatar circular.
- * @param imageUrl URL de la imagen.
- * @param avatarIcon Puntero al Icon donde mostrarla.
- */
-void friendswindow::downloadAndSetAvatar(const QString &imageUrl, Icon *avatarIcon) {
-    if (!avatarIcon) {
-        qDebug() << "imagen perfil: avatarIcon es nullptr.";
-        return;
-    }
-    if (imageUrl.isEmpty() || !QUrl(imageUrl).isValid()) {
-        qDebug() << "imagen perfil: la URL de la imagen es inválida o está vacía:" << imageUrl;
-        return;
-    }
-    QNetworkAccessManager *manager = new QNetworkAccessManager(this);
-    QNetworkRequest request{QUrl(imageUrl)};
-    QNetworkReply *reply = manager->get(request);
-    QPointer<friendswindow> weakSelf = this;
-    QPointer<Icon> weakAvatarIcon = avatarIcon;
-    connect(reply, &QNetworkReply::finished, this, [weakSelf, weakAvatarIcon, reply, imageUrl]() {
-        if (!weakSelf || !weakAvatarIcon) {
-            qDebug() << "imagen perfil: error destrucción anticipada.";
-            if (reply) reply->deleteLater();
-            return;
-        }
-        if (reply->error() == QNetworkReply::NoError) {
-            QByteArray imgData = reply->readAll();
-            QPixmap pixmap;
-            if (pixmap.loadFromData(imgData)) {
-                int size = 100;
-                QPixmap circular = weakSelf->createCircularImage(pixmap, size);
-                if (weakAvatarIcon) weakAvatarIcon->setPixmapImg(circular, size, size);
-            } else {
-                qDebug() << "Error al cargar la imagen desde QByteArray para" << imageUrl;
+                QList<QJsonObject> usuarios;
+                for (const QJsonValue &value : obj["usuarios"].toArray())
+                    usuarios.append(value.toObject());
+                searchCache.insert(queryText, usuarios);
+                searchModel->setItems(usuarios);
             }
-        } else {
-            qDebug() << "Error al descargar la imagen" << imageUrl << ":" << reply->errorString();
         }
         reply->deleteLater();
     });
 }
 
-/**
- * @brief Convierte un QPixmap en una versión circular de tamaño dado.
- * @param src QPixmap de origen.
- * @param size Dimensión del lado del círculo.
- * @return QPixmap circular resultante.
- */
-
-QPixmap friendswindow::createCircularImage(const QPixmap &src, int size) {
-    // Escalamos a un cuadrado de “size × size” y recortamos el exceso
-    QPixmap scaled = src.scaled(size, size,
-                                Qt::KeepAspectRatioByExpanding,
-                                Qt::SmoothTransformation);
-    QPixmap circular(size, size);
-    circular.fill(Qt::transparent);
-
-    QPainter painter(&circular);
-    painter.setRenderHint(QPainter::Antialiasing);
-    QPainterPath path;
-    path.addEllipse(0, 0, size, size);
-    painter.setClipPath(path);
-    painter.drawPixmap(0, 0, size, size, scaled);
-
-    return circular;
-}
-
-/**
- * @brief Crea el widget de una solicitud de amistad.
- * @param solicitud Objeto JSON con datos de la solicitud.
- * @return Puntero al QWidget de la solicitud.
- */
-
-QWidget* friendswindow::createRequestWidget(const QJsonObject &solicitud) {
-    QWidget *widget = new QWidget();
-    widget->setMinimumSize(300, 130);
-    widget->setStyleSheet("border-radius: 10px;");
-
-    QHBoxLayout *layout = new QHBoxLayout(widget);
-    layout->setContentsMargins(10, 2, 10, 2);
-    layout->setSpacing(7);
-
-    // Layout para la foto de perfil y el nombre
-    QHBoxLayout *leftLayout = new QHBoxLayout();
-
-    // Icon placeholder
-    int pfpSize = 100;
-    QString avatarUrl = solicitud["imagen"].toString();  // Obtener la URL de la imagen
-    Icon *avatarIcon = new Icon(this);
-    avatarIcon->setHoverEnabled(false);
-
-    // Descargar la imagen de perfil y asignarla al Icon
-    if (!avatarUrl.isEmpty()) {
-        downloadAndSetAvatar(avatarUrl, avatarIcon);
-    } else {
-        // Si no se proporciona imagen, usar una imagen predeterminada
-        QString imagePath = ":/icons/profile.png";
-        QPixmap circularImage = createCircularImage(imagePath, pfpSize);
-        avatarIcon->setPixmapImg(circularImage, pfpSize, pfpSize);
-    }
-
-    leftLayout->addWidget(avatarIcon);
-    leftLayout->addSpacing(10);  // Espacio entre la foto de perfil y el nombre
-
-    // Información del solicitante
-    QVBoxLayout *infoLayout = new QVBoxLayout();
-    QString nombre = solicitud["solicitante"].toString();
-    QLabel *nameLabel = new QLabel(nombre, widget);
-    nameLabel->setStyleSheet("color: white; font-size: 20px; font-weight: bold;");
-    infoLayout->addWidget(nameLabel);
-
-    leftLayout->addLayout(infoLayout);
-    layout->addLayout(leftLayout);
-    layout->addStretch();  // Espacio para el resto de los widgets
-
-    // Botón Aceptar
-    QPushButton *acceptBtn = new QPushButton("Aceptar", widget);
-    QString solicitudId = QString::number(solicitud["id"].toInt());
-    acceptBtn->setProperty("solicitudId", solicitudId);
-    acceptBtn->setStyleSheet(
-        "QPushButton { background-color: #1D4536; color: #F9F9F4; font-size: 18px; padding: 10px; border-radius: 10px; }"
-        "QPushButton:hover { background-color: #2A5C45; }"
-        );
-    connect(acceptBtn, &QPushButton::clicked, this, [=]() {
-        this->acceptRequest();
-    });
-    layout->addWidget(acceptBtn);
-
-    // Botón Rechazar
-    QPushButton *rejectBtn = new QPushButton("Rechazar", widget);
-    rejectBtn->setStyleSheet(
-        "QPushButton { background-color: #8B3A3A; color: #F1F1F1; font-size: 18px; padding: 10px; border-radius: 10px; }"
-        "QPushButton:hover { background-color: #C9B170; color: #1C1C1C; }"
-        );
-    rejectBtn->setProperty("solicitudId", solicitudId);
-    connect(rejectBtn, &QPushButton::clicked, this, [=]() {
-        this->rejectRequest();
-    });
-    layout->addWidget(rejectBtn);
-
-    widget->setLayout(layout);
-    return widget;
-}
-
 /**
  * @brief Envía una solicitud de amistad al usuario indicado.
+ * @param userId ID del destinatario.
  */
 
-void friendswindow::sendFriendRequest() {
-    QPushButton *button = qobject_cast<QPushButton*>(sender());
-    if (!button) {
-        qDebug() << "sendFriendRequest: El sender no es un QPushButton.";
-        return;
-    }
-    QString userId = button->property("userId").toString();
+void friendswindow::sendFriendRequest(const QString &userId) {
     if (userId.isEmpty()) {
         qDebug() << "sendFriendRequest: userId está vacío.";
         return;
     }
-    QString token = loadAuthToken();
+    QString token = Session::forUser(userKey).token();
     if (token.isEmpty()) {
         qDebug() << "sendFriendRequest: token vacío.";
         return;
@@ -925,13 +608,19 @@ void friendswindow::sendFriendRequest() {
     json["destinatario_id"] = userId;
     QJsonDocument doc(json);
     QNetworkReply *reply = networkManager->post(request, doc.toJson());
-    connect(reply, &QNetworkReply::finished, [this, reply, button, userId]() {
+    connect(reply, &QNetworkReply::finished, [this, reply, userId]() {
         if (reply->error() == QNetworkReply::NoError) {
             qDebug() << "Solicitud enviada correctamente para userId:" << userId;
-            // Actualizamos el botón para indicar que la solicitud fue enviada
-            button->setText("Solicitud Enviada");
-            button->setStyleSheet("background-color: #C2C7B0; color: #203F31; font-size: 18px; padding: 10px; border-radius: 10px;");
-            button->setEnabled(false);
+            // Las respuestas guardadas ya no reflejan la solicitud pendiente
+            searchCache.clear();
+            // La tarjeta pasa a mostrar el botón deshabilitado "Solicitud Enviada"
+            for (int row = 0; row < searchModel->rowCount(); ++row) {
+                QJsonObject usuario = searchModel->payload(row);
+                if (UserListModel::keyFor(usuario) != userId) continue;
+                usuario["solicitud_enviada"] = true;
+                searchModel->updateItem(userId, usuario);
+                break;
+            }
             createDialog(this, "Se ha enviado la solicitud de amistad.")->show();
         } else {
             qDebug() << "Error al enviar la solicitud para userId:" << userId << " Error:" << reply->errorString();
@@ -943,15 +632,13 @@ void friendswindow::sendFriendRequest() {
 
 
 /**
- * @brief Acepta la solicitud de amistad seleccionada.
+ * @brief Acepta una solicitud de amistad.
+ * @param solicitudId ID de la solicitud.
  */
 
-void friendswindow::acceptRequest() {
-    QObject *senderObj = sender();
-    if (!senderObj) return;
-    QString solicitudId = senderObj->property("solicitudId").toString();
+void friendswindow::acceptRequest(const QString &solicitudId) {
     if (solicitudId.isEmpty()) return;
-    QString token = loadAuthToken();
+    QString token = Session::forUser(userKey).token();
     if (token.isEmpty()) return;
 
     QUrl url("http://188.165.76.134:8000/usuarios/aceptar_solicitud_amistad/");
@@ -982,15 +669,13 @@ void friendswindow::acceptRequest() {
 }
 
 /**
- * @brief Rechaza la solicitud de amistad seleccionada.
+ * @brief Rechaza una solicitud de amistad.
+ * @param solicitudId ID de la solicitud.
  */
 
-void friendswindow::rejectRequest() {
-    QObject *senderObj = sender();
-    if (!senderObj) return;
-    QString solicitudId = senderObj->property("solicitudId").toString();
+void friendswindow::rejectRequest(const QString &solicitudId) {
     if (solicitudId.isEmpty()) return;
-    QString token = loadAuthToken();
+    QString token = Session::forUser(userKey).token();
     if(token.isEmpty()) return;
 
     QUrl url("http://188.165.76.134:8000/usuarios/denegar_solicitud_amistad/");
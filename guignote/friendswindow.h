@@ -16,14 +16,20 @@
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QTabWidget>
-#include <QListWidget>
+#include <QListView>
 #include <QLineEdit>
 #include <QPushButton>
 #include <QLabel>
 #include <QNetworkAccessManager>
 #include <QCloseEvent>
 #include <QJsonObject>
+#include <QPointer>
 #include "icon.h"
+#include "searchprefixcache.h"
+
+class UserListModel;
+class QNetworkReply;
+class QTimer;
 
 /**
  * @class friendswindow
@@ -63,19 +69,25 @@ private:
     QTabWidget *tabWidget;         ///< Pestañas principales.
 
     // --- Pestaña "Amigos" ---
-    QListWidget *friendsListWidget;    ///< Lista de amigos actuales.
+    QListView *friendsListView;        ///< Lista de amigos actuales.
+    UserListModel *friendsModel;       ///< Amigos mostrados.
 
     // --- Pestaña "Solicitudes" ---
-    QListWidget *requestsListWidget;   ///< Lista de solicitudes recibidas.
+    QListView *requestsListView;       ///< Lista de solicitudes recibidas.
+    UserListModel *requestsModel;      ///< Solicitudes mostradas.
     QPushButton *acceptButton;         ///< Botón para aceptar solicitud.
     QPushButton *rejectButton;         ///< Botón para rechazar solicitud.
 
     // --- Pestaña "Buscar" ---
     QLineEdit *searchLineEdit;         ///< Campo de texto para buscar usuarios.
     QPushButton *searchButton;         ///< Botón para iniciar la búsqueda.
-    QListWidget *searchResultsListWidget; ///< Resultados de búsqueda.
+    QListView *searchResultsListView;  ///< Resultados de búsqueda.
+    UserListModel *searchModel;        ///< Usuarios encontrados.
 
     QString currentSearchQuery;        ///< Consulta actual de búsqueda.
+    QTimer *searchDebounce;            ///< Espera a que el usuario deje de escribir.
+    QPointer<QNetworkReply> searchReply; ///< Búsqueda en curso (se aborta al escribir).
+    SearchPrefixCache searchCache;     ///< Respuestas recientes por consulta.
 
     QNetworkAccessManager *networkManager; ///< Gestor de peticiones HTTP.
 
@@ -105,35 +117,37 @@ private:
      */
     QWidget* createSearchTab();
 
-    // --- Métodos para crear widgets personalizados ---
+    // --- Listas con modelo y delegado ---
     /**
-     * @brief Crea un widget de resultado de búsqueda a partir de datos JSON.
-     * @param usuario Objeto JSON con información del usuario.
-     * @return Widget representando al usuario.
+     * @brief Crea una vista de tarjetas de usuario sobre un modelo.
+     * @param model Modelo de la lista.
+     * @param mode Tipo de tarjetas (FriendCardDelegate::Mode).
+     * @param parent Página de la pestaña.
+     * @return Vista configurada.
      */
-    QWidget* createSearchResultWidget(const QJsonObject &usuario);
+    QListView* createCardList(UserListModel *model, int mode, QWidget *parent);
 
     /**
-     * @brief Crea un widget para una solicitud de amistad.
-     * @param solicitud Objeto JSON con datos de la solicitud.
-     * @return Widget representando la solicitud.
+     * @brief Atiende la pulsación de un botón de una tarjeta.
+     * @param action Acción del botón.
+     * @param index Fila de la tarjeta.
      */
-    QWidget* createRequestWidget(const QJsonObject &solicitud);
+    void onCardAction(const QString &action, const QModelIndex &index);
 
     /**
-     * @brief Crea un widget para un amigo.
-     * @param amigo Objeto JSON con los datos del amigo.
-     * @return Widget representando al amigo.
+     * @brief Abre (o trae al frente) el chat con un amigo.
+     * @param friendId ID del amigo.
+     * @param nombre Nombre del amigo.
      */
-    QWidget* createFriendWidget(const QJsonObject &amigo);
+    void openChat(const QString &friendId, const QString &nombre);
 
-    // --- Métodos de conexión con el backend ---
     /**
-     * @brief Carga el token de autenticación desde almacenamiento local.
-     * @return Token del usuario.
+     * @brief Pide confirmación antes de eliminar a un amigo.
+     * @param friendId ID del amigo.
      */
-    QString loadAuthToken();
+    void confirmRemoveFriend(const QString &friendId);
 
+    // --- Métodos de conexión con el backend ---
     /** @brief Realiza una petición para obtener la lista de amigos. */
     void fetchFriends();
 
@@ -143,29 +157,26 @@ private:
     /** @brief Realiza una búsqueda de usuarios en el backend. */
     void searchUsers();
 
-    /** @brief Envía una solicitud de amistad. */
-    void sendFriendRequest();
+    /** @brief Reacciona a cada pulsación en el campo de búsqueda. */
+    void onSearchTextChanged();
 
-    /** @brief Acepta una solicitud de amistad. */
-    void acceptRequest();
-
-    /** @brief Rechaza una solicitud de amistad. */
-    void rejectRequest();
+    /**
+     * @brief Envía una solicitud de amistad.
+     * @param userId ID del destinatario.
+     */
+    void sendFriendRequest(const QString &userId);
 
     /**
-     * @brief Descarga y establece el avatar de un usuario.
-     * @param imageUrl URL de la imagen.
-     * @param avatarIcon Widget de tipo Icon donde se mostrará.
+     * @brief Acepta una solicitud de amistad.
+     * @param solicitudId ID de la solicitud.
      */
-    void downloadAndSetAvatar(const QString &imageUrl, Icon *avatarIcon);
+    void acceptRequest(const QString &solicitudId);
 
     /**
-     * @brief Crea una imagen circular a partir de un QPixmap.
-     * @param src Imagen original.
-     * @param size Tamaño del círculo.
-     * @return Imagen circular.
+     * @brief Rechaza una solicitud de amistad.
+     * @param solicitudId ID de la solicitud.
      */
-    QPixmap createCircularImage(const QPixmap &src, int size);
+    void rejectRequest(const QString &solicitudId);
 };
 
 #endif // FRIENDSWINDOW_H
@@ -6,12 +6,18 @@
  * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
  *
  * Contiene la definición de la ventana de chat de partida, que gestiona
- * la interfaz de mensajería, la conexión WebSocket/Socket TCP y el
- * almacenamiento de histórico de mensajes.
+ * la interfaz de mensajería, su canal en ChatHub, la carga paginada
+ * del historial y el almacenamiento de histórico de mensajes.
  */
 
 
 #include "gamemessagewindow.h"
+#include "theme.h"
+#include "session.h"
+#include "chathub.h"
+#include "chathistoryloader.h"
+#include "chatmodel.h"
+#include "chatbubbledelegate.h"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -21,6 +27,9 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QTimer>
+#include <QShowEvent>
+#include <QHideEvent>
+#include <QScrollBar>
 #include <QDebug>
 #include <qjsonarray.h>
 #include <QSettings>
@@ -38,104 +47,122 @@ QMap<QString, QList<QPair<QString,QString>>> GameMessageWindow::chatHistories;
  */
 
 GameMessageWindow::GameMessageWindow(const QString &userKey, QWidget *parent, const QString &gameID, const QString &userID)
-    : QWidget(parent), chatID(gameID), userID(userID)
+    : QWidget(parent), chatID(gameID), userID(userID), userKey(userKey),
+      channel(ChatHub::gameChannel(gameID))
 {
     // Ventana sin borde y estilo
     setWindowFlags(Qt::FramelessWindowHint | Qt::Dialog);
     setAttribute(Qt::WA_StyledBackground, true);
     setAttribute(Qt::WA_DeleteOnClose);
-    setStyleSheet("background-color: #171718; border-radius: 30px; padding: 20px;");
+    Theme::setRole(this, "panel");
     setFixedSize(600, 680);
 
     setupUI(userKey);
-    setupWebSocketConnection(userKey);
+
+    // La conexión la mantiene ChatHub; si ya estaba abierta no hay handshake
+    ChatHub &hub = ChatHub::forUser(userKey);
+    connect(&hub, &ChatHub::messageReceived, this, &GameMessageWindow::onChatMessage);
+    hub.open(channel);
 
     //  — Cargar historial previo si existiera —
-    networkManager = new QNetworkAccessManager(this);
     loadChatHistoryFromServer(userKey);
 }
 
 
 /**
- * @brief Descarga el historial de chat de la partida mediante socket TCP.
+ * @brief Descarga el historial de chat de la partida sin bloquear la interfaz.
  * @param userKey Clave del usuario para enviar en la petición.
+ *
+ * Se muestra primero la página más reciente; las anteriores se insertan
+ * encima al desplazarse hasta arriba de la lista.
  */
 
 void GameMessageWindow::loadChatHistoryFromServer(const QString &userKey) {
-    QString token = loadAuthToken(userKey);
+    QString token = Session::forUser(userKey).token();
     if (token.isEmpty()) {
         qDebug() << "GameMessageWindow: No se puede cargar historial, token vacío.";
         return;
     }
 
-    QTcpSocket *socket = new QTcpSocket(this);
-    socket->connectToHost("188.165.76.134", 8000);
-    if (!socket->waitForConnected(3000)) {
-        qDebug() << "GameMessageWindow: Error al conectar socket:" << socket->errorString();
-        socket->deleteLater();
-        return;
-    }
-
-    // Construimos la petición HTTP “a mano”
-    QString httpReq = QString(
-                          "GET /chat_partida/obtener/?chat_id=%1 HTTP/1.1\r\n"
-                          "Host: 188.165.76.134:8000\r\n"
-                          "Auth: %2\r\n"
-                          "Connection: close\r\n"
-                          "\r\n"
-                          ).arg(chatID, token.trimmed());
+    QNetworkRequest request(QUrl(QString("http://188.165.76.134:8000/chat_partida/obtener/?chat_id=%1").arg(chatID)));
+    request.setRawHeader("Auth", token.trimmed().toUtf8());
 
-    qDebug() << "[DDD] " << httpReq;
+    // El servidor devuelve los mensajes del más reciente al más antiguo
+    historyLoader = new ChatHistoryLoader(request, true, 30, this);
+    connect(historyLoader, &ChatHistoryLoader::pageReady, this, &GameMessageWindow::prependHistory);
+    connect(historyLoader, &ChatHistoryLoader::failed, this, [](int status, const QString &error) {
+        qDebug() << "GameMessageWindow: Error al cargar historial (" << status << "):" << error;
+    });
 
-    socket->write(httpReq.toUtf8());
-    if (!socket->waitForBytesWritten(3000)) {
-        qDebug() << "GameMessageWindow: Error al enviar petición:" << socket->errorString();
-    }
-    if (!socket->waitForReadyRead(5000)) {
-        qDebug() << "GameMessageWindow: Timeout esperando respuesta.";
-        socket->close();
-        socket->deleteLater();
-        return;
-    }
+    // Al llegar arriba del todo se pide la página anterior
+    connect(messagesView->verticalScrollBar(), &QScrollBar::valueChanged, this, [this](int value) {
+        if (value == messagesView->verticalScrollBar()->minimum() && historyLoader->hasMore())
+            historyLoader->fetchOlder();
+    });
 
-    QByteArray raw = socket->readAll();
-    socket->close();
-    socket->deleteLater();
+    historyLoader->start();
+}
 
-    // Separa cabeceras de cuerpo
-    int idx = raw.indexOf("\r\n\r\n");
-    if (idx < 0) {
-        qDebug() << "GameMessageWindow: Respuesta HTTP malformada.";
-        return;
-    }
-    QByteArray body = raw.mid(idx + 4);
+/**
+ * @brief Inserta una página del historial encima de los mensajes ya mostrados.
+ * @param messages Mensajes en orden cronológico.
+ * @param first true para la página más reciente (se baja al final de la lista).
+ */
 
-    // Parseamos JSON y mostramos como antes
-    QJsonDocument doc = QJsonDocument::fromJson(body);
-    if (!doc.isObject()) {
-        qDebug() << "Respuesta de historial no es JSON válido.";
-        qDebug() << "Raw response:" << QString(raw);
-        return;
-    }
-    QJsonArray mensajes = doc.object()["mensajes"].toArray();
-    qDebug() << "[AAA] Numero de mensajes recibidos: " << mensajes.size();
-    for (int i = mensajes.size() - 1; i >= 0; --i) {
-        QJsonObject msg = mensajes[i].toObject();
-        QString senderId = QString::number(msg["emisor"].toInt());
-        QString content  = msg["contenido"].toString();
-        appendMessage(senderId, content);
-    }
+void GameMessageWindow::prependHistory(const QList<ChatMessage> &messages, bool first) {
+    QScrollBar *bar = messagesView->verticalScrollBar();
+    int fromBottom = bar->maximum() - bar->value();
+
+    messagesModel->prepend(messages);
+    for (int i = 0; i < messages.size(); ++i)
+        chatHistories[chatID].insert(i, qMakePair(messages[i].senderId, messages[i].content));
+
+    // Tras colocar las filas nuevas, mantener la posición de lectura
+    QTimer::singleShot(0, this, [this, fromBottom, first]() {
+        QScrollBar *bar = messagesView->verticalScrollBar();
+        if (first)
+            messagesView->scrollToBottom();
+        else
+            bar->setValue(bar->maximum() - fromBottom);
+
+        // Si la lista aún no llena la ventana no habrá desplazamiento: pedir más
+        if (bar->maximum() == 0 && historyLoader->hasMore())
+            historyLoader->fetchOlder();
+    });
 }
 
 
 /**
- * @brief Destructor: cierra el WebSocket y libera recursos.
+ * @brief Destructor: la conexión queda abierta en ChatHub.
  */
 
 GameMessageWindow::~GameMessageWindow() {
-    qDebug() << "GameMessageWindow: Destructor, cerrando WebSocket.";
-    webSocket->close();
-    delete webSocket;
+    if (attached)
+        ChatHub::forUser(userKey).detach(channel);
+}
+
+/**
+ * @brief Registra la ventana visible en ChatHub.
+ */
+
+void GameMessageWindow::showEvent(QShowEvent *event) {
+    if (!attached) {
+        ChatHub::forUser(userKey).attach(channel);
+        attached = true;
+    }
+    QWidget::showEvent(event);
+}
+
+/**
+ * @brief Quita el registro al ocultarse.
+ */
+
+void GameMessageWindow::hideEvent(QHideEvent *event) {
+    if (attached) {
+        ChatHub::forUser(userKey).detach(channel);
+        attached = false;
+    }
+    QWidget::hideEvent(event);
 }
 
 /**
@@ -152,15 +179,12 @@ void GameMessageWindow::setupUI(const QString userKey) {
     // — Header —
     QHBoxLayout *headerLayout = new QHBoxLayout();
     titleLabel = new QLabel("Chat de Partida", this);
-    titleLabel->setStyleSheet("color: white; font-size: 28px; font-weight: bold;");
+    Theme::setRole(titleLabel, "title");
     closeButton = new QPushButton(this);
     closeButton->setIcon(QIcon(":/icons/cross.png"));
     closeButton->setIconSize(QSize(22,22));
     closeButton->setFixedSize(35,35);
-    closeButton->setStyleSheet(
-        "QPushButton { background-color: #c2c2c3; border: none; border-radius: 17px; }"
-        "QPushButton:hover { background-color: #9b9b9b; }"
-        );
+    Theme::setRole(closeButton, "close");
     connect(closeButton, &QPushButton::clicked, this, &QWidget::close);
 
     headerLayout->addWidget(titleLabel);
@@ -168,23 +192,22 @@ void GameMessageWindow::setupUI(const QString userKey) {
     headerLayout->addWidget(closeButton);
     mainLayout->addLayout(headerLayout);
 
-    // — Lista de mensajes —
-    messagesListWidget = new QListWidget(this);
-    messagesListWidget->setStyleSheet(
-        "background-color: #292A2D; color: white; font-size: 16px; padding: 10px; "
-        "border-radius: 10px; border: 1px solid #444;"
-        );
-    messagesListWidget->setSelectionMode(QAbstractItemView::NoSelection);
-    mainLayout->addWidget(messagesListWidget);
+    // — Lista de mensajes (las burbujas las pinta el delegado) —
+    messagesModel = new ChatModel(userID, this);
+    messagesView = new QListView(this);
+    Theme::setRole(messagesView, "chatView");
+    messagesView->setModel(messagesModel);
+    messagesView->setItemDelegate(new ChatBubbleDelegate(messagesView));
+    messagesView->setSelectionMode(QAbstractItemView::NoSelection);
+    messagesView->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    messagesView->setResizeMode(QListView::Adjust);
+    mainLayout->addWidget(messagesView);
 
     // — Entrada + botón enviar —
     QHBoxLayout *inputLayout = new QHBoxLayout();
     messageInput = new QLineEdit(this);
     messageInput->setPlaceholderText("Escribe un mensaje...");
-    messageInput->setStyleSheet(
-        "background-color: #292A2D; color: white; font-size: 16px; padding: 10px; "
-        "border-radius: 10px; border: 1px solid #444;"
-        );
+    Theme::setRole(messageInput, "chatInput");
     messageInput->setFixedHeight(40);
     connect(messageInput, &QLineEdit::returnPressed, this, [=]() {
         this->sendMessage(userKey);
@@ -192,11 +215,7 @@ void GameMessageWindow::setupUI(const QString userKey) {
 
     sendButton = new QPushButton("Enviar", this);
     sendButton->setFixedHeight(40);
-    sendButton->setStyleSheet(
-        "QPushButton { background-color: #1D4536; color: #F9F9F4; font-size: 16px;"
-        "padding: 8px 15px; border-radius: 10px; }"
-        "QPushButton:hover { background-color: #2A5C45; }"
-        );
+    Theme::setRole(sendButton, "send");
     connect(sendButton, &QPushButton::clicked, this, [=]() {
         this->sendMessage(userKey);
     });
@@ -207,56 +226,13 @@ void GameMessageWindow::setupUI(const QString userKey) {
 }
 
 /**
- * @brief Establece la conexión WebSocket para recibir mensajes en tiempo real.
- * @param userKey Clave del usuario usada para obtener el token.
- */
-
-void GameMessageWindow::setupWebSocketConnection(const QString &userKey) {
-    webSocket = new QWebSocket();
-    QString token = loadAuthToken(userKey);
-    if (token.isEmpty()) {
-        qDebug() << "GameMessageWindow: Token vacío, no se puede conectar WebSocket.";
-        return;
-    }
-
-    QString urlString = QString("ws://188.165.76.134:8000/ws/chat_partida/%1/?token=%2")
-                            .arg(chatID, token);
-
-    qDebug() << "GameMessageWindow: Conectando a" << urlString;
-    webSocket->open(QUrl(urlString));
-
-    connect(webSocket, &QWebSocket::connected, this, &GameMessageWindow::onConnected);
-    connect(webSocket, &QWebSocket::disconnected, this, &GameMessageWindow::onDisconnected);
-    connect(webSocket, &QWebSocket::textMessageReceived,
-            this, &GameMessageWindow::onTextMessageReceived);
-}
-
-/**
- * @brief Callback que se ejecuta cuando el WebSocket se conecta.
- */
-
-void GameMessageWindow::onConnected() {
-    qDebug() << "GameMessageWindow: WebSocket conectado.";
-}
-
-/**
- * @brief Callback que se ejecuta cuando el WebSocket se desconecta.
- */
-
-void GameMessageWindow::onDisconnected() {
-    qDebug() << "GameMessageWindow: WebSocket desconectado.";
-}
-
-/**
- * @brief Procesa un mensaje recibido por WebSocket.
- * @param message Cadena JSON con el mensaje.
+ * @brief Procesa un mensaje recibido por el canal del chat.
+ * @param ch Canal por el que llega (se ignoran los de otros chats).
+ * @param obj Mensaje recibido.
  */
 
-void GameMessageWindow::onTextMessageReceived(const QString &message) {
-    QJsonDocument doc = QJsonDocument::fromJson(message.toUtf8());
-    if (!doc.isObject()) return;
-
-    QJsonObject obj = doc.object();
+void GameMessageWindow::onChatMessage(const QString &ch, const QJsonObject &obj) {
+    if (ch != channel) return;
     if (obj.contains("error")) return;
 
     QJsonObject emisorObj = obj["emisor"].toObject();
@@ -286,16 +262,17 @@ void GameMessageWindow::sendMessage(const QString &userKey) {
     // 2) Mostrar inmediatamente tu burbuja (estilo “propio”)
     appendMessage(userID, text);
 
-    // 3) Enviar el mensaje por WebSocket
-    if (!webSocket->isValid()) {
-        qDebug() << "GameMessageWindow: WebSocket no válido, reintentando conexión...";
-        setupWebSocketConnection(userKey);
-    }
+    // 3) Enviar el mensaje por el canal compartido
     QJsonObject json;
     json["contenido"] = text;
     QJsonDocument doc(json);
-    webSocket->sendTextMessage(QString::fromUtf8(doc.toJson()));
-    qDebug() << "GameMessageWindow: Mensaje enviado:" << text;
+    ChatHub &hub = ChatHub::forUser(userKey);
+    if (hub.send(channel, QString::fromUtf8(doc.toJson()))) {
+        qDebug() << "GameMessageWindow: Mensaje enviado:" << text;
+    } else {
+        qDebug() << "GameMessageWindow: Canal no conectado, reintentando conexión...";
+        hub.open(channel);
+    }
 
     // 4) Limpiar el campo de entrada
     messageInput->clear();
@@ -303,69 +280,20 @@ void GameMessageWindow::sendMessage(const QString &userKey) {
 
 
 /**
- * @brief Añade un mensaje al listado de chat con estilo de burbuja.
+ * @brief Añade un mensaje al final del chat.
  * @param senderId ID del remitente.
  * @param content Texto del mensaje.
  */
 
 void GameMessageWindow::appendMessage(const QString &senderId, const QString &content) {
-    QLabel *lbl = new QLabel(content);
-    lbl->setWordWrap(true);
-    lbl->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
-
-    QWidget *container = new QWidget();
-    container->setStyleSheet("background: transparent; border: none;");
-    QVBoxLayout *lay = new QVBoxLayout(container);
-    lay->setContentsMargins(5,5,5,5);
-    lay->addWidget(lbl);
-
-    QListWidgetItem *item = new QListWidgetItem();
-    messagesListWidget->addItem(item);
-    messagesListWidget->setItemWidget(item, container);
-
-    // — Usar los mismos estilos de burbuja que en FriendsMessageWindow —
-    if (senderId != userID) {
-        lbl->setStyleSheet(
-            "background-color: #1D4536; color: #F9F9F4; padding: 8px; font-size: 16px;"
-            "border-radius: 10px; min-width: 100px; max-width: 400px;"
-            );
-        lay->setAlignment(lbl, Qt::AlignLeft);
-    } else {
-        lbl->setStyleSheet(
-            "background-color: white; color: black; padding: 8px; font-size: 16px;"
-            "border-radius: 10px; min-width: 100px; max-width: 400px;"
-        );
-        lay->setAlignment(lbl, Qt::AlignRight);
-    }
+    messagesModel->append(senderId, content);
 
     // — Guardar en el historial —
     chatHistories[chatID].append(qMakePair(senderId, content));
 
-    // Ajustar altura y desplazarse abajo
-    QTimer::singleShot(0, this, [=]() {
-        lbl->adjustSize();
-        int h = lbl->height() * 0.35;
-        if (h < 40) h = 40;
-        item->setSizeHint(QSize(400, h + 10));
-        messagesListWidget->scrollToBottom();
+    // Desplazarse abajo una vez colocada la fila
+    QTimer::singleShot(0, this, [this]() {
+        messagesView->scrollToBottom();
     });
 }
 
-/**
- * @brief Lee el token de autenticación guardado en configuración.
- * @param userKey Clave del usuario para localizar el archivo .conf.
- * @return Token como QString, o cadena vacía si no existe.
- */
-
-QString GameMessageWindow::loadAuthToken(const QString &userKey) {
-    // Construimos la misma ruta que usa LoginWindow para el .conf
-    QString configPath = QStandardPaths::writableLocation(QStandardPaths::ConfigLocation)
-                       + QString("/Grace Hopper/Sota, Caballo y Rey_%1.conf").arg(userKey);
-    // Forzamos formato INI para leerlo
-    QSettings settings(configPath, QSettings::IniFormat);
-    QString token = settings.value("auth/token").toString();
-    if (token.isEmpty()) {
-        qDebug() << "GameMessageWindow: Token no encontrado en" << configPath;
-    }
-    return token;
-}
@@ -6,28 +6,29 @@
  * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
  *
  * GameMessageWindow proporciona una interfaz de chat en tiempo real durante una partida multijugador.
- * Utiliza WebSocket para comunicación en vivo y HTTP para cargar el historial previo.
+ * Utiliza el canal de ChatHub para comunicación en vivo y HTTP (ChatHistoryLoader) para cargar el historial previo.
  */
 
 #pragma once
 
 #include <QWidget>
-#include <QWebSocket>
-#include <QListWidget>
+#include <QJsonObject>
+#include <QListView>
 #include <QLineEdit>
 #include <QPushButton>
 #include <QBoxLayout>
 #include <QLabel>
-#include <QNetworkAccessManager>
-#include <QNetworkRequest>
-#include <QNetworkReply>
+#include "chathistoryloader.h"
+
+class ChatModel;
 
 /**
  * @class GameMessageWindow
  * @brief Ventana de chat para partidas multijugador.
  *
  * Permite enviar y recibir mensajes en tiempo real mediante WebSocket,
- * así como recuperar el historial del chat desde el servidor.
+ * así como recuperar el historial del chat desde el servidor. La conexión es
+ * de ChatHub: cerrar la ventana no la cierra y reabrirla no repite el handshake.
  */
 class GameMessageWindow : public QWidget {
     Q_OBJECT
@@ -45,18 +46,20 @@ public:
     /** @brief Destructor de GameMessageWindow. */
     ~GameMessageWindow();
 
-private slots:
-    /** @brief Slot llamado cuando se establece conexión con el WebSocket. */
-    void onConnected();
+protected:
+    /** @brief Registra la ventana en ChatHub mientras se muestra. */
+    void showEvent(QShowEvent *event) override;
 
-    /** @brief Slot llamado cuando se pierde la conexión con el WebSocket. */
-    void onDisconnected();
+    /** @brief Quita el registro; la conexión sigue abierta. */
+    void hideEvent(QHideEvent *event) override;
 
+private slots:
     /**
-     * @brief Slot llamado al recibir un mensaje desde el WebSocket.
-     * @param message Mensaje recibido en formato texto.
+     * @brief Slot llamado al recibir un mensaje por un canal de ChatHub.
+     * @param ch Canal por el que llega.
+     * @param obj Mensaje recibido.
      */
-    void onTextMessageReceived(const QString &message);
+    void onChatMessage(const QString &ch, const QJsonObject &obj);
 
     /**
      * @brief Envía el mensaje actual al servidor.
@@ -65,7 +68,7 @@ private slots:
     void sendMessage(const QString &userKey);
 
 private:
-    QNetworkAccessManager *networkManager;  ///< Gestor de peticiones de red.
+    ChatHistoryLoader *historyLoader = nullptr;  ///< Carga paginada del historial.
 
     /**
      * @brief Carga el historial del chat desde el servidor.
@@ -74,16 +77,17 @@ private:
     void loadChatHistoryFromServer(const QString &userKey);
 
     /**
-     * @brief Configura los elementos de la interfaz gráfica.
-     * @param userKey Clave del usuario para personalización.
+     * @brief Inserta una página del historial encima de los mensajes mostrados.
+     * @param messages Mensajes en orden cronológico.
+     * @param first true para la página más reciente.
      */
-    void setupUI(const QString userKey);
+    void prependHistory(const QList<ChatMessage> &messages, bool first);
 
     /**
-     * @brief Establece la conexión WebSocket para el chat.
-     * @param userKey Clave del usuario para autenticación.
+     * @brief Configura los elementos de la interfaz gráfica.
+     * @param userKey Clave del usuario para personalización.
      */
-    void setupWebSocketConnection(const QString &userKey);
+    void setupUI(const QString userKey);
 
     /**
      * @brief Añade un mensaje a la ventana de chat.
@@ -92,13 +96,6 @@ private:
      */
     void appendMessage(const QString &senderId, const QString &content);
 
-    /**
-     * @brief Carga el token de autenticación del usuario.
-     * @param userkey Clave del usuario.
-     * @return Token de autenticación.
-     */
-    QString loadAuthToken(const QString &userkey);
-
     // --- Atributos ---
 
     /** @brief Historiales estáticos de chats por partida. */
@@ -106,13 +103,16 @@ private:
 
     QString chatID;              ///< Identificador del chat (por partida).
     QString userID;              ///< ID del usuario local.
-    QWebSocket *webSocket;       ///< Cliente WebSocket para mensajería en tiempo real.
+    QString userKey;             ///< Clave del usuario (su ChatHub).
+    QString channel;             ///< Canal del chat en ChatHub.
+    bool attached = false;       ///< true mientras la ventana está registrada en ChatHub.
 
     // Interfaz gráfica
     QVBoxLayout *mainLayout;         ///< Layout principal vertical.
     QLabel *titleLabel;              ///< Título de la ventana.
     QPushButton *closeButton;        ///< Botón para cerrar la ventana.
-    QListWidget *messagesListWidget; ///< Lista de mensajes mostrados.
+    QListView *messagesView;         ///< Vista de los mensajes mostrados.
+    ChatModel *messagesModel;        ///< Mensajes del chat.
     QLineEdit *messageInput;         ///< Campo de texto para escribir mensajes.
     QPushButton *sendButton;         ///< Botón para enviar mensajes.
 };
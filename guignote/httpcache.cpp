@@ -0,0 +1,308 @@
+/**
+ * @file httpcache.cpp
+ * @brief Implementación de la clase HttpCache.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * Contiene la lógica de búsqueda, persistencia y revalidación condicional
+ * de las respuestas HTTP compartidas entre ventanas.
+ */
+
+#include "httpcache.h"
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QCryptographicHash>
+#include <QStandardPaths>
+#include <QDataStream>
+#include <QSaveFile>
+#include <QPointer>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDebug>
+
+namespace {
+/// Cabecera de los ficheros de caché; cambiarla invalida todas las entradas antiguas.
+constexpr quint32 kMagic = 0x48434331; // "HCC1"
+}
+
+/**
+ * @brief Fracción de peticiones atendidas al instante desde la caché.
+ * @return Valor entre 0 y 1.
+ */
+double HttpCache::Stats::hitRate() const {
+    int total = fresh + stale + misses;
+    return total ? double(fresh + stale) / total : 0.0;
+}
+
+/**
+ * @brief Devuelve la instancia compartida, con las reglas de frescura de cada endpoint.
+ */
+HttpCache &HttpCache::instance() {
+    static HttpCache *cache = [] {
+        auto *c = new HttpCache();
+        // Los rankings apenas cambian entre partidas
+        c->setFreshness("/usuarios/top_elo", 300);
+        // ELO y estadísticas cambian al terminar una partida
+        c->setFreshness("/usuarios/elo/", 60);
+        c->setFreshness("/usuarios/estadisticas/", 60);
+        // Los objetos desbloqueados solo cambian al subir de nivel
+        c->setFreshness("/usuarios/get_unlocked_items/", 600);
+        // Datos que precarga la pantalla de carga para el menú y la partida
+        c->setFreshness("/usuarios/usuarios/id/", 86400);
+        c->setFreshness("/usuarios/get_equipped_items/", 30);
+        c->setFreshness("/usuarios/listar_solicitudes_amistad/", 30);
+        return c;
+    }();
+    return *cache;
+}
+
+/**
+ * @brief Constructor de HttpCache.
+ * @param directory Carpeta de persistencia (vacía = CacheLocation/http).
+ * @param parent Objeto padre.
+ */
+HttpCache::HttpCache(const QString &directory, QObject *parent)
+    : QObject(parent),
+      manager(new QNetworkAccessManager(this)),
+      directory(directory)
+{
+    if (this->directory.isEmpty())
+        this->directory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/http";
+    QDir().mkpath(this->directory);
+    prune(kMaxDiskBytes, kMaxAgeDays);
+}
+
+/**
+ * @brief Borra de disco las entradas caducadas y, si la carpeta sigue pasando
+ *        del límite, las más antiguas (por fecha de modificación).
+ *
+ * Cada store() reescribe el archivo, así que la fecha de modificación es la
+ * de la última validación de la entrada.
+ */
+void HttpCache::prune(qint64 maxBytes, int maxAgeDays) {
+    const QFileInfoList files = QDir(directory).entryInfoList({"*.cache"}, QDir::Files, QDir::Time);
+    const QDateTime oldest = QDateTime::currentDateTime().addDays(-maxAgeDays);
+
+    // Más reciente primero: se conserva desde el principio hasta llenar el límite
+    qint64 total = 0;
+    int removed = 0;
+    for (const QFileInfo &info : files) {
+        total += info.size();
+        if (info.lastModified() < oldest || total > maxBytes) {
+            QFile::remove(info.filePath());
+            ++removed;
+        }
+    }
+    if (removed)
+        qDebug() << "[HTTP-CACHE] Borradas" << removed << "entradas antiguas de" << directory;
+}
+
+/**
+ * @brief Fija los segundos de frescura para un prefijo de ruta.
+ */
+void HttpCache::setFreshness(const QString &pathPrefix, int seconds) {
+    for (auto &rule : freshness) {
+        if (rule.first == pathPrefix) {
+            rule.second = seconds;
+            return;
+        }
+    }
+    freshness.append({pathPrefix, seconds});
+}
+
+/**
+ * @brief Segundos de frescura de una URL; gana la regla de prefijo más largo.
+ */
+int HttpCache::freshnessFor(const QUrl &url) const {
+    const QString path = url.path();
+    int best = -1, seconds = 0;
+    for (const auto &rule : freshness) {
+        if (path.startsWith(rule.first) && rule.first.size() > best) {
+            best = rule.first.size();
+            seconds = rule.second;
+        }
+    }
+    return seconds;
+}
+
+/**
+ * @brief Clave de la entrada: URL completa más un resumen del token de sesión.
+ */
+QString HttpCache::keyFor(const QNetworkRequest &request) const {
+    QByteArray auth = QCryptographicHash::hash(request.rawHeader("Auth"), QCryptographicHash::Sha1).toHex().left(16);
+    return request.url().toString() + '|' + QString::fromLatin1(auth);
+}
+
+/**
+ * @brief Ruta en disco de una entrada.
+ */
+QString HttpCache::pathFor(const QString &key) const {
+    QByteArray name = QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex();
+    return directory + '/' + QString::fromLatin1(name) + ".cache";
+}
+
+/**
+ * @brief Busca una entrada en memoria y, si no está, en disco.
+ */
+HttpCache::Entry HttpCache::lookup(const QString &key) {
+    auto it = memory.constFind(key);
+    if (it != memory.constEnd())
+        return it.value();
+
+    Entry entry;
+    QFile file(pathFor(key));
+    if (!file.open(QIODevice::ReadOnly))
+        return entry;
+
+    QDataStream in(&file);
+    quint32 magic = 0;
+    in >> magic;
+    if (magic != kMagic)
+        return entry;
+    in >> entry.url >> entry.etag >> entry.lastModified >> entry.storedAt >> entry.body;
+    entry.valid = (in.status() == QDataStream::Ok);
+    if (entry.valid)
+        memory.insert(key, entry);
+    return entry;
+}
+
+/**
+ * @brief Guarda una entrada en memoria y la persiste de forma atómica.
+ */
+void HttpCache::store(const QString &key, const Entry &entry) {
+    memory.insert(key, entry);
+
+    QSaveFile file(pathFor(key));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "[HTTP-CACHE] No se pudo escribir" << file.fileName();
+        return;
+    }
+    QDataStream out(&file);
+    out << kMagic << entry.url << entry.etag << entry.lastModified << entry.storedAt << entry.body;
+    file.commit();
+}
+
+/**
+ * @brief Descarta las entradas cuya ruta comienza por el prefijo.
+ */
+void HttpCache::invalidate(const QString &pathPrefix) {
+    for (auto it = memory.begin(); it != memory.end();) {
+        if (it.value().url.path().startsWith(pathPrefix))
+            it = memory.erase(it);
+        else
+            ++it;
+    }
+
+    // Entradas de sesiones anteriores que aún no se han leído: basta la URL
+    const QFileInfoList files = QDir(directory).entryInfoList({"*.cache"}, QDir::Files);
+    for (const QFileInfo &info : files) {
+        QFile file(info.filePath());
+        if (!file.open(QIODevice::ReadOnly))
+            continue;
+        QDataStream in(&file);
+        quint32 magic = 0;
+        QUrl url;
+        in >> magic >> url;
+        file.close();
+        if (magic != kMagic || url.path().startsWith(pathPrefix))
+            QFile::remove(info.filePath());
+    }
+}
+
+/**
+ * @brief Realiza un GET a través de la caché.
+ *
+ * Si hay copia local se entrega de inmediato; si además es fresca no se toca la red.
+ * En otro caso se lanza la petición (condicional si hay validadores) y solo se vuelve
+ * a llamar a @p onData cuando el contenido ha cambiado.
+ */
+void HttpCache::get(const QNetworkRequest &request, QObject *context,
+                    DataHandler onData, ErrorHandler onError) {
+    const QString key = keyFor(request);
+    const QUrl url = request.url();
+    Entry cached = lookup(key);
+
+    QNetworkRequest conditional(request);
+    if (cached.valid) {
+        if (onData) onData(cached.body, true);
+
+        qint64 age = cached.storedAt.secsTo(QDateTime::currentDateTimeUtc());
+        if (age >= 0 && age < freshnessFor(url)) {
+            ++counters.fresh;
+            log("fresca", url);
+            return;
+        }
+        ++counters.stale;
+        if (!cached.etag.isEmpty())
+            conditional.setRawHeader("If-None-Match", cached.etag);
+        if (!cached.lastModified.isEmpty())
+            conditional.setRawHeader("If-Modified-Since", cached.lastModified);
+    } else {
+        ++counters.misses;
+    }
+
+    const bool hasContext = (context != nullptr);
+    QPointer<QObject> guard(context);
+    QNetworkReply *reply = manager->get(conditional);
+    connect(reply, &QNetworkReply::finished, this, [=]() mutable {
+        reply->deleteLater();
+        int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        bool alive = !hasContext || guard;
+
+        if (status == 304 && cached.valid) {
+            ++counters.revalidated;
+            cached.storedAt = QDateTime::currentDateTimeUtc();
+            store(key, cached);
+            log("revalidada", url);
+            return;
+        }
+
+        if (reply->error() != QNetworkReply::NoError) {
+            ++counters.errors;
+            log("error", url);
+            if (alive && onError) onError(status, reply->errorString());
+            return;
+        }
+
+        Entry fresh;
+        fresh.url = url;
+        fresh.etag = reply->rawHeader("ETag");
+        fresh.lastModified = reply->rawHeader("Last-Modified");
+        fresh.storedAt = QDateTime::currentDateTimeUtc();
+        fresh.body = reply->readAll();
+        fresh.valid = true;
+        store(key, fresh);
+
+        bool changed = !cached.valid || cached.body != fresh.body;
+        log(changed ? "descargada" : "sin cambios", url);
+        if (changed && alive && onData) onData(fresh.body, false);
+    });
+}
+
+/**
+ * @brief Devuelve los contadores acumulados.
+ */
+HttpCache::Stats HttpCache::stats() const {
+    return counters;
+}
+
+/**
+ * @brief Escribe una línea de log con el evento y la tasa de aciertos actual.
+ */
+void HttpCache::log(const char *event, const QUrl &url) const {
+    qDebug().noquote() << QString("[HTTP-CACHE] %1 %2 — aciertos %3%")
+                              .arg(QLatin1String(event), url.path())
+                              .arg(counters.hitRate() * 100.0, 0, 'f', 1);
+}
+
+/**
+ * @brief Vuelca todos los contadores en el log.
+ */
+void HttpCache::logSummary() const {
+    qDebug().noquote() << QString("[HTTP-CACHE] frescas=%1 revalidadas=%2 (304=%3) fallos=%4 errores=%5 aciertos=%6%")
+                              .arg(counters.fresh).arg(counters.stale).arg(counters.revalidated)
+                              .arg(counters.misses).arg(counters.errors)
+                              .arg(counters.hitRate() * 100.0, 0, 'f', 1);
+}
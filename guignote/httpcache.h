@@ -0,0 +1,144 @@
+/**
+ * @file httpcache.h
+ * @brief Declaración de la clase HttpCache, caché HTTP persistente con revalidación condicional.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * La clase HttpCache guarda en disco las respuestas GET de los endpoints de solo lectura
+ * (rankings, estadísticas, ELO, objetos desbloqueados) y las revalida con ETag / Last-Modified.
+ * Las ventanas pintan al instante la copia local y la refrescan en segundo plano.
+ */
+
+#ifndef HTTPCACHE_H
+#define HTTPCACHE_H
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QDateTime>
+#include <QNetworkRequest>
+#include <functional>
+
+class QNetworkAccessManager;
+
+/**
+ * @class HttpCache
+ * @brief Caché compartida de respuestas HTTP con reglas de frescura por endpoint.
+ *
+ * Cada entrada se indexa por URL y token de sesión, de modo que dos usuarios
+ * del mismo equipo nunca comparten respuestas. Mientras una entrada sea fresca
+ * no se toca la red; cuando caduca se sirve igualmente y se lanza una petición
+ * condicional (If-None-Match / If-Modified-Since) para refrescarla.
+ */
+class HttpCache : public QObject {
+    Q_OBJECT
+
+public:
+    /// Días que se conserva en disco una entrada que no se vuelve a guardar.
+    static constexpr int kMaxAgeDays = 30;
+    /// Tamaño máximo de la carpeta; al pasarlo se borran las entradas más antiguas.
+    static constexpr qint64 kMaxDiskBytes = 16 * 1024 * 1024;
+
+    /// Recibe el cuerpo de la respuesta y si procede de la copia local.
+    using DataHandler  = std::function<void(const QByteArray &body, bool fromCache)>;
+    /// Recibe el código HTTP (0 si no hubo respuesta) y la descripción del error.
+    using ErrorHandler = std::function<void(int httpStatus, const QString &error)>;
+
+    /**
+     * @struct Stats
+     * @brief Contadores de uso de la caché desde el arranque.
+     */
+    struct Stats {
+        int fresh = 0;        ///< Servidas sin tocar la red.
+        int stale = 0;        ///< Servidas de disco y revalidadas en segundo plano.
+        int revalidated = 0;  ///< Revalidaciones respondidas con 304.
+        int misses = 0;       ///< Peticiones sin copia local.
+        int errors = 0;       ///< Peticiones fallidas.
+
+        /** @brief Fracción de peticiones atendidas al instante desde la caché. */
+        double hitRate() const;
+    };
+
+    /**
+     * @brief Devuelve la instancia compartida por toda la aplicación.
+     */
+    static HttpCache &instance();
+
+    /**
+     * @brief Constructor.
+     * @param directory Carpeta donde persistir las entradas (vacía = CacheLocation/http).
+     * @param parent Objeto padre.
+     *
+     * Al abrir la carpeta se aplica prune() con los límites kMaxAgeDays y kMaxDiskBytes.
+     */
+    explicit HttpCache(const QString &directory = QString(), QObject *parent = nullptr);
+
+    /**
+     * @brief Realiza un GET a través de la caché.
+     * @param request Petición ya configurada (incluida la cabecera Auth).
+     * @param context Objeto cuyo ciclo de vida limita los callbacks (puede ser nullptr).
+     * @param onData Se invoca con la copia local (si existe) y de nuevo si el servidor
+     *               devuelve un contenido distinto.
+     * @param onError Se invoca si la petición falla (p. ej. 401 por sesión caducada).
+     */
+    void get(const QNetworkRequest &request, QObject *context,
+             DataHandler onData, ErrorHandler onError = nullptr);
+
+    /**
+     * @brief Fija cuántos segundos se considera fresca una respuesta.
+     * @param pathPrefix Prefijo de la ruta (p. ej. "/usuarios/top_elo").
+     * @param seconds Segundos de frescura; 0 obliga a revalidar siempre.
+     */
+    void setFreshness(const QString &pathPrefix, int seconds);
+
+    /**
+     * @brief Segundos de frescura aplicables a una URL (gana el prefijo más largo).
+     */
+    int freshnessFor(const QUrl &url) const;
+
+    /**
+     * @brief Descarta las entradas cuya ruta comienza por el prefijo dado.
+     * @param pathPrefix Prefijo de la ruta a invalidar.
+     *
+     * Se recorren también los archivos de disco (cada uno empieza por su URL),
+     * porque lookup() carga las entradas de sesiones anteriores bajo demanda.
+     */
+    void invalidate(const QString &pathPrefix);
+
+    /** @brief Contadores acumulados desde el arranque. */
+    Stats stats() const;
+
+    /** @brief Vuelca los contadores en el log de depuración. */
+    void logSummary() const;
+
+private:
+    /**
+     * @struct Entry
+     * @brief Respuesta almacenada junto con sus validadores.
+     */
+    struct Entry {
+        QUrl url;                ///< URL original.
+        QByteArray etag;         ///< Cabecera ETag recibida.
+        QByteArray lastModified; ///< Cabecera Last-Modified recibida.
+        QDateTime storedAt;      ///< Momento de la última validación.
+        QByteArray body;         ///< Cuerpo de la respuesta.
+        bool valid = false;      ///< false si no hay copia.
+    };
+
+    QString keyFor(const QNetworkRequest &request) const;
+    QString pathFor(const QString &key) const;
+    Entry lookup(const QString &key);
+    void prune(qint64 maxBytes, int maxAgeDays);
+    void store(const QString &key, const Entry &entry);
+    void log(const char *event, const QUrl &url) const;
+
+    QNetworkAccessManager *manager;          ///< Gestor de red propio de la caché.
+    QHash<QString, Entry> memory;            ///< Entradas ya leídas de disco.
+    QList<QPair<QString, int>> freshness;    ///< Prefijo de ruta → segundos de frescura.
+    QString directory;                       ///< Carpeta de persistencia.
+    Stats counters;                          ///< Contadores de uso.
+};
+
+#endif // HTTPCACHE_H
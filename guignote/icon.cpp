@@ -12,6 +12,7 @@
 
 
 #include "icon.h"
+#include "imageloader.h"
 #include <QDebug>
 
 /**
@@ -38,18 +39,20 @@ Icon::Icon(QWidget *parent) : QLabel(parent) {
  * En caso contrario, se imprime un mensaje de error en la consola de depuración.
  */
 void Icon::setImage(const QString &imagePath, int width, int height) {
-    QPixmap pixmap(imagePath);
+    // Se decodifica ya al tamaño del icono y queda en la caché compartida
+    QPixmap pixmap = ImageLoader::instance().pixmap(imagePath, QSize(width, height));
     if (pixmap.isNull()) {  // Verifica si la imagen no se ha cargado correctamente
         qDebug() << "Error: No se pudo cargar la imagen desde " << imagePath;
         return;
     }
 
     // Guardamos la información para reescalados posteriores
+    originalPath = imagePath;
     originalPixmap = pixmap;
     baseWidth = width;
     baseHeight = height;
 
-    setPixmap(pixmap.scaled(width, height, Qt::KeepAspectRatio, Qt::SmoothTransformation));
+    setPixmap(pixmap);
     setFixedSize(width, height);
 }
 
@@ -72,6 +75,7 @@ void Icon::setPixmapImg(const QPixmap pixmap, int width, int height) {
         qDebug() << "Icon inválido o destruido.";
         return;
     }
+    originalPath.clear();
     originalPixmap = pixmap;
     baseWidth = width;
     baseHeight = height;
@@ -109,9 +113,7 @@ void Icon::enterEvent(QEnterEvent *event) {
     int newW = static_cast<int>(baseWidth * 1.1);
     int newH = static_cast<int>(baseHeight * 1.1);
 
-    setPixmap(originalPixmap.scaled(newW, newH,
-                                    Qt::KeepAspectRatio,
-                                    Qt::SmoothTransformation));
+    setPixmap(scaledPixmap(newW, newH));
     setFixedSize(newW, newH);
 
     QLabel::enterEvent(event); // Llamada al padre
@@ -127,9 +129,7 @@ void Icon::enterEvent(QEnterEvent *event) {
 
 void Icon::leaveEvent(QEvent *event) {
     if (!hoverEnabled) return;
-    setPixmap(originalPixmap.scaled(baseWidth, baseHeight,
-                                    Qt::KeepAspectRatio,
-                                    Qt::SmoothTransformation));
+    setPixmap(scaledPixmap(baseWidth, baseHeight));
     setFixedSize(baseWidth, baseHeight);
 
     QLabel::leaveEvent(event);
@@ -142,3 +142,17 @@ void Icon::leaveEvent(QEvent *event) {
 void Icon::setHoverEnabled(bool enabled) {
     hoverEnabled = enabled;
 }
+
+/**
+ * @brief Imagen del icono a otro tamaño (para el efecto de hover).
+ * @param width Ancho deseado.
+ * @param height Altura deseada.
+ *
+ * Si la imagen vino de un recurso se vuelve a decodificar a ese tamaño a través
+ * de la caché de ImageLoader; si se asignó un QPixmap, se escala el original.
+ */
+QPixmap Icon::scaledPixmap(int width, int height) const {
+    if (!originalPath.isEmpty())
+        return ImageLoader::instance().pixmap(originalPath, QSize(width, height));
+    return originalPixmap.scaled(width, height, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+}
@@ -72,6 +72,9 @@ protected:
     void leaveEvent(QEvent *event) override;
 
 private:
+    QPixmap scaledPixmap(int width, int height) const;
+
+    QString originalPath;     ///< Recurso de setImage() (vacío si se asignó un QPixmap).
     QPixmap originalPixmap;
     bool hoverEnabled;
     int baseWidth{0};
@@ -16,6 +16,9 @@
 #include <QBitmap>
 #include <QFontDatabase>
 #include <QPainter>
+#include <QImageReader>
+#include <QGuiApplication>
+#include <QScreen>
 
 /**
  * @brief Constructor de ImageButton.
@@ -23,12 +26,12 @@
  * @param text Texto que se mostrará sobre la imagen.
  * @param parent Widget padre, por defecto es nullptr.
  *
- * Inicializa el botón de imagen cargando la imagen normal y generando una versión
- * oscurecida para los efectos interactivos. Además, configura una fuente personalizada
- * para el texto, ajusta la transparencia y define el tamaño del widget.
+ * Inicializa el botón de imagen con la imagen normal y la oscurecida ya escaladas
+ * al tamaño de pantalla completa (normalmente precargadas durante el arranque).
+ * Además, configura una fuente personalizada para el texto y ajusta la transparencia.
  */
 ImageButton::ImageButton(const QString &imagePath, const QString &text, QWidget *parent)
-    : QLabel(parent), normalPixmap(imagePath) {
+    : QLabel(parent), imagePath(imagePath), originalSize(QImageReader(imagePath).size()) {
     setAttribute(Qt::WA_TranslucentBackground);
 
     // Cargar la fuente personalizada.
@@ -41,50 +44,45 @@ ImageButton::ImageButton(const QString &imagePath, const QString &text, QWidget
         titleFont = QFont("Arial", 32, QFont::Bold);
     }
 
-    // Asegurar que la imagen mantiene su transparencia.
-    QImage img = normalPixmap.toImage().convertToFormat(QImage::Format_ARGB32);
-    normalPixmap = QPixmap::fromImage(img);
-    // Generar la imagen oscurecida para el efecto al pasar el cursor.
-    darkenedPixmap = generateDarkenedPixmap(normalPixmap);
-    setPixmap(normalPixmap);
-    setFixedSize(normalPixmap.size());
-
     // Crear y configurar la etiqueta de texto.
     textLabel = new QLabel(text, this);
     textLabel->setAlignment(Qt::AlignCenter);
     textLabel->setStyleSheet("color: white; font-size: 24px; font-weight: bold; background: transparent;");
-    textLabel->setGeometry(0, 0, width(), height());
     textLabel->setFont(titleFont);
     textLabel->hide();  // Ocultar texto al inicio.
+
+    // El menú ocupa toda la pantalla: se parte del tamaño que le dará updatesize().
+    QScreen *screen = QGuiApplication::primaryScreen();
+    applySize(scaledSize(originalSize, screen ? screen->size().height() : 600));
 }
 
 /**
- * @brief Genera una versión oscurecida del QPixmap proporcionado.
- * @param source QPixmap original.
- * @return QPixmap Imagen oscurecida.
+ * @brief Genera una versión oscurecida de la imagen proporcionada.
+ * @param source Imagen original.
+ * @return QImage Imagen oscurecida.
  *
- * Este método recorre cada píxel de la imagen fuente, reduciendo su brillo al 50%
- * y manteniendo la transparencia para lograr un efecto de oscurecimiento.
+ * Reduce el brillo de cada píxel al 50% manteniendo la transparencia. Con
+ * píxeles premultiplicados basta con dividir entre dos los tres canales de color.
  */
-QPixmap ImageButton::generateDarkenedPixmap(const QPixmap &source) {
-    QImage img = source.toImage().convertToFormat(QImage::Format_ARGB32);
+QImage ImageButton::generateDarkenedImage(const QImage &source) {
+    QImage img = source.convertToFormat(QImage::Format_ARGB32_Premultiplied);
 
     for (int y = 0; y < img.height(); ++y) {
         QRgb *line = reinterpret_cast<QRgb *>(img.scanLine(y));
         for (int x = 0; x < img.width(); ++x) {
-            QColor color = QColor::fromRgba(line[x]);
-
-            // Si el píxel no es completamente transparente.
-            if (color.alpha() > 0) {
-                int r = qMax(color.red() * 0.5, 0.0);   // Reducir brillo al 50%.
-                int g = qMax(color.green() * 0.5, 0.0);
-                int b = qMax(color.blue() * 0.5, 0.0);
-                line[x] = QColor(r, g, b, color.alpha()).rgba(); // Mantener la transparencia.
-            }
+            const QRgb p = line[x];
+            line[x] = qRgba(qRed(p) / 2, qGreen(p) / 2, qBlue(p) / 2, qAlpha(p));
         }
     }
 
-    return QPixmap::fromImage(img);
+    return img;
+}
+
+/**
+ * @brief Variante "oscura" de ImageLoader: la imagen de hover.
+ */
+ImageLoader::Filter ImageButton::darkened() {
+    return {QStringLiteral("oscura"), &ImageButton::generateDarkenedImage};
 }
 
 /**
@@ -95,7 +93,7 @@ QPixmap ImageButton::generateDarkenedPixmap(const QPixmap &source) {
  */
 void ImageButton::enterEvent(QEnterEvent *event) {
     Q_UNUSED(event);
-    setPixmap(darkenedPixmap.scaled(size(), Qt::KeepAspectRatio, Qt::SmoothTransformation));
+    setPixmap(darkenedPixmap);
     textLabel->show();
 }
 
@@ -107,7 +105,7 @@ void ImageButton::enterEvent(QEnterEvent *event) {
  */
 void ImageButton::leaveEvent(QEvent *event) {
     Q_UNUSED(event);
-    setPixmap(normalPixmap.scaled(size(), Qt::KeepAspectRatio, Qt::SmoothTransformation));
+    setPixmap(normalPixmap);
     textLabel->hide();
 }
 
@@ -128,41 +126,48 @@ void ImageButton::mousePressEvent(QMouseEvent *event) {
  * @param h Altura de referencia (por ejemplo, altura de la ventana).
  * @return QSize Nuevo tamaño calculado para el botón.
  *
- * Escala el QPixmap original de acuerdo a la nueva altura (dividida entre 3),
- * aplica límites mínimos y máximos, y reajusta la posición del texto centrado.
+ * Toma de ImageLoader la imagen normal y la oscurecida a la nueva altura
+ * (dividida entre 3, con límites) y reajusta la posición del texto centrado.
  */
 
 QSize ImageButton::updatesize(int h) {
-    if (normalPixmap.isNull()) return QSize(0, 0);
+    QSize size = scaledSize(originalSize, h);
+    if (size.isEmpty()) return QSize(0, 0);
+    if (size != this->size() || normalPixmap.isNull())
+        applySize(size);
+    return size;
+}
+
+/**
+ * @brief Calcula el tamaño del botón para una altura de ventana.
+ */
+QSize ImageButton::scaledSize(const QSize &original, int h) {
+    if (original.isEmpty()) return QSize(0, 0);
 
-    int originalWidth = normalPixmap.width();
-    int originalHeight = normalPixmap.height();
-    double aspectRatio = static_cast<double>(originalWidth) / originalHeight;
+    double aspectRatio = static_cast<double>(original.width()) / original.height();
 
     int newHeight = h / 3;  // Escalar basado en la altura de la ventana.
-    int newWidth = static_cast<int>(newHeight * aspectRatio);
 
     // Definir valores mínimos y máximos.
     const int minHeight = 200;
     const int maxHeight = 800;
+    newHeight = qBound(minHeight, newHeight, maxHeight);
 
-    // Ajustar a los límites establecidos.
-    if (newHeight < minHeight) {
-        newHeight = minHeight;
-        newWidth = static_cast<int>(newHeight * aspectRatio);
-    }
-    if (newHeight > maxHeight) {
-        newHeight = maxHeight;
-        newWidth = static_cast<int>(newHeight * aspectRatio);
-    }
-
-    // Ajustar el tamaño del ImageButton
-    setFixedSize(newWidth, newHeight);
-    setPixmap(normalPixmap.scaled(newWidth, newHeight, Qt::KeepAspectRatio, Qt::SmoothTransformation));
+    return QSize(static_cast<int>(newHeight * aspectRatio), newHeight);
+}
 
-    // ✅ Ajustar la posición y tamaño de textLabel para que siga centrado
-    textLabel->setGeometry(0, 0, newWidth, newHeight);
+/**
+ * @brief Aplica un tamaño: imágenes de la caché, tamaño fijo y texto centrado.
+ */
+void ImageButton::applySize(const QSize &size) {
+    if (size.isEmpty()) {
+        qWarning() << "No se pudo cargar la imagen" << imagePath;
+        return;
+    }
+    normalPixmap = ImageLoader::instance().pixmap(imagePath, size);
+    darkenedPixmap = ImageLoader::instance().pixmap(imagePath, size, Qt::KeepAspectRatio, darkened());
 
-    return QSize(newWidth, newHeight);
+    setFixedSize(size);
+    setPixmap(textLabel->isHidden() ? normalPixmap : darkenedPixmap);
+    textLabel->setGeometry(0, 0, size.width(), size.height());
 }
-
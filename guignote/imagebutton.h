@@ -13,6 +13,7 @@
 #ifndef IMAGEBUTTON_H
 #define IMAGEBUTTON_H
 
+#include "imageloader.h"
 #include <QLabel>
 #include <QPixmap>
 #include <QSize>
@@ -50,6 +51,22 @@ public:
      */
     QSize updatesize(int h);
 
+    /**
+     * @brief Tamaño del botón para una altura de ventana dada.
+     * @param original Tamaño original de la imagen.
+     * @param h Altura de la ventana.
+     * @return Un tercio de la altura (entre 200 y 800 px) con la proporción de la imagen.
+     *
+     * Es el cálculo de updatesize(); la precarga lo usa para decodificar la imagen
+     * ya al tamaño con que se mostrará.
+     */
+    static QSize scaledSize(const QSize &original, int h);
+
+    /**
+     * @brief Variante oscurecida (hover) para ImageLoader.
+     */
+    static ImageLoader::Filter darkened();
+
 signals:
     /**
      * @brief Señal emitida cuando se hace clic sobre el botón.
@@ -84,15 +101,22 @@ protected:
     /**
      * @brief Genera una versión oscurecida de la imagen fuente.
      * @param source Imagen original a la que se aplicará el efecto de oscurecimiento.
-     * @return QPixmap Imagen resultante con el efecto aplicado.
+     * @return QImage Imagen resultante con el efecto aplicado.
      *
-     * Este método crea una nueva imagen a partir de la imagen original aplicando
-     * un filtro o transformación para oscurecerla, utilizado para efectos interactivos.
+     * Trabaja sobre QImage, así que ImageLoader puede aplicarlo en un hilo de trabajo.
      */
-    QPixmap generateDarkenedPixmap(const QPixmap &source);
+    static QImage generateDarkenedImage(const QImage &source);
 
 private:
-    QPixmap normalPixmap;   ///< Imagen original del botón.
+    /**
+     * @brief Muestra el botón a un tamaño, con las imágenes ya escaladas de ImageLoader.
+     * @param size Tamaño del botón.
+     */
+    void applySize(const QSize &size);
+
+    QString imagePath;      ///< Recurso de la imagen.
+    QSize originalSize;     ///< Tamaño original de la imagen (leído de la cabecera).
+    QPixmap normalPixmap;   ///< Imagen del botón al tamaño actual.
     QLabel *textLabel;      ///< Etiqueta para mostrar el texto asociado al botón.
     QPixmap darkenedPixmap; ///< Imagen oscurecida utilizada para efectos interactivos.
 };
@@ -0,0 +1,299 @@
+/**
+ * @file imageloader.cpp
+ * @brief Implementación de la clase ImageLoader.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * Contiene la decodificación escalada con QImageReader, la cola de hilos de
+ * trabajo y el registro de tiempo y memoria.
+ */
+
+#include "imageloader.h"
+#include <QImageIOHandler>
+#include <QImageReader>
+#include <QPixmapCache>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QDebug>
+#include <atomic>
+
+namespace {
+std::atomic<qint64> liveBytes{0};  ///< Memoria de decodificación reservada ahora (todos los hilos).
+std::atomic<qint64> livePeak{0};   ///< Máximo alcanzado por liveBytes.
+
+/// Suma (o resta) memoria de decodificación y actualiza el máximo simultáneo.
+void track(qint64 delta) {
+    const qint64 now = liveBytes.fetch_add(delta) + delta;
+    qint64 peak = livePeak.load();
+    while (now > peak && !livePeak.compare_exchange_weak(peak, now)) {}
+}
+
+/// Formato que QPixmap usa de forma nativa para la imagen.
+QImage::Format nativeFormat(const QImage &image) {
+    return image.hasAlphaChannel() ? QImage::Format_ARGB32_Premultiplied
+                                   : QImage::Format_RGB32;
+}
+}
+
+/**
+ * @brief Devuelve la instancia compartida.
+ */
+ImageLoader &ImageLoader::instance() {
+    static ImageLoader *loader = new ImageLoader();
+    return *loader;
+}
+
+/**
+ * @brief Constructor de ImageLoader.
+ *
+ * Deja un núcleo libre para el hilo de la interfaz.
+ */
+ImageLoader::ImageLoader(QObject *parent)
+    : QObject(parent)
+{
+    workers.setMaxThreadCount(qMax(2, QThread::idealThreadCount() - 1));
+}
+
+/**
+ * @brief Decodifica una imagen y la escala al tamaño pedido.
+ *
+ * Solo los formatos cuyo lector admite ScaledSize (JPEG) reducen la imagen al
+ * decodificar. El lector de PNG, que es el de todos los recursos, la
+ * decodifica entera; entonces se pasa a formato nativo (en el sitio si la
+ * profundidad coincide) y se escala después. Así el escalado suave no tiene
+ * que hacer otra copia a tamaño completo para premultiplicar. Mientras tanto
+ * se mide cada búfer reservado: @p workBytes recibe el máximo que ha llegado
+ * a convivir.
+ */
+QImage ImageLoader::decode(const QString &path, const QSize &size,
+                           Qt::AspectRatioMode mode, QSize *sourceSize,
+                           qint64 *workBytes) {
+    QImageReader reader(path);
+    const QSize original = reader.size();
+    if (sourceSize)
+        *sourceSize = original;
+    if (workBytes)
+        *workBytes = 0;
+
+    QSize target;
+    if (size.isValid() && original.isValid() && original.scaled(size, mode) != original)
+        target = original.scaled(size, mode);
+    if (target.isValid() && reader.supportsOption(QImageIOHandler::ScaledSize))
+        reader.setScaledSize(target);
+
+    QImage image = reader.read();
+    if (image.isNull()) {
+        qWarning() << "[IMAGENES] No se puede cargar" << path << ":" << reader.errorString();
+        return image;
+    }
+
+    qint64 held = image.sizeInBytes();
+    qint64 peak = held;
+    track(held);
+    auto replaced = [&held, &peak](qint64 bytes) {
+        track(bytes);
+        peak = qMax(peak, held + bytes);
+        track(-held);
+        held = bytes;
+    };
+
+    const QImage::Format native = nativeFormat(image);
+    if (image.format() != native) {
+        const uchar *before = image.constBits();
+        image.convertTo(native);
+        if (image.constBits() != before)
+            replaced(image.sizeInBytes());
+    }
+
+    if (target.isValid() && image.size() != target) {
+        QImage scaled = image.scaled(target, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        replaced(scaled.sizeInBytes());
+        image = std::move(scaled);
+    }
+
+    track(-held);
+    if (workBytes)
+        *workBytes = peak;
+    return image;
+}
+
+/**
+ * @brief Decodifica y, si hay filtro, lo aplica; el resultado queda en formato nativo.
+ *
+ * La copia filtrada convive un momento con la escalada y cuenta en @p workBytes.
+ */
+QImage ImageLoader::produce(const QString &path, const QSize &size, Qt::AspectRatioMode mode,
+                            const Filter &filter, qint64 *workBytes) {
+    QImage image = decode(path, size, mode, nullptr, workBytes);
+    if (image.isNull() || filter.name.isEmpty() || !filter.apply)
+        return image;
+
+    QImage filtered = filter.apply(image);
+    if (!filtered.isNull() && filtered.format() != nativeFormat(filtered))
+        filtered.convertTo(nativeFormat(filtered));
+
+    // La escalada y la filtrada conviven hasta aquí
+    const qint64 both = image.sizeInBytes() + filtered.sizeInBytes();
+    track(both);
+    track(-both);
+    if (workBytes)
+        *workBytes = qMax(*workBytes, both);
+    return filtered;
+}
+
+/**
+ * @brief Clave en QPixmapCache: ruta, tamaño, modo de proporción y variante.
+ */
+QString ImageLoader::keyFor(const QString &path, const QSize &size, Qt::AspectRatioMode mode,
+                            const QString &filter) {
+    QString key = QStringLiteral("%1@%2x%3:%4")
+        .arg(path).arg(size.width()).arg(size.height()).arg(int(mode));
+    if (!filter.isEmpty())
+        key += QLatin1Char('#') + filter;
+    return key;
+}
+
+/**
+ * @brief Copia en caché o, si falta, decodificación inmediata.
+ */
+QPixmap ImageLoader::pixmap(const QString &path, const QSize &size, Qt::AspectRatioMode mode,
+                            const Filter &filter) {
+    const QString key = keyFor(path, size, mode, filter.name);
+    QPixmap cached;
+    if (findCached(key, &cached))
+        return cached;
+
+    QElapsedTimer timer;
+    timer.start();
+    qint64 work = 0;
+    QImage image = produce(path, size, mode, filter, &work);
+    if (image.isNull())
+        return QPixmap();
+    record(image, work, timer.nsecsElapsed());
+
+    cached = QPixmap::fromImage(std::move(image));
+    QPixmapCache::insert(key, cached);
+    return cached;
+}
+
+/**
+ * @brief Pide una imagen escalada; la decodificación se hace en un hilo de trabajo.
+ */
+void ImageLoader::load(const QString &path, const QSize &size, Qt::AspectRatioMode mode,
+                       QObject *context, Handler onReady, const Filter &filter) {
+    const QString key = keyFor(path, size, mode, filter.name);
+    QPixmap cached;
+    if (findCached(key, &cached)) {
+        if (onReady) onReady(cached);
+        return;
+    }
+
+    Waiter waiter;
+    waiter.context = context;
+    waiter.hasContext = (context != nullptr);
+    waiter.onReady = onReady;
+
+    auto it = pending.find(key);
+    if (it != pending.end()) {
+        it->append(waiter);
+        return;
+    }
+    pending.insert(key, {waiter});
+
+    workers.start([this, key, path, size, mode, filter]() {
+        QElapsedTimer timer;
+        timer.start();
+        qint64 work = 0;
+        QImage image = produce(path, size, mode, filter, &work);
+        const qint64 nsecs = timer.nsecsElapsed();
+        QMetaObject::invokeMethod(this, [this, key, image, work, nsecs]() {
+            if (!image.isNull())
+                record(image, work, nsecs);
+            deliver(key, image);
+        }, Qt::QueuedConnection);
+    });
+}
+
+/**
+ * @brief Registra una imagen ya escalada que vive fuera de QPixmapCache.
+ */
+void ImageLoader::addResident(const QString &key, const QImage &image) {
+    residents.insert(key, image);
+}
+
+/**
+ * @brief Olvida una imagen residente.
+ */
+void ImageLoader::removeResident(const QString &key) {
+    residents.remove(key);
+}
+
+/**
+ * @brief Busca en QPixmapCache y, si la entrada se expulsó, entre las residentes.
+ */
+bool ImageLoader::findCached(const QString &key, QPixmap *pixmap) {
+    if (QPixmapCache::find(key, pixmap))
+        return true;
+
+    const QImage resident = residents.value(key);
+    if (resident.isNull())
+        return false;
+    *pixmap = QPixmap::fromImage(resident);
+    QPixmapCache::insert(key, *pixmap);
+    counters.resident++;
+    return true;
+}
+
+/**
+ * @brief Suma una decodificación a los contadores.
+ */
+void ImageLoader::record(const QImage &image, qint64 workBytes, qint64 nsecs) {
+    counters.decoded++;
+    counters.decodeNsecs += nsecs;
+    counters.bytes += image.sizeInBytes();
+    counters.workBytes += workBytes;
+    counters.peakBytes = qMax(counters.peakBytes, workBytes);
+    counters.livePeakBytes = livePeak.load();
+}
+
+/**
+ * @brief Convierte el resultado a QPixmap (hilo de interfaz) y avisa a todas las vistas en espera.
+ *
+ * Si la imagen no se pudo cargar se avisa igualmente con un QPixmap nulo, para
+ * que quien cuenta respuestas pendientes no se quede esperando.
+ */
+void ImageLoader::deliver(const QString &key, const QImage &image) {
+    QList<Waiter> waiters = pending.take(key);
+
+    QPixmap pixmap;
+    if (!image.isNull()) {
+        pixmap = QPixmap::fromImage(image);
+        QPixmapCache::insert(key, pixmap);
+    }
+    for (const Waiter &w : waiters) {
+        if (w.hasContext && !w.context) continue;
+        if (w.onReady) w.onReady(pixmap);
+    }
+
+    if (pending.isEmpty())
+        report();
+}
+
+/**
+ * @brief Escribe en el log el tiempo y la memoria de decodificación acumulados.
+ *
+ * Todas las cifras salen de QImage::sizeInBytes() de los búferes reservados.
+ */
+void ImageLoader::report() const {
+    qDebug().noquote() << QString("[IMAGENES] %1 decodificadas en %2 ms, %3 sin decodificar; "
+                                  "escaladas %4 KB; reservado al decodificar %5 KB "
+                                  "(pico por imagen %6 KB, pico entre hilos %7 KB)")
+                              .arg(counters.decoded)
+                              .arg(counters.decodeNsecs / 1000000)
+                              .arg(counters.resident)
+                              .arg(counters.bytes / 1024)
+                              .arg(counters.workBytes / 1024)
+                              .arg(counters.peakBytes / 1024)
+                              .arg(counters.livePeakBytes / 1024);
+}
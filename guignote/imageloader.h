@@ -0,0 +1,190 @@
+/**
+ * @file imageloader.h
+ * @brief Declaración de la clase ImageLoader, carga de imágenes al tamaño final.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * Las cartas, las casillas del inventario y los iconos se muestran mucho más
+ * pequeños que los PNG de los recursos. ImageLoader los decodifica y escala al
+ * tamaño en pantalla en hilos de trabajo, y deja el resultado en QPixmapCache
+ * para que cualquier ventana lo reutilice. Lo que ya está escalado en disco
+ * (CardAtlas) se sirve sin decodificar.
+ */
+
+#ifndef IMAGELOADER_H
+#define IMAGELOADER_H
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QImage>
+#include <QPixmap>
+#include <QPointer>
+#include <QSize>
+#include <QThreadPool>
+#include <functional>
+
+/**
+ * @class ImageLoader
+ * @brief Decodificación escalada de recursos con caché compartida.
+ *
+ * Si varias vistas piden la misma imagen al mismo tamaño mientras se está
+ * decodificando, solo se decodifica una vez. Si QPixmapCache ha expulsado una
+ * imagen que sigue residente (addResident()), se recupera de ahí. Lleva la
+ * cuenta del tiempo y de la memoria reservada al decodificar, y la escribe en
+ * el log al vaciarse la cola.
+ */
+class ImageLoader : public QObject {
+    Q_OBJECT
+
+public:
+    /// Recibe la imagen ya escalada (nula si no se pudo cargar).
+    using Handler = std::function<void(const QPixmap &pixmap)>;
+
+    /**
+     * @struct Filter
+     * @brief Transformación que se aplica tras decodificar (girar, oscurecer...).
+     *
+     * Se ejecuta en el mismo hilo que la decodificación y el resultado se guarda
+     * en caché como una variante más de la imagen, identificada por su nombre.
+     */
+    struct Filter {
+        QString name;                                 ///< Nombre de la variante (vacío = sin filtro).
+        std::function<QImage(const QImage &)> apply;  ///< Transformación; debe poder llamarse desde cualquier hilo.
+    };
+
+    /**
+     * @struct Request
+     * @brief Imagen a cargar: ruta, tamaño, proporción y variante.
+     */
+    struct Request {
+        QString path;                                 ///< Ruta del recurso.
+        QSize size;                                   ///< Tamaño de destino.
+        Qt::AspectRatioMode mode = Qt::KeepAspectRatio; ///< Modo de proporción.
+        Filter filter = {};                           ///< Variante (opcional).
+    };
+
+    /**
+     * @struct Stats
+     * @brief Contadores acumulados de decodificación.
+     */
+    struct Stats {
+        int decoded = 0;           ///< Imágenes decodificadas.
+        int resident = 0;          ///< Imágenes recuperadas de las residentes, sin decodificar.
+        qint64 decodeNsecs = 0;    ///< Tiempo total de decodificación.
+        qint64 bytes = 0;          ///< Memoria de las imágenes ya escaladas.
+        qint64 workBytes = 0;      ///< Suma de los picos de cada decodificación.
+        qint64 peakBytes = 0;      ///< Mayor pico de una sola decodificación.
+        qint64 livePeakBytes = 0;  ///< Mayor memoria de decodificación simultánea entre hilos.
+    };
+
+    /** @brief Instancia compartida por toda la aplicación. */
+    static ImageLoader &instance();
+
+    /**
+     * @brief Constructor.
+     * @param parent Objeto padre.
+     */
+    explicit ImageLoader(QObject *parent = nullptr);
+
+    /**
+     * @brief Decodifica una imagen y la escala al tamaño pedido.
+     * @param path Ruta del recurso.
+     * @param size Tamaño de destino (inválido = tamaño original).
+     * @param mode Cómo respetar la proporción, igual que en QPixmap::scaled().
+     * @param sourceSize Si no es nulo, recibe el tamaño original de la imagen.
+     * @param workBytes Si no es nulo, recibe la mayor memoria reservada a la vez.
+     * @return Imagen escalada, o nula si no se pudo leer.
+     *
+     * Trabaja sobre QImage, así que puede llamarse desde cualquier hilo.
+     */
+    static QImage decode(const QString &path, const QSize &size = QSize(),
+                         Qt::AspectRatioMode mode = Qt::KeepAspectRatio,
+                         QSize *sourceSize = nullptr, qint64 *workBytes = nullptr);
+
+    /**
+     * @brief Clave en QPixmapCache de una imagen escalada.
+     * @param path Ruta del recurso.
+     * @param size Tamaño de destino.
+     * @param mode Modo de proporción.
+     * @param filter Nombre de la variante (vacío = imagen tal cual).
+     */
+    static QString keyFor(const QString &path, const QSize &size,
+                          Qt::AspectRatioMode mode = Qt::KeepAspectRatio,
+                          const QString &filter = QString());
+
+    /**
+     * @brief Imagen escalada; si no está en caché se decodifica en el momento.
+     * @param path Ruta del recurso.
+     * @param size Tamaño de destino.
+     * @param mode Modo de proporción.
+     * @param filter Variante a aplicar tras decodificar.
+     */
+    QPixmap pixmap(const QString &path, const QSize &size,
+                   Qt::AspectRatioMode mode = Qt::KeepAspectRatio,
+                   const Filter &filter = Filter());
+
+    /**
+     * @brief Pide una imagen escalada sin bloquear la interfaz.
+     * @param path Ruta del recurso.
+     * @param size Tamaño de destino.
+     * @param mode Modo de proporción.
+     * @param context Objeto cuyo ciclo de vida limita el callback (puede ser nullptr).
+     * @param onReady Se invoca con la imagen; de forma inmediata si ya estaba en caché.
+     * @param filter Variante a aplicar tras decodificar.
+     */
+    void load(const QString &path, const QSize &size, Qt::AspectRatioMode mode,
+              QObject *context, Handler onReady, const Filter &filter = Filter());
+
+    /**
+     * @brief Igual que load(), con la petición en un Request.
+     */
+    void load(const Request &request, QObject *context, Handler onReady) {
+        load(request.path, request.size, request.mode, context, onReady, request.filter);
+    }
+
+    /**
+     * @brief Registra una imagen ya escalada que vive fuera de QPixmapCache.
+     * @param key Clave de la imagen (keyFor()).
+     * @param image Imagen; sus píxeles deben seguir válidos hasta removeResident().
+     *
+     * Si QPixmapCache expulsa la entrada, se vuelve a crear a partir de esta
+     * imagen sin decodificar el recurso.
+     */
+    void addResident(const QString &key, const QImage &image);
+
+    /**
+     * @brief Olvida una imagen residente.
+     * @param key Clave de la imagen.
+     */
+    void removeResident(const QString &key);
+
+    /** @brief Contadores acumulados desde el arranque. */
+    Stats stats() const { return counters; }
+
+private:
+    /**
+     * @struct Waiter
+     * @brief Vista que espera una imagen en curso.
+     */
+    struct Waiter {
+        QPointer<QObject> context; ///< Objeto que limita el callback.
+        bool hasContext = false;   ///< false si se pidió sin contexto.
+        Handler onReady;           ///< Callback a invocar.
+    };
+
+    static QImage produce(const QString &path, const QSize &size, Qt::AspectRatioMode mode,
+                          const Filter &filter, qint64 *workBytes);
+    bool findCached(const QString &key, QPixmap *pixmap);
+    void record(const QImage &image, qint64 workBytes, qint64 nsecs);
+    void deliver(const QString &key, const QImage &image);
+    void report() const;
+
+    QHash<QString, QList<Waiter>> pending;   ///< Decodificaciones en curso por clave.
+    QHash<QString, QImage> residents;        ///< Imágenes escaladas fuera de QPixmapCache.
+    QThreadPool workers;                     ///< Hilos de decodificación.
+    Stats counters;                          ///< Contadores acumulados.
+};
+
+#endif // IMAGELOADER_H
@@ -12,6 +12,10 @@
 
 
 #include "inventorywindow.h"
+#include "httpcache.h"
+#include "playerprofiles.h"
+#include "imageloader.h"
+#include "pixmapshadoweffect.h"
 #include <QGridLayout>
 #include <QHBoxLayout>
 #include <QVBoxLayout>
@@ -64,6 +68,24 @@ static const char *tileQss = R"(
     }
 )";
 
+/// Zona de imagen de una CardTile (150 × 110 menos 5 px de margen por lado).
+static const QSize kTileImageSize(140, 100);
+
+/// Imagen de cada baraja según su id en el servidor.
+static const QMap<int, QString> kDeckTiles = {
+    {1, ":/tiles/base.png"},
+    {2, ":/tiles/poker.png"},
+    {3, ":/tiles/paint.png"}
+};
+
+/// Imagen de cada tapete según su id en el servidor.
+static const QMap<int, QString> kMatTiles = {
+    {1, ":/tiles/tapetebase.png"},
+    {2, ":/tiles/rojo.png"},
+    {3, ":/tiles/azul.png"},
+    {4, ":/tiles/negro.png"}
+};
+
 /**
  * @brief Constructor de CardTile.
  * @param text Texto que mostrará la tarjeta.
@@ -93,13 +115,21 @@ public:
                     // Cuando cambie checked, forzamos un repaint
                     this->update();
                 });
-        shadow = new QGraphicsDropShadowEffect(this);
-        shadow->setBlurRadius(18);
-        shadow->setOffset(0, 4);
-        shadow->setColor(QColor(0,0,0,160));
+        // Sombra desenfocada una sola vez; el hover solo la funde con la levantada
+        shadow = new PixmapShadowEffect(12, {18, 4}, {28, 6}, QColor(0,0,0,160), this);
         setGraphicsEffect(shadow);
     }
 
+    /**
+     * @brief Asigna la imagen de la tarjeta cuando termina de cargarse.
+     * @param pixmap Imagen ya escalada a kTileImageSize.
+     */
+    void setImage(const QPixmap &pixmap) {
+        m_pixmap = pixmap;
+        m_scaled = QPixmap();
+        update();
+    }
+
 protected:
 
     /**
@@ -112,7 +142,7 @@ protected:
  */
 
     void enterEvent(QEnterEvent *e) override {
-        elevate(28, 6);
+        shadow->animateTo(1.0);
         QPushButton::enterEvent(e);
     }
 
@@ -122,7 +152,7 @@ protected:
  */
 
     void leaveEvent(QEvent *e) override {
-        elevate(18, 4);
+        shadow->animateTo(0.0);
         QPushButton::leaveEvent(e);
     }
 
@@ -150,10 +180,7 @@ protected:
         if (!m_pixmap.isNull()) {
             // Deja un margen mínimo
             QRect imgArea = rect().adjusted(5, 5, -5, -5);
-            QPixmap scaled = m_pixmap.scaled(
-                imgArea.size(),
-                Qt::KeepAspectRatioByExpanding,
-                Qt::SmoothTransformation);
+            const QPixmap &scaled = scaledImage(imgArea.size());
             // Centrar el scaled dentro de imgArea
             QPoint pt(
                 imgArea.x() + (imgArea.width()  - scaled.width())/2,
@@ -183,30 +210,21 @@ protected:
 
 private:
     /**
- * @brief Ajusta dinámicamente el radio de desenfoque y el desplazamiento de la sombra.
- * @param blur Nuevo valor para blurRadius del efecto de sombra.
- * @param y Nuevo valor de offset vertical de la sombra.
- *
- * Crea animaciones que interpolan desde los valores actuales hasta los especificados,
- * para dar un efecto de elevación al pasar/retirar el cursor.
- */
-
-    void elevate(qreal blur, qreal y)
-    {
-        auto animate = [this](const char *prop, const QVariant &v) {
-            auto *a = new QPropertyAnimation(shadow, prop, this);
-            a->setDuration(160);
-            a->setStartValue(shadow->property(prop));
-            a->setEndValue(v);
-            a->setEasingCurve(QEasingCurve::OutCubic);
-            a->start(QAbstractAnimation::DeleteWhenStopped);
-        };
-        animate("blurRadius", blur);
-        animate("offset", QPointF(0, y));
+     * @brief Imagen escalada al área de dibujo; solo se recalcula si cambia el tamaño.
+     * @param size Tamaño del área de imagen.
+     */
+    const QPixmap &scaledImage(const QSize &size) {
+        if (m_scaled.isNull() || m_scaledFor != size) {
+            m_scaled = m_pixmap.scaled(size, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+            m_scaledFor = size;
+        }
+        return m_scaled;
     }
 
-    QGraphicsDropShadowEffect *shadow;
+    PixmapShadowEffect *shadow;
     QPixmap m_pixmap;
+    QPixmap m_scaled;      ///< m_pixmap ya escalada a m_scaledFor.
+    QSize m_scaledFor;
 };
 
 /**
@@ -428,19 +446,8 @@ InventoryWindow::InventoryWindow(QWidget *parent, QString usr) : QDialog(parent)
     stackedWidget->addWidget(deckPage);
 
 
-    // 3) Primero: pedir el ID numérico para el username m_userId
     m_netMgr = new QNetworkAccessManager(this);
 
-    // Slot específico para la primera respuesta
-    QUrl urlId(QStringLiteral(
-                   "http://188.165.76.134:8000/usuarios/usuarios/id/%1/")
-                   .arg(m_userId));
-    QNetworkRequest reqId(urlId);
-    QNetworkReply *replyId = m_netMgr->get(reqId);
-    connect(replyId, &QNetworkReply::finished, this, [this, replyId]() {
-        onGetUserIdReply(replyId);
-    });
-
     /* ====================  Página 2 : Tapetes ==================== */
 
     matPage = new QWidget;
@@ -467,6 +474,11 @@ InventoryWindow::InventoryWindow(QWidget *parent, QString usr) : QDialog(parent)
     connect(sidebar, &QListWidget::currentRowChanged,
             this,    &InventoryWindow::onTabChanged);
 
+    // 3) ID numérico y objetos equipados de m_userId (caché compartida con la
+    //    partida). Va al final: con la copia en memoria las páginas se rellenan ya.
+    PlayerProfiles::instance().lookup(m_userId, this, [this](const PlayerProfiles::Profile &profile) {
+        onProfileReady(profile);
+    });
 }
 
 // inventorywindow.cpp
@@ -486,9 +498,11 @@ void InventoryWindow::onDeckSelected(int skinId)
     QJsonObject body{{"skin_id", skinId}};
     QNetworkReply* reply = m_netMgr->post(req, QJsonDocument(body).toJson());
 
-    connect(reply, &QNetworkReply::finished, this, [reply]() {
+    connect(reply, &QNetworkReply::finished, this, [this, reply, skinId]() {
         if (reply->error() == QNetworkReply::NoError) {
             qDebug() << "Skin equipada correctamente:" << reply->readAll();
+            HttpCache::instance().invalidate("/usuarios/get_equipped_items/");
+            PlayerProfiles::instance().updateEquipped(m_numericUserId, skinId, -1);
         } else {
             qWarning() << "Error equipando skin:" << reply->errorString();
         }
@@ -509,70 +523,39 @@ void InventoryWindow::onTabChanged(int row)
     slidePages(stackedWidget, row, 350, -1);  // slide de derecha a izquierda
 }
 
-void InventoryWindow::onGetUserIdReply(QNetworkReply *reply)
+void InventoryWindow::onProfileReady(const PlayerProfiles::Profile &profile)
 {
-    // 1) Comprueba error y borra reply
-    if (reply->error() != QNetworkReply::NoError) {
-        qWarning() << "Error obteniendo numeric ID:" << reply->errorString();
-        reply->deleteLater();
-        return;
-    }
-    auto docId = QJsonDocument::fromJson(reply->readAll());
-    reply->deleteLater();
-    m_numericUserId = docId.object().value("user_id").toInt(-1);
+    // 1) Sin id no se puede consultar ni equipar nada
+    m_numericUserId = profile.id;
     if (m_numericUserId < 0) {
         qWarning() << "No vino user_id válido";
         return;
     }
 
-    // 2) Obtener skin y tapete equipado
-    QUrl urlEq(QStringLiteral(
-                   "http://188.165.76.134:8000/usuarios/get_equipped_items/%1/")
-                   .arg(m_numericUserId));
-    QNetworkRequest reqEq(urlEq);
-    QNetworkReply *replyEq = m_netMgr->get(reqEq);
-    connect(replyEq, &QNetworkReply::finished, this, [this, replyEq]() {
-        if (replyEq->error() == QNetworkReply::NoError) {
-            auto doc = QJsonDocument::fromJson(replyEq->readAll());
-            if (doc.isObject()) {
-                auto o = doc.object();
-                m_equippedSkinId = o.value("equipped_skin")
-                                       .toObject()
-                                       .value("id").toInt(-1);
-                m_equippedMatId  = o.value("equipped_tapete")
-                                      .toObject()
-                                      .value("id").toInt(-1);
-            }
-        }
-        replyEq->deleteLater();
-
-        // 3) Pedir TODOS los ítems desbloqueados
-        QUrl urlUnl(QStringLiteral(
-                        "http://188.165.76.134:8000/usuarios/get_unlocked_items/%1/")
-                        .arg(m_numericUserId));
-        QNetworkReply *replyUnl = m_netMgr->get(QNetworkRequest(urlUnl));
-        connect(replyUnl, &QNetworkReply::finished, this, [this, replyUnl]() {
-            // 3.1) Comprobar errores
-            if (replyUnl->error() != QNetworkReply::NoError) {
-                qWarning() << "Error al obtener ítems desbloqueados:"
-                           << replyUnl->errorString();
-                replyUnl->deleteLater();
-                return;
-            }
-            // 3.2) Leer y parsear JSON
-            QByteArray data = replyUnl->readAll();
-            replyUnl->deleteLater();
+    // 2) Skin y tapete equipados
+    m_equippedSkinId = profile.skinId;
+    m_equippedMatId  = profile.tapeteId;
+
+    // 3) Pedir TODOS los ítems desbloqueados (copia en caché al instante, refresco en segundo plano)
+    QUrl urlUnl(QStringLiteral(
+                    "http://188.165.76.134:8000/usuarios/get_unlocked_items/%1/")
+                    .arg(m_numericUserId));
+    HttpCache::instance().get(QNetworkRequest(urlUnl), this,
+        [this](const QByteArray &data, bool) {
+            // 3.1) Leer y parsear JSON
             QJsonDocument doc = QJsonDocument::fromJson(data);
             if (!doc.isObject()) {
                 qWarning() << "Respuesta de unlocked_items no es un objeto";
                 return;
             }
             QJsonObject obj = doc.object();
-            // 3.3) Extraer y poblar
+            // 3.2) Extraer y poblar
             populateDeckPage(obj.value("unlocked_skins").toArray());
             populateMatPage(obj.value("unlocked_tapetes").toArray());
+        },
+        [](int, const QString &error) {
+            qWarning() << "Error al obtener ítems desbloqueados:" << error;
         });
-    });
 }
 
 
@@ -635,11 +618,7 @@ void InventoryWindow::populateDeckPage(const QJsonArray &skins)
         unlockedIds.insert(v.toObject().value("id").toInt());
 
     // 3) Mapa interno id → recurso
-    static const QMap<int, QString> resourceMap = {
-        {1, ":/tiles/base.png"},
-        {2, ":/tiles/poker.png"},
-        {3, ":/tiles/paint.png"}
-    };
+    const QMap<int, QString> &resourceMap = kDeckTiles;
 
     // 4) Construir el nuevo grid
     auto *grid = new QGridLayout;
@@ -647,10 +626,12 @@ void InventoryWindow::populateDeckPage(const QJsonArray &skins)
     const int cols = 3;
     for (int idx = 1; idx <= 6; ++idx) {
         bool ok = unlockedIds.contains(idx) && resourceMap.contains(idx);
-        QPixmap pix;
-        if (ok) pix.load(resourceMap[idx]);
-
-        CardTile *tile = new CardTile(QString("Baraja %1").arg(idx), pix);
+        CardTile *tile = new CardTile(QString("Baraja %1").arg(idx));
+        if (ok) {
+            // Se decodifica en segundo plano, ya al tamaño de la casilla
+            ImageLoader::instance().load(resourceMap[idx], kTileImageSize, Qt::KeepAspectRatioByExpanding,
+                                         tile, [tile](const QPixmap &pix) { tile->setImage(pix); });
+        }
         tile->setEnabled(ok);
         tile->setCheckable(ok);
         if (ok)
@@ -708,12 +689,7 @@ void InventoryWindow::populateMatPage(const QJsonArray &mats)
         unlockedIds.insert(v.toObject().value("id").toInt());
 
     // 3) Mapa interno id → recurso
-    static const QMap<int, QString> matMap = {
-        {1, ":/tiles/tapetebase.png"},
-        {2, ":/tiles/rojo.png"},
-        {3, ":/tiles/azul.png"},
-        {4, ":/tiles/negro.png"}
-    };
+    const QMap<int, QString> &matMap = kMatTiles;
 
     // 4) Construir el nuevo grid (siempre 6 casillas: 2 filas x 3 cols)
     auto *grid = new QGridLayout;
@@ -722,10 +698,12 @@ void InventoryWindow::populateMatPage(const QJsonArray &mats)
     const int maxMats = 6;
     for (int idx = 1; idx <= maxMats; ++idx) {
         bool ok = unlockedIds.contains(idx) && matMap.contains(idx);
-        QPixmap pix;
-        if (ok) pix.load(matMap[idx]);
-
-        CardTile *tile = new CardTile(QString("Tapete %1").arg(idx), pix);
+        CardTile *tile = new CardTile(QString("Tapete %1").arg(idx));
+        if (ok) {
+            // Se decodifica en segundo plano, ya al tamaño de la casilla
+            ImageLoader::instance().load(matMap[idx], kTileImageSize, Qt::KeepAspectRatioByExpanding,
+                                         tile, [tile](const QPixmap &pix) { tile->setImage(pix); });
+        }
         tile->setEnabled(ok);
         tile->setCheckable(ok);
         if (ok)
@@ -775,10 +753,12 @@ void InventoryWindow::onMatSelected(int matId)
     QJsonObject body; body["tapete_id"] = matId;
     auto *reply = m_netMgr->post(req, QJsonDocument(body).toJson());
 
-    connect(reply, &QNetworkReply::finished, this, [reply]() {
+    connect(reply, &QNetworkReply::finished, this, [this, reply, matId]() {
         if (reply->error() == QNetworkReply::NoError) {
             QByteArray raw = reply->readAll();
             qDebug() << "[DEBUG] Respuesta equip_tapete:" << QString::fromUtf8(raw);
+            HttpCache::instance().invalidate("/usuarios/get_equipped_items/");
+            PlayerProfiles::instance().updateEquipped(m_numericUserId, -1, matId);
 
             QJsonDocument doc = QJsonDocument::fromJson(raw);
             if (doc.isObject()) {
@@ -807,4 +787,16 @@ void InventoryWindow::onMatSelected(int matId)
 
 InventoryWindow::~InventoryWindow() {}
 
+/**
+ * @brief Casillas de barajas y tapetes, recortadas igual que las pinta CardTile.
+ */
+QList<ImageLoader::Request> InventoryWindow::warmUpImages() {
+    QList<ImageLoader::Request> requests;
+    for (const QString &path : kDeckTiles)
+        requests.append({path, kTileImageSize, Qt::KeepAspectRatioByExpanding});
+    for (const QString &path : kMatTiles)
+        requests.append({path, kTileImageSize, Qt::KeepAspectRatioByExpanding});
+    return requests;
+}
+
 #include "inventorywindow.moc"
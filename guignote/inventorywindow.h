@@ -26,6 +26,8 @@
 #include <QPushButton>
 #include <QGraphicsOpacityEffect>
 #include <QButtonGroup>
+#include "playerprofiles.h"
+#include "imageloader.h"
 
 /**
  * @class InventoryWindow
@@ -49,6 +51,11 @@ public:
     /** @brief Destructor. */
     ~InventoryWindow();
 
+    /**
+     * @brief Imágenes de las casillas de barajas y tapetes, a su tamaño en la rejilla.
+     */
+    static QList<ImageLoader::Request> warmUpImages();
+
 private:
     QListWidget *sidebar;            ///< Lista lateral para navegación por pestañas.
     QStackedWidget *stackedWidget;   ///< Contenedor apilado para los contenidos de cada pestaña.
@@ -97,7 +104,7 @@ private slots:
      */
     void onTabChanged(int index);
 
-    void onGetUserIdReply(QNetworkReply *reply);
+    void onProfileReady(const PlayerProfiles::Profile &profile);
     void onUnlockedSkinsReply(QNetworkReply *reply);
 
     void onDeckSelected(int skinId);
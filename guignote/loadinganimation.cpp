@@ -0,0 +1,223 @@
+/**
+ * @file loadinganimation.cpp
+ * @brief Implementación de la clase LoadingAnimation.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * Contiene la composición del logotipo y los textos y el pintado de cada fotograma.
+ */
+
+#include "loadinganimation.h"
+#include "imageloader.h"
+#include <QPainter>
+#include <QPaintEvent>
+#include <QFontDatabase>
+#include <QEasingCurve>
+#include <QtMath>
+
+namespace {
+/// Mismos colores que el gif original.
+const QColor kFondo(0xFE, 0xF6, 0xF0);
+const QColor kTinta(0x1A, 0x14, 0x14);
+
+/// Familia de la fuente manuscrita del título (se registra una sola vez).
+QString familiaTitulo() {
+    static const QString familia = []() {
+        int id = QFontDatabase::addApplicationFont(":/fonts/GlossypersonaluseRegular-eZL93.otf");
+        return id == -1 ? QString() : QFontDatabase::applicationFontFamilies(id).value(0);
+    }();
+    return familia;
+}
+
+/// Texto en un pixmap transparente ajustado a su tamaño.
+QPixmap textoEnPixmap(const QString &texto, const QFont &font, qreal dpr) {
+    const QSize size = QFontMetrics(font).size(Qt::TextSingleLine, texto) + QSize(8, 4);
+    QPixmap pixmap(size * dpr);
+    pixmap.setDevicePixelRatio(dpr);
+    pixmap.fill(Qt::transparent);
+    QPainter painter(&pixmap);
+    painter.setRenderHint(QPainter::TextAntialiasing);
+    painter.setFont(font);
+    painter.setPen(kTinta);
+    painter.drawText(QRect(QPoint(0, 0), size), Qt::AlignCenter, texto);
+    return pixmap;
+}
+}
+
+/**
+ * @brief Constructor de LoadingAnimation.
+ *
+ * El widget pinta todo su fondo, así que Qt no necesita borrarlo antes.
+ */
+LoadingAnimation::LoadingAnimation(QWidget *parent)
+    : QWidget(parent)
+{
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    frameTimer.setInterval(kFrameMs);
+    frameTimer.setTimerType(Qt::CoarseTimer);
+    connect(&frameTimer, &QTimer::timeout, this, &LoadingAnimation::nextFrame);
+}
+
+/**
+ * @brief Detiene la animación.
+ */
+void LoadingAnimation::stop() {
+    frameTimer.stop();
+}
+
+/**
+ * @brief Progreso de la entrada, de 0 a 1.
+ */
+qreal LoadingAnimation::introProgress() const {
+    if (!clock.isValid())
+        return 0.0;
+    return qMin<qreal>(1.0, qreal(clock.elapsed()) / kIntroMs);
+}
+
+/**
+ * @brief Compone logotipo y textos al tamaño actual.
+ *
+ * Se hace al cambiar de tamaño, no en cada fotograma. El logotipo se decodifica
+ * ya escalado con ImageLoader y se tiñe del color de la tinta.
+ */
+void LoadingAnimation::compose() {
+    const int h = height();
+    const qreal dpr = devicePixelRatioF();
+    if (h <= 0)
+        return;
+
+    QPixmap fuente = ImageLoader::instance().pixmap(":/images/app_logo_no_letters.png",
+                                                    QSize(width(), h * 22 / 100) * dpr);
+    logo = QPixmap();
+    if (!fuente.isNull()) {
+        logo = QPixmap(fuente.size());
+        logo.fill(Qt::transparent);
+        QPainter painter(&logo);
+        painter.drawPixmap(0, 0, fuente);
+        painter.setCompositionMode(QPainter::CompositionMode_SourceIn);
+        painter.fillRect(logo.rect(), kTinta);
+        painter.end();
+        logo.setDevicePixelRatio(dpr);
+    }
+
+    QFont fuenteTitulo(familiaTitulo());
+    fuenteTitulo.setPixelSize(qMax(12, h * 8 / 100));
+    title = textoEnPixmap("Sota, Caballo y Rey", fuenteTitulo, dpr);
+
+    QFont fuenteSubtitulo("Georgia");
+    fuenteSubtitulo.setPixelSize(qMax(8, h * 18 / 1000));
+    fuenteSubtitulo.setLetterSpacing(QFont::PercentageSpacing, 130);
+    caption = textoEnPixmap("GRACE HOPPER", fuenteSubtitulo, dpr);
+
+    // Columna centrada: logotipo, título, subtítulo y puntos
+    const QSize logoSize = logo.isNull() ? QSize() : logo.size() / dpr;
+    const QSize titleSize = title.size() / dpr;
+    const QSize captionSize = caption.size() / dpr;
+    const int dot = qMax(4, h / 120);
+    const int gap = h / 40;
+    const int total = logoSize.height() + gap + titleSize.height() + gap
+                      + captionSize.height() + gap + dot;
+    int y = (h - total) / 2;
+    const int cx = width() / 2;
+
+    logoRect = QRect(QPoint(cx - logoSize.width() / 2, y), logoSize);
+    y += logoSize.height() + gap;
+    titleRect = QRect(QPoint(cx - titleSize.width() / 2, y), titleSize);
+    y += titleSize.height() + gap;
+    captionRect = QRect(QPoint(cx - captionSize.width() / 2, y), captionSize);
+    y += captionSize.height() + gap;
+    dotsRect = QRect(cx - dot * 4, y, dot * 8, dot);
+}
+
+/**
+ * @brief Avanza un fotograma repintando solo la zona que cambia.
+ */
+void LoadingAnimation::nextFrame() {
+    if (!introDone) {
+        // El logotipo sube unos píxeles al aparecer: se incluye su recorrido
+        update(logoRect.adjusted(0, 0, 0, height() / 50)
+                   .united(titleRect).united(captionRect).united(dotsRect));
+        introDone = introProgress() >= 1.0;
+    } else {
+        update(dotsRect);
+    }
+}
+
+/**
+ * @brief Pinta el fotograma actual a partir de los pixmaps ya compuestos.
+ */
+void LoadingAnimation::paintEvent(QPaintEvent *event) {
+    QPainter painter(this);
+    painter.fillRect(event->rect(), kFondo);
+
+    const QEasingCurve ease(QEasingCurve::OutCubic);
+    const qreal t = introProgress();
+    auto tramo = [t](qreal desde, qreal hasta) {
+        return qBound<qreal>(0.0, (t - desde) / (hasta - desde), 1.0);
+    };
+
+    // 1) Logotipo: fundido y subida
+    const qreal logoT = ease.valueForProgress(tramo(0.0, 0.45));
+    if (!logo.isNull() && logoT > 0.0) {
+        painter.setOpacity(logoT);
+        painter.drawPixmap(logoRect.topLeft() + QPoint(0, qRound((1.0 - logoT) * height() / 50)), logo);
+    }
+
+    // 2) Título: se descubre de izquierda a derecha, como si se escribiera
+    const qreal titleT = tramo(0.3, 0.9);
+    if (titleT > 0.0) {
+        painter.setOpacity(1.0);
+        const int visible = qRound(titleRect.width() * titleT);
+        painter.drawPixmap(titleRect.topLeft(), title,
+                           QRectF(0, 0, visible * title.devicePixelRatio(),
+                                  title.height()));
+    }
+
+    // 3) Subtítulo
+    const qreal captionT = tramo(0.75, 1.0);
+    if (captionT > 0.0) {
+        painter.setOpacity(captionT);
+        painter.drawPixmap(captionRect.topLeft(), caption);
+    }
+
+    // 4) Puntos de espera, cuando ya terminó la entrada
+    if (t >= 1.0) {
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setPen(Qt::NoPen);
+        const int dot = dotsRect.height();
+        const qreal fase = (clock.elapsed() - kIntroMs) / 400.0;
+        for (int i = 0; i < 3; ++i) {
+            painter.setOpacity(0.25 + 0.75 * (0.5 + 0.5 * qSin(fase - i * 0.9)));
+            painter.setBrush(kTinta);
+            painter.drawEllipse(QRect(dotsRect.x() + dot * (1 + 3 * i) - dot / 2,
+                                      dotsRect.y(), dot, dot));
+        }
+    }
+}
+
+/**
+ * @brief Recompone los pixmaps para el nuevo tamaño.
+ */
+void LoadingAnimation::resizeEvent(QResizeEvent *event) {
+    QWidget::resizeEvent(event);
+    compose();
+}
+
+/**
+ * @brief Arranca (o reanuda) la animación al mostrarse.
+ */
+void LoadingAnimation::showEvent(QShowEvent *event) {
+    QWidget::showEvent(event);
+    if (!clock.isValid())
+        clock.start();
+    frameTimer.start();
+}
+
+/**
+ * @brief Oculta, no se pinta: se detiene el temporizador.
+ */
+void LoadingAnimation::hideEvent(QHideEvent *event) {
+    QWidget::hideEvent(event);
+    frameTimer.stop();
+}
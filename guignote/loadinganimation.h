@@ -0,0 +1,75 @@
+/**
+ * @file loadinganimation.h
+ * @brief Declaración de la clase LoadingAnimation, animación de la pantalla de carga.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * Sustituye al antiguo "carga.gif" (150 fotogramas 1920×1080 decodificados y
+ * reescalados uno a uno). El logotipo y los textos se componen una sola vez al
+ * tamaño de la ventana; cada fotograma solo copia esos pixmaps con otra
+ * opacidad o recorte, y solo repinta la zona que cambia.
+ */
+
+#ifndef LOADINGANIMATION_H
+#define LOADINGANIMATION_H
+
+#include <QWidget>
+#include <QPixmap>
+#include <QTimer>
+#include <QElapsedTimer>
+
+/**
+ * @class LoadingAnimation
+ * @brief Presentación del logotipo mientras arranca la aplicación.
+ *
+ * Primero aparece el logotipo y se "escribe" el título de izquierda a derecha;
+ * después quedan tres puntos latiendo bajo el texto hasta que termina la carga.
+ * La animación solo avanza mientras el widget está visible.
+ */
+class LoadingAnimation : public QWidget {
+    Q_OBJECT
+
+public:
+    /// Intervalo entre fotogramas (~30 fps: de sobra para un fundido).
+    static constexpr int kFrameMs = 33;
+    /// Duración de la entrada del logotipo y el título.
+    static constexpr int kIntroMs = 1800;
+
+    /**
+     * @brief Constructor.
+     * @param parent Widget padre.
+     */
+    explicit LoadingAnimation(QWidget *parent = nullptr);
+
+    /** @brief Detiene la animación y deja el último fotograma. */
+    void stop();
+
+    /** @brief true mientras se están pintando fotogramas. */
+    bool isRunning() const { return frameTimer.isActive(); }
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+private:
+    void compose();
+    void nextFrame();
+    qreal introProgress() const;
+
+    QTimer frameTimer;          ///< Marca los fotogramas.
+    QElapsedTimer clock;        ///< Tiempo desde que empezó la animación.
+    bool introDone = false;     ///< La entrada ya terminó: solo se repintan los puntos.
+
+    QPixmap logo;               ///< Logotipo ya escalado y teñido.
+    QPixmap title;              ///< "Sota, Caballo y Rey" en la fuente del juego.
+    QPixmap caption;            ///< "GRACE HOPPER".
+    QRect logoRect;             ///< Posición del logotipo.
+    QRect titleRect;            ///< Posición del título.
+    QRect captionRect;          ///< Posición del subtítulo.
+    QRect dotsRect;             ///< Zona de los puntos de espera.
+};
+
+#endif // LOADINGANIMATION_H
@@ -6,45 +6,44 @@
  * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
  *
  * Contiene la definición de la ventana de carga a pantalla completa,
- * que muestra un GIF animado, gestiona el temporizador de visualización
- * y la animación de desvanecimiento antes de pasar a MenuWindow.
+ * que muestra la animación del logotipo mientras dura el arranque y la animación
+ * de desvanecimiento antes de pasar a MenuWindow.
  */
 
 
 #include "loadingwindow.h"
+#include "session.h"
 #include "menuwindow.h"
+#include "startuporchestrator.h"
+#include "loadinganimation.h"
 #include <QVBoxLayout>
 #include <QTimer>
 #include <QPropertyAnimation>
 #include <QGraphicsOpacityEffect>
 #include <QShowEvent>
 #include <QMainWindow>
+#include <QSettings>
+#include <QApplication>
 #include <QDebug>
 
 /**
  * @brief Constructor de la pantalla de carga.
  * @param userKey Clave del usuario para pasar a la siguiente ventana.
  * @param parent Widget padre opcional.
+ * @param orchestrator Arranque ya lanzado o nullptr para lanzarlo aquí con el token guardado.
  *
- * Configura el diálogo sin bordes, a pantalla completa, inicializa
- * el GIF de carga, el temporizador de visualización y el efecto de opacidad.
+ * Configura el diálogo sin bordes, a pantalla completa, la animación
+ * de carga y el arranque en segundo plano.
  */
 
-LoadingWindow::LoadingWindow(const QString &userKey, QWidget *parent)
+LoadingWindow::LoadingWindow(const QString &userKey, QWidget *parent, StartupOrchestrator *orchestrator)
     : QDialog(parent),
     userKey(userKey),
-    gifLabel(new QLabel(this)),
-    loadingMovie(new QMovie(":/video/carga.gif")),
-    displayTimer(new QTimer(this)),
+    animation(new LoadingAnimation(this)),
+    orchestrator(orchestrator),
     fadeAnimation(nullptr),
     fadeOutStarted(false)
 {
-    if (!loadingMovie->isValid()) {
-        qWarning() << "El gif no se pudo cargar. Verifica la ruta.";
-    }
-
-    gifLabel->setScaledContents(true);
-
     // Configuración de la ventana: sin bordes, a pantalla completa y fondo negro.
     setWindowFlags(Qt::FramelessWindowHint);
     setAttribute(Qt::WA_TranslucentBackground, true);
@@ -55,23 +54,19 @@ LoadingWindow::LoadingWindow(const QString &userKey, QWidget *parent)
     QVBoxLayout *mainLayout = new QVBoxLayout(this);
     mainLayout->setContentsMargins(0, 0, 0, 0);
     mainLayout->setSpacing(0);
-    mainLayout->addWidget(gifLabel);
-    gifLabel->setAlignment(Qt::AlignCenter);
-
-    // Configuración del gif.
-    gifLabel->setMovie(loadingMovie);
-    loadingMovie->start();
-
-    // Configurar el timer para la duración de la pantalla de carga (3.5 segundos antes de iniciar el fade out).
-    displayTimer->setSingleShot(true);
-    connect(displayTimer, &QTimer::timeout, this, [this, userKey]() {
-        this->startFadeOut(userKey);
+    // La animación se pinta sola y solo mientras es visible.
+    mainLayout->addWidget(animation);
+
+    // La pantalla de carga dura lo que tarda el trabajo real de arranque (sin temporizador fijo).
+    if (!this->orchestrator) {
+        // Login manual: el token ya está en la sesión
+        this->orchestrator = new StartupOrchestrator(userKey, qApp);
+        this->orchestrator->startWithToken(Session::forUser(userKey).token());
+    }
+    connect(this->orchestrator, &StartupOrchestrator::finished, this, [this, userKey]() {
+        if (isVisible())
+            this->startFadeOut(userKey);
     });
-
-    // Configurar el efecto de opacidad.
-    QGraphicsOpacityEffect *opacityEffect = new QGraphicsOpacityEffect(this);
-    this->setGraphicsEffect(opacityEffect);
-    opacityEffect->setOpacity(1.0);
 }
 
 /**
@@ -90,7 +85,7 @@ LoadingWindow::~LoadingWindow()
 /**
  * @brief Evento que se ejecuta al mostrar la ventana.
  *
- * Inicia el gif y programa la transición a la ventana del menú.
+ * Ajusta la geometría y programa la transición a la ventana del menú.
  *
  * @param event Evento de tipo QShowEvent.
  */
@@ -104,12 +99,9 @@ void LoadingWindow::showEvent(QShowEvent *event)
         // Si no hay widget padre, se ajusta a la geometría de la pantalla disponible.
         setGeometry(QGuiApplication::primaryScreen()->availableGeometry());
     }
-    if (loadingMovie) {
-        loadingMovie->start();
-    }
-    // Inicia el timer solo si no se ha iniciado ya el fade out.
-    if (!fadeOutStarted) {
-        displayTimer->start(3500);
+    // Si el arranque terminó antes de mostrarse la ventana, se pasa directamente al menú.
+    if (!fadeOutStarted && orchestrator && orchestrator->isFinished()) {
+        QTimer::singleShot(0, this, [this]() { startFadeOut(this->userKey); });
     }
 }
 
@@ -121,14 +113,16 @@ void LoadingWindow::startFadeOut(const QString &userKey) {
         return;
     fadeOutStarted = true;
 
-    // Obtener el efecto de opacidad aplicado.
-    QGraphicsOpacityEffect *opacityEffect = qobject_cast<QGraphicsOpacityEffect*>(this->graphicsEffect());
-    if (!opacityEffect)
-        return;
+    // El efecto de opacidad obliga a componer la ventana entera fuera de pantalla en cada
+    // repintado: solo se instala para el fundido, con la animación ya parada.
+    animation->stop();
+    QGraphicsOpacityEffect *opacityEffect = new QGraphicsOpacityEffect(this);
+    opacityEffect->setOpacity(1.0);
+    this->setGraphicsEffect(opacityEffect);
 
     // Configurar la animación sobre la propiedad "opacity" del efecto.
     fadeAnimation = new QPropertyAnimation(opacityEffect, "opacity");
-    fadeAnimation->setDuration(1000); // Duración de 1 segundo.
+    fadeAnimation->setDuration(300); // Transición breve: el menú ya tiene sus datos.
     fadeAnimation->setStartValue(1.0);
     fadeAnimation->setEndValue(0.0);
     connect(fadeAnimation, &QPropertyAnimation::finished, this, [=]() {
@@ -143,9 +137,6 @@ void LoadingWindow::startFadeOut(const QString &userKey) {
  * Abre la ventana del menú y cierra la pantalla de carga.
  */
 void LoadingWindow::onFadeOutFinished(const QString &userKey) {
-    if (loadingMovie) {
-        loadingMovie->stop();
-    }
     // Si LoadingWindow tiene un padre y éste es un QMainWindow, se reemplaza su widget central.
     QMainWindow *mainWin = qobject_cast<QMainWindow*>(parentWidget());
     if (mainWin) {
@@ -159,6 +150,14 @@ void LoadingWindow::onFadeOutFinished(const QString &userKey) {
         menuWin->showFullScreen();
     }
 
+    // Tiempo hasta el primer fotograma interactivo del menú
+    StartupOrchestrator *orch = orchestrator;
+    QTimer::singleShot(0, orch, [orch]() {
+        orch->markInteractive();
+        orch->deleteLater();
+    });
+    orchestrator = nullptr;
+
     if (fadeAnimation) {
         fadeAnimation->deleteLater();
         fadeAnimation = nullptr;
@@ -166,15 +165,3 @@ void LoadingWindow::onFadeOutFinished(const QString &userKey) {
     // Cierra la pantalla de carga.
     this->close();
 }
-
-/**
- * @brief Evento que se ejecuta al cambiar el tamaño de la ventana.
- *
- * Ajusta el tamaño del label del gif al de la ventana.
- *
- * @param event Evento de tipo QResizeEvent.
- */
-void LoadingWindow::resizeEvent(QResizeEvent *event) {
-    QDialog::resizeEvent(event);  // Llama a la implementación base.
-    gifLabel->setFixedSize(this->size());  // Ajusta el label al tamaño de la ventana.
-}
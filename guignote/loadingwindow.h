@@ -5,20 +5,22 @@
  * Este archivo forma parte del Proyecto de Software 2024/2025
  * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
  *
- * Esta clase representa la pantalla de carga inicial que muestra una animación GIF
- * ("carga.gif") a pantalla completa durante unos segundos, seguido de un efecto
- * de desvanecimiento que da paso a la ventana principal del menú (MenuWindow).
+ * Esta clase representa la pantalla de carga inicial que muestra la animación del
+ * logotipo (LoadingAnimation) a pantalla completa mientras StartupOrchestrator completa
+ * el arranque, seguido de un efecto de desvanecimiento que da paso a la ventana principal
+ * del menú (MenuWindow).
  */
 
 #ifndef LOADINGWINDOW_H
 #define LOADINGWINDOW_H
 
 #include <QDialog>
-#include <QMovie>
-#include <QLabel>
 #include <QTimer>
 #include <QPropertyAnimation>
 
+class StartupOrchestrator;
+class LoadingAnimation;
+
 /**
  * @class LoadingWindow
  * @brief Ventana que muestra una animación de carga antes de mostrar el menú principal.
@@ -32,8 +34,11 @@ public:
      * @brief Constructor de la pantalla de carga.
      * @param userKey Clave del usuario para pasar al menú principal.
      * @param parent Widget padre.
+     * @param orchestrator Arranque ya en marcha (login automático); si es nullptr se crea
+     *        uno con el token guardado.
      */
-    explicit LoadingWindow(const QString &userKey, QWidget *parent = nullptr);
+    explicit LoadingWindow(const QString &userKey, QWidget *parent = nullptr,
+                           StartupOrchestrator *orchestrator = nullptr);
 
     /** @brief Destructor. */
     ~LoadingWindow();
@@ -42,17 +47,11 @@ protected:
     /**
      * @brief Evento que se ejecuta al mostrar la ventana.
      *
-     * Inicia la reproducción del gif y programa la transición a la ventana del menú.
+     * Ajusta la geometría; la transición al menú empieza cuando termina el arranque.
      * @param event Evento de tipo QShowEvent.
      */
     void showEvent(QShowEvent *event) override;
 
-    /**
-     * @brief Evento de redimensionamiento de la ventana.
-     * @param event Evento de tipo QResizeEvent.
-     */
-    void resizeEvent(QResizeEvent *event) override;
-
 private slots:
     /**
      * @brief Inicia la animación de desvanecimiento de la pantalla de carga.
@@ -71,9 +70,8 @@ private slots:
 private:
     QString userKey;                      ///< Clave del usuario autenticado.
 
-    QLabel *gifLabel;                     ///< Etiqueta para mostrar el gif.
-    QMovie *loadingMovie;                 ///< Objeto QMovie para reproducir el gif.
-    QTimer *displayTimer;                 ///< Temporizador para controlar duración.
+    LoadingAnimation *animation;          ///< Animación del logotipo.
+    StartupOrchestrator *orchestrator;    ///< Trabajo de arranque que marca el fin de la carga.
     QPropertyAnimation *fadeAnimation;    ///< Animación para desvanecer la pantalla.
     bool fadeOutStarted = false;          ///< Bandera para evitar múltiples fade outs.
 };
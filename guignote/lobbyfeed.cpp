@@ -0,0 +1,53 @@
+/**
+ * @file lobbyfeed.cpp
+ * @brief Implementación de la clase LobbyFeed.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ */
+
+#include "lobbyfeed.h"
+#include "roomwatcher.h"
+
+/**
+ * @brief Constructor de LobbyFeed.
+ * @param token Token de autenticación.
+ * @param path Ruta de la lista de salas.
+ * @param parent Objeto padre.
+ */
+LobbyFeed::LobbyFeed(const QString &token, const QString &path, QObject *parent)
+    : QObject(parent),
+      watcher(new RoomWatcher(token, {path}, "[LOBBY]", kMinPollMs, kMaxPollMs, this))
+{
+    connect(watcher, &RoomWatcher::changed, this, [this]() {
+        emit roomsChanged(watcher->salas(0));
+    });
+}
+
+/**
+ * @brief Abre el canal de avisos y lanza la primera consulta.
+ */
+void LobbyFeed::start() {
+    watcher->start();
+}
+
+/**
+ * @brief Deja de vigilar: sin canal, sin sondeo y sin consulta pendiente.
+ */
+void LobbyFeed::stop() {
+    watcher->stop();
+}
+
+/**
+ * @brief Consulta ya; con una consulta en curso, la repite al terminar.
+ */
+void LobbyFeed::refresh() {
+    watcher->refresh();
+}
+
+/**
+ * @brief Cambia la ruta vigilada; la lista y el ETag anteriores dejan de valer.
+ */
+void LobbyFeed::setPath(const QString &path) {
+    watcher->setPath(0, path);
+}
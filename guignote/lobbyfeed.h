@@ -0,0 +1,72 @@
+/**
+ * @file lobbyfeed.h
+ * @brief Declaración de la clase LobbyFeed.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * La clase LobbyFeed mantiene al día la lista de salas personalizadas
+ * disponibles mientras CustomGamesWindow está abierta.
+ */
+
+#ifndef LOBBYFEED_H
+#define LOBBYFEED_H
+
+#include <QObject>
+#include <QJsonArray>
+#include <QString>
+
+class RoomWatcher;
+
+/**
+ * @class LobbyFeed
+ * @brief Notifica los cambios en las salas disponibles.
+ *
+ * Igual que RejoinMonitor, delega en un RoomWatcher: los avisos del WebSocket
+ * de salas disparan una consulta y, sin canal, se sondea con espera creciente.
+ * Solo se emite roomsChanged() cuando la lista recibida difiere de la anterior.
+ */
+class LobbyFeed : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor.
+     * @param token Token de autenticación del usuario.
+     * @param path Ruta (con consulta) de la lista de salas.
+     * @param parent Objeto padre.
+     */
+    LobbyFeed(const QString &token, const QString &path, QObject *parent = nullptr);
+
+    /** @brief Abre el canal de avisos y hace la primera consulta. */
+    void start();
+
+    /** @brief Cierra el canal y detiene el sondeo (ventana oculta). */
+    void stop();
+
+    /** @brief Consulta ya, sin esperar al siguiente aviso o sondeo. */
+    void refresh();
+
+    /**
+     * @brief Cambia la lista vigilada (todas las salas o solo las de amigos) y la consulta.
+     * @param path Nueva ruta.
+     */
+    void setPath(const QString &path);
+
+    /** @brief Intervalo de sondeo mínimo (ms). */
+    static constexpr int kMinPollMs = 2000;
+    /** @brief Intervalo de sondeo máximo (ms). */
+    static constexpr int kMaxPollMs = 30000;
+
+signals:
+    /**
+     * @brief La lista de salas ha cambiado.
+     * @param salas Salas disponibles.
+     */
+    void roomsChanged(const QJsonArray &salas);
+
+private:
+    RoomWatcher *watcher;           ///< Avisos y sondeo de la lista de salas.
+};
+
+#endif // LOBBYFEED_H
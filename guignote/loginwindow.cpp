@@ -13,6 +13,7 @@
 
 
 #include "loginwindow.h"
+#include "session.h"
 #include "loadingwindow.h"
 
 // Inclusión de librerías de Qt necesarias para la interfaz y red
@@ -253,10 +254,8 @@ LoginWindow::LoginWindow(QWidget *parent)
 
                         // ← INICIO SNIPPET CORREGIDO
                         QSettings settings("Grace Hopper", "Sota, Caballo y Rey");
-                        // Guardar token en settings específicos por usuario (opcional)
-                        QSettings userSettings("Grace Hopper",
-                                               QString("Sota, Caballo y Rey_%1").arg(userKey));
-                        userSettings.setValue("auth/token", token);
+                        // La sesión guarda el token en memoria y lo escribe en disco en segundo plano
+                        Session::forUser(userKey).setToken(token);
 
                         // Guardado de “recordar” y credenciales en el QSettings base
                         settings.setValue("auth/remember", rememberCheck->isChecked());
@@ -13,64 +13,13 @@
 
 #include "loadingwindow.h"
 #include "mainwindow.h"
+#include "httpcache.h"
+#include "startuporchestrator.h"
+#include "session.h"
+#include "theme.h"
 #include <QApplication>
 #include <QSettings>
 #include <QString>
-#include <QNetworkAccessManager>
-#include <QNetworkRequest>
-#include <QNetworkReply>
-#include <QJsonDocument>
-#include <QJsonObject>
-#include <QEventLoop>
-#include <QUrl>
-
-
-/**
- * @brief Realiza un intento síncrono de login contra el servidor.
- * @param user Nombre de usuario o correo.
- * @param pass Contraseña en texto claro.
- * @param outToken Referencia donde devolver el token si tiene éxito.
- * @return true si la autenticación fue correcta y se obtuvo token, false en caso contrario.
- *
- * Envía una petición POST JSON a la API de login y espera de forma bloqueante
- * la respuesta antes de devolver el control.
- */
-
-bool tryLogin(const QString &user, const QString &pass, QString &outToken) {
-    QUrl url("http://188.165.76.134:8000/usuarios/iniciar_sesion/");
-    QNetworkRequest request(url);
-    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-
-    QJsonObject json;
-    if (user.contains('@'))
-        json["correo"] = user;
-    else
-        json["nombre"] = user;
-    json["contrasegna"] = pass;
-    QJsonDocument doc(json);
-
-    QNetworkAccessManager manager;
-    QNetworkReply *reply = manager.post(request, doc.toJson());
-
-    QEventLoop loop;
-    QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-    loop.exec();
-
-    if (reply->error() == QNetworkReply::NoError) {
-        QByteArray responseData = reply->readAll();
-        QJsonDocument responseDoc = QJsonDocument::fromJson(responseData);
-        if (responseDoc.isObject()) {
-            QJsonObject respObj = responseDoc.object();
-            if (respObj.contains("token")) {
-                outToken = respObj["token"].toString();
-                reply->deleteLater();
-                return true;
-            }
-        }
-    }
-    reply->deleteLater();
-    return false;
-}
 
 
 /**
@@ -80,8 +29,9 @@ bool tryLogin(const QString &user, const QString &pass, QString &outToken) {
  * @return Entero de estado de salida del proceso.
  *
  * Verifica si existen credenciales guardadas; si no, muestra la ventana principal
- * de login. Si hay credenciales, intenta login automático y muestra la pantalla de carga
- * o vuelve al login manual según el resultado. Además, limpia las credenciales al cerrar
+ * de login. Si hay credenciales, muestra al instante la pantalla de carga mientras
+ * StartupOrchestrator hace el login automático y la precarga en paralelo; si el login
+ * falla se vuelve al login manual. Además, limpia las credenciales al cerrar
  * si no está marcada la opción de “Recordar contraseña”.
  */
 
@@ -89,6 +39,9 @@ int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
 
+    // Hoja de estilo común: se analiza una vez y los widgets solo eligen su rol
+    Theme::apply();
+
     // Al salir de la aplicación, si "Recordar" no está marcado,
     // eliminamos las credenciales (usuario y contraseña)
     QObject::connect(qApp, &QCoreApplication::aboutToQuit, [](){
@@ -97,6 +50,10 @@ int main(int argc, char *argv[])
             settings.remove("auth/user");
             settings.remove("auth/pass");
         }
+        // Resumen de aciertos de la caché HTTP de la sesión
+        HttpCache::instance().logSummary();
+        // Terminar de escribir token y perfil antes de salir
+        Session::flushAll();
     });
 
     // Leer credenciales guardadas
@@ -111,20 +68,19 @@ int main(int argc, char *argv[])
         return a.exec();
     }
 
-    // 2) Si hay credenciales, intento login automático
-    QString token;
-    if (tryLogin(user, pass, token)) {
-        QSettings userSettings("Grace Hopper", QString("Sota, Caballo y Rey_%1").arg(user));
-        userSettings.setValue("auth/token", token);
-        // Muestro directamente el LoadingWindow
-        LoadingWindow *l = new LoadingWindow(user);
-        l->show();
-        return a.exec();
-    } else {
-        // Si falla, vuelvo al login manual
-        MainWindow w;
-        w.show();
-        return a.exec();
-    }
-
+    // 2) Si hay credenciales, la pantalla de carga aparece ya y el login automático
+    //    corre en paralelo con el resto del arranque
+    StartupOrchestrator *orchestrator = new StartupOrchestrator(user, qApp);
+    LoadingWindow *l = new LoadingWindow(user, nullptr, orchestrator);
+    QObject::connect(orchestrator, &StartupOrchestrator::loginFailed, l, [l]() {
+        // Si falla, vuelvo al login manual (se muestra antes de cerrar la carga
+        // para que la aplicación no se quede sin ventanas)
+        MainWindow *w = new MainWindow;
+        w->setAttribute(Qt::WA_DeleteOnClose);
+        w->show();
+        l->close();
+    });
+    l->show();
+    orchestrator->startWithLogin(user, pass);
+    return a.exec();
 }
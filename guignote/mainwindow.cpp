@@ -18,6 +18,7 @@
 #include "loginwindow.h"
 #include "registerwindow.h"
 #include "icon.h"
+#include "backdropservice.h"
 
 // Inclusión de librerías de Qt para gestionar layouts, widgets y efectos visuales
 #include <QVBoxLayout>
@@ -28,8 +29,6 @@
 #include <QPushButton>
 #include <QGraphicsDropShadowEffect>
 #include <QFontDatabase>
-#include <QResizeEvent>
-#include <QTransform>
 #include <QDialog>
 #include <QApplication>
 #include <QPainter>
@@ -42,17 +41,13 @@
  *
  * Inicializa la interfaz de usuario, establece el tamaño y fondo de la ventana, y configura
  * la disposición de widgets y efectos visuales. Además, define la lógica para abrir otras ventanas
- * (LoginWindow, RegisterWindow y SettingsWindow) y añade elementos decorativos en las esquinas.
+ * (LoginWindow, RegisterWindow y SettingsWindow).
  *
  * @param parent Widget padre, por defecto nullptr.
  */
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
-    , cornerTopLeft(nullptr)
-    , cornerTopRight(nullptr)
-    , cornerBottomLeft(nullptr)
-    , cornerBottomRight(nullptr)
 {
     // Inicializa la interfaz generada con Qt Designer
     ui->setupUi(this);
@@ -69,13 +64,7 @@ MainWindow::MainWindow(QWidget *parent)
         setCentralWidget(central);
     }
 
-    // Aplicar un fondo con gradiente radial a la ventana
-    this->setStyleSheet(
-        "QWidget {"
-        "  background: qradialgradient(cx:0.5, cy:0.5, radius:1, "
-        "  fx:0.5, fy:0.5, stop:0 #1f5a1f, stop:1 #0a2a08);"
-        "}"
-        );
+    // El fondo (gradiente verde y ornamentos) lo pinta paintEvent() desde BackdropService
 
     // Creación de una caja central (marco) con fondo y bordes redondeados
     QFrame *centralBox = new QFrame(ui->centralwidget);
@@ -227,62 +216,7 @@ MainWindow::MainWindow(QWidget *parent)
     mainLayoutWidget->addStretch();
     ui->centralwidget->setLayout(mainLayoutWidget);
 
-    // Configuración de los adornos decorativos en las esquinas
-    ornamentSize = QSize(300, 299);
-    QPixmap ornamentPixmap(":/images/set-golden-border-ornaments/gold_ornaments.png");
-
-    // Esquina superior izquierda
-    cornerTopLeft = new QLabel(ui->centralwidget);
-    QPixmap topLeftPixmap = ornamentPixmap.scaled(ornamentSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-    cornerTopLeft->setPixmap(topLeftPixmap);
-    cornerTopLeft->setFixedSize(ornamentSize);
-    cornerTopLeft->setAttribute(Qt::WA_TransparentForMouseEvents);
-    cornerTopLeft->setAttribute(Qt::WA_TranslucentBackground);
-    cornerTopLeft->setStyleSheet("background: transparent;");
-    cornerTopLeft->raise();
-
-    // Esquina superior derecha (imagen invertida horizontalmente)
-    cornerTopRight = new QLabel(ui->centralwidget);
-    QTransform transformH;
-    transformH.scale(-1, 1);
-    QPixmap topRightPixmap = ornamentPixmap.transformed(transformH, Qt::SmoothTransformation)
-                                 .scaled(ornamentSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-    cornerTopRight->setPixmap(topRightPixmap);
-    cornerTopRight->setFixedSize(ornamentSize);
-    cornerTopRight->setAttribute(Qt::WA_TransparentForMouseEvents);
-    cornerTopRight->setAttribute(Qt::WA_TranslucentBackground);
-    cornerTopRight->setStyleSheet("background: transparent;");
-    cornerTopRight->raise();
-
-    // Esquina inferior izquierda (imagen invertida verticalmente)
-    cornerBottomLeft = new QLabel(ui->centralwidget);
-    QTransform transformV;
-    transformV.scale(1, -1);
-    QPixmap bottomLeftPixmap = ornamentPixmap.transformed(transformV, Qt::SmoothTransformation)
-                                   .scaled(ornamentSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-    cornerBottomLeft->setPixmap(bottomLeftPixmap);
-    cornerBottomLeft->setFixedSize(ornamentSize);
-    cornerBottomLeft->setAttribute(Qt::WA_TransparentForMouseEvents);
-    cornerBottomLeft->setAttribute(Qt::WA_TranslucentBackground);
-    cornerBottomLeft->setStyleSheet("background: transparent;");
-    cornerBottomLeft->raise();
-
-    // Esquina inferior derecha (imagen invertida horizontal y verticalmente)
-    cornerBottomRight = new QLabel(ui->centralwidget);
-    QTransform transformHV;
-    transformHV.scale(-1, -1);
-    QPixmap bottomRightPixmap = ornamentPixmap.transformed(transformHV, Qt::SmoothTransformation)
-                                    .scaled(ornamentSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-    cornerBottomRight->setPixmap(bottomRightPixmap);
-    cornerBottomRight->setFixedSize(ornamentSize);
-    cornerBottomRight->setAttribute(Qt::WA_TransparentForMouseEvents);
-    cornerBottomRight->setAttribute(Qt::WA_TranslucentBackground);
-    cornerBottomRight->setStyleSheet("background: transparent;");
-    cornerBottomRight->raise();
-
-    // Reposicionar los adornos en las esquinas según el tamaño actual del widget central
     this->showFullScreen();
-    repositionOrnaments();
 }
 
 /**
@@ -296,35 +230,16 @@ MainWindow::~MainWindow()
 }
 
 /**
- * @brief Evento de redimensionamiento.
+ * @brief Pinta el tapete verde con sus ornamentos.
  *
- * Se invoca cuando la ventana cambia de tamaño, lo que permite reajustar la posición
- * de los adornos decorativos.
- *
- * @param event Evento de redimensionamiento.
- */
-void MainWindow::resizeEvent(QResizeEvent *event)
-{
-    QMainWindow::resizeEvent(event);
-    repositionOrnaments();
-}
-
-/**
- * @brief Reposiciona los adornos decorativos en las esquinas del widget central.
+ * El fondo se compone una vez por tamaño de ventana; aquí solo se copia.
  *
- * Calcula la posición en función del tamaño actual del widget central para mantener
- * la coherencia visual en la interfaz.
+ * @param event Evento de pintado.
  */
-void MainWindow::repositionOrnaments()
+void MainWindow::paintEvent(QPaintEvent *event)
 {
-    if (!ui->centralwidget) return;
-    int cw = ui->centralwidget->width();
-    int ch = ui->centralwidget->height();
-
-    cornerTopLeft->move(0, 0);
-    cornerTopRight->move(cw - cornerTopRight->width(), 0);
-    cornerBottomLeft->move(0, ch - cornerBottomLeft->height());
-    cornerBottomRight->move(cw - cornerBottomRight->width(), ch - cornerBottomRight->height());
+    Q_UNUSED(event);
+    BackdropService::paint(this, 1);
 }
 
 /**
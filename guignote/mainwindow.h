@@ -7,7 +7,7 @@
  *
  * La clase MainWindow gestiona la interfaz principal de la aplicación,
  * incluyendo la navegación hacia las ventanas de inicio de sesión y registro,
- * así como la gestión de decoraciones visuales en la ventana principal.
+ * así como el pintado del fondo de la ventana principal.
  */
 
 #ifndef MAINWINDOW_H
@@ -15,7 +15,6 @@
 
 #include <QMainWindow>
 
-class QLabel;  // Declaración adelantada de QLabel para evitar incluir todo el archivo
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
@@ -27,7 +26,7 @@ QT_END_NAMESPACE
  *
  * Esta clase extiende QMainWindow y se encarga de gestionar la interfaz principal,
  * incluyendo la apertura de ventanas secundarias como la de inicio de sesión (`LoginWindow`)
- * y la de registro (`RegisterWindow`). También maneja decoraciones y eventos de redimensionamiento.
+ * y la de registro (`RegisterWindow`). El fondo lo compone BackdropService.
  */
 class MainWindow : public QMainWindow
 {
@@ -59,22 +58,12 @@ private slots:
 private:
     Ui::MainWindow *ui; ///< Puntero a la interfaz gráfica generada por Qt Designer.
 
-    // --- Elementos decorativos de la ventana ---
-    QLabel *cornerTopLeft;     ///< Imagen decorativa en la esquina superior izquierda.
-    QLabel *cornerTopRight;    ///< Imagen decorativa en la esquina superior derecha.
-    QLabel *cornerBottomLeft;  ///< Imagen decorativa en la esquina inferior izquierda.
-    QLabel *cornerBottomRight; ///< Imagen decorativa en la esquina inferior derecha.
-
-    QSize ornamentSize; ///< Tamaño de los adornos en las esquinas de la ventana.
-
+protected:
     /**
-     * @brief Evento de redimensionamiento de la ventana.
-     * @param event Evento de tipo `QResizeEvent`.
+     * @brief Pinta el fondo del tapete (BackdropService).
+     * @param event Evento de tipo `QPaintEvent`.
      */
-    void resizeEvent(QResizeEvent *event) override;
-
-    /** @brief Reposiciona los adornos en las esquinas tras redimensionar. */
-    void repositionOrnaments();
+    void paintEvent(QPaintEvent *event) override;
 };
 
 #endif // MAINWINDOW_H
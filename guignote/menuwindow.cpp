@@ -8,6 +8,10 @@
  */
 
  #include "menuwindow.h"
+ #include "session.h"
+ #include "chathub.h"
+ #include "audioengine.h"
+ #include "backdropservice.h"
  #include "icon.h"
  #include "ui_menuwindow.h"
  #include "imagebutton.h"
@@ -18,6 +22,7 @@
  #include "myprofilewindow.h"
  #include "rankingwindow.h"
  #include "rejoinwindow.h"
+ #include "rejoinmonitor.h"
  #include "customgameswindow.h"
  #include <QGraphicsDropShadowEffect>
  #include <QTimer>
@@ -37,6 +42,14 @@
  #include <QWebSocketProtocol>
  #include <QApplication>
 #include "rankswindow.h"
+#include "httpcache.h"
+#include <QImageReader>
+ 
+ namespace {
+ /// Imágenes de los botones de modo de juego.
+ const QString kBoton1v1 = QStringLiteral(":/images/cartaBoton.png");
+ const QString kBoton2v2 = QStringLiteral(":/images/cartasBoton.png");
+ }
  
  // Función auxiliar para crear un diálogo modal de sesión expirada.
  static QDialog* createExpiredDialog(QWidget *parent) {
@@ -112,13 +125,7 @@
          gameWindow->init();
      });
  
-     // ⚠️ Parar música antes de cerrar
-     if (backgroundPlayer) {
-         backgroundPlayer->stop();
-         backgroundPlayer->deleteLater();
-         backgroundPlayer = nullptr;
-     }
-
+     // La música no se para: la partida solo cambia de pista en AudioEngine
      for (QWidget *w : QApplication::topLevelWidgets()) {
          if (w != gameWindow) {
              w->close();
@@ -126,85 +133,7 @@
      }
  }
  
- void MenuWindow::checkRejoin() {
-     QNetworkAccessManager *networkManager = new QNetworkAccessManager(this);
-
-     // Primer consulta: salas reconectables
-     QNetworkRequest requestReconectables(QUrl("http://188.165.76.134:8000/salas/reconectables/"));
-     requestReconectables.setRawHeader("Auth", token.toUtf8());
-     qDebug() << "Comprobamos salas reconectables...";
-
-     QNetworkReply *replyReconectables = networkManager->get(requestReconectables);
-
-     // Segunda consulta: salas pausadas
-     QNetworkRequest requestPausadas(QUrl("http://188.165.76.134:8000/salas/pausadas/"));
-     requestPausadas.setRawHeader("Auth", token.toUtf8());
-     qDebug() << "Comprobamos salas pausadas...";
-
-     QNetworkReply *replyPausadas = networkManager->get(requestPausadas);
-
-     connect(replyReconectables, &QNetworkReply::finished, this, [this, replyReconectables, replyPausadas]() {
-         // Comprobación de errores para salas reconectables
-         if (replyReconectables->error() != QNetworkReply::NoError) {
-             qDebug() << "Error de red (reconectables):" << replyReconectables->errorString();
-             replyReconectables->deleteLater();
-             return;
-         }
-
-         const QByteArray dataReconectables = replyReconectables->readAll();
-         QJsonParseError parseErrorReconectables;
-         QJsonDocument docReconectables = QJsonDocument::fromJson(dataReconectables, &parseErrorReconectables);
-         if (parseErrorReconectables.error != QJsonParseError::NoError || !docReconectables.isObject()) {
-             qDebug() << "Error parseando JSON (reconectables):" << parseErrorReconectables.errorString();
-             replyReconectables->deleteLater();
-             return;
-         }
-
-         QJsonObject objReconectables = docReconectables.object();
-         if (!objReconectables.contains("salas") || !objReconectables.value("salas").isArray()) {
-             qDebug() << "La respuesta de salas reconectables no contiene el campo 'salas'";
-             replyReconectables->deleteLater();
-         } else {
-             salas = objReconectables.value("salas").toArray();
-         }
-
-         // Comprobación de errores para salas pausadas
-         if (replyPausadas->error() != QNetworkReply::NoError) {
-             qDebug() << "Error de red (pausadas):" << replyPausadas->errorString();
-             replyPausadas->deleteLater();
-             return;
-         }
-
-         const QByteArray dataPausadas = replyPausadas->readAll();
-         QJsonParseError parseErrorPausadas;
-         QJsonDocument docPausadas = QJsonDocument::fromJson(dataPausadas, &parseErrorPausadas);
-         if (parseErrorPausadas.error != QJsonParseError::NoError || !docPausadas.isObject()) {
-             qDebug() << "Error parseando JSON (pausadas):" << parseErrorPausadas.errorString();
-             replyPausadas->deleteLater();
-             return;
-         }
-
-         QJsonObject objPausadas = docPausadas.object();
-         if (!objPausadas.contains("salas") || !objPausadas.value("salas").isArray()) {
-             qDebug() << "La respuesta de salas pausadas no contiene el campo 'salas'";
-             replyPausadas->deleteLater();
-         } else {
-             salasPausadas = objPausadas.value("salas").toArray();
-         }
 
-         // Lógica para mostrar el botón
-         if (salas.isEmpty() && salasPausadas.isEmpty()) {
-             ReconnectButton->hide();
-         } else {
-             ReconnectButton->show();
-         }
-
-         replyReconectables->deleteLater();
-         replyPausadas->deleteLater();
-     });
- }
-
- 
  // Constructor de la clase MenuWindow
  MenuWindow::MenuWindow(const QString &userKey, QWidget *parent) :
      QWidget(parent),
@@ -217,24 +146,33 @@
      friends(nullptr),
      exit(nullptr),
      usrLabel(nullptr),
-     rejoinTimer(new QTimer(this))
+     rejoinMonitor(nullptr)
  {
      this->setAttribute(Qt::WA_DeleteOnClose);
-     connect(rejoinTimer, &QTimer::timeout,
-             this, &MenuWindow::checkRejoin);
-     rejoinTimer->start(1000);
  
      ui->setupUi(this);
      // Activa el relleno de fondo desde la hoja de estilo
      this->setAttribute(Qt::WA_StyledBackground, true);
  
      this->userKey = userKey;
-     token = loadAuthToken(userKey);
+     token = Session::forUser(userKey).token();
      qDebug() << "Token recibido: " + token;
  
+     // Aviso de caducidad sin esperar a que el servidor responda 401
+     connect(&Session::forUser(userKey), &Session::expired, this, [this]() {
+         createExpiredDialog(this)->show();
+     });
+
+     // Mensajes de chats sin ventana abierta (las conexiones siguen vivas en ChatHub)
+     connect(&ChatHub::forUser(userKey), &ChatHub::unreadChanged, this, [this]() {
+         unreadMessages = ChatHub::forUser(this->userKey).totalUnread();
+         if (countLabel)
+             showBadge();
+     });
+ 
      // ------------- IMÁGENES DE CARTAS -------------
-     boton1v1 = new ImageButton(":/images/cartaBoton.png", "Individual", this);
-     boton2v2 = new ImageButton(":/images/cartasBoton.png", "Parejas", this);
+     boton1v1 = new ImageButton(kBoton1v1, "Individual", this);
+     boton2v2 = new ImageButton(kBoton2v2, "Parejas", this);
  
      // ------------- EVENTOS DE CLICK EN CARTAS -------------
      connect(boton1v1, &ImageButton::clicked, this, [this, userKey]() {
@@ -286,6 +224,8 @@
              );
          rjWin->setModal(true);
          rjWin->exec();
+         // Al volver del diálogo las salas pueden haber cambiado
+         rejoinMonitor->refresh();
      });
  
      QHBoxLayout *h = new QHBoxLayout;
@@ -298,7 +238,15 @@
  
      setLayout(mainLayout);
  
-     checkRejoin();
+     // Avisos de salas reconectables/pausadas (WebSocket, con sondeo adaptativo de respaldo)
+     rejoinMonitor = new RejoinMonitor(token, this);
+     connect(rejoinMonitor, &RejoinMonitor::roomsChanged, this,
+             [this](const QJsonArray &reconectables, const QJsonArray &pausadas) {
+         salas = reconectables;
+         salasPausadas = pausadas;
+         ReconnectButton->setVisible(!salas.isEmpty() || !salasPausadas.isEmpty());
+     });
+     rejoinMonitor->start();
  
      // ------------- BARRAS (BARS) -------------
      bottomBar = new QFrame(this);
@@ -319,58 +267,37 @@
  
      // ------------- NOMBRE DE USUARIO Y RANGO EN TOPBAR -------------
      usrLabel = new QLabel(this);
-     QTimer::singleShot(1000, this, [this]() {
-         // Se carga el token desde el archivo de configuración
+     // Se pinta con el perfil de la sesión (lo deja la pantalla de carga) y se repinta
+     // cuando cambia. Se difiere al bucle de eventos porque el primer pintado muestra la
+     // ventana, lo que no debe ocurrir a mitad del constructor.
+     QTimer::singleShot(0, this, [this]() {
          if (token.isEmpty()) {
              usrLabel->setText("ERROR");
-         } else {
-             QNetworkAccessManager *networkManager = new QNetworkAccessManager(this);
-             QNetworkRequest request(QUrl("http://188.165.76.134:8000/usuarios/estadisticas/"));
-             request.setRawHeader("Auth", token.toUtf8());
- 
-             QNetworkReply *reply = networkManager->get(request);
-             connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-                 int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
-                 if (statusCode == 401) {
-                     createExpiredDialog(this)->show();
-                     reply->deleteLater();
-                     return;
-                 }
-                 if (reply->error() == QNetworkReply::NoError) {
-                     QByteArray responseData = reply->readAll();
-                     QJsonDocument jsonDoc = QJsonDocument::fromJson(responseData);
-                     QJsonObject jsonObj = jsonDoc.object();
- 
-                     // Se extrae el nombre del usuario y otros datos
-                     QString nombre = jsonObj.value("nombre").toString();
-                     this->usr = nombre;
-                     int ELO = jsonObj.value("elo").toInt(); // Actualiza si dispones de este dato
-                     QString rank = "Rango"; // Actualiza si se recibe el rango
- 
-                     QString UsrELORank = QString(
-                                              "<span style='font-size: 24px; font-weight: bold; color: white;'>%1 (%2) </span>"
-                                              "<span style='font-size: 20px; font-weight: normal; color: white;'>%3</span>"
-                                              ).arg(nombre).arg(ELO).arg(rank);
- 
-                     usrLabel->setText(UsrELORank);
-
-                     nameHasLoaded = true;
- 
-                     // ------------- MÚSICA -------------
-                     backgroundPlayer = new QMediaPlayer(this);
-                     audioOutput = new QAudioOutput(this);
-                     backgroundPlayer->setAudioOutput(audioOutput);
-                     audioOutput->setVolume(0.0); // Rango 0.0 a 1.0
-                     backgroundPlayer->setSource(QUrl("qrc:/bgm/menu_jazz_lofi.mp3"));
-                     backgroundPlayer->setLoops(QMediaPlayer::Infinite);
-                     backgroundPlayer->play();
-                     getSettings();
-                 } else {
-                     usrLabel->setText("Error al cargar usuario");
-                 }
-                 reply->deleteLater();
-             });
+             return;
          }
+
+         Session &session = Session::forUser(userKey);
+         connect(&session, &Session::profileChanged, this, &MenuWindow::showProfile);
+         if (!session.profile().isEmpty())
+             showProfile(session.profile());
+
+         // Revalidación: solo repinta (vía profileChanged) si el perfil ha cambiado
+         QNetworkRequest request(QUrl("http://188.165.76.134:8000/usuarios/estadisticas/"));
+         request.setRawHeader("Auth", token.toUtf8());
+         HttpCache::instance().get(request, this, [this](const QByteArray &responseData, bool) {
+             QJsonObject perfil = QJsonDocument::fromJson(responseData).object();
+             if (!perfil.isEmpty())
+                 Session::forUser(userKey).setProfile(perfil);
+             else if (!nameHasLoaded)
+                 usrLabel->setText("Error al cargar usuario");
+         }, [this](int statusCode, const QString &) {
+             if (statusCode == 401) {
+                 createExpiredDialog(this)->show();
+                 return;
+             }
+             if (!nameHasLoaded)
+                 usrLabel->setText("Error al cargar usuario");
+         });
      });
      usrLabel->setAlignment(Qt::AlignCenter);
      usrLabel->setTextFormat(Qt::RichText);
@@ -393,6 +320,16 @@
      customGames->setImage(":/icons/gameslist.png", 50, 50);
      ranks    ->setImage(":/icons/ranks.png", 50, 50);
  
+     // Insignia con las solicitudes de amistad pendientes (precargadas durante el arranque)
+     countLabel = new QLabel(this);
+     countLabel->setAlignment(Qt::AlignCenter);
+     countLabel->setFixedSize(22, 22);
+     countLabel->setStyleSheet("background-color: #c0392b; color: white; border-radius: 11px;"
+                               "font-size: 12px; font-weight: bold;");
+     countLabel->setAttribute(Qt::WA_TransparentForMouseEvents);
+     countLabel->hide();
+     updateFriendRequestBadge();
+ 
      // ------------- EVENTOS DE CLICK EN ICONOS -------------
      connect(settings, &Icon::clicked, [=]() {
          if (!nameHasLoaded) return;
@@ -411,6 +348,9 @@
          fw->setModal(true);
          fw->exec();
          friends->setImage(":/icons/friends.png", 60, 60);
+         // Las solicitudes pueden haberse aceptado o rechazado en la ventana de amigos
+         HttpCache::instance().invalidate("/usuarios/listar_solicitudes_amistad/");
+         updateFriendRequestBadge();
      });
  
      connect(exit, &Icon::clicked, this, [this]() {
@@ -521,56 +461,9 @@
          cstgmWin->exec();
      });
  
-     // ------------- ORNAMENTOS ESQUINAS -------------
-     ornamentSize = QSize(300, 299);
-     QPixmap ornamentPixmap(":/images/set-golden-border-ornaments/gold_ornaments.png");
- 
-     cornerTopLeft = new QLabel(this);
-     cornerTopRight = new QLabel(this);
-     cornerBottomLeft = new QLabel(this);
-     cornerBottomRight = new QLabel(this);
- 
-     cornerTopLeft->setPixmap(ornamentPixmap.scaled(ornamentSize, Qt::KeepAspectRatio, Qt::SmoothTransformation));
- 
-     QTransform transformH;
-     transformH.scale(-1, 1);
-     cornerTopRight->setPixmap(
-         ornamentPixmap.transformed(transformH, Qt::SmoothTransformation)
-             .scaled(ornamentSize, Qt::KeepAspectRatio, Qt::SmoothTransformation)
-         );
- 
-     QTransform transformV;
-     transformV.scale(1, -1);
-     cornerBottomLeft->setPixmap(
-         ornamentPixmap.transformed(transformV, Qt::SmoothTransformation)
-             .scaled(ornamentSize, Qt::KeepAspectRatio, Qt::SmoothTransformation)
-         );
- 
-     QTransform transformHV;
-     transformHV.scale(-1, -1);
-     cornerBottomRight->setPixmap(
-         ornamentPixmap.transformed(transformHV, Qt::SmoothTransformation)
-             .scaled(ornamentSize, Qt::KeepAspectRatio, Qt::SmoothTransformation)
-         );
- 
-     QList<QLabel*> corners = {cornerTopLeft, cornerTopRight, cornerBottomLeft, cornerBottomRight};
-     for (QLabel* corner : corners) {
-         corner->setFixedSize(ornamentSize);
-         corner->setAttribute(Qt::WA_TransparentForMouseEvents);
-         corner->setAttribute(Qt::WA_TranslucentBackground);
-         corner->setStyleSheet("background: transparent;");
-         corner->raise();
-     }
- 
+     // ------------- FONDO -------------
+     // Gradiente y ornamentos de las esquinas los pinta paintEvent() desde BackdropService
      this->setStyleSheet(R"(
-     /* Fondo de la ventana con gradiente verde */
-     QWidget {
-         background: qradialgradient(cx:0.5, cy:0.5, radius:1,
-                                     fx:0.5, fy:0.5,
-                                     stop:0 #1f5a1f,
-                                     stop:1 #0a2a08);
-     }
- 
      /* Barras top y bottom con gradiente vertical gris–negro */
      QFrame#topBar, QFrame#bottomBar {
          background: qlineargradient(
@@ -584,53 +477,15 @@
          border: 2px solid #000000;
      }
      )");
- 
-     repositionOrnaments();
  }
  
- // Función para extraer el token de autenticación desde el archivo .conf
- QString MenuWindow::loadAuthToken(const QString &userKey) {
-     QString configPath = QStandardPaths::writableLocation(QStandardPaths::ConfigLocation)
-     + QString("/Grace Hopper/Sota, Caballo y Rey_%1.conf").arg(userKey);
- 
-     qDebug() << "userKey: " << userKey;
- 
-     QFile configFile(configPath);
-     if (!configFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-         // Pon un qDebug() o algo para saber que falló
-         qDebug() << "No se pudo abrir el archivo de configuración en MenuWindow." << configFile.fileName();
-         return "";
-     }
- 
-     QString token;
-     while (!configFile.atEnd()) {
-         QString line = configFile.readLine().trimmed();
-         if (line.startsWith("token=")) {
-             token = line.mid(QString("token=").length()).trimmed();
-             break;
-         }
-     }
-     configFile.close();
-     return token;
- }
  
  /**
-  * @brief Reposiciona los adornos decorativos en las esquinas de la ventana.
+  * @brief Pinta el tapete verde con sus ornamentos (compuesto una vez por tamaño).
   */
- void MenuWindow::repositionOrnaments() {
-     int w = this->width();
-     int h = this->height();
-     int topOffset = 0;
- 
-     cornerTopLeft->move(0, topOffset);
-     cornerTopRight->move(w - cornerTopRight->width(), topOffset);
-     cornerBottomLeft->move(0, h - cornerBottomLeft->height());
-     cornerBottomRight->move(w - cornerBottomRight->width(), h - cornerBottomRight->height());
- 
-     QList<QLabel*> corners = {cornerTopLeft, cornerTopRight, cornerBottomLeft, cornerBottomRight};
-     for (QLabel* corner : corners) {
-         corner->lower();
-     }
+ void MenuWindow::paintEvent(QPaintEvent *event) {
+     Q_UNUSED(event);
+     BackdropService::paint(this, 1);
  }
  
  // Función para reposicionar los ImageButtons
@@ -719,6 +574,60 @@
          w->move(x, y);
          x += w->width() + spacing;
      }
+
+     // 7) Insignia en la esquina superior derecha del icono de amigos
+     if (countLabel) {
+         countLabel->move(friends->x() + friends->width() - countLabel->width() / 2,
+                          friends->y() - countLabel->height() / 3);
+         countLabel->raise();
+     }
+ }
+
+ /**
+  * @brief Pinta nombre y ELO en la barra superior; la primera vez arranca también la música.
+  * @param perfil Perfil del usuario (Session::profile()).
+  */
+ void MenuWindow::showProfile(const QJsonObject &perfil) {
+     QString nombre = perfil.value("nombre").toString();
+     this->usr = nombre;
+     int ELO = perfil.value("elo").toInt();
+     QString rank = "Rango"; // Actualiza si se recibe el rango
+
+     QString UsrELORank = QString(
+                              "<span style='font-size: 24px; font-weight: bold; color: white;'>%1 (%2) </span>"
+                              "<span style='font-size: 20px; font-weight: normal; color: white;'>%3</span>"
+                              ).arg(nombre).arg(ELO).arg(rank);
+
+     usrLabel->setText(UsrELORank);
+
+     if (nameHasLoaded) return;
+     nameHasLoaded = true;
+
+     // ------------- MÚSICA -------------
+     getSettings();
+     AudioEngine::instance().playMusic(QUrl("qrc:/bgm/menu_jazz_lofi.mp3"));
+ }
+
+ /**
+  * @brief Pide el número de solicitudes de amistad pendientes y actualiza la insignia.
+  */
+ void MenuWindow::updateFriendRequestBadge() {
+     if (token.isEmpty()) return;
+     QNetworkRequest request(QUrl("http://188.165.76.134:8000/usuarios/listar_solicitudes_amistad/"));
+     request.setRawHeader("Auth", token.toUtf8());
+     HttpCache::instance().get(request, this, [this](const QByteArray &data, bool) {
+         pendingRequests = QJsonDocument::fromJson(data).object().value("solicitudes").toArray().size();
+         showBadge();
+     });
+ }
+
+ /**
+  * @brief Insignia de amigos: solicitudes pendientes más mensajes no leídos.
+  */
+ void MenuWindow::showBadge() {
+     int total = pendingRequests + unreadMessages;
+     countLabel->setText(total > 9 ? "9+" : QString::number(total));
+     countLabel->setVisible(total > 0);
  }
  
  // Función para recolocar y reposicionar todos los elementos
@@ -727,7 +636,6 @@
          qWarning() << "Evitar redimensionamiento con tamaño inválido:" << this->width() << "x" << this->height();
          return;
      }
-     repositionOrnaments();
      repositionBars();
      repositionImageButtons();
      repositionIcons();
@@ -735,9 +643,7 @@
  }
  
  void MenuWindow::setVolume(int volumePercentage) {
-     if (audioOutput) {
-         audioOutput->setVolume(volumePercentage / 100.0);
-     }
+     AudioEngine::instance().setMusicVolume(volumePercentage);
  }
  
  MenuWindow::~MenuWindow() {
@@ -745,16 +651,30 @@
      delete ui;
  }
  
- // Sobrescribimos closeEvent para parar la música:
- void MenuWindow::closeEvent(QCloseEvent *event)
- {
-     // Detenemos la música antes de cerrar
-     if (backgroundPlayer) {
-         backgroundPlayer->stop();
+ /**
+  * @brief Imágenes que pinta el menú nada más abrirse, a su tamaño final.
+  *
+  * Son las mismas peticiones que hacen ImageButton e Icon, así que al crear el
+  * menú ya están en QPixmapCache. Incluye las variantes oscuras del hover.
+  */
+ QList<ImageLoader::Request> MenuWindow::warmUpImages(const QSize &screen) {
+     QList<ImageLoader::Request> requests;
+     for (const QString &path : {kBoton1v1, kBoton2v2}) {
+         const QSize size = ImageButton::scaledSize(QImageReader(path).size(), screen.height());
+         requests.append({path, size});
+         requests.append({path, size, Qt::KeepAspectRatio, ImageButton::darkened()});
      }
  
-     // Luego dejamos que continúe el proceso normal de cierre
-     event->accept();
+     const QList<QPair<QString, int>> icons = {
+         {"audio", 50}, {"friends", 60}, {"door", 60}, {"chest", 50},
+         {"trophy", 50}, {"gameslist", 50}, {"ranks", 50},
+         {"darkenedaudio", 60}, {"audio", 60}, {"darkenedfriends", 60},
+         {"darkeneddoor", 60}, {"darkenedchest", 60}, {"chest", 60},
+         {"darkenedtrophy", 60}, {"trophy", 60}, {"darkenedgameslist", 50}
+     };
+     for (const auto &icon : icons)
+         requests.append({QString(":/icons/%1.png").arg(icon.first), QSize(icon.second, icon.second)});
+     return requests;
  }
  
  void MenuWindow::getSettings() {
@@ -765,11 +685,7 @@
  
      this->showFullScreen();
  
-     if (audioOutput) {
-         audioOutput->setVolume(static_cast<double>(volume) / 100.0);
-     } else {
-         qWarning() << "Error: audioOutput no está inicializado.";
-     }
+     AudioEngine::instance().loadVolumes(usr);
      this->update();
  }
  
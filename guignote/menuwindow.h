@@ -15,12 +15,15 @@
 #include <QWebSocket>
 #include <QVBoxLayout>
 #include <QJsonArray>
+#include <QJsonObject>
 #include <QTimer>
 #include "estadopartida.h"
 #include "rankswindow.h"
+#include "imageloader.h"
 
 class ImageButton;
 class Icon;
+class RejoinMonitor;
 
 namespace Ui {
 class MenuWindow;
@@ -30,17 +33,21 @@ class MenuWindow : public QWidget {
     Q_OBJECT
 public:
     explicit MenuWindow(const QString &userKey, QWidget *parent = nullptr);
-    QMediaPlayer *backgroundPlayer = nullptr;
-    QAudioOutput *audioOutput = nullptr;
     ~MenuWindow();
 
+    /**
+     * @brief Imágenes del menú (botones de juego e iconos) a su tamaño final.
+     * @param screen Tamaño de la pantalla: el menú se muestra a pantalla completa.
+     */
+    static QList<ImageLoader::Request> warmUpImages(const QSize &screen);
+
 public slots:
     void setVolume(int volumePercentage);
 
 protected:
     void resizeEvent(QResizeEvent *event) override;
-    void closeEvent(QCloseEvent *event) override;  // Sobrescribimos closeEvent
     void showEvent(QShowEvent *event) override;
+    void paintEvent(QPaintEvent *event) override;
 
 
 private:
@@ -66,22 +73,13 @@ private:
     QPushButton *invisibleButton;
     QLabel *usrLabel;
 
-    // Adornos decorativos en las esquinas
-    QLabel *cornerTopLeft;
-    QLabel *cornerTopRight;
-    QLabel *cornerBottomLeft;
-    QLabel *cornerBottomRight;
-    QSize ornamentSize;
-
     // Métodos de reposicionamiento de elementos
-    void repositionOrnaments();
     void repositionImageButtons();
     void repositionBars();
     void repositionIcons();
     void getSettings();
 
     // Métodos para la conexión con el backend
-    QString loadAuthToken(const QString &userKey);
     QString token;
 
     void jugarPartida(const QString &userKey, const QString &token, int capacidad = 2);
@@ -92,9 +90,12 @@ private:
     QJsonArray salas;
     QJsonArray salasPausadas;
     QVBoxLayout *mainLayout;
-    void checkRejoin();
 
     QLabel* countLabel = nullptr;
+    int pendingRequests = 0;
+    void updateFriendRequestBadge();
+    void showBadge();
+    void showProfile(const QJsonObject &perfil);
 
     void ensureLoggedIn();
     QString loadToken();
@@ -106,7 +107,7 @@ private:
 
     // Skins seleccionadas
     int fondo = 1;
-    QTimer *rejoinTimer;
+    RejoinMonitor *rejoinMonitor;
 
     bool nameHasLoaded = false;
 };
@@ -0,0 +1,145 @@
+/**
+ * @file messagebanner.cpp
+ * @brief Implementación de la clase MessageBanner.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ */
+
+#include "messagebanner.h"
+#include <QEvent>
+#include <QGraphicsOpacityEffect>
+#include <QLabel>
+#include <QPauseAnimation>
+#include <QPropertyAnimation>
+#include <QSequentialAnimationGroup>
+#include <QVBoxLayout>
+
+/**
+ * @brief Crea la capa, su etiqueta y la animación una sola vez.
+ * @param parent Widget que cubre.
+ */
+MessageBanner::MessageBanner(QWidget *parent)
+    : QWidget(parent)
+{
+    setAttribute(Qt::WA_StyledBackground, true);
+    setAttribute(Qt::WA_TransparentForMouseEvents, true);
+    setStyleSheet("MessageBanner { background-color: black; }");
+
+    label = new QLabel(this);
+    label->setAlignment(Qt::AlignCenter);
+    label->setStyleSheet("QLabel { color: white; font-size: 64px; font-weight: bold; }");
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addWidget(label, 0, Qt::AlignCenter);
+    layout->setContentsMargins(0, 0, 0, 0);
+
+    opacity = new QGraphicsOpacityEffect(this);
+    opacity->setOpacity(0.0);
+    setGraphicsEffect(opacity);
+
+    // Fundido de entrada → pausa → fundido de salida
+    sequence = new QSequentialAnimationGroup(this);
+    fadeIn = new QPropertyAnimation(opacity, "opacity", sequence);
+    fadeIn->setStartValue(0.0);
+    fadeIn->setEndValue(0.8);
+    fadeIn->setEasingCurve(QEasingCurve::OutCubic);
+    hold = new QPauseAnimation(sequence);
+    fadeOut = new QPropertyAnimation(opacity, "opacity", sequence);
+    fadeOut->setStartValue(0.8);
+    fadeOut->setEndValue(0.0);
+    fadeOut->setEasingCurve(QEasingCurve::InCubic);
+    sequence->addAnimation(fadeIn);
+    sequence->addAnimation(hold);
+    sequence->addAnimation(fadeOut);
+    connect(sequence, &QSequentialAnimationGroup::finished, this, &MessageBanner::finishCurrent);
+
+    setGeometry(parent->rect());
+    parent->installEventFilter(this);
+    hide();
+}
+
+/**
+ * @brief Añade el aviso a la cola, fusionándolo si procede.
+ */
+void MessageBanner::post(const QString &text, std::function<void()> onSeen, const QString &key) {
+    Entry *target = nullptr;
+    if (!key.isEmpty()) {
+        for (Entry &e : queue) {
+            if (e.key == key) {
+                e.text = text;   // el pendiente ya no es actual: se sustituye
+                target = &e;
+                break;
+            }
+        }
+    }
+    if (!target && !queue.isEmpty() && queue.last().text == text)
+        target = &queue.last();
+
+    if (!target) {
+        queue.enqueue(Entry{text, key, {}});
+        target = &queue.last();
+    }
+    if (onSeen)
+        target->onSeen.append(std::move(onSeen));
+
+    if (!showing)
+        showNext();
+}
+
+/**
+ * @brief Saca el siguiente aviso; si hay más esperando se acorta su duración.
+ */
+void MessageBanner::showNext() {
+    if (showing || queue.isEmpty())
+        return;
+    current = queue.dequeue();
+    showing = true;
+
+    const bool busy = !queue.isEmpty();
+    fadeIn->setDuration(busy ? kFadeMs / 2 : kFadeMs);
+    hold->setDuration(busy ? kBusyHoldMs : kHoldMs);
+    fadeOut->setDuration(busy ? kFadeMs / 2 : kFadeMs);
+
+    label->setText(current.text);
+    setGeometry(parentWidget()->rect());
+    show();
+    raise();
+    sequence->start();
+}
+
+/**
+ * @brief Fin de un aviso: avisa a quien esperaba y pasa al siguiente.
+ */
+void MessageBanner::finishCurrent() {
+    const QList<std::function<void()>> waiting = current.onSeen;
+    current = Entry();
+    showing = false;
+    if (queue.isEmpty())
+        hide();
+
+    for (const auto &callback : waiting)
+        callback();
+    showNext();
+}
+
+/**
+ * @brief Detiene el aviso actual y vacía la cola.
+ */
+void MessageBanner::clear() {
+    sequence->stop();
+    queue.clear();
+    current = Entry();
+    showing = false;
+    opacity->setOpacity(0.0);
+    hide();
+}
+
+/**
+ * @brief Ajusta la capa al tamaño del padre.
+ */
+bool MessageBanner::eventFilter(QObject *watched, QEvent *event) {
+    if (watched == parentWidget() && event->type() == QEvent::Resize)
+        setGeometry(parentWidget()->rect());
+    return QWidget::eventFilter(watched, event);
+}
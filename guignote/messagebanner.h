@@ -0,0 +1,108 @@
+/**
+ * @file messagebanner.h
+ * @brief Declaración de la clase MessageBanner para los avisos de la partida.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * La clase MessageBanner es una capa fija sobre la ventana de partida que
+ * muestra los avisos ("Es tu turno", resultado de la baza, cantos...) de uno
+ * en uno, reutilizando siempre la misma etiqueta, efecto y animación.
+ */
+
+#ifndef MESSAGEBANNER_H
+#define MESSAGEBANNER_H
+
+#include <QWidget>
+#include <QQueue>
+#include <QList>
+#include <functional>
+
+class QLabel;
+class QGraphicsOpacityEffect;
+class QPropertyAnimation;
+class QPauseAnimation;
+class QSequentialAnimationGroup;
+
+/**
+ * @class MessageBanner
+ * @brief Cola de avisos con fundido, que no bloquea a quien los publica.
+ *
+ * post() añade un aviso y vuelve al momento; quien necesite que el jugador lo
+ * haya visto pasa una función que se llama al terminar de mostrarse. Los
+ * avisos se fusionan: uno igual al último pendiente no se repite, y uno con
+ * la misma clave sustituye al pendiente anterior (p. ej. un turno que ya no es
+ * el actual). Con avisos en espera, cada uno se muestra menos tiempo.
+ *
+ * La capa ocupa todo el padre pero deja pasar el ratón, así que se puede jugar
+ * mientras se ve un aviso.
+ */
+class MessageBanner : public QWidget {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor de MessageBanner.
+     * @param parent Widget que cubre (la ventana de partida).
+     */
+    explicit MessageBanner(QWidget *parent);
+
+    /**
+     * @brief Publica un aviso.
+     * @param text Texto a mostrar.
+     * @param onSeen Se llama cuando el aviso ha terminado de mostrarse. Opcional.
+     * @param key Clave de sustitución: un aviso pendiente con la misma clave se reemplaza. Opcional.
+     */
+    void post(const QString &text, std::function<void()> onSeen = nullptr, const QString &key = QString());
+
+    /**
+     * @brief Oculta el aviso actual y descarta los pendientes.
+     *
+     * Las funciones onSeen pendientes no se llaman: se usa al reiniciar o
+     * destruir la partida, cuando no hay nadie esperando.
+     */
+    void clear();
+
+    /** @brief Avisos en espera (sin contar el que se muestra). */
+    int pendingCount() const { return queue.size(); }
+
+    /** @brief true mientras se muestra un aviso. */
+    bool isShowing() const { return showing; }
+
+    /** @brief Duración (ms) de cada fundido. */
+    static constexpr int kFadeMs = 500;
+    /** @brief Tiempo (ms) que se mantiene un aviso. */
+    static constexpr int kHoldMs = 1250;
+    /** @brief Tiempo (ms) que se mantiene un aviso si hay otros esperando. */
+    static constexpr int kBusyHoldMs = 400;
+
+protected:
+    /** @brief Sigue el tamaño del padre. */
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    /**
+     * @struct Entry
+     * @brief Aviso pendiente o en pantalla.
+     */
+    struct Entry {
+        QString text;                          ///< Texto.
+        QString key;                           ///< Clave de sustitución.
+        QList<std::function<void()>> onSeen;   ///< Quien espera a que se vea.
+    };
+
+    void showNext();
+    void finishCurrent();
+
+    QLabel *label;                        ///< Texto del aviso.
+    QGraphicsOpacityEffect *opacity;      ///< Opacidad de la capa.
+    QSequentialAnimationGroup *sequence;  ///< Fundido de entrada, pausa y salida.
+    QPropertyAnimation *fadeIn;           ///< Fundido de entrada.
+    QPauseAnimation *hold;                ///< Tiempo en pantalla.
+    QPropertyAnimation *fadeOut;          ///< Fundido de salida.
+    QQueue<Entry> queue;                  ///< Avisos en espera.
+    Entry current;                        ///< Aviso en pantalla.
+    bool showing = false;                 ///< Hay un aviso en pantalla.
+};
+
+#endif // MESSAGEBANNER_H
@@ -12,16 +12,18 @@
  */
 
 #include "myprofilewindow.h"
+#include "session.h"
+#include "chathub.h"
+#include "audioengine.h"
 #include <QHBoxLayout>
 #include <QVBoxLayout>
 #include <QPixmap>
-#include <QPainter>
-#include <QPainterPath>
 #include <QTimer>
 #include "mainwindow.h"
 #include <QDebug>
 #include <QSettings>
 #include "icon.h"
+#include "avatarservice.h"
 #include <QNetworkAccessManager>
 #include <QNetworkRequest>
 #include <QNetworkReply>
@@ -140,6 +142,10 @@ QDialog* MyProfileWindow::createDialogLogOut(QWidget *parent, const QString &mes
         settings.remove("auth/user");
         settings.remove("auth/pass");
         settings.remove("auth/token");
+        Session::forUser(m_userKey).clear();
+        ChatHub::forUser(m_userKey).closeAll();
+        // La música es de todo el proceso: no debe seguir en la pantalla de login
+        AudioEngine::instance().stopMusic();
         qDebug() << "Credenciales eliminadas correctamente desde QSettings.";
 
         QWidget *p = parentWidget();
@@ -221,6 +227,10 @@ QDialog* MyProfileWindow::createDialogBorrarUsr(QWidget *parent, const QString &
         settings.remove("auth/user");
         settings.remove("auth/pass");
         settings.remove("auth/token");
+        Session::forUser(m_userKey).clear();
+        ChatHub::forUser(m_userKey).closeAll();
+        // La música es de todo el proceso: no debe seguir en la pantalla de login
+        AudioEngine::instance().stopMusic();
         qDebug() << "Credenciales eliminadas correctamente desde QSettings.";
 
         QWidget *p = parentWidget();
@@ -345,7 +355,7 @@ void MyProfileWindow::choosePfp() {
     qDebug() << "Imagen añadida al QHttpMultiPart.";
 
     // Obtener el token de autenticación
-    QString token = loadAuthToken(m_userKey);
+    QString token = Session::forUser(m_userKey).token();
     if (token.isEmpty()) {
         createDialog(this, "No se encontró el token de autenticación.")->show();
         return;
@@ -406,6 +416,8 @@ void MyProfileWindow::choosePfp() {
                 // Emitir la señal después de la actualización exitosa de la foto de perfil
                 emit pfpChangedSuccessfully();
                 qDebug() << "Foto de perfil actualizada.";
+                // La URL puede no cambiar al sobrescribir la foto: descartar la copia cacheada
+                AvatarService::instance().invalidate(shownImageUrl);
                 loadNameAndStats(m_userKey);
             }
         } else {
@@ -507,12 +519,9 @@ QVBoxLayout* MyProfileWindow::createProfileLayout() {
     profileLayout->addStretch();
 
     int pfpSize = 200;
-    QString imagePath = ":/icons/profile.png";
-    QPixmap circularImage = createCircularImage(imagePath, pfpSize);
-
     fotoPerfil = new Icon(this);
     fotoPerfil->setHoverEnabled(false);
-    fotoPerfil->setPixmapImg(circularImage, pfpSize, pfpSize);
+    fotoPerfil->setPixmapImg(AvatarService::instance().placeholder(pfpSize), pfpSize, pfpSize);
     connect(fotoPerfil, &Icon::clicked, [=]() {
         createDialogSetPfp(this, "¿Cambiar foto de perfil?")->show();
     });
@@ -606,65 +615,23 @@ QHBoxLayout* MyProfileWindow::createBottomLayout() {
 
 
 
-/**
- * @brief Convierte un QPixmap rectangular en uno circular.
- * @param src Imagen original a recortar.
- * @param size Diámetro deseado para la imagen circular.
- * @return QPixmap resultante con recorte circular.
- */
-QPixmap MyProfileWindow::createCircularImage(const QPixmap &src, int size) {
-    // Escalamos a un cuadrado de “size × size” y recortamos el exceso
-    QPixmap scaled = src.scaled(size, size,
-                                Qt::KeepAspectRatioByExpanding,
-                                Qt::SmoothTransformation);
-    QPixmap circular(size, size);
-    circular.fill(Qt::transparent);
-
-    QPainter painter(&circular);
-    painter.setRenderHint(QPainter::Antialiasing);
-    QPainterPath path;
-    path.addEllipse(0, 0, size, size);
-    painter.setClipPath(path);
-    painter.drawPixmap(0, 0, size, size, scaled);
-
-    return circular;
-}
-
-/**
- * @brief Extrae el token de autenticación almacenado en QSettings.
- * @param userKey Clave del usuario cuyo token se desea recuperar.
- * @return Token como QString, o cadena vacía si no se encuentra.
- */
-QString MyProfileWindow::loadAuthToken(const QString &userKey) {
-    // Usa la misma organización y nombre de aplicación/grupo que en LoginWindow
-    QSettings settings("Grace Hopper", QString("Sota, Caballo y Rey_%1").arg(userKey));
-
-    // Lee el valor usando la clave correcta
-    QString token = settings.value("auth/token").toString();
-
-    if (token.isEmpty()) {
-        qWarning() << "No se encontró el token para userKey:" << userKey << "en la configuración.";
-        // Mantén o ajusta tu diálogo de error si es necesario
-        createDialog(this, "No se encontró el token en la configuración.")->show();
-        return ""; // Devuelve vacío si no se encuentra
-    }
-
-    qDebug() << "Token cargado para userKey:" << userKey;
-    return token;
-}
-
 /**
  * @brief Solicita al servidor nombre, ELO y estadísticas del usuario,
  *        actualiza las etiquetas userLabel y statsLabel, y descarga la foto de perfil.
  * @param userKey Clave del usuario para la petición.
  */
 void MyProfileWindow::loadNameAndStats(const QString &userKey) {
-    QString token = loadAuthToken(userKey);
+    QString token = Session::forUser(userKey).token();
     if (token.isEmpty()) {
         createDialog(this, "No se encontró el token de autenticación.")->show();
         return;
     }
 
+    // El perfil de la sesión se pinta al momento; la respuesta lo actualiza
+    const QJsonObject guardado = Session::forUser(userKey).profile();
+    if (!guardado.isEmpty())
+        showProfile(guardado);
+
     // Creamos un QNetworkAccessManager para estas peticiones
     QNetworkAccessManager *manager = new QNetworkAccessManager(this);
     QNetworkRequest request(QUrl("http://188.165.76.134:8000/usuarios/estadisticas/"));
@@ -687,94 +654,9 @@ void MyProfileWindow::loadNameAndStats(const QString &userKey) {
         if (reply->error() == QNetworkReply::NoError) {
             QJsonDocument doc = QJsonDocument::fromJson(reply->readAll());
             if (doc.isObject()) {
-                QJsonObject obj = doc.object();
-
-                // ——— Nombre y ELO ———
-                int elo = obj.value("elo").toInt();
-                QString nombre = obj.value("nombre").toString();
-                userLabel->setText(
-                    QString("<span style='font-size:24px;font-weight:bold;color:white;'>%1 (%2)</span>")
-                        .arg(nombre)
-                        .arg(elo)
-                    );
-                userLabel->setStyleSheet("background: transparent; color: white;");
-
-                // ——— Rango ———
-                int idx = 0;
-                while (idx < m_thresholds.size() && elo >= m_thresholds[idx]) ++idx;
-                rankNameLabel->setText(m_rangos[idx]);
-                rankNameLabel->setStyleSheet("background: transparent; color: white; font-size: 22px;" );
-
-                // Icono de rango
-                QString iconPath = QString(":/icons/%1.png").arg(m_icons[idx]);
-                QPixmap pix(iconPath);
-                if (pix.isNull()) {
-                    qWarning() << "No se pudo cargar recurso:" << iconPath;
-                } else {
-                    rankIconLabel->setPixmap(
-                        pix.scaled(32, 32, Qt::KeepAspectRatio, Qt::SmoothTransformation)
-                        );
-                }
-
-                // ——— Estadísticas ———
-                int victorias     = obj.value("victorias").toInt();
-                int derrotas      = obj.value("derrotas").toInt();
-                int racha         = obj.value("racha_victorias").toInt();
-                int mayorRacha    = obj.value("mayor_racha_victorias").toInt();
-                int totalPartidas = obj.value("total_partidas").toInt();
-                double pctVic     = obj.value("porcentaje_victorias").toDouble();
-                double pctDer     = obj.value("porcentaje_derrotas").toDouble();
-
-                QString statsText = QString(
-                                        "Victorias: %1\n"
-                                        "Derrotas: %2\n"
-                                        "Racha: %3\n"
-                                        "Mejor Racha: %4\n"
-                                        "Partidas: %5\n"
-                                        "%% Victorias: %6%\n"
-                                        "%% Derrotas: %7%"
-                                        )
-                                        .arg(victorias)
-                                        .arg(derrotas)
-                                        .arg(racha)
-                                        .arg(mayorRacha)
-                                        .arg(totalPartidas)
-                                        .arg(pctVic, 0, 'f', 1)
-                                        .arg(pctDer, 0, 'f', 1);
-
-                statsLabel->setText(statsText);
-                statsLabel->setStyleSheet("background: transparent; color: white; font-size: 22px;");
-
-                // ——— Foto de perfil ———
-                QString imageUrl = obj.value("imagen").toString();
-                qDebug() << "[AAA] URL de la imagen de perfil:" << imageUrl;
-
-                QUrl url(imageUrl);
-                QNetworkRequest imgReq(url);
-                qDebug() << "-> imgReq URL =" << imgReq.url();
-                // ó bien: QNetworkRequest imgReq = QNetworkRequest(QUrl(imageUrl));
-
-                auto *imgManager = new QNetworkAccessManager(this);
-                QNetworkReply *imgReply = imgManager->get(imgReq);
-                connect(imgReply, &QNetworkReply::finished, this, [this, imgReply, imgManager]() {
-                    qDebug() << "Cargamos foto de perfil";
-                    if (imgReply->error() == QNetworkReply::NoError) {
-                        QByteArray data = imgReply->readAll();
-                        QPixmap src;
-                        if (src.loadFromData(data)) {
-                            qDebug() << "Foto de perfil cargada";
-                            int diam = fotoPerfil->width();
-                            QPixmap circ = createCircularImage(src, diam);
-                            fotoPerfil->setPixmapImg(circ, diam, diam);
-                        } else {
-                            qDebug() << "No se pudo cargar pixmap de la imagen de perfil.";
-                        }
-                    } else {
-                        qDebug() << "Error al descargar imagen de perfil:" << imgReply->errorString();
-                    }
-                    imgReply->deleteLater();
-                    imgManager->deleteLater();
-                });
+                // La sesión avisa al menú (profileChanged) si algo ha cambiado
+                Session::forUser(m_userKey).setProfile(doc.object());
+                showProfile(doc.object());
             }
         } else {
             createDialog(this, "Error al cargar el perfil de usuario.")->show();
@@ -785,6 +667,78 @@ void MyProfileWindow::loadNameAndStats(const QString &userKey) {
     });
 }
 
+/**
+ * @brief Pinta nombre, ELO, rango, estadísticas y foto a partir del perfil.
+ * @param perfil Perfil del usuario (Session::profile() o la respuesta del servidor).
+ */
+void MyProfileWindow::showProfile(const QJsonObject &perfil) {
+    // ——— Nombre y ELO ———
+    int elo = perfil.value("elo").toInt();
+    QString nombre = perfil.value("nombre").toString();
+    userLabel->setText(
+        QString("<span style='font-size:24px;font-weight:bold;color:white;'>%1 (%2)</span>")
+            .arg(nombre)
+            .arg(elo)
+        );
+    userLabel->setStyleSheet("background: transparent; color: white;");
+
+    // ——— Rango ———
+    int idx = 0;
+    while (idx < m_thresholds.size() && elo >= m_thresholds[idx]) ++idx;
+    rankNameLabel->setText(m_rangos[idx]);
+    rankNameLabel->setStyleSheet("background: transparent; color: white; font-size: 22px;" );
+
+    // Icono de rango
+    QString iconPath = QString(":/icons/%1.png").arg(m_icons[idx]);
+    QPixmap pix(iconPath);
+    if (pix.isNull()) {
+        qWarning() << "No se pudo cargar recurso:" << iconPath;
+    } else {
+        rankIconLabel->setPixmap(
+            pix.scaled(32, 32, Qt::KeepAspectRatio, Qt::SmoothTransformation)
+            );
+    }
+
+    // ——— Estadísticas ———
+    int victorias     = perfil.value("victorias").toInt();
+    int derrotas      = perfil.value("derrotas").toInt();
+    int racha         = perfil.value("racha_victorias").toInt();
+    int mayorRacha    = perfil.value("mayor_racha_victorias").toInt();
+    int totalPartidas = perfil.value("total_partidas").toInt();
+    double pctVic     = perfil.value("porcentaje_victorias").toDouble();
+    double pctDer     = perfil.value("porcentaje_derrotas").toDouble();
+
+    QString statsText = QString(
+                            "Victorias: %1\n"
+                            "Derrotas: %2\n"
+                            "Racha: %3\n"
+                            "Mejor Racha: %4\n"
+                            "Partidas: %5\n"
+                            "%% Victorias: %6%\n"
+                            "%% Derrotas: %7%"
+                            )
+                            .arg(victorias)
+                            .arg(derrotas)
+                            .arg(racha)
+                            .arg(mayorRacha)
+                            .arg(totalPartidas)
+                            .arg(pctVic, 0, 'f', 1)
+                            .arg(pctDer, 0, 'f', 1);
+
+    statsLabel->setText(statsText);
+    statsLabel->setStyleSheet("background: transparent; color: white; font-size: 22px;");
+
+    // ——— Foto de perfil ———
+    QString imageUrl = perfil.value("imagen").toString();
+    qDebug() << "[AAA] URL de la imagen de perfil:" << imageUrl;
+
+    shownImageUrl = imageUrl;
+    if (!imageUrl.isEmpty()) {
+        int diam = fotoPerfil->width();
+        AvatarService::instance().setAvatar(fotoPerfil, imageUrl, diam);
+    }
+}
+
 
 
 
@@ -794,7 +748,7 @@ void MyProfileWindow::loadNameAndStats(const QString &userKey) {
  * @param userKey Clave del usuario cuya cuenta se va a eliminar.
  */
 void MyProfileWindow::delUsr(const QString &userKey) {
-    QString token = loadAuthToken(userKey);
+    QString token = Session::forUser(userKey).token();
     if (token.isEmpty()) {
         createDialog(this, "No se encontró el token de autenticación.")->show();
         return;
@@ -17,6 +17,7 @@
 #include <QVBoxLayout>
 #include <QLabel>
 #include <QPixmap>
+#include <QJsonObject>
 #include "icon.h"
 
 /**
@@ -56,23 +57,27 @@ private:
     QPushButton   *logOutButton;   ///< Botón para cerrar sesión.
 
     QString m_userKey;             ///< Clave del usuario actual.
+    QString shownImageUrl;         ///< URL de la foto de perfil mostrada.
 
     // --- Métodos de configuración de UI ---
     void setupUI();
     QHBoxLayout* createHeaderLayout();
     QVBoxLayout* createProfileLayout();
     QHBoxLayout* createBottomLayout();
-    QPixmap createCircularImage(const QPixmap &src, int size);
 
     // --- Backend y lógica ---
-    QString loadAuthToken(const QString &userKey);
-
     /**
      * @brief Carga el nombre, ELO y estadísticas del usuario desde el backend.
      * @param userKey Clave del usuario.
      */
     void loadNameAndStats(const QString &userKey);
 
+    /**
+     * @brief Pinta nombre, ELO, rango, estadísticas y foto de perfil.
+     * @param perfil Perfil del usuario.
+     */
+    void showProfile(const QJsonObject &perfil);
+
     /**
      * @brief Solicita el borrado de la cuenta del usuario.
      * @param userKey Clave del usuario.
@@ -0,0 +1,169 @@
+/**
+ * @file pixmapshadoweffect.cpp
+ * @brief Implementación de la clase PixmapShadowEffect.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * Contiene el desenfoque de la sombra (una vez por tamaño) y su pintado.
+ */
+
+#include "pixmapshadoweffect.h"
+#include <QPainter>
+#include <QPainterPath>
+#include <QPixmapCache>
+#include <QVariantAnimation>
+#include <QEasingCurve>
+
+namespace {
+/**
+ * @brief Desenfoque de caja en un sentido; fuera de la imagen se toma transparente.
+ *
+ * Trabaja sobre píxeles premultiplicados, así que basta con promediar los
+ * cuatro canales por igual.
+ */
+void boxBlurPass(const QImage &src, QImage &dst, int r, bool horizontal) {
+    const int w = src.width();
+    const int h = src.height();
+    const int lines = horizontal ? h : w;
+    const int length = horizontal ? w : h;
+    const int d = 2 * r + 1;
+
+    for (int line = 0; line < lines; ++line) {
+        auto at = [&](const QImage &img, int i) -> QRgb {
+            return horizontal ? reinterpret_cast<const QRgb *>(img.constScanLine(line))[i]
+                              : reinterpret_cast<const QRgb *>(img.constScanLine(i))[line];
+        };
+        int sum[4] = {0, 0, 0, 0};
+        auto add = [&](int i, int sign) {
+            if (i < 0 || i >= length) return;
+            const QRgb p = at(src, i);
+            sum[0] += sign * qAlpha(p);
+            sum[1] += sign * qRed(p);
+            sum[2] += sign * qGreen(p);
+            sum[3] += sign * qBlue(p);
+        };
+        for (int i = -r; i <= r; ++i)
+            add(i, 1);
+        for (int i = 0; i < length; ++i) {
+            const QRgb out = qRgba(sum[1] / d, sum[2] / d, sum[3] / d, sum[0] / d);
+            if (horizontal)
+                reinterpret_cast<QRgb *>(dst.scanLine(line))[i] = out;
+            else
+                reinterpret_cast<QRgb *>(dst.scanLine(i))[line] = out;
+            add(i - r, -1);
+            add(i + r + 1, 1);
+        }
+    }
+}
+}
+
+/**
+ * @brief Constructor de PixmapShadowEffect.
+ */
+PixmapShadowEffect::PixmapShadowEffect(int cornerRadius, Level rest, Level raised,
+                                       const QColor &color, QObject *parent)
+    : QGraphicsEffect(parent),
+      cornerRadius(cornerRadius),
+      rest(rest),
+      raised(raised),
+      color(color)
+{
+}
+
+/**
+ * @brief Compone y desenfoca la sombra, o la recupera de QPixmapCache.
+ *
+ * Tres pasadas de desenfoque de caja en cada sentido dan un resultado muy
+ * parecido al gaussiano de QGraphicsDropShadowEffect.
+ */
+QPixmap PixmapShadowEffect::shadow(const QSize &size, int cornerRadius, int blur, const QColor &color) {
+    const QString key = QStringLiteral("shadow:%1x%2:%3:%4:%5")
+        .arg(size.width()).arg(size.height()).arg(cornerRadius).arg(blur).arg(color.rgba(), 0, 16);
+    QPixmap cached;
+    if (QPixmapCache::find(key, &cached))
+        return cached;
+    if (size.isEmpty())
+        return QPixmap();
+
+    QImage image(size + QSize(2 * blur, 2 * blur), QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    {
+        QPainter painter(&image);
+        painter.setRenderHint(QPainter::Antialiasing);
+        QPainterPath path;
+        path.addRoundedRect(QRectF(QPointF(blur, blur), size), cornerRadius, cornerRadius);
+        painter.fillPath(path, color);
+    }
+
+    const int r = qMax(1, blur / 3);
+    QImage scratch(image.size(), image.format());
+    for (int pass = 0; pass < 3; ++pass) {
+        boxBlurPass(image, scratch, r, true);
+        boxBlurPass(scratch, image, r, false);
+    }
+
+    cached = QPixmap::fromImage(std::move(image));
+    QPixmapCache::insert(key, cached);
+    return cached;
+}
+
+/**
+ * @brief Fija la elevación y repinta.
+ */
+void PixmapShadowEffect::setElevation(qreal elevation) {
+    elevation = qBound(0.0, elevation, 1.0);
+    if (qFuzzyCompare(elevation, lift))
+        return;
+    lift = elevation;
+    update();
+}
+
+/**
+ * @brief Anima la elevación; una animación nueva sustituye a la anterior.
+ */
+void PixmapShadowEffect::animateTo(qreal elevation, int msecs) {
+    if (!animation) {
+        animation = new QVariantAnimation(this);
+        animation->setEasingCurve(QEasingCurve::OutCubic);
+        connect(animation, &QVariantAnimation::valueChanged, this, [this](const QVariant &v) {
+            setElevation(v.toReal());
+        });
+    }
+    animation->stop();
+    animation->setDuration(msecs);
+    animation->setStartValue(lift);
+    animation->setEndValue(elevation);
+    animation->start();
+}
+
+/**
+ * @brief Área del widget más el espacio que ocupa la sombra más grande.
+ */
+QRectF PixmapShadowEffect::boundingRectFor(const QRectF &rect) const {
+    const qreal blur = qMax(rest.blur, raised.blur);
+    const qreal top = qMin(rest.offsetY, raised.offsetY);
+    const qreal bottom = qMax(rest.offsetY, raised.offsetY);
+    return rect.united(rect.adjusted(-blur, -blur + top, blur, blur + bottom));
+}
+
+/**
+ * @brief Pinta las dos sombras fundidas según la elevación y después el widget.
+ */
+void PixmapShadowEffect::draw(QPainter *painter) {
+    const QRectF source = sourceBoundingRect(Qt::LogicalCoordinates);
+    const qreal offsetY = rest.offsetY + (raised.offsetY - rest.offsetY) * lift;
+    const qreal opacity = painter->opacity();
+
+    auto layer = [&](const Level &level, qreal weight) {
+        if (weight <= 0.0) return;
+        const QPixmap pixmap = shadow(source.size().toSize(), cornerRadius, level.blur, color);
+        painter->setOpacity(opacity * weight);
+        painter->drawPixmap(source.topLeft() + QPointF(-level.blur, -level.blur + offsetY), pixmap);
+    };
+    layer(rest, 1.0 - lift);
+    layer(raised, lift);
+
+    painter->setOpacity(opacity);
+    drawSource(painter);
+}
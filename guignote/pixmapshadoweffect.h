@@ -0,0 +1,92 @@
+/**
+ * @file pixmapshadoweffect.h
+ * @brief Declaración de la clase PixmapShadowEffect, sombra pre-renderizada.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * QGraphicsDropShadowEffect desenfoca la sombra en cada repintado, y al animar
+ * su radio lo hace en cada fotograma. PixmapShadowEffect desenfoca una sola vez
+ * por tamaño de widget, guarda el resultado en QPixmapCache y durante la
+ * animación solo funde y desplaza las sombras ya hechas.
+ */
+
+#ifndef PIXMAPSHADOWEFFECT_H
+#define PIXMAPSHADOWEFFECT_H
+
+#include <QGraphicsEffect>
+#include <QColor>
+#include <QPixmap>
+
+class QVariantAnimation;
+
+/**
+ * @class PixmapShadowEffect
+ * @brief Sombra de rectángulo redondeado con dos niveles de elevación.
+ *
+ * La elevación va de 0 (sombra en reposo) a 1 (sombra levantada); los valores
+ * intermedios funden las dos sombras y desplazan su posición.
+ */
+class PixmapShadowEffect : public QGraphicsEffect {
+    Q_OBJECT
+
+public:
+    /**
+     * @struct Level
+     * @brief Aspecto de la sombra en un nivel de elevación.
+     */
+    struct Level {
+        int blur;      ///< Radio de desenfoque en píxeles.
+        qreal offsetY; ///< Desplazamiento vertical.
+    };
+
+    /**
+     * @brief Constructor.
+     * @param cornerRadius Radio de las esquinas del widget.
+     * @param rest Sombra en reposo.
+     * @param raised Sombra levantada.
+     * @param color Color de la sombra.
+     * @param parent Objeto padre.
+     */
+    PixmapShadowEffect(int cornerRadius, Level rest, Level raised,
+                       const QColor &color, QObject *parent = nullptr);
+
+    /**
+     * @brief Sombra desenfocada de un rectángulo redondeado (desde QPixmapCache si ya existe).
+     * @param size Tamaño del rectángulo.
+     * @param cornerRadius Radio de las esquinas.
+     * @param blur Radio de desenfoque; la imagen mide size + 2·blur.
+     * @param color Color de la sombra.
+     */
+    static QPixmap shadow(const QSize &size, int cornerRadius, int blur, const QColor &color);
+
+    /** @brief Elevación actual, entre 0 y 1. */
+    qreal elevation() const { return lift; }
+
+    /**
+     * @brief Fija la elevación sin animar.
+     * @param elevation Valor entre 0 y 1.
+     */
+    void setElevation(qreal elevation);
+
+    /**
+     * @brief Anima la elevación desde el valor actual.
+     * @param elevation Valor final entre 0 y 1.
+     * @param msecs Duración de la animación.
+     */
+    void animateTo(qreal elevation, int msecs = 160);
+
+protected:
+    QRectF boundingRectFor(const QRectF &rect) const override;
+    void draw(QPainter *painter) override;
+
+private:
+    int cornerRadius;
+    Level rest;
+    Level raised;
+    QColor color;
+    qreal lift = 0.0;
+    QVariantAnimation *animation = nullptr;
+};
+
+#endif // PIXMAPSHADOWEFFECT_H
@@ -0,0 +1,301 @@
+/**
+ * @file playerprofiles.cpp
+ * @brief Implementación de la clase PlayerProfiles.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * Contiene la resolución nombre → id → objetos equipados, la agrupación de
+ * peticiones por jugador y la persistencia en disco de los perfiles.
+ */
+
+#include "playerprofiles.h"
+#include <QNetworkAccessManager>
+#include <QNetworkRequest>
+#include <QNetworkReply>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStandardPaths>
+#include <QDataStream>
+#include <QSaveFile>
+#include <QTimer>
+#include <QFile>
+#include <QDir>
+#include <QDebug>
+#include <memory>
+
+namespace {
+/// Cabecera del fichero; cambiarla descarta los perfiles guardados.
+constexpr quint32 kMagic = 0x50505231; // "PPR1"
+
+/// Id de un objeto equipado: el servidor lo envía como objeto {"id": n} o como entero.
+int equippedId(const QJsonValue &value) {
+    if (value.isObject()) return value.toObject().value("id").toInt(-1);
+    if (value.isDouble()) return value.toInt(-1);
+    return -1;
+}
+}
+
+/**
+ * @brief Devuelve la instancia compartida.
+ */
+PlayerProfiles &PlayerProfiles::instance() {
+    static PlayerProfiles *profiles = new PlayerProfiles();
+    return *profiles;
+}
+
+/**
+ * @brief Constructor de PlayerProfiles; carga los perfiles guardados.
+ * @param directory Carpeta de persistencia (vacía = CacheLocation).
+ * @param parent Objeto padre.
+ */
+PlayerProfiles::PlayerProfiles(const QString &directory, QObject *parent)
+    : QObject(parent),
+      manager(new QNetworkAccessManager(this)),
+      saveTimer(new QTimer(this))
+{
+    QString dir = directory.isEmpty()
+                      ? QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+                      : directory;
+    QDir().mkpath(dir);
+    path = dir + "/profiles.dat";
+
+    // Varias respuestas seguidas (inicio de partida) se escriben de una vez
+    saveTimer->setSingleShot(true);
+    saveTimer->setInterval(1000);
+    connect(saveTimer, &QTimer::timeout, this, &PlayerProfiles::save);
+
+    load();
+}
+
+/**
+ * @brief true si los objetos se leyeron hace menos de kTtlSecs.
+ */
+bool PlayerProfiles::isFresh(const Profile &profile) {
+    if (!profile.hasItems())
+        return false;
+    qint64 age = profile.fetchedAt.secsTo(QDateTime::currentDateTimeUtc());
+    return age >= 0 && age < kTtlSecs;
+}
+
+/**
+ * @brief Anota el id de un jugador. Si cambia, los objetos guardados dejan de valer.
+ */
+void PlayerProfiles::remember(const QString &name, int id) {
+    if (name.isEmpty() || id < 0)
+        return;
+    Profile &profile = profiles[name];
+    profile.name = name;
+    if (profile.id == id)
+        return;
+    if (profile.id >= 0)
+        names.remove(profile.id);
+    profile.id = id;
+    profile.fetchedAt = QDateTime();
+    names.insert(id, name);
+    saveTimer->start();
+}
+
+/**
+ * @brief Lanza la consulta en segundo plano si el perfil no está fresco.
+ */
+void PlayerProfiles::prefetch(const QString &name, int id) {
+    if (name.isEmpty())
+        return;
+    remember(name, id);
+    if (!isFresh(profiles.value(name)))
+        refresh(name);
+}
+
+/**
+ * @brief Pide el perfil de un jugador.
+ *
+ * Con objetos en memoria responde al momento (y refresca si han caducado);
+ * si no, espera a la consulta en curso o lanza una nueva.
+ */
+void PlayerProfiles::lookup(const QString &name, QObject *context, Handler onReady) {
+    if (name.isEmpty()) {
+        if (onReady) onReady(Profile());
+        return;
+    }
+
+    const Profile profile = profiles.value(name);
+    if (profile.hasItems()) {
+        if (onReady) onReady(profile);
+        if (!isFresh(profile))
+            refresh(name);
+        return;
+    }
+
+    Waiter waiter;
+    waiter.context = context;
+    waiter.hasContext = (context != nullptr);
+    waiter.onReady = onReady;
+    pending[name].append(waiter);
+    refresh(name);
+}
+
+/**
+ * @brief Pide varios perfiles en paralelo y avisa una vez, cuando están todos.
+ */
+void PlayerProfiles::resolveAll(const QList<QPair<QString, int>> &players, QObject *context,
+                                BatchHandler onReady) {
+    if (players.isEmpty()) {
+        if (onReady) onReady({});
+        return;
+    }
+
+    auto result = std::make_shared<QHash<QString, Profile>>();
+    auto left = std::make_shared<int>(players.size());
+    QPointer<QObject> guard = context;
+    const bool hasContext = (context != nullptr);
+
+    for (const auto &player : players) {
+        remember(player.first, player.second);
+        lookup(player.first, nullptr, [=](const Profile &profile) {
+            if (!player.first.isEmpty())
+                result->insert(player.first, profile);
+            if (--*left > 0)
+                return;
+            if (hasContext && !guard)
+                return;
+            if (onReady) onReady(*result);
+        });
+    }
+}
+
+/**
+ * @brief Aplica un cambio de objetos hecho por el propio usuario.
+ */
+void PlayerProfiles::updateEquipped(int id, int skinId, int tapeteId) {
+    auto it = names.constFind(id);
+    if (it == names.constEnd())
+        return;
+    Profile &profile = profiles[it.value()];
+    if (skinId > 0) profile.skinId = skinId;
+    if (tapeteId > 0) profile.tapeteId = tapeteId;
+    profile.fetchedAt = QDateTime::currentDateTimeUtc();
+    saveTimer->start();
+    emit profileUpdated(profile);
+}
+
+/**
+ * @brief Lanza la consulta de un jugador salvo que ya haya una en curso.
+ */
+void PlayerProfiles::refresh(const QString &name) {
+    if (inFlight.contains(name))
+        return;
+    inFlight.insert(name);
+    if (profiles.value(name).id >= 0)
+        fetchItems(name);
+    else
+        fetchId(name);
+}
+
+/**
+ * @brief Id numérico a partir del nombre ("usuarios/id").
+ */
+void PlayerProfiles::fetchId(const QString &name) {
+    QNetworkRequest request(QUrl(QStringLiteral("http://188.165.76.134:8000/usuarios/usuarios/id/%1/").arg(name)));
+    request.setTransferTimeout(kTimeoutMs);
+    QNetworkReply *reply = manager->get(request);
+    connect(reply, &QNetworkReply::finished, this, [this, reply, name]() {
+        reply->deleteLater();
+        if (reply->error() != QNetworkReply::NoError) {
+            qWarning() << "[PERFILES] Error id para" << name << ":" << reply->errorString();
+            finish(name);
+            return;
+        }
+        int id = QJsonDocument::fromJson(reply->readAll()).object().value("user_id").toInt(-1);
+        if (id < 0) {
+            finish(name);
+            return;
+        }
+        remember(name, id);
+        fetchItems(name);
+    });
+}
+
+/**
+ * @brief Objetos equipados a partir del id ("get_equipped_items").
+ */
+void PlayerProfiles::fetchItems(const QString &name) {
+    const int id = profiles.value(name).id;
+    QNetworkRequest request(QUrl(QStringLiteral("http://188.165.76.134:8000/usuarios/get_equipped_items/%1/").arg(id)));
+    request.setTransferTimeout(kTimeoutMs);
+    QNetworkReply *reply = manager->get(request);
+    connect(reply, &QNetworkReply::finished, this, [this, reply, name]() {
+        reply->deleteLater();
+        if (reply->error() != QNetworkReply::NoError) {
+            qWarning() << "[PERFILES] Error objetos para" << name << ":" << reply->errorString();
+            finish(name);
+            return;
+        }
+        const QJsonDocument doc = QJsonDocument::fromJson(reply->readAll());
+        if (doc.isObject()) {
+            Profile &profile = profiles[name];
+            profile.skinId = equippedId(doc.object().value("equipped_skin"));
+            profile.tapeteId = equippedId(doc.object().value("equipped_tapete"));
+            profile.fetchedAt = QDateTime::currentDateTimeUtc();
+            saveTimer->start();
+            qDebug() << "[PERFILES]" << name << "→ baraja" << profile.skinId << "tapete" << profile.tapeteId;
+            emit profileUpdated(profile);
+        }
+        finish(name);
+    });
+}
+
+/**
+ * @brief Cierra la consulta de un jugador y avisa a las vistas en espera.
+ */
+void PlayerProfiles::finish(const QString &name) {
+    inFlight.remove(name);
+    const QList<Waiter> waiters = pending.take(name);
+    const Profile profile = profiles.value(name);
+    for (const Waiter &w : waiters) {
+        if (w.hasContext && !w.context) continue;
+        if (w.onReady) w.onReady(profile);
+    }
+}
+
+/**
+ * @brief Lee los perfiles guardados.
+ */
+void PlayerProfiles::load() {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    QDataStream in(&file);
+    quint32 magic = 0;
+    qint32 count = 0;
+    in >> magic;
+    if (magic != kMagic)
+        return;
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        Profile profile;
+        in >> profile.name >> profile.id >> profile.skinId >> profile.tapeteId >> profile.fetchedAt;
+        if (in.status() != QDataStream::Ok || profile.name.isEmpty())
+            break;
+        profiles.insert(profile.name, profile);
+        if (profile.id >= 0)
+            names.insert(profile.id, profile.name);
+    }
+}
+
+/**
+ * @brief Escribe todos los perfiles de forma atómica.
+ */
+void PlayerProfiles::save() {
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "[PERFILES] No se pudo escribir" << path;
+        return;
+    }
+    QDataStream out(&file);
+    out << kMagic << qint32(profiles.size());
+    for (const Profile &profile : std::as_const(profiles))
+        out << profile.name << profile.id << profile.skinId << profile.tapeteId << profile.fetchedAt;
+    file.commit();
+}
@@ -0,0 +1,167 @@
+/**
+ * @file playerprofiles.h
+ * @brief Declaración de la clase PlayerProfiles, caché de perfiles de jugador.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * PlayerProfiles guarda, por nombre de usuario, su id numérico y los objetos que
+ * tiene equipados (baraja y tapete). La partida, el inventario y la pantalla de
+ * carga la consultan en lugar de encadenar "usuarios/id" y "get_equipped_items"
+ * cada vez que necesitan la baraja de un jugador.
+ */
+
+#ifndef PLAYERPROFILES_H
+#define PLAYERPROFILES_H
+
+#include <QObject>
+#include <QDateTime>
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QPointer>
+#include <QSet>
+#include <functional>
+
+class QNetworkAccessManager;
+class QTimer;
+
+/**
+ * @class PlayerProfiles
+ * @brief Caché persistente de id y objetos equipados, indexada por nombre e id.
+ *
+ * - El id de un usuario no cambia: una vez conocido (por "usuarios/id" o porque
+ *   lo trae un evento de la partida) no se vuelve a pedir.
+ * - Los objetos equipados se consideran frescos durante kTtlSecs. Pasado ese
+ *   tiempo se sirven igualmente y se refrescan en segundo plano
+ *   (profileUpdated()).
+ * - Las peticiones de un mismo jugador se agrupan: si ya hay una en curso, las
+ *   nuevas esperan a esa.
+ *
+ * El contenido se guarda en disco para que la primera partida de la sesión ya
+ * tenga las barajas de los rivales habituales.
+ */
+class PlayerProfiles : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @struct Profile
+     * @brief Datos de un jugador.
+     */
+    struct Profile {
+        QString name;         ///< Nombre de usuario.
+        int id = -1;          ///< Id numérico (-1 si aún no se conoce).
+        int skinId = -1;      ///< Baraja equipada, id del servidor (1 = base).
+        int tapeteId = -1;    ///< Tapete equipado, id del servidor (1 = verde).
+        QDateTime fetchedAt;  ///< Última lectura de los objetos equipados (inválida = nunca).
+
+        /** @brief true si ya se han leído alguna vez los objetos equipados. */
+        bool hasItems() const { return fetchedAt.isValid(); }
+    };
+
+    /// Recibe el perfil (sin objetos si no se pudieron obtener).
+    using Handler = std::function<void(const Profile &profile)>;
+    /// Recibe los perfiles pedidos, indexados por nombre.
+    using BatchHandler = std::function<void(const QHash<QString, Profile> &profiles)>;
+
+    /** @brief Instancia compartida por toda la aplicación. */
+    static PlayerProfiles &instance();
+
+    /**
+     * @brief Constructor.
+     * @param directory Carpeta de persistencia (vacía = CacheLocation).
+     * @param parent Objeto padre.
+     */
+    explicit PlayerProfiles(const QString &directory = QString(), QObject *parent = nullptr);
+
+    /**
+     * @brief Anota el id de un jugador sin tocar la red.
+     * @param name Nombre de usuario.
+     * @param id Id numérico.
+     */
+    void remember(const QString &name, int id);
+
+    /**
+     * @brief Empieza a obtener el perfil si no está fresco (p. ej. al llegar "player_joined").
+     * @param name Nombre de usuario.
+     * @param id Id numérico, si se conoce (evita la consulta "usuarios/id").
+     */
+    void prefetch(const QString &name, int id = -1);
+
+    /**
+     * @brief Pide el perfil de un jugador.
+     * @param name Nombre de usuario.
+     * @param context Objeto cuyo ciclo de vida limita el callback (puede ser nullptr).
+     * @param onReady Se invoca de inmediato si ya hay objetos en memoria.
+     */
+    void lookup(const QString &name, QObject *context, Handler onReady);
+
+    /**
+     * @brief Pide los perfiles de varios jugadores a la vez.
+     * @param players Pares (nombre, id); id -1 si no se conoce.
+     * @param context Objeto cuyo ciclo de vida limita el callback.
+     * @param onReady Se invoca una sola vez, cuando todos están resueltos.
+     *
+     * Las consultas que faltan se lanzan todas en paralelo; con los ids que da
+     * la partida basta una petición por jugador.
+     */
+    void resolveAll(const QList<QPair<QString, int>> &players, QObject *context, BatchHandler onReady);
+
+    /**
+     * @brief Perfil en memoria, sin lanzar ninguna consulta.
+     * @param name Nombre de usuario.
+     */
+    Profile cached(const QString &name) const { return profiles.value(name); }
+
+    /** @brief true si los objetos equipados se leyeron hace menos de kTtlSecs. */
+    static bool isFresh(const Profile &profile);
+
+    /**
+     * @brief Actualiza los objetos equipados tras cambiarlos desde el inventario.
+     * @param id Id numérico del usuario.
+     * @param skinId Nueva baraja (-1 = sin cambios).
+     * @param tapeteId Nuevo tapete (-1 = sin cambios).
+     */
+    void updateEquipped(int id, int skinId, int tapeteId);
+
+    /** @brief Segundos que se consideran frescos los objetos equipados. */
+    static constexpr int kTtlSecs = 300;
+    /** @brief Tiempo máximo de cada petición. */
+    static constexpr int kTimeoutMs = 5000;
+
+signals:
+    /**
+     * @brief Han llegado objetos equipados nuevos para un jugador.
+     * @param profile Perfil actualizado.
+     */
+    void profileUpdated(const PlayerProfiles::Profile &profile);
+
+private:
+    /**
+     * @struct Waiter
+     * @brief Vista que espera un perfil en curso.
+     */
+    struct Waiter {
+        QPointer<QObject> context; ///< Objeto que limita el callback.
+        bool hasContext = false;   ///< false si se pidió sin contexto.
+        Handler onReady;           ///< Callback a invocar.
+    };
+
+    void refresh(const QString &name);
+    void fetchId(const QString &name);
+    void fetchItems(const QString &name);
+    void finish(const QString &name);
+    void load();
+    void save();
+
+    QHash<QString, Profile> profiles;       ///< Perfiles por nombre.
+    QHash<int, QString> names;              ///< Id numérico → nombre.
+    QHash<QString, QList<Waiter>> pending;  ///< Vistas en espera por nombre.
+    QSet<QString> inFlight;                 ///< Nombres con una consulta en curso.
+    QNetworkAccessManager *manager;         ///< Gestor de red propio.
+    QTimer *saveTimer;                      ///< Agrupa las escrituras a disco.
+    QString path;                           ///< Fichero de persistencia.
+};
+
+#endif // PLAYERPROFILES_H
@@ -0,0 +1,52 @@
+/**
+ * @file rankingdelegate.cpp
+ * @brief Implementación de la clase RankingDelegate.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ */
+
+#include "rankingdelegate.h"
+#include "rankingmodel.h"
+#include <QPainter>
+
+/**
+ * @brief Constructor de RankingDelegate.
+ */
+RankingDelegate::RankingDelegate(QObject *parent)
+    : QStyledItemDelegate(parent)
+{
+}
+
+/**
+ * @brief Todas las filas tienen el mismo alto.
+ */
+QSize RankingDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &) const {
+    return QSize(option.rect.width(), kRowHeight);
+}
+
+/**
+ * @brief Pinta una fila: cebra en los puestos impares y azul para el usuario local.
+ */
+void RankingDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
+                            const QModelIndex &index) const {
+    const bool own = index.data(RankingModel::CurrentUserRole).toBool();
+    const int position = index.data(RankingModel::PositionRole).toInt();
+
+    painter->save();
+
+    if (own)
+        painter->fillRect(option.rect, QColor("#3d82f6"));
+    else if (position % 2 == 1)
+        painter->fillRect(option.rect, QColor(255, 255, 255, 15));  // ~6 % opacidad
+
+    QFont font("Montserrat", 15);
+    font.setLetterSpacing(QFont::AbsoluteSpacing, 0.6);
+    font.setBold(own);
+    painter->setFont(font);
+    painter->setPen(QColor("#ffffff"));
+    painter->drawText(option.rect.adjusted(8, 0, -8, 0), Qt::AlignLeft | Qt::AlignVCenter,
+                      index.data(Qt::DisplayRole).toString());
+
+    painter->restore();
+}
@@ -0,0 +1,40 @@
+/**
+ * @file rankingdelegate.h
+ * @brief Declaración de la clase RankingDelegate, que pinta las filas de la clasificación.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ */
+
+#ifndef RANKINGDELEGATE_H
+#define RANKINGDELEGATE_H
+
+#include <QStyledItemDelegate>
+
+/**
+ * @class RankingDelegate
+ * @brief Filas de RankingModel con rayado alterno y el usuario local resaltado.
+ *
+ * El estilo (tipografía, cebra y resaltado) se decide al pintar a partir de los
+ * roles del modelo, en lugar de guardarlo en cada elemento.
+ */
+class RankingDelegate : public QStyledItemDelegate {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor.
+     * @param parent Objeto padre.
+     */
+    explicit RankingDelegate(QObject *parent = nullptr);
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option,
+               const QModelIndex &index) const override;
+    QSize sizeHint(const QStyleOptionViewItem &option,
+                   const QModelIndex &index) const override;
+
+private:
+    static constexpr int kRowHeight = 40;  ///< Alto de cada fila.
+};
+
+#endif // RANKINGDELEGATE_H
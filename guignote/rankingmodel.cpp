@@ -0,0 +1,138 @@
+/**
+ * @file rankingmodel.cpp
+ * @brief Implementación de la clase RankingModel.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ */
+
+#include "rankingmodel.h"
+#include <QJsonObject>
+
+/**
+ * @brief Constructor de RankingModel.
+ */
+RankingModel::RankingModel(const QString &currentUser, QObject *parent)
+    : QAbstractListModel(parent),
+      currentUser(currentUser)
+{
+}
+
+/**
+ * @brief Solo cuentan las filas ya reveladas.
+ */
+int RankingModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : loaded;
+}
+
+/**
+ * @brief "Nº  nombre - Elo: X" y los roles que usa RankingDelegate.
+ */
+QVariant RankingModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= loaded)
+        return QVariant();
+
+    const Entry &e = entries.at(index.row());
+    switch (role) {
+    case Qt::DisplayRole:
+        return QString("%1º  %2 - Elo: %3").arg(index.row() + 1).arg(e.name).arg(e.elo);
+    case NameRole:        return e.name;
+    case EloRole:         return e.elo;
+    case PositionRole:    return index.row() + 1;
+    case CurrentUserRole: return e.name == currentUser;
+    default:              return QVariant();
+    }
+}
+
+/**
+ * @brief Quedan jugadores sin revelar.
+ */
+bool RankingModel::canFetchMore(const QModelIndex &parent) const {
+    return !parent.isValid() && loaded < entries.size();
+}
+
+/**
+ * @brief La vista ha llegado al final: se revela la siguiente página.
+ */
+void RankingModel::fetchMore(const QModelIndex &parent) {
+    if (parent.isValid()) return;
+    revealUpTo(loaded + kPageSize);
+}
+
+/**
+ * @brief Inserta las filas hasta @p count (acotado al total).
+ */
+void RankingModel::revealUpTo(int count) {
+    count = qMin(count, int(entries.size()));
+    if (count <= loaded) return;
+    beginInsertRows(QModelIndex(), loaded, count - 1);
+    loaded = count;
+    endInsertRows();
+}
+
+/**
+ * @brief Sustituye la clasificación y reconstruye el índice por nombre.
+ *
+ * HttpCache entrega primero la copia local y después la del servidor; si ambas
+ * coinciden no se reinicia el modelo y la vista conserva el desplazamiento.
+ */
+void RankingModel::setPlayers(const QJsonArray &players, const QString &field) {
+    if (players == source && field == eloField)
+        return;
+
+    beginResetModel();
+    source = players;
+    eloField = field;
+    entries.clear();
+    entries.reserve(players.size());
+    byName.clear();
+    for (const QJsonValue &value : players) {
+        QJsonObject player = value.toObject();
+        Entry e{player.value("nombre").toString(), player.value(field).toInt()};
+        // Si un nombre se repite (parejas) se queda el mejor puesto
+        const QString key = e.name.toLower();
+        if (!byName.contains(key))
+            byName.insert(key, entries.size());
+        entries.append(e);
+    }
+    loaded = qMin(int(kPageSize), int(entries.size()));
+    endResetModel();
+}
+
+/**
+ * @brief Número total de jugadores.
+ */
+int RankingModel::totalCount() const {
+    return entries.size();
+}
+
+/**
+ * @brief Coincidencia exacta o, si no la hay, el primer nombre (alfabético) con ese prefijo.
+ */
+int RankingModel::indexOf(const QString &name) const {
+    const QString key = name.trimmed().toLower();
+    if (key.isEmpty())
+        return -1;
+    auto it = byName.lowerBound(key);
+    if (it == byName.constEnd() || !it.key().startsWith(key))
+        return -1;
+    return it.value();
+}
+
+/**
+ * @brief Fila del usuario local.
+ */
+int RankingModel::currentUserRow() const {
+    int row = byName.value(currentUser.toLower(), -1);
+    return (row >= 0 && entries.at(row).name == currentUser) ? row : -1;
+}
+
+/**
+ * @brief Revela hasta la página que contiene @p row.
+ */
+QModelIndex RankingModel::reveal(int row) {
+    if (row < 0 || row >= entries.size())
+        return QModelIndex();
+    revealUpTo((row / kPageSize + 1) * kPageSize);
+    return index(row);
+}
@@ -0,0 +1,104 @@
+/**
+ * @file rankingmodel.h
+ * @brief Declaración de la clase RankingModel, modelo de la clasificación.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * RankingModel respalda la lista de RankingWindow: expone los jugadores por
+ * páginas a medida que se desplaza la vista y permite saltar a un jugador.
+ */
+
+#ifndef RANKINGMODEL_H
+#define RANKINGMODEL_H
+
+#include <QAbstractListModel>
+#include <QJsonArray>
+#include <QMap>
+#include <QVector>
+
+/**
+ * @class RankingModel
+ * @brief Clasificación (individual o por parejas) cargada por páginas.
+ *
+ * setPlayers() recibe la respuesta completa de /usuarios/top_elo*, pero la vista
+ * solo ve las filas ya reveladas: canFetchMore()/fetchMore() añaden kPageSize
+ * filas cada vez que se llega al final. El índice por nombre resuelve búsquedas
+ * sin recorrer la lista y reveal() carga las páginas necesarias para mostrar
+ * una posición concreta.
+ */
+class RankingModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    /** @brief Roles adicionales de cada fila. */
+    enum Roles {
+        NameRole = Qt::UserRole + 1,  ///< Nombre del jugador.
+        EloRole,                      ///< Elo mostrado.
+        PositionRole,                 ///< Puesto (empezando en 1).
+        CurrentUserRole               ///< true si es el usuario local.
+    };
+
+    /** @brief Filas que se revelan en cada página. */
+    static constexpr int kPageSize = 50;
+
+    /**
+     * @brief Constructor.
+     * @param currentUser Nombre del usuario local, que se resalta.
+     * @param parent Objeto padre.
+     */
+    explicit RankingModel(const QString &currentUser, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+
+    /**
+     * @brief Sustituye la clasificación; si no ha cambiado no hace nada.
+     * @param players Array de jugadores con "nombre" y el campo de Elo.
+     * @param eloField "elo" o "elo_parejas".
+     */
+    void setPlayers(const QJsonArray &players, const QString &eloField);
+
+    /** @brief Número total de jugadores, revelados o no. */
+    int totalCount() const;
+
+    /**
+     * @brief Fila del jugador cuyo nombre coincide o empieza por el texto dado.
+     * @param name Nombre buscado (sin distinguir mayúsculas).
+     * @return Fila, o -1 si no hay coincidencia.
+     */
+    int indexOf(const QString &name) const;
+
+    /** @brief Fila del usuario local, o -1 si no aparece. */
+    int currentUserRow() const;
+
+    /**
+     * @brief Revela las páginas necesarias para mostrar una fila.
+     * @param row Fila (0 = primer puesto).
+     * @return Índice de la fila, o inválido si no existe.
+     */
+    QModelIndex reveal(int row);
+
+private:
+    /**
+     * @struct Entry
+     * @brief Jugador de la clasificación.
+     */
+    struct Entry {
+        QString name;  ///< Nombre.
+        int elo;       ///< Elo.
+    };
+
+    void revealUpTo(int count);
+
+    QString currentUser;          ///< Usuario local.
+    QString eloField;             ///< Campo de Elo de la respuesta actual.
+    QJsonArray source;            ///< Última respuesta aplicada.
+    QVector<Entry> entries;       ///< Todos los jugadores, por puesto.
+    int loaded = 0;               ///< Filas visibles para la vista.
+    QMap<QString, int> byName;    ///< Nombre en minúsculas → fila (ordenado, para prefijos).
+};
+
+#endif // RANKINGMODEL_H
@@ -12,8 +12,13 @@
  */
 
 #include "rankingwindow.h"
+#include "session.h"
+#include "httpcache.h"
+#include "rankingmodel.h"
+#include "rankingdelegate.h"
 
-#include <QListWidget>
+#include <QListView>
+#include <QLineEdit>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QLabel>
@@ -46,40 +51,11 @@ RankingWindow::RankingWindow(const QString &userKey, QWidget *parent)
     setStyleSheet("background-color: #171718; border-radius: 30px; padding: 20px;");
     setFixedSize(900, 650);
 
-    networkManager = new QNetworkAccessManager(this);
-    authToken = loadAuthToken(userKey);
+    authToken = Session::forUser(userKey).token();
     setupUI();
     fetchIndividualRanking();
 }
 
-/**
- * @brief Carga el token de autenticación desde el archivo .conf del usuario.
- * @param userKey Clave de usuario usada en el nombre del archivo.
- * @return QString Token extraído o cadena vacía si falla.
- */
-QString RankingWindow::loadAuthToken(const QString &userKey) {
-    QString configPath = QStandardPaths::writableLocation(QStandardPaths::ConfigLocation)
-    + QString("/Grace Hopper/Sota, Caballo y Rey_%1.conf").arg(userKey);
-    QFile configFile(configPath);
-    if (!configFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qDebug() << "No se pudo cargar el archivo de configuración.";
-        return "";
-    }
-    QString token;
-    while (!configFile.atEnd()) {
-        QString line = configFile.readLine().trimmed();
-        if (line.startsWith("token=")) {
-            token = line.mid(QString("token=").length()).trimmed();
-            break;
-        }
-    }
-    configFile.close();
-    if (token.isEmpty()) {
-        qDebug() << "No se encontró el token en el archivo de configuración.";
-    }
-    return token;
-}
-
 /**
  * @brief Construye y organiza todos los widgets de la UI.
  *
@@ -178,31 +154,56 @@ void RankingWindow::setupUI() {
 
     mainLayout->addLayout(filterLayout);
 
-    rankingListWidget = new QListWidget(this);
+    // ——— Búsqueda local y "Mi posición" ———
+    searchEdit = new QLineEdit(this);
+    searchEdit->setPlaceholderText("Buscar jugador...");
+    searchEdit->setStyleSheet(
+        "QLineEdit { background-color: #222; color: white; border: 1px solid #555; border-radius: 15px; padding: 6px 12px; font-size: 16px; }"
+        "QLineEdit:focus { border: 1px solid #888; }"
+        );
+    connect(searchEdit, &QLineEdit::textChanged, this, [this](const QString &text) {
+        jumpTo(text);
+    });
+
+    myPositionButton = new QPushButton("Mi posición", this);
+    myPositionButton->setStyleSheet(
+        "QPushButton { background-color: #3d82f6; color: white; border: none; border-radius: 15px; padding: 6px 16px; font-size: 16px; }"
+        "QPushButton:hover { background-color: #2f6fd8; }"
+        );
+    connect(myPositionButton, &QPushButton::clicked, this, [this]() {
+        jumpTo(currentUserName);
+    });
 
-    rankingListWidget->setStyleSheet(R"(
-    rankingListWidget->setStyleSheet(R"(
-    QListWidget {
+    QHBoxLayout *searchLayout = new QHBoxLayout();
+    searchLayout->addStretch();
+    searchLayout->addWidget(searchEdit, 1);
+    searchLayout->addWidget(myPositionButton);
+    searchLayout->addStretch();
+    mainLayout->addLayout(searchLayout);
+
+    // ——— Lista: el modelo revela páginas al desplazarse y el delegado pinta las filas ———
+    rankingModel = new RankingModel(currentUserName, this);
+    rankingListView = new QListView(this);
+    rankingListView->setModel(rankingModel);
+    rankingListView->setItemDelegate(new RankingDelegate(rankingListView));
+    rankingListView->setUniformItemSizes(true);
+    rankingListView->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+
+    rankingListView->setStyleSheet(R"(
+    QListView {
         background: transparent;
         border: none;
     }
-
-    /* Eliminamos el reborde punteado que dibuja Qt cuando hay foco/selección */
-    QListWidget::item:selected {
-        outline: none;
-    }
     )");
 
-    rankingListWidget->setSelectionMode(QAbstractItemView::NoSelection);
-    rankingListWidget->setMinimumWidth(600);
-    rankingListWidget->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Expanding);
-    rankingListWidget->setTextElideMode(Qt::ElideNone);
-    rankingListWidget->setWordWrap(true);
-    rankingListWidget->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-    rankingListWidget->setFocusPolicy(Qt::NoFocus);
+    rankingListView->setSelectionMode(QAbstractItemView::NoSelection);
+    rankingListView->setMinimumWidth(600);
+    rankingListView->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Expanding);
+    rankingListView->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    rankingListView->setFocusPolicy(Qt::NoFocus);
     QHBoxLayout *centeredListLayout = new QHBoxLayout();
     centeredListLayout->addStretch();
-    centeredListLayout->addWidget(rankingListWidget);
+    centeredListLayout->addWidget(rankingListView);
     centeredListLayout->addStretch();
     mainLayout->addLayout(centeredListLayout);
 
@@ -213,130 +214,109 @@ void RankingWindow::setupUI() {
 /**
  * @brief Solicita al servidor el ranking individual.
  *
- * Monta la URL según si está marcado “Solo amigos” y envía un GET.
- * Conecta la respuesta a @ref handleIndividualRankingResponse.
+ * Monta la URL según si está marcado “Solo amigos” y la pide a través de
+ * @ref HttpCache: si hay copia local se pinta al instante y se refresca en segundo plano.
  */
 void RankingWindow::fetchIndividualRanking() {
-    QString cat = "top_elo" + amigos;
+    QString filtro = amigos;
+    QString cat = "top_elo" + filtro;
     QUrl url(QString("http://188.165.76.134:8000/usuarios/" + cat +"/"));
     QNetworkRequest request(url);
     request.setRawHeader("Auth", authToken.toUtf8());
-    QNetworkReply *reply = networkManager->get(request);
-    connect(reply, &QNetworkReply::finished, this, &RankingWindow::handleIndividualRankingResponse);
     lastPressed = 1;
+    // Cambiar de pestaña es inmediato si ya se había recibido este ranking
+    if (rankings.contains(cat))
+        updateRankingList(rankings.value(cat), 1);
+    HttpCache::instance().get(request, this,
+        [this, filtro](const QByteArray &data, bool) {
+            // Ignoramos respuestas de una pestaña o filtro que ya no está activo
+            if (lastPressed == 1 && amigos == filtro)
+                handleIndividualRankingResponse(data);
+        },
+        [](int, const QString &error) {
+            qDebug() << "Error al obtener el ranking individual:" << error;
+        });
 }
 
 /**
  * @brief Solicita al servidor el ranking por parejas.
  *
- * Monta la URL correspondiente (parejas + filtro amigos) y envía un GET.
- * Conecta la respuesta a @ref handleTeamRankingResponse.
+ * Monta la URL correspondiente (parejas + filtro amigos) y la pide a través de
+ * @ref HttpCache, igual que el ranking individual.
  */
 void RankingWindow::fetchTeamRanking() {
-    QString cat = "top_elo_parejas" + amigos;
+    QString filtro = amigos;
+    QString cat = "top_elo_parejas" + filtro;
     QUrl url(QString("http://188.165.76.134:8000/usuarios/" + cat +"/"));
     QNetworkRequest request(url);
     request.setRawHeader("Auth", authToken.toUtf8());
-    QNetworkReply *reply = networkManager->get(request);
-    connect(reply, &QNetworkReply::finished, this, &RankingWindow::handleTeamRankingResponse);
     lastPressed = 2;
+    if (rankings.contains(cat))
+        updateRankingList(rankings.value(cat), 2);
+    HttpCache::instance().get(request, this,
+        [this, filtro](const QByteArray &data, bool) {
+            if (lastPressed == 2 && amigos == filtro)
+                handleTeamRankingResponse(data);
+        },
+        [](int, const QString &error) {
+            qDebug() << "Error al obtener el ranking por parejas:" << error;
+        });
 }
 
 /**
  * @brief Procesa la respuesta del servidor para el ranking individual.
+ * @param responseData Cuerpo JSON de la respuesta.
  *
- * Si no hay error, parsea el JSON y extrae el array "top_elo_players",
- * luego llama a @ref updateRankingList con dicho array.
- * En caso de error, imprime en debug.
+ * Extrae el array "top_elo_players" y llama a @ref updateRankingList con dicho array.
  */
-void RankingWindow::handleIndividualRankingResponse() {
-    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
-    if (reply->error() == QNetworkReply::NoError) {
-        QByteArray responseData = reply->readAll();
-        QJsonDocument jsonDoc = QJsonDocument::fromJson(responseData);
-        QJsonArray playersArray = jsonDoc.object().value("top_elo_players").toArray();
-        updateRankingList(playersArray, 1);
-    } else {
-        qDebug() << "Error al obtener el ranking individual:" << reply->errorString();
-    }
-    reply->deleteLater();
+void RankingWindow::handleIndividualRankingResponse(const QByteArray &responseData) {
+    QJsonDocument jsonDoc = QJsonDocument::fromJson(responseData);
+    QJsonArray playersArray = jsonDoc.object().value("top_elo_players").toArray();
+    updateRankingList(playersArray, 1);
 }
 
 /**
  * @brief Procesa la respuesta del servidor para el ranking por parejas.
+ * @param responseData Cuerpo JSON de la respuesta.
  *
- * Si no hay error, parsea el JSON y extrae el array "top_elo_parejas_players",
- * luego llama a @ref updateRankingList con dicho array.
- * En caso de error, imprime en debug.
+ * Extrae el array "top_elo_parejas_players" y llama a @ref updateRankingList con dicho array.
  */
-void RankingWindow::handleTeamRankingResponse() {
-    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
-    if (reply->error() == QNetworkReply::NoError) {
-        QByteArray responseData = reply->readAll();
-        QJsonDocument jsonDoc = QJsonDocument::fromJson(responseData);
-        QJsonArray playersArray = jsonDoc.object().value("top_elo_parejas_players").toArray();
-        updateRankingList(playersArray, 2);
-    } else {
-        qDebug() << "Error al obtener el ranking por parejas:" << reply->errorString();
-    }
-    reply->deleteLater();
+void RankingWindow::handleTeamRankingResponse(const QByteArray &responseData) {
+    QJsonDocument jsonDoc = QJsonDocument::fromJson(responseData);
+    QJsonArray playersArray = jsonDoc.object().value("top_elo_parejas_players").toArray();
+    updateRankingList(playersArray, 2);
 }
 
 /**
- * @brief Actualiza el QListWidget con los datos del ranking.
+ * @brief Muestra una clasificación y la recuerda para volver a ella sin esperar.
  * @param playersArray Array de objetos JSON con campos "nombre" y "elo"/"elo_parejas".
  * @param type       1=individual, 2=parejas.
  *
- * Limpia la lista, recorre el array, crea items con formato,
- * aplica “zebra” y resalta al usuario actual.
+ * El modelo solo revela la primera página; el resto se añade al desplazarse.
+ * La cebra y el resaltado del usuario actual los pinta @ref RankingDelegate.
  */
 void RankingWindow::updateRankingList(const QJsonArray &playersArray, int type)
 {
-    rankingListWidget->clear();
-
-    int position = 1;
-    for (const QJsonValue &value : playersArray) {
-        QJsonObject playerObj = value.toObject();
-        QString playerName = playerObj.value("nombre").toString();
-
-        int elo = (type == 1)
-                      ? playerObj.value("elo").toInt()
-                      : playerObj.value("elo_parejas").toInt();
-
-        QString listItemText = QString("%1º  %2 - Elo: %3")
-                                   .arg(position)
-                                   .arg(playerName)
-                                   .arg(elo);
-
-        /* ────────────── Crear item ────────────── */
-        QListWidgetItem *item = new QListWidgetItem(listItemText);
-
-        /* --- tipografía base --- */
-        QFont font("Montserrat", 15);
-        font.setLetterSpacing(QFont::AbsoluteSpacing, 0.6);
-        item->setFont(font);
-        item->setSizeHint(QSize(rankingListWidget->width() - 40, 40));
-
-        /* >>> NUEVA LÍNEA: color de texto por defecto <<< */
-        item->setForeground(QColor("#ffffff"));   // texto blanco
-
-        /* --- zebra manual (posición empieza en 1) --- */
-        if (position % 2 == 1) {                               // filas 1,3,5…
-            item->setBackground(QColor(255, 255, 255, 15));    // ~6 % opacidad
-        }
-
-        /* --- resaltar a mi usuario --- */
-        if (playerName == currentUserName) {
-            item->setBackground(QColor("#3d82f6"));
-            item->setForeground(QColor("#ffffff"));            // texto casi negro
-            font.setBold(true);
-            item->setFont(font);
-        }
-
-        rankingListWidget->addItem(item);
-        ++position;
-    }
+    rankings.insert(rankingKey(type), playersArray);
+    rankingModel->setPlayers(playersArray, type == 1 ? "elo" : "elo_parejas");
+}
 
-    rankingListWidget->updateGeometry();
+/**
+ * @brief "top_elo" o "top_elo_parejas", con el sufijo de amigos si está activo.
+ */
+QString RankingWindow::rankingKey(int type) const {
+    return (type == 1 ? "top_elo" : "top_elo_parejas") + amigos;
 }
 
+/**
+ * @brief Busca al jugador en el índice del modelo y lo centra en la lista.
+ */
+bool RankingWindow::jumpTo(const QString &name) {
+    int row = (name == currentUserName) ? rankingModel->currentUserRow()
+                                        : rankingModel->indexOf(name);
+    QModelIndex index = rankingModel->reveal(row);
+    if (!index.isValid())
+        return false;
+    rankingListView->scrollTo(index, QAbstractItemView::PositionAtCenter);
+    return true;
+}
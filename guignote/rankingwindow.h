@@ -13,13 +13,16 @@
 #define RANKINGWINDOW_H
 
 #include <QDialog>
-#include <QNetworkAccessManager>
 #include <QVBoxLayout>
 #include <QLabel>
 #include <QPushButton>
 #include <QCheckBox>
-#include <QListWidget>
+#include <QListView>
+#include <QLineEdit>
 #include <QJsonArray>
+#include <QHash>
+
+class RankingModel;
 
 /**
  * @class RankingWindow
@@ -49,38 +52,34 @@ private:
     QPushButton *individualButton;   ///< Botón para ver ranking individual.
     QPushButton *parejasButton;      ///< Botón para ver ranking por parejas.
     QCheckBox *soloAmigosCheck;      ///< Checkbox para filtrar solo amigos.
-    QListWidget *rankingListWidget;  ///< Lista que muestra los jugadores y sus datos.
+    QListView *rankingListView;      ///< Lista que muestra los jugadores y sus datos.
+    RankingModel *rankingModel;      ///< Clasificación mostrada, revelada por páginas.
+    QLineEdit *searchEdit;           ///< Búsqueda de un jugador por nombre.
+    QPushButton *myPositionButton;   ///< Salta a la posición del usuario actual.
 
     // --- Red ---
-    QNetworkAccessManager *networkManager; ///< Gestor de peticiones HTTP.
     QString authToken;                     ///< Token de autenticación del usuario.
 
     // --- Estado y lógica ---
     QString amigos = "";           ///< Cadena que representa filtro de amigos (si se aplica).
     int lastPressed = 1;           ///< 1 para individual, 2 para parejas.
+    QHash<QString, QJsonArray> rankings; ///< Última clasificación recibida por ranking ("top_elo_amigos"...).
 
     // --- Métodos privados ---
     /** @brief Configura la interfaz gráfica. */
     void setupUI();
 
-    /**
-     * @brief Carga el token de autenticación del usuario.
-     * @param userKey Clave del usuario.
-     * @return Token válido para uso en peticiones.
-     */
-    QString loadAuthToken(const QString &userKey);
-
     /** @brief Solicita el ranking individual desde el backend. */
     void fetchIndividualRanking();
 
     /** @brief Solicita el ranking por parejas desde el backend. */
     void fetchTeamRanking();
 
-    /** @brief Maneja la respuesta HTTP del ranking individual. */
-    void handleIndividualRankingResponse();
+    /** @brief Maneja la respuesta HTTP (o la copia en caché) del ranking individual. */
+    void handleIndividualRankingResponse(const QByteArray &responseData);
 
-    /** @brief Maneja la respuesta HTTP del ranking por parejas. */
-    void handleTeamRankingResponse();
+    /** @brief Maneja la respuesta HTTP (o la copia en caché) del ranking por parejas. */
+    void handleTeamRankingResponse(const QByteArray &responseData);
 
     /**
      * @brief Actualiza la lista de jugadores mostrados en pantalla.
@@ -88,6 +87,19 @@ private:
      * @param type Tipo de ranking (1 = individual, 2 = parejas).
      */
     void updateRankingList(const QJsonArray &playersArray, int type);
+
+    /**
+     * @brief Nombre del ranking activo, que coincide con el de su endpoint.
+     * @param type Tipo de ranking (1 = individual, 2 = parejas).
+     */
+    QString rankingKey(int type) const;
+
+    /**
+     * @brief Desplaza la lista hasta un jugador.
+     * @param name Nombre (o prefijo) del jugador.
+     * @return true si se ha encontrado.
+     */
+    bool jumpTo(const QString &name);
 };
 
 #endif // RANKINGWINDOW_H
@@ -1,5 +1,7 @@
 // rankswindow.cpp
 #include "rankswindow.h"
+#include "session.h"
+#include "imageloader.h"
 #include <QHBoxLayout>
 #include <QVBoxLayout>
 #include <QLabel>
@@ -18,6 +20,10 @@
 #include <QSize>
 #include <QPropertyAnimation>
 
+// Iconos de cada rango, de menor a mayor
+static const QVector<QString> kRankIcons = { "flip-flops", "sofa", "beer", "80", "yogi" };
+static const QSize kRankIconSize(32, 32);
+
 // --- RangeBarWidget --------------------------------------------------------
 
 class RangeBarWidget : public QWidget {
@@ -121,9 +127,8 @@ private:
 
 // --- RanksWindow implementation --------------------------------------------
 
-#include <QNetworkAccessManager>
+#include "httpcache.h"
 #include <QNetworkRequest>
-#include <QNetworkReply>
 #include <QJsonDocument>
 #include <QJsonObject>
 
@@ -131,8 +136,6 @@ RanksWindow::RanksWindow(const QString &userKey, QWidget *parent)
     : QDialog(parent)
     , userKey(userKey)
 {
-    networkManager = new QNetworkAccessManager(this);
-
     // diálogo sin marco y fondo oscuro
     setWindowFlags(Qt::FramelessWindowHint | Qt::Dialog);
     setAttribute(Qt::WA_StyledBackground, true);
@@ -151,70 +154,54 @@ RanksWindow::RanksWindow(const QString &userKey, QWidget *parent)
     fetchElo();
 }
 
-QString RanksWindow::loadAuthToken() {
-    QString configPath = QStandardPaths::writableLocation(QStandardPaths::ConfigLocation)
-    + QString("/Grace Hopper/Sota, Caballo y Rey_%1.conf").arg(userKey);
-    QFile file(configPath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "No se pudo abrir config:" << configPath;
-        return {};
-    }
-    QString token;
-    while (!file.atEnd()) {
-        QString line = file.readLine().trimmed();
-        if (line.startsWith("token=")) {
-            token = line.mid(QString("token=").length()).trimmed();
-            break;
-        }
-    }
-    return token;
-}
-
 void RanksWindow::fetchElo() {
-    QString token = loadAuthToken();
+    QString token = Session::forUser(userKey).token();
     if (token.isEmpty()) return;
 
     QNetworkRequest req(QUrl("http://188.165.76.134:8000/usuarios/elo/"));
     req.setRawHeader("Auth", token.toUtf8());
-    auto* reply = networkManager->get(req);
-    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-        if (reply->error() == QNetworkReply::NoError) {
-            auto doc = QJsonDocument::fromJson(reply->readAll());
-            if (doc.isObject()) {
-                int finalElo = doc.object().value("elo").toInt();
-
-                // 1) calcular índice de rango
-                int idx = 0;
-                while (idx < m_thresholds.size() && finalElo >= m_thresholds[idx]) ++idx;
-
-                // 2) actualizar icono
-                QPixmap pm(QString(":/icons/%1.png").arg(m_icons[idx]));
-                rangoIconLabel->setPixmap(pm.scaled(32,32,Qt::KeepAspectRatio,Qt::SmoothTransformation));
-
-                // 3) actualizar texto
-                eloLabel->setText(QString("Rango: %1").arg(m_rangos[idx]));
-
-                // 4) animar barra
-                QPropertyAnimation* anim = new QPropertyAnimation(barWidget, "elo", this);
-                anim->setStartValue(0);
-                anim->setEndValue(finalElo);
-                anim->setDuration(1500);
-                anim->setEasingCurve(QEasingCurve::OutCubic);
-                anim->start(QAbstractAnimation::DeleteWhenStopped);
-            }
-        } else {
-            qWarning() << "Error fetchElo:" << reply->errorString();
-        }
-        reply->deleteLater();
+    // La copia en caché se pinta al instante; si el servidor trae otro ELO, la barra se anima hasta él
+    HttpCache::instance().get(req, this, [this](const QByteArray &data, bool) {
+        auto doc = QJsonDocument::fromJson(data);
+        if (!doc.isObject()) return;
+        int finalElo = doc.object().value("elo").toInt();
+
+        // 1) calcular índice de rango
+        int idx = 0;
+        while (idx < m_thresholds.size() && finalElo >= m_thresholds[idx]) ++idx;
+
+        // 2) actualizar icono
+        rangoIconLabel->setPixmap(ImageLoader::instance().pixmap(
+            QString(":/icons/%1.png").arg(m_icons[idx]), kRankIconSize));
+
+        // 3) actualizar texto
+        eloLabel->setText(QString("Rango: %1").arg(m_rangos[idx]));
+
+        // 4) animar barra desde el valor mostrado
+        QPropertyAnimation* anim = new QPropertyAnimation(barWidget, "elo", this);
+        anim->setStartValue(barWidget->property("elo").toInt());
+        anim->setEndValue(finalElo);
+        anim->setDuration(1500);
+        anim->setEasingCurve(QEasingCurve::OutCubic);
+        anim->start(QAbstractAnimation::DeleteWhenStopped);
+    }, [](int, const QString &error) {
+        qWarning() << "Error fetchElo:" << error;
     });
 }
 
 
 
+QList<ImageLoader::Request> RanksWindow::warmUpImages() {
+    QList<ImageLoader::Request> requests;
+    for (const QString &icon : kRankIcons)
+        requests.append({QString(":/icons/%1.png").arg(icon), kRankIconSize});
+    return requests;
+}
+
 void RanksWindow::setupUI() {
     //  — Colores, thresholds, iconos y textos de rango —
     m_thresholds = { 1200, 1600, 2100, 2700 };
-    m_icons      = { "flip-flops", "sofa", "beer", "80", "yogi" };
+    m_icons      = kRankIcons;
     m_rangos     = { "Guiri", "Casual", "Parroquiano", "Octogenario", "Leyenda del Imserso" };
     QVector<QString> colors = { "#fc03a5", "#045bcc", "#e0c200", "#3ea607", "#f0055b" };
 
@@ -306,8 +293,8 @@ void RanksWindow::setupUI() {
 
         // Icono
         QLabel* ic = new QLabel(item);
-        QPixmap pm(QString(":/icons/%1.png").arg(m_icons[i]));
-        ic->setPixmap(pm.scaled(32,32,Qt::KeepAspectRatio,Qt::SmoothTransformation));
+        ic->setPixmap(ImageLoader::instance().pixmap(
+            QString(":/icons/%1.png").arg(m_icons[i]), kRankIconSize));
         ic->setAlignment(Qt::AlignCenter);
 
         // Texto
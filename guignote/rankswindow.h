@@ -2,8 +2,8 @@
 #pragma once
 
 #include <QDialog>
-#include <QNetworkAccessManager>
 #include <QLabel>
+#include "imageloader.h"
 
 class RangeBarWidget;
 
@@ -13,15 +13,16 @@ class RanksWindow : public QDialog {
 public:
     explicit RanksWindow(const QString &userKey, QWidget *parent = nullptr);
 
+    // Iconos de los rangos a 32x32, tal y como los pinta la ventana
+    static QList<ImageLoader::Request> warmUpImages();
+
 private:
     void setupUI();
-    QString loadAuthToken();
     void fetchElo();
 
     QLabel* eloLabel = nullptr;
 
     QString userKey;
-    QNetworkAccessManager *networkManager;
     RangeBarWidget *barWidget;
     QLabel* rangoIconLabel;
     QLabel* rankIconLabel;
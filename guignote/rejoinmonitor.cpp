@@ -0,0 +1,53 @@
+/**
+ * @file rejoinmonitor.cpp
+ * @brief Implementación de la clase RejoinMonitor.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ */
+
+#include "rejoinmonitor.h"
+#include "roomwatcher.h"
+
+/**
+ * @brief Constructor de RejoinMonitor.
+ * @param token Token de autenticación.
+ * @param parent Objeto padre.
+ */
+RejoinMonitor::RejoinMonitor(const QString &token, QObject *parent)
+    : QObject(parent),
+      watcher(new RoomWatcher(token, {"/salas/reconectables/", "/salas/pausadas/"},
+                              "[REJOIN]", kMinPollMs, kMaxPollMs, this))
+{
+    connect(watcher, &RoomWatcher::changed, this, [this]() {
+        emit roomsChanged(reconectables(), pausadas());
+    });
+}
+
+/**
+ * @brief Abre el canal de avisos y lanza la primera consulta.
+ */
+void RejoinMonitor::start() {
+    watcher->start();
+}
+
+/**
+ * @brief Consulta las dos listas; con una ronda en curso, la repite al terminar.
+ */
+void RejoinMonitor::refresh() {
+    watcher->refresh();
+}
+
+/**
+ * @brief Salas reconectables conocidas.
+ */
+QJsonArray RejoinMonitor::reconectables() const {
+    return watcher->salas(0);
+}
+
+/**
+ * @brief Salas pausadas conocidas.
+ */
+QJsonArray RejoinMonitor::pausadas() const {
+    return watcher->salas(1);
+}
@@ -0,0 +1,68 @@
+/**
+ * @file rejoinmonitor.h
+ * @brief Declaración de la clase RejoinMonitor.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * La clase RejoinMonitor vigila las salas reconectables y pausadas del usuario
+ * para que el menú muestre u oculte el botón de reconexión.
+ */
+
+#ifndef REJOINMONITOR_H
+#define REJOINMONITOR_H
+
+#include <QObject>
+#include <QJsonArray>
+#include <QString>
+
+class RoomWatcher;
+
+/**
+ * @class RejoinMonitor
+ * @brief Notifica cambios en las salas a las que el usuario puede volver.
+ *
+ * Vigila las dos listas con un RoomWatcher: avisos por WebSocket y, sin canal,
+ * sondeo adaptativo con consultas condicionales.
+ */
+class RejoinMonitor : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor.
+     * @param token Token de autenticación del usuario.
+     * @param parent Objeto padre.
+     */
+    explicit RejoinMonitor(const QString &token, QObject *parent = nullptr);
+
+    /** @brief Abre el canal de avisos y hace la primera consulta. */
+    void start();
+
+    /** @brief Consulta ya, sin esperar al siguiente aviso o sondeo (p. ej. al volver al menú). */
+    void refresh();
+
+    /** @brief Salas reconectables conocidas. */
+    QJsonArray reconectables() const;
+
+    /** @brief Salas pausadas conocidas. */
+    QJsonArray pausadas() const;
+
+    /** @brief Intervalo de sondeo mínimo (ms). */
+    static constexpr int kMinPollMs = 2000;
+    /** @brief Intervalo de sondeo máximo (ms). */
+    static constexpr int kMaxPollMs = 60000;
+
+signals:
+    /**
+     * @brief Las listas han cambiado respecto a la última consulta.
+     * @param salas Salas reconectables.
+     * @param salasPausadas Salas pausadas.
+     */
+    void roomsChanged(const QJsonArray &salas, const QJsonArray &salasPausadas);
+
+private:
+    RoomWatcher *watcher;           ///< Avisos y sondeo de /salas/reconectables/ y /salas/pausadas/.
+};
+
+#endif // REJOINMONITOR_H
@@ -12,6 +12,7 @@
 
 
 #include "rejoinwindow.h"
+#include "session.h"
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QHBoxLayout>
@@ -50,7 +51,7 @@ RejoinWindow::RejoinWindow(QJsonArray salas, QJsonArray salasPausadas, int fondo
         qDebug() << "Número de salas pausadas:" << salasPausadas.size();
     }
 
-    token = loadAuthToken(userKey);
+    token = Session::forUser(userKey).token();
     setWindowFlags(Qt::FramelessWindowHint | Qt::Dialog);
     setAttribute(Qt::WA_StyledBackground, true);
     setStyleSheet("background-color: #171718; border-radius: 30px; padding: 20px;");
@@ -236,39 +237,6 @@ void RejoinWindow::populateSalas() {
 }
 
 
-/**
- * @brief Extrae el token de autenticación desde el archivo de configuración.
- * @param userKey Clave del usuario usada para formar la ruta del .conf.
- * @return Cadena con el token, o vacía si ocurre un error.
- *
- * Abre el fichero `.conf` asociado, busca la línea `token=...`
- * y devuelve su valor.
- */
-QString RejoinWindow::loadAuthToken(const QString &userKey) {
-    QString configPath = QStandardPaths::writableLocation(QStandardPaths::ConfigLocation)
-    + QString("/Grace Hopper/Sota, Caballo y Rey_%1.conf").arg(userKey);
-
-    qDebug() << "userKey: " << userKey;
-
-    QFile configFile(configPath);
-    if (!configFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        // Pon un qDebug() o algo para saber que falló
-        qDebug() << "No se pudo abrir el archivo de configuración en MenuWindow." << configFile.fileName();
-        return "";
-    }
-
-    QString token;
-    while (!configFile.atEnd()) {
-        QString line = configFile.readLine().trimmed();
-        if (line.startsWith("token=")) {
-            token = line.mid(QString("token=").length()).trimmed();
-            break;
-        }
-    }
-    configFile.close();
-    return token;
-}
-
 /**
  * @brief Inicia la reconexión a la sala seleccionada.
  * @param idPart Identificador de la sala (string).
@@ -68,13 +68,6 @@ private:
      */
     void manejarMensaje(const QString &userKey, const QString &mensaje);
 
-    /**
-     * @brief Carga el token de autenticación del usuario.
-     * @param userKey Clave del usuario.
-     * @return Token válido.
-     */
-    QString loadAuthToken(const QString &userKey);
-
     /**
      * @brief Realiza la solicitud de reconexión a una sala específica.
      * @param idPart ID de la partida a la que se desea reincorporar.
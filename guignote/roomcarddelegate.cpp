@@ -0,0 +1,142 @@
+/**
+ * @file roomcarddelegate.cpp
+ * @brief Implementación de la clase RoomCardDelegate.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ */
+
+#include "roomcarddelegate.h"
+#include "userlistmodel.h"
+#include <QAbstractItemView>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPainterPath>
+#include <QFontMetrics>
+
+/**
+ * @brief Constructor de RoomCardDelegate.
+ * @param parent Vista que usa el delegado.
+ */
+RoomCardDelegate::RoomCardDelegate(QObject *parent)
+    : QStyledItemDelegate(parent)
+{
+}
+
+/**
+ * @brief "Nombre  —  jugadores/capacidad".
+ */
+QString RoomCardDelegate::titleText(const QJsonObject &sala) {
+    return QString("%1  —  %2/%3")
+        .arg(sala["nombre"].toString())
+        .arg(sala["num_jugadores"].toInt())
+        .arg(sala["capacidad"].toInt());
+}
+
+/**
+ * @brief "Tiempo Turno: Xs, Reglas Arrastre: Sí/No, Revueltas: Sí/No, Solo Amigos: Sí/No".
+ */
+QString RoomCardDelegate::detailsText(const QJsonObject &sala) {
+    if (!sala["personalizacion"].isObject())
+        return QString();
+    QJsonObject personalizacion = sala["personalizacion"].toObject();
+    return "Tiempo Turno: " + QString::number(personalizacion["tiempo_turno"].toInt()) + "s, "
+           + "Reglas Arrastre: " + (personalizacion["reglas_arrastre"].toBool() ? "Sí" : "No") + ", "
+           + "Revueltas: " + (personalizacion["permitir_revueltas"].toBool() ? "Sí" : "No") + ", "
+           + "Solo Amigos: " + (personalizacion["solo_amigos"].toBool() ? "Sí" : "No");
+}
+
+/**
+ * @brief Todas las tarjetas tienen el mismo alto.
+ */
+QSize RoomCardDelegate::sizeHint(const QStyleOptionViewItem &option,
+                                 const QModelIndex &) const {
+    return QSize(qMax(option.rect.width(), 300), kRowHeight);
+}
+
+/**
+ * @brief Botón "Unirse", a la derecha y centrado en vertical.
+ */
+QRect RoomCardDelegate::buttonRect(const QRect &card) const {
+    const QSize size(90, 34);
+    return QRect(QPoint(card.right() - 10 - size.width(), card.center().y() - size.height() / 2), size);
+}
+
+/**
+ * @brief Pinta la tarjeta: fondo, nombre y ocupación, personalización y botón.
+ */
+void RoomCardDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
+                             const QModelIndex &index) const {
+    const QRect card = option.rect.adjusted(0, 5, 0, -5);
+    const QJsonObject sala = index.data(UserListModel::PayloadRole).toJsonObject();
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+
+    // Fondo ligeramente más claro que el de la ventana (#171718)
+    QPainterPath background;
+    background.addRoundedRect(card, 10, 10);
+    painter->fillPath(background, QColor("#232326"));
+
+    const QRect button = buttonRect(card);
+    const int textLeft = card.left() + 15;
+    const int textRight = button.left() - 15;
+
+    QFont titleFont = option.font;
+    titleFont.setPixelSize(18);
+    QFont detailsFont = option.font;
+    detailsFont.setPixelSize(14);
+
+    // La personalización se alinea a la derecha, junto al botón; el título ocupa el resto
+    QString details = detailsText(sala);
+    QFontMetrics detailsMetrics(detailsFont);
+    int detailsWidth = qMin(detailsMetrics.horizontalAdvance(details), (textRight - textLeft) / 2);
+    QRect detailsRect(textRight - detailsWidth, card.top(), detailsWidth, card.height());
+    QRect titleRect(textLeft, card.top(), qMax(0, detailsRect.left() - 15 - textLeft), card.height());
+
+    painter->setPen(Qt::white);
+    painter->setFont(titleFont);
+    painter->drawText(titleRect, Qt::AlignLeft | Qt::AlignVCenter,
+                      QFontMetrics(titleFont).elidedText(titleText(sala), Qt::ElideRight, titleRect.width()));
+    painter->setFont(detailsFont);
+    painter->drawText(detailsRect, Qt::AlignRight | Qt::AlignVCenter,
+                      detailsMetrics.elidedText(details, Qt::ElideRight, detailsRect.width()));
+
+    // Botón verde "Unirse"
+    QPainterPath path;
+    path.addRoundedRect(button, 5, 5);
+    painter->fillPath(path, hoverIndex == index ? QColor("#218838") : QColor("#28a745"));
+    painter->setPen(Qt::white);
+    painter->drawText(button, Qt::AlignCenter, "Unirse");
+
+    painter->restore();
+}
+
+/**
+ * @brief Resalta el botón bajo el ratón y emite joinRequested() al pulsarlo.
+ */
+bool RoomCardDelegate::editorEvent(QEvent *event, QAbstractItemModel *,
+                                   const QStyleOptionViewItem &option, const QModelIndex &index) {
+    if (event->type() != QEvent::MouseMove && event->type() != QEvent::MouseButtonRelease)
+        return false;
+
+    const QPoint pos = static_cast<QMouseEvent *>(event)->position().toPoint();
+    const bool over = buttonRect(option.rect.adjusted(0, 5, 0, -5)).contains(pos);
+
+    if (event->type() == QEvent::MouseMove) {
+        QPersistentModelIndex wanted = over ? QPersistentModelIndex(index) : QPersistentModelIndex();
+        if (hoverIndex != wanted) {
+            hoverIndex = wanted;
+            if (auto *view = qobject_cast<QAbstractItemView *>(parent()))
+                view->viewport()->update();
+        }
+        return false;
+    }
+
+    if (static_cast<QMouseEvent *>(event)->button() == Qt::LeftButton && over) {
+        const QJsonObject sala = index.data(UserListModel::PayloadRole).toJsonObject();
+        emit joinRequested(index.data(UserListModel::KeyRole).toString(), sala["capacidad"].toInt());
+        return true;
+    }
+    return false;
+}
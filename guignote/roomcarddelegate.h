@@ -0,0 +1,75 @@
+/**
+ * @file roomcarddelegate.h
+ * @brief Declaración de la clase RoomCardDelegate, que pinta las salas personalizadas.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * RoomCardDelegate dibuja cada fila de CustomGamesWindow (nombre, ocupación,
+ * personalización y botón "Unirse") sin crear widgets por sala.
+ */
+
+#ifndef ROOMCARDDELEGATE_H
+#define ROOMCARDDELEGATE_H
+
+#include <QStyledItemDelegate>
+#include <QPersistentModelIndex>
+#include <QJsonObject>
+
+/**
+ * @class RoomCardDelegate
+ * @brief Delegado de tarjetas de sala con botón "Unirse" pintado.
+ *
+ * Trabaja sobre un UserListModel cuyas filas son las salas de
+ * /salas/disponibles/. Al pulsar el botón emite joinRequested() con el id y la
+ * capacidad de esa fila.
+ */
+class RoomCardDelegate : public QStyledItemDelegate {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor.
+     * @param parent Vista que usa el delegado.
+     */
+    explicit RoomCardDelegate(QObject *parent = nullptr);
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option,
+               const QModelIndex &index) const override;
+    QSize sizeHint(const QStyleOptionViewItem &option,
+                   const QModelIndex &index) const override;
+
+    /**
+     * @brief "Nombre  —  jugadores/capacidad".
+     * @param sala Objeto JSON de la sala.
+     */
+    static QString titleText(const QJsonObject &sala);
+
+    /**
+     * @brief Resumen de la personalización de la sala.
+     * @param sala Objeto JSON de la sala.
+     * @return Texto vacío si la sala no trae "personalizacion".
+     */
+    static QString detailsText(const QJsonObject &sala);
+
+signals:
+    /**
+     * @brief Se ha pulsado "Unirse" en una sala.
+     * @param idSala Identificador de la sala.
+     * @param capacidad Capacidad de la sala.
+     */
+    void joinRequested(const QString &idSala, int capacidad);
+
+protected:
+    bool editorEvent(QEvent *event, QAbstractItemModel *model,
+                     const QStyleOptionViewItem &option, const QModelIndex &index) override;
+
+private:
+    QRect buttonRect(const QRect &card) const;
+
+    static constexpr int kRowHeight = 70;  ///< Alto de cada tarjeta (con separación).
+
+    QPersistentModelIndex hoverIndex;      ///< Fila con el ratón sobre el botón.
+};
+
+#endif // ROOMCARDDELEGATE_H
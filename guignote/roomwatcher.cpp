@@ -0,0 +1,242 @@
+/**
+ * @file roomwatcher.cpp
+ * @brief Implementación de la clase RoomWatcher.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * Contiene la suscripción por WebSocket a los avisos de salas y el sondeo
+ * condicional con espera exponencial que la sustituye cuando no hay canal.
+ */
+
+#include "roomwatcher.h"
+#include <QNetworkAccessManager>
+#include <QNetworkRequest>
+#include <QWebSocket>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTimer>
+#include <QUrl>
+#include <QDebug>
+
+/**
+ * @brief Constructor de RoomWatcher.
+ * @param token Token de autenticación.
+ * @param paths Rutas de las listas.
+ * @param tag Prefijo del log.
+ * @param minPollMs Intervalo de sondeo mínimo.
+ * @param maxPollMs Intervalo de sondeo máximo.
+ * @param parent Objeto padre.
+ */
+RoomWatcher::RoomWatcher(const QString &token, const QStringList &paths, const QString &tag,
+                         int minPollMs, int maxPollMs, QObject *parent)
+    : QObject(parent),
+      token(token),
+      tag(tag),
+      minPollMs(minPollMs),
+      maxPollMs(maxPollMs),
+      manager(new QNetworkAccessManager(this)),
+      socket(new QWebSocket(QString(), QWebSocketProtocol::VersionLatest, this)),
+      pollTimer(new QTimer(this)),
+      reconnectTimer(new QTimer(this)),
+      pollInterval(minPollMs)
+{
+    for (const QString &path : paths) {
+        Endpoint endpoint;
+        endpoint.path = path;
+        endpoints.append(endpoint);
+    }
+
+    pollTimer->setSingleShot(true);
+    connect(pollTimer, &QTimer::timeout, this, &RoomWatcher::refresh);
+
+    reconnectTimer->setSingleShot(true);
+    connect(reconnectTimer, &QTimer::timeout, this, &RoomWatcher::connectPush);
+
+    connect(socket, &QWebSocket::connected, this, [this]() {
+        qDebug().noquote() << this->tag << "Canal de avisos conectado; sondeo desactivado.";
+        pushActive = true;
+        reconnectDelay = 5000;
+        pollTimer->stop();
+        // El estado pudo cambiar mientras no había canal
+        refresh();
+    });
+    // stateChanged cubre tanto el cierre como el fallo al conectar
+    connect(socket, &QWebSocket::stateChanged, this, [this](QAbstractSocket::SocketState state) {
+        if (state == QAbstractSocket::UnconnectedState)
+            onPushDisconnected();
+    });
+    connect(socket, &QWebSocket::textMessageReceived, this, [this](const QString &) {
+        // Cualquier aviso (sala creada, llena, pausada, terminada...) invalida las listas
+        refresh();
+    });
+}
+
+/**
+ * @brief Abre el canal de avisos y lanza la primera consulta.
+ */
+void RoomWatcher::start() {
+    if (running) return;
+    running = true;
+    pollInterval = minPollMs;
+    refresh();
+    connectPush();
+}
+
+/**
+ * @brief Deja de vigilar: sin canal, sin sondeo y sin consultas pendientes.
+ */
+void RoomWatcher::stop() {
+    if (!running) return;
+    running = false;
+    refreshAgain = false;
+    pollTimer->stop();
+    reconnectTimer->stop();
+    for (const Endpoint &endpoint : endpoints) {
+        if (endpoint.reply)
+            endpoint.reply->abort();
+    }
+    socket->close();
+}
+
+/**
+ * @brief Cambia una ruta; si hay una ronda en curso, se repite con la nueva.
+ */
+void RoomWatcher::setPath(int index, const QString &path) {
+    if (index < 0 || index >= endpoints.size() || endpoints[index].path == path) return;
+    Endpoint &endpoint = endpoints[index];
+    endpoint.path = path;
+    endpoint.etag.clear();
+    endpoint.salas = QJsonArray();
+    endpoint.delivered = false;
+    if (endpoint.reply)
+        endpoint.reply->abort();
+    if (running)
+        refresh();
+}
+
+/**
+ * @brief Intenta abrir el WebSocket de avisos de salas.
+ */
+void RoomWatcher::connectPush() {
+    if (token.isEmpty() || !running) return;
+    socket->open(QUrl(QString("ws://188.165.76.134:8000/ws/salas/?token=%1").arg(token)));
+}
+
+/**
+ * @brief Sin canal de avisos: pasa a sondeo y programa un reintento con espera creciente.
+ */
+void RoomWatcher::onPushDisconnected() {
+    // Solo al perder un canal que funcionaba: si el servidor de avisos sigue
+    // caído, cada reintento fallido no debe reiniciar la espera del sondeo
+    if (pushActive) {
+        qDebug().noquote() << tag << "Canal de avisos cerrado; se vuelve al sondeo.";
+        pushActive = false;
+        pollInterval = minPollMs;
+        scheduleNextPoll();
+    }
+    if (!running) return;
+
+    reconnectTimer->start(reconnectDelay);
+    reconnectDelay = qMin(reconnectDelay * 2, 300000);
+}
+
+/**
+ * @brief Consulta todas las listas; con una ronda en curso, la repite al terminar.
+ *
+ * Las respuestas de la ronda en curso pueden ser anteriores al aviso que ha
+ * provocado esta llamada, y con el canal activo no hay sondeo que lo corrija.
+ */
+void RoomWatcher::refresh() {
+    if (token.isEmpty() || !running) return;
+    if (pending > 0) {
+        refreshAgain = true;
+        return;
+    }
+    refreshAgain = false;
+    pollTimer->stop();
+    pending = endpoints.size();
+    roundChanged = false;
+    for (int i = 0; i < endpoints.size(); ++i)
+        fetch(i);
+}
+
+/**
+ * @brief GET condicional de una lista; un 304 cuenta como “sin cambios”.
+ */
+void RoomWatcher::fetch(int index) {
+    Endpoint &endpoint = endpoints[index];
+    QNetworkRequest request(QUrl("http://188.165.76.134:8000" + endpoint.path));
+    request.setRawHeader("Auth", token.toUtf8());
+    if (!endpoint.etag.isEmpty())
+        request.setRawHeader("If-None-Match", endpoint.etag);
+
+    QNetworkReply *reply = manager->get(request);
+    endpoint.reply = reply;
+    connect(reply, &QNetworkReply::finished, this, [this, reply, index]() {
+        reply->deleteLater();
+        Endpoint &ep = endpoints[index];
+
+        // Cancelada por stop() o setPath(): ya no corresponde a la lista vigente
+        if (reply->error() == QNetworkReply::OperationCanceledError) {
+            onFetchDone(false);
+            return;
+        }
+
+        int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        if (status == 304) {
+            onFetchDone(false);
+            return;
+        }
+        if (reply->error() != QNetworkReply::NoError) {
+            qDebug().noquote() << tag << "Error de red" << ep.path << ":" << reply->errorString();
+            onFetchDone(false);
+            return;
+        }
+
+        QJsonParseError parseError;
+        QJsonDocument doc = QJsonDocument::fromJson(reply->readAll(), &parseError);
+        if (parseError.error != QJsonParseError::NoError || !doc.isObject()
+            || !doc.object().value("salas").isArray()) {
+            qDebug().noquote() << tag << "Respuesta sin campo 'salas' en" << ep.path;
+            onFetchDone(false);
+            return;
+        }
+
+        ep.etag = reply->rawHeader("ETag");
+        QJsonArray nuevas = doc.object().value("salas").toArray();
+        bool changed = (nuevas != ep.salas) || !ep.delivered;
+        ep.salas = nuevas;
+        ep.delivered = true;
+        onFetchDone(changed);
+    });
+}
+
+/**
+ * @brief Cierra la ronda cuando responden todas las listas y ajusta el sondeo.
+ */
+void RoomWatcher::onFetchDone(bool changed) {
+    roundChanged = roundChanged || changed;
+    if (--pending > 0) return;
+
+    if (roundChanged) {
+        pollInterval = minPollMs;
+        emit changed();
+    } else {
+        pollInterval = qMin(pollInterval * 2, maxPollMs);
+    }
+
+    if (refreshAgain) {
+        refresh();
+        return;
+    }
+    scheduleNextPoll();
+}
+
+/**
+ * @brief Programa el siguiente sondeo; con el canal de avisos activo no se sondea.
+ */
+void RoomWatcher::scheduleNextPoll() {
+    if (pushActive || !running) return;
+    pollTimer->start(pollInterval);
+}
@@ -0,0 +1,119 @@
+/**
+ * @file roomwatcher.h
+ * @brief Declaración de la clase RoomWatcher.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * La clase RoomWatcher mantiene al día una o varias listas de salas del
+ * servidor. La usan RejoinMonitor (salas reconectables y pausadas) y LobbyFeed
+ * (salas disponibles), que solo deciden qué rutas vigilar.
+ */
+
+#ifndef ROOMWATCHER_H
+#define ROOMWATCHER_H
+
+#include <QObject>
+#include <QJsonArray>
+#include <QByteArray>
+#include <QList>
+#include <QPointer>
+#include <QString>
+#include <QStringList>
+#include <QNetworkReply>
+
+class QNetworkAccessManager;
+class QWebSocket;
+class QTimer;
+
+/**
+ * @class RoomWatcher
+ * @brief Avisos por WebSocket con sondeo adaptativo de respaldo.
+ *
+ * Se suscribe al WebSocket de salas y, ante cada aviso, consulta todas las
+ * rutas en una ronda. Si el canal no está disponible recurre a un sondeo cuyo
+ * intervalo se duplica mientras nada cambia y vuelve al mínimo al detectar un
+ * cambio. Las consultas son condicionales (ETag), así que las respuestas sin
+ * cambios no viajan de nuevo.
+ *
+ * Un aviso que llega con una ronda en curso no se pierde: la ronda se repite
+ * al terminar, porque sus respuestas pueden ser anteriores al aviso.
+ */
+class RoomWatcher : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor.
+     * @param token Token de autenticación del usuario.
+     * @param paths Rutas (con consulta) de las listas a vigilar.
+     * @param tag Prefijo de los mensajes de log (p. ej. "[REJOIN]").
+     * @param minPollMs Intervalo de sondeo mínimo.
+     * @param maxPollMs Intervalo de sondeo máximo.
+     * @param parent Objeto padre.
+     */
+    RoomWatcher(const QString &token, const QStringList &paths, const QString &tag,
+                int minPollMs, int maxPollMs, QObject *parent = nullptr);
+
+    /** @brief Abre el canal de avisos y hace la primera consulta. */
+    void start();
+
+    /** @brief Cierra el canal, detiene el sondeo y cancela las consultas en curso. */
+    void stop();
+
+    /** @brief Consulta ya; con una ronda en curso, la repite al terminar. */
+    void refresh();
+
+    /**
+     * @brief Cambia la ruta de una lista; su contenido y su ETag dejan de valer.
+     * @param index Posición de la lista (la de la ruta en el constructor).
+     * @param path Nueva ruta.
+     */
+    void setPath(int index, const QString &path);
+
+    /** @brief Última lista recibida en la posición dada. */
+    QJsonArray salas(int index) const { return endpoints.value(index).salas; }
+
+signals:
+    /** @brief Alguna lista ha cambiado (o se ha recibido por primera vez). */
+    void changed();
+
+private:
+    /**
+     * @struct Endpoint
+     * @brief Estado de cada una de las listas.
+     */
+    struct Endpoint {
+        QString path;                   ///< Ruta en el servidor.
+        QByteArray etag;                ///< Validador de la última respuesta.
+        QJsonArray salas;               ///< Última lista recibida.
+        bool delivered = false;         ///< Ya se ha avisado de esta ruta.
+        QPointer<QNetworkReply> reply;  ///< Consulta en curso, si la hay.
+    };
+
+    void connectPush();
+    void onPushDisconnected();
+    void fetch(int index);
+    void onFetchDone(bool changed);
+    void scheduleNextPoll();
+
+    QString token;                  ///< Token de autenticación.
+    QString tag;                    ///< Prefijo del log.
+    int minPollMs;                  ///< Intervalo de sondeo mínimo.
+    int maxPollMs;                  ///< Intervalo de sondeo máximo.
+    QNetworkAccessManager *manager; ///< Gestor HTTP reutilizado.
+    QWebSocket *socket;             ///< Canal de avisos del servidor.
+    QTimer *pollTimer;              ///< Sondeo de respaldo.
+    QTimer *reconnectTimer;         ///< Reintento del canal de avisos.
+
+    QList<Endpoint> endpoints;      ///< Listas vigiladas.
+    bool running = false;           ///< Entre start() y stop().
+    bool pushActive = false;        ///< true mientras el WebSocket está conectado.
+    int pollInterval;               ///< Intervalo de sondeo actual.
+    int reconnectDelay = 5000;      ///< Espera antes de reintentar el WebSocket.
+    int pending = 0;                ///< Consultas en curso de la ronda actual.
+    bool roundChanged = false;      ///< Alguna lista cambió en la ronda actual.
+    bool refreshAgain = false;      ///< Repetir la ronda al terminar la actual.
+};
+
+#endif // ROOMWATCHER_H
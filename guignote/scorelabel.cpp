@@ -0,0 +1,88 @@
+/**
+ * @file scorelabel.cpp
+ * @brief Implementación de la clase ScoreLabel.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ */
+
+#include "scorelabel.h"
+#include <QVariantAnimation>
+#include <QEasingCurve>
+#include <cstdlib>
+
+/**
+ * @brief Constructor de ScoreLabel.
+ * @param parent Widget padre.
+ */
+ScoreLabel::ScoreLabel(QWidget *parent)
+    : QLabel(parent),
+      animation(new QVariantAnimation(this))
+{
+    animation->setEasingCurve(QEasingCurve::OutCubic);
+    connect(animation, &QVariantAnimation::valueChanged, this, [this](const QVariant &value) {
+        showValue(value.toInt());
+    });
+    setText(QString::number(m_displayed));
+}
+
+/**
+ * @brief Indica si el recuento sigue en marcha.
+ */
+bool ScoreLabel::isAnimating() const {
+    return animation->state() == QAbstractAnimation::Running;
+}
+
+/**
+ * @brief Fija la puntuación al instante (salvo que ya se esté animando hacia ella).
+ */
+void ScoreLabel::setScore(int value) {
+    if (isAnimating() && value == m_score)
+        return;
+    animation->stop();
+    m_score = value;
+    showValue(value);
+}
+
+/**
+ * @brief Fija la puntuación y anima el número mostrado en paralelo.
+ *
+ * La duración crece con la diferencia hasta el tope: una baza de 30 puntos
+ * no tarda más que una de 5 en terminar de contarse.
+ */
+void ScoreLabel::animateTo(int value) {
+    m_score = value;
+    int delta = std::abs(value - m_displayed);
+    int duration = qMin(m_maxDuration, delta * kMsPerPoint);
+
+    animation->stop();
+    if (duration <= 0) {
+        showValue(value);
+        return;
+    }
+    animation->setStartValue(m_displayed);
+    animation->setEndValue(value);
+    animation->setDuration(duration);
+    animation->start();
+}
+
+/**
+ * @brief Cambia el tope de duración de las animaciones siguientes.
+ */
+void ScoreLabel::setMaxDuration(int ms) {
+    m_maxDuration = qMax(0, ms);
+}
+
+/**
+ * @brief Muestra un número manteniendo el centro de la etiqueta.
+ */
+void ScoreLabel::showValue(int value) {
+    if (value == m_displayed && text() == QString::number(value))
+        return;
+    m_displayed = value;
+
+    const QPoint center = geometry().center();
+    setText(QString::number(value));
+    adjustSize();
+    move(center.x() - width() / 2, center.y() - height() / 2);
+}
@@ -0,0 +1,81 @@
+/**
+ * @file scorelabel.h
+ * @brief Declaración de la clase ScoreLabel para mostrar puntuaciones animadas.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * La clase ScoreLabel extiende QLabel: el valor de la puntuación cambia al
+ * instante y el número mostrado lo alcanza con una animación de duración acotada.
+ */
+
+#ifndef SCORELABEL_H
+#define SCORELABEL_H
+
+#include <QLabel>
+
+class QVariantAnimation;
+
+/**
+ * @class ScoreLabel
+ * @brief Etiqueta de puntuación con recuento animado.
+ *
+ * animateTo() fija el valor real y anima el número mostrado hasta él en
+ * kMsPerPoint por punto, sin pasar nunca de maxDuration(). La animación no
+ * bloquea a quien la lanza. Al cambiar el texto la etiqueta conserva su centro.
+ */
+class ScoreLabel : public QLabel {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor de ScoreLabel.
+     * @param parent Widget padre. Opcional.
+     */
+    explicit ScoreLabel(QWidget *parent = nullptr);
+
+    /** @brief Valor real de la puntuación (el destino si hay animación). */
+    int score() const { return m_score; }
+
+    /** @brief Valor mostrado ahora mismo. */
+    int displayed() const { return m_displayed; }
+
+    /** @brief true mientras el número mostrado no ha alcanzado score(). */
+    bool isAnimating() const;
+
+    /**
+     * @brief Fija la puntuación sin animar.
+     * @param value Puntuación.
+     *
+     * Si ya se está animando hacia ese mismo valor, la animación sigue.
+     */
+    void setScore(int value);
+
+    /**
+     * @brief Fija la puntuación y anima el número mostrado hasta ella.
+     * @param value Puntuación.
+     */
+    void animateTo(int value);
+
+    /**
+     * @brief Duración máxima de la animación.
+     * @param ms Milisegundos (0 = sin animación).
+     */
+    void setMaxDuration(int ms);
+    int maxDuration() const { return m_maxDuration; }
+
+    /** @brief Duración máxima por defecto (ms). */
+    static constexpr int kDefaultMaxDurationMs = 600;
+    /** @brief Tiempo (ms) por punto en diferencias pequeñas. */
+    static constexpr int kMsPerPoint = 60;
+
+private:
+    void showValue(int value);
+
+    int m_score = 0;                          ///< Puntuación real.
+    int m_displayed = 0;                      ///< Número mostrado.
+    int m_maxDuration = kDefaultMaxDurationMs; ///< Tope de la animación (ms).
+    QVariantAnimation *animation;             ///< Recuento en curso.
+};
+
+#endif // SCORELABEL_H
@@ -0,0 +1,72 @@
+/**
+ * @file searchprefixcache.cpp
+ * @brief Implementación de la clase SearchPrefixCache.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ */
+
+#include "searchprefixcache.h"
+#include "userlistmodel.h"
+
+/**
+ * @brief Constructor de SearchPrefixCache.
+ */
+SearchPrefixCache::SearchPrefixCache(int ttlSeconds, int maxEntries)
+    : ttlSeconds(ttlSeconds),
+      maxEntries(maxEntries)
+{
+}
+
+/**
+ * @brief La búsqueda no distingue mayúsculas ni espacios en los extremos.
+ */
+QString SearchPrefixCache::normalize(const QString &query) {
+    return query.trimmed().toLower();
+}
+
+/**
+ * @brief Guarda una respuesta; si se supera el tamaño se descarta la más antigua.
+ */
+void SearchPrefixCache::insert(const QString &query, const QList<QJsonObject> &results) {
+    const QString key = normalize(query);
+    order.removeAll(key);
+    order.append(key);
+    entries.insert(key, {results, QDateTime::currentDateTimeUtc()});
+
+    while (order.size() > maxEntries)
+        entries.remove(order.takeFirst());
+}
+
+/**
+ * @brief Resuelve la consulta con la respuesta exacta o con la del prefijo más largo.
+ */
+bool SearchPrefixCache::lookup(const QString &query, QList<QJsonObject> *results) const {
+    const QString key = normalize(query);
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+
+    for (int len = key.size(); len >= 0; --len) {
+        auto it = entries.constFind(key.left(len));
+        if (it == entries.constEnd() || it->storedAt.secsTo(now) > ttlSeconds)
+            continue;
+
+        if (len == key.size()) {
+            *results = it->results;
+        } else {
+            results->clear();
+            for (const QJsonObject &usuario : it->results)
+                if (UserListModel::displayName(usuario).toLower().contains(key))
+                    results->append(usuario);
+        }
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Vacía la caché.
+ */
+void SearchPrefixCache::clear() {
+    entries.clear();
+    order.clear();
+}
@@ -0,0 +1,74 @@
+/**
+ * @file searchprefixcache.h
+ * @brief Declaración de la clase SearchPrefixCache, caché de resultados de búsqueda por prefijo.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * SearchPrefixCache recuerda las últimas respuestas de /usuarios/buscar_usuarios/
+ * y resuelve en local las búsquedas que refinan una anterior ("ana" → "anab").
+ */
+
+#ifndef SEARCHPREFIXCACHE_H
+#define SEARCHPREFIXCACHE_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QStringList>
+
+/**
+ * @class SearchPrefixCache
+ * @brief Resultados de búsqueda indexados por consulta, con caducidad.
+ *
+ * Cualquier usuario cuyo nombre contenga "anab" contiene también "ana", así que
+ * los resultados de una consulta sirven para todas las que empiezan por ella:
+ * basta con filtrarlos por nombre.
+ */
+class SearchPrefixCache {
+public:
+    /**
+     * @brief Constructor.
+     * @param ttlSeconds Segundos que una respuesta se considera válida.
+     * @param maxEntries Número máximo de consultas recordadas.
+     */
+    explicit SearchPrefixCache(int ttlSeconds = 60, int maxEntries = 32);
+
+    /**
+     * @brief Guarda la respuesta del servidor para una consulta.
+     * @param query Texto buscado.
+     * @param results Usuarios devueltos.
+     */
+    void insert(const QString &query, const QList<QJsonObject> &results);
+
+    /**
+     * @brief Busca la consulta exacta o la más larga que sea prefijo de ella.
+     * @param query Texto buscado.
+     * @param results Resultados (filtrados si vienen de un prefijo).
+     * @return true si se ha podido resolver sin el servidor.
+     */
+    bool lookup(const QString &query, QList<QJsonObject> *results) const;
+
+    /** @brief Olvida todas las consultas (p. ej. tras enviar una solicitud). */
+    void clear();
+
+private:
+    /**
+     * @struct Entry
+     * @brief Respuesta guardada.
+     */
+    struct Entry {
+        QList<QJsonObject> results;  ///< Usuarios devueltos.
+        QDateTime storedAt;          ///< Momento de la respuesta.
+    };
+
+    static QString normalize(const QString &query);
+
+    int ttlSeconds;                  ///< Caducidad de cada respuesta.
+    int maxEntries;                  ///< Tamaño máximo.
+    QHash<QString, Entry> entries;   ///< Consulta normalizada → respuesta.
+    QStringList order;               ///< Consultas de la más antigua a la más reciente.
+};
+
+#endif // SEARCHPREFIXCACHE_H
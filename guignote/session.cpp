@@ -0,0 +1,196 @@
+/**
+ * @file session.cpp
+ * @brief Implementación de la clase Session.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ */
+
+#include "session.h"
+#include <QHash>
+#include <QJsonDocument>
+#include <QSettings>
+#include <QStringList>
+#include <QTimer>
+#include <QTimeZone>
+#include <QDebug>
+#include <limits>
+
+/**
+ * @brief Sesiones creadas, por clave de usuario; viven hasta el final del proceso.
+ */
+static QHash<QString, Session *> &sessions() {
+    static QHash<QString, Session *> registry;
+    return registry;
+}
+
+/**
+ * @brief Sesión de un usuario.
+ */
+Session &Session::forUser(const QString &userKey) {
+    Session *&session = sessions()[userKey];
+    if (!session) {
+        session = new Session(userKey);
+        session->load();
+    }
+    return *session;
+}
+
+/**
+ * @brief Constructor de Session.
+ */
+Session::Session(const QString &userKey, QObject *parent)
+    : QObject(parent),
+      userKey(userKey),
+      expiryTimer(new QTimer(this))
+{
+    io.setMaxThreadCount(1);
+    expiryTimer->setSingleShot(true);
+    connect(expiryTimer, &QTimer::timeout, this, [this]() {
+        // Caducidades muy lejanas se alcanzan en varios tramos
+        if (!isExpired()) {
+            scheduleExpiry();
+            return;
+        }
+        qDebug() << "[SESSION] El token de" << this->userKey << "ha caducado.";
+        emit expired();
+    });
+}
+
+/**
+ * @brief Destructor: deja terminar las escrituras pendientes.
+ */
+Session::~Session() {
+    io.waitForDone();
+}
+
+/**
+ * @brief Payload del JWT (Base64URL → JSON): "user_id"/"id" y "exp".
+ */
+Session::Claims Session::decode(const QString &token) {
+    Claims claims;
+    const QStringList parts = token.split('.');
+    if (parts.size() < 2)
+        return claims;
+
+    QJsonDocument doc = QJsonDocument::fromJson(
+        QByteArray::fromBase64(parts.at(1).toUtf8(),
+                               QByteArray::Base64UrlEncoding | QByteArray::OmitTrailingEquals));
+    if (!doc.isObject())
+        return claims;
+
+    QJsonObject obj = doc.object();
+    if (obj.contains("user_id"))
+        claims.userId = QString::number(obj.value("user_id").toInt());
+    else if (obj.contains("id"))
+        claims.userId = QString::number(obj.value("id").toInt());
+    if (obj.contains("exp"))
+        claims.expiresAt = QDateTime::fromSecsSinceEpoch(qint64(obj.value("exp").toDouble()), QTimeZone::UTC);
+    return claims;
+}
+
+/**
+ * @brief Lectura inicial de lo guardado por una sesión anterior.
+ */
+void Session::load() {
+    QSettings settings("Grace Hopper", QString("Sota, Caballo y Rey_%1").arg(userKey));
+    m_token = settings.value("auth/token").toString();
+    m_claims = decode(m_token);
+    m_profile = QJsonDocument::fromJson(settings.value("session/profile").toByteArray()).object();
+    scheduleExpiry();
+}
+
+/**
+ * @brief Sin token, o con caducidad dentro del margen.
+ */
+bool Session::isExpired() const {
+    if (m_token.isEmpty())
+        return true;
+    if (!m_claims.expiresAt.isValid())
+        return false;
+    return QDateTime::currentDateTimeUtc().secsTo(m_claims.expiresAt) < kExpiryMarginSecs;
+}
+
+/**
+ * @brief Token nuevo tras iniciar sesión.
+ */
+void Session::setToken(const QString &token) {
+    if (token == m_token) return;
+    m_token = token;
+    m_claims = decode(token);
+    scheduleExpiry();
+    persist();
+}
+
+/**
+ * @brief Perfil nuevo (p. ej. al recibir las estadísticas en el arranque).
+ */
+void Session::setProfile(const QJsonObject &profile) {
+    if (profile == m_profile) return;
+    m_profile = profile;
+    persist();
+    emit profileChanged(m_profile);
+}
+
+/**
+ * @brief Cierre de sesión.
+ */
+void Session::clear() {
+    m_token.clear();
+    m_claims = Claims();
+    m_profile = QJsonObject();
+    expiryTimer->stop();
+    persist();
+}
+
+/**
+ * @brief Bloquea hasta que se hayan escrito los cambios (p. ej. antes de salir).
+ */
+void Session::flush() {
+    io.waitForDone();
+}
+
+/**
+ * @brief Espera a las escrituras de todas las sesiones.
+ */
+void Session::flushAll() {
+    for (Session *session : std::as_const(sessions()))
+        session->flush();
+}
+
+/**
+ * @brief Escritura diferida en QSettings; se copia el estado para no compartirlo con el hilo.
+ */
+void Session::persist() {
+    const QString key = userKey;
+    const QString token = m_token;
+    const QByteArray profile = m_profile.isEmpty()
+        ? QByteArray() : QJsonDocument(m_profile).toJson(QJsonDocument::Compact);
+
+    io.start([key, token, profile]() {
+        QSettings settings("Grace Hopper", QString("Sota, Caballo y Rey_%1").arg(key));
+        if (token.isEmpty())
+            settings.remove("auth/token");
+        else
+            settings.setValue("auth/token", token);
+        if (profile.isEmpty())
+            settings.remove("session/profile");
+        else
+            settings.setValue("session/profile", profile);
+        settings.sync();
+    });
+}
+
+/**
+ * @brief Programa expired() para kExpiryMarginSecs antes de la caducidad.
+ */
+void Session::scheduleExpiry() {
+    expiryTimer->stop();
+    if (m_token.isEmpty() || !m_claims.expiresAt.isValid())
+        return;
+
+    qint64 ms = QDateTime::currentDateTimeUtc().msecsTo(m_claims.expiresAt) - kExpiryMarginSecs * 1000;
+    // QTimer admite como mucho ~24 días; el temporizador se reprograma al vencer
+    ms = qBound<qint64>(0, ms, std::numeric_limits<int>::max());
+    expiryTimer->start(int(ms));
+}
@@ -0,0 +1,129 @@
+/**
+ * @file session.h
+ * @brief Declaración de la clase Session, sesión del usuario en memoria.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * Session guarda el token, los datos que lleva dentro (id de usuario y
+ * caducidad) y el perfil del usuario, de modo que las ventanas no tengan que
+ * leer el fichero de configuración ni decodificar el JWT cada vez que se abren.
+ */
+
+#ifndef SESSION_H
+#define SESSION_H
+
+#include <QObject>
+#include <QDateTime>
+#include <QJsonObject>
+#include <QThreadPool>
+
+class QTimer;
+
+/**
+ * @class Session
+ * @brief Sesión de un usuario, compartida por todas las ventanas.
+ *
+ * Hay una instancia por clave de usuario (forUser()). La primera vez se lee el
+ * token guardado en QSettings; después todo se sirve desde memoria. Los cambios
+ * (setToken(), setProfile(), clear()) se escriben en disco en segundo plano.
+ * Un temporizador emite expired() al acercarse la caducidad del token, antes
+ * de que el servidor empiece a responder 401.
+ */
+class Session : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @struct Claims
+     * @brief Campos del JWT que usa el cliente.
+     */
+    struct Claims {
+        QString userId;      ///< Id numérico del usuario ("user_id" o "id").
+        QDateTime expiresAt; ///< Caducidad ("exp"); inválida si el token no la lleva.
+    };
+
+    /**
+     * @brief Sesión de un usuario (se crea y carga la primera vez).
+     * @param userKey Clave del usuario (nombre o correo).
+     */
+    static Session &forUser(const QString &userKey);
+
+    /**
+     * @brief Decodifica el payload de un JWT sin verificar la firma.
+     * @param token Token JWT.
+     * @return Campos extraídos (vacíos si el token no es válido).
+     */
+    static Claims decode(const QString &token);
+
+    /** @brief Token de autenticación (vacío si no hay sesión). */
+    QString token() const { return m_token; }
+
+    /** @brief Id numérico del usuario, extraído del token. */
+    QString userId() const { return m_claims.userId; }
+
+    /** @brief Caducidad del token. */
+    QDateTime expiresAt() const { return m_claims.expiresAt; }
+
+    /** @brief true si el token falta o caduca en menos de kExpiryMarginSecs. */
+    bool isExpired() const;
+
+    /**
+     * @brief Perfil del usuario (estadísticas de /usuarios/estadisticas/).
+     *
+     * Lo deja la pantalla de carga y lo refresca MyProfileWindow; el menú y el
+     * perfil lo pintan al abrirse sin esperar a la red (vacío si aún no hay).
+     */
+    QJsonObject profile() const { return m_profile; }
+
+    /**
+     * @brief Guarda un token nuevo (login) y programa el aviso de caducidad.
+     * @param token Token JWT.
+     */
+    void setToken(const QString &token);
+
+    /**
+     * @brief Guarda el perfil del usuario y, si ha cambiado, emite profileChanged().
+     * @param profile Objeto JSON del perfil.
+     */
+    void setProfile(const QJsonObject &profile);
+
+    /** @brief Cierra la sesión: olvida token y perfil y los borra del disco. */
+    void clear();
+
+    /** @brief Espera a que terminen las escrituras pendientes. */
+    void flush();
+
+    /** @brief flush() de todas las sesiones (al salir de la aplicación). */
+    static void flushAll();
+
+    /** @brief Margen (s) con el que se considera caducado el token. */
+    static constexpr int kExpiryMarginSecs = 60;
+
+signals:
+    /** @brief El token ha caducado (o está a punto): hay que volver a iniciar sesión. */
+    void expired();
+
+    /**
+     * @brief El perfil del usuario ha cambiado.
+     * @param profile Perfil nuevo.
+     */
+    void profileChanged(const QJsonObject &profile);
+
+private:
+    explicit Session(const QString &userKey, QObject *parent = nullptr);
+    ~Session() override;
+
+    void load();
+    void persist();
+    void scheduleExpiry();
+
+    QString userKey;          ///< Clave del usuario.
+    QString m_token;          ///< Token actual.
+    Claims m_claims;          ///< Campos del token actual.
+    QJsonObject m_profile;    ///< Perfil del usuario.
+    QTimer *expiryTimer;      ///< Dispara expired().
+    QThreadPool io;           ///< Hilo único de escritura en disco.
+};
+
+#endif // SESSION_H
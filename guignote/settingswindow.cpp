@@ -16,6 +16,7 @@
 #include <QStackedWidget>
 #include <QVBoxLayout>
 #include "menuwindow.h"
+#include "audioengine.h"
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QGroupBox>
@@ -135,18 +136,12 @@ SettingsWindow::SettingsWindow(QWidget *mainWindow, QWidget *parent, QString usr
     // Conectar el botón de cerrar
     connect(closeButton, &QPushButton::clicked, this, &SettingsWindow::close);
 
-    // Conectar con MenuWindow si es posible
-    MenuWindow *menuWin = qobject_cast<MenuWindow*>(mainWindowRef);
-    if (menuWin) {
-        connect(audioSlider, &QSlider::valueChanged,
-                menuWin,       &MenuWindow::setVolume);
-        if (menuWin->audioOutput) {
-            int initialVol = static_cast<int>(menuWin->audioOutput->volume() * 100);
-            audioSlider->setValue(initialVol);
-        }
-    } else {
-        qWarning() << "mainWindowRef no es un MenuWindow. No se conectará el slider de volumen.";
-    }
+    // Los sliders ajustan al momento la salida compartida de música y efectos
+    AudioEngine &audio = AudioEngine::instance();
+    audioSlider->setValue(audio.musicVolume());
+    soundSlider->setValue(audio.effectsVolume());
+    connect(audioSlider, &QSlider::valueChanged, &audio, &AudioEngine::setMusicVolume);
+    connect(soundSlider, &QSlider::valueChanged, &audio, &AudioEngine::setEffectsVolume);
 
     loadSettings();
 }
@@ -0,0 +1,284 @@
+/**
+ * @file startuporchestrator.cpp
+ * @brief Implementación de la clase StartupOrchestrator.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * Contiene el login asíncrono, la precarga de datos del usuario a través de
+ * HttpCache y la decodificación de cartas y ornamentos en hilos de trabajo.
+ */
+
+#include "startuporchestrator.h"
+#include "playerprofiles.h"
+#include "session.h"
+#include "httpcache.h"
+#include "carta.h"
+#include "backdropservice.h"
+#include "imageloader.h"
+#include "cardatlas.h"
+#include "menuwindow.h"
+#include "rankswindow.h"
+#include "inventorywindow.h"
+#include <QNetworkAccessManager>
+#include <QNetworkRequest>
+#include <QNetworkReply>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QSettings>
+#include <QPixmapCache>
+#include <QGuiApplication>
+#include <QScreen>
+#include <QDebug>
+#include <memory>
+
+namespace {
+/// Tiempo máximo por petición de arranque; pasado este plazo la etapa se da por terminada.
+constexpr int kRequestTimeoutMs = 5000;
+}
+
+/**
+ * @brief Constructor de StartupOrchestrator.
+ * @param userKey Clave del usuario.
+ * @param parent Objeto padre.
+ */
+StartupOrchestrator::StartupOrchestrator(const QString &userKey, QObject *parent)
+    : QObject(parent),
+      userKey(userKey),
+      manager(new QNetworkAccessManager(this))
+{
+    clock.start();
+    // La baraja en vertical y en horizontal, el menú, los rangos y las casillas
+    // del inventario quedan residentes a la vez: no caben en los 10 MB por defecto
+    if (QPixmapCache::cacheLimit() < 48 * 1024)
+        QPixmapCache::setCacheLimit(48 * 1024);
+}
+
+/**
+ * @brief Arranca el login y, en paralelo, la decodificación de recursos.
+ */
+void StartupOrchestrator::startWithLogin(const QString &user, const QString &pass) {
+    decodeAssets();
+    login(user, pass);
+}
+
+/**
+ * @brief Arranca con token ya disponible: todas las etapas a la vez.
+ */
+void StartupOrchestrator::startWithToken(const QString &token) {
+    this->token = token;
+    loggedIn = true;
+    decodeAssets();
+    runTokenStages();
+}
+
+/**
+ * @brief Marca una etapa como iniciada.
+ */
+void StartupOrchestrator::beginStage(const QString &stage) {
+    running.append(stage);
+}
+
+/**
+ * @brief Marca una etapa como terminada y, si era la última, emite finished().
+ */
+void StartupOrchestrator::endStage(const QString &stage) {
+    if (!running.removeOne(stage)) return;
+
+    qint64 ms = clock.elapsed();
+    done.insert(stage, ms);
+    qDebug().noquote() << QString("[STARTUP] %1 lista en %2 ms").arg(stage).arg(ms);
+    emit stageFinished(stage, ms);
+
+    if (running.isEmpty() && loggedIn && !finishedEmitted) {
+        finishedEmitted = true;
+        emit finished();
+    }
+}
+
+/**
+ * @brief Registra el primer fotograma interactivo y resume todas las etapas.
+ */
+void StartupOrchestrator::markInteractive() {
+    qint64 ms = clock.elapsed();
+    done.insert("interactivo", ms);
+    QStringList parts;
+    for (auto it = done.constBegin(); it != done.constEnd(); ++it)
+        parts << QString("%1=%2ms").arg(it.key()).arg(it.value());
+    qDebug().noquote() << "[STARTUP] Menú interactivo:" << parts.join(' ');
+}
+
+/**
+ * @brief Login asíncrono con las credenciales guardadas.
+ */
+void StartupOrchestrator::login(const QString &user, const QString &pass) {
+    beginStage("login");
+
+    QNetworkRequest request(QUrl("http://188.165.76.134:8000/usuarios/iniciar_sesion/"));
+    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    request.setTransferTimeout(kRequestTimeoutMs);
+
+    QJsonObject json;
+    if (user.contains('@'))
+        json["correo"] = user;
+    else
+        json["nombre"] = user;
+    json["contrasegna"] = pass;
+
+    QNetworkReply *reply = manager->post(request, QJsonDocument(json).toJson());
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+        reply->deleteLater();
+        QJsonObject respObj = QJsonDocument::fromJson(reply->readAll()).object();
+        if (reply->error() != QNetworkReply::NoError || !respObj.contains("token")) {
+            qDebug() << "[STARTUP] Login automático fallido:" << reply->errorString();
+            running.removeOne("login");
+            emit loginFailed();
+            return;
+        }
+
+        token = respObj["token"].toString();
+        Session::forUser(userKey).setToken(token);
+
+        loggedIn = true;
+        runTokenStages();
+        endStage("login");
+    });
+}
+
+/**
+ * @brief Lanza las etapas que necesitan token.
+ */
+void StartupOrchestrator::runTokenStages() {
+    fetchStats();
+    fetchFriendRequests();
+}
+
+/**
+ * @brief Estadísticas del usuario (las que pinta el menú); da el nombre para la etapa de equipados.
+ */
+void StartupOrchestrator::fetchStats() {
+    beginStage("estadisticas");
+    beginStage("equipados");
+
+    QNetworkRequest request(QUrl("http://188.165.76.134:8000/usuarios/estadisticas/"));
+    request.setRawHeader("Auth", token.toUtf8());
+    request.setTransferTimeout(kRequestTimeoutMs);
+    HttpCache::instance().get(request, this, [this](const QByteArray &data, bool) {
+        if (!running.contains("estadisticas")) return;
+        QJsonObject perfil = QJsonDocument::fromJson(data).object();
+        Session::forUser(userKey).setProfile(perfil);
+        QString nombre = perfil.value("nombre").toString();
+        endStage("estadisticas");
+        fetchEquipped(nombre);
+    }, [this](int, const QString &) {
+        endStage("estadisticas");
+        endStage("equipados");
+    });
+}
+
+/**
+ * @brief Id numérico y objetos equipados del usuario.
+ */
+void StartupOrchestrator::fetchEquipped(const QString &nombre) {
+    if (nombre.isEmpty()) {
+        endStage("equipados");
+        return;
+    }
+
+    // Queda en PlayerProfiles, que es donde lo buscan el inventario y la partida
+    PlayerProfiles::instance().lookup(nombre, this, [this](const PlayerProfiles::Profile &) {
+        endStage("equipados");
+    });
+}
+
+/**
+ * @brief Número de solicitudes de amistad pendientes (insignia del menú).
+ */
+void StartupOrchestrator::fetchFriendRequests() {
+    beginStage("solicitudes");
+
+    QNetworkRequest request(QUrl("http://188.165.76.134:8000/usuarios/listar_solicitudes_amistad/"));
+    request.setRawHeader("Auth", token.toUtf8());
+    request.setTransferTimeout(kRequestTimeoutMs);
+    HttpCache::instance().get(request, this, [this](const QByteArray &, bool) {
+        endStage("solicitudes");
+    }, [this](int, const QString &) {
+        endStage("solicitudes");
+    });
+}
+
+/**
+ * @brief Decodifica en hilos de trabajo todo lo que se pinta tras el login.
+ *
+ * Cada grupo (cartas de la baraja equipada, menú, rangos e inventario) se pide
+ * a ImageLoader con el tamaño y la variante exactos con que lo piden sus
+ * ventanas, así que las encuentran ya escaladas en QPixmapCache. ImageLoader
+ * reparte las peticiones entre sus hilos; aquí solo se mide cada grupo. Las
+ * cartas salen de CardAtlas cuando el archivo del arranque anterior sigue
+ * valiendo para esta pantalla.
+ */
+void StartupOrchestrator::decodeAssets() {
+    beginStage("recursos");
+
+    QSettings userSettings("Grace Hopper", QString("Sota, Caballo y Rey_%1").arg(userKey));
+    QScreen *screen = QGuiApplication::primaryScreen();
+    const QSize screenSize = screen ? screen->size() : QSize(1920, 1080);
+    const qreal dpr = screen ? screen->devicePixelRatio() : 1.0;
+
+    // Fondos del menú (tapete verde) y del tapete equipado, en sus propios hilos
+    if (screen) {
+        BackdropService::instance().prerender(1, screenSize, dpr);
+        int mat = userSettings.value("selectedMat", 1).toInt();
+        if (mat > 1)
+            BackdropService::instance().prerender(mat, screenSize, dpr);
+    }
+
+    // selectedDeck guarda el id del servidor (1 = base); Carta usa 0..2
+    int skin = qBound(0, userSettings.value("selectedDeck", 1).toInt() - 1, 2);
+
+    // Si la baraja ya está en disco para esta pantalla, el grupo "cartas" se
+    // sirve entero desde QPixmapCache; si no, se guarda al terminar
+    const bool cartasEnDisco = CardAtlas::instance().restore(skin, dpr);
+
+    const QList<QPair<QString, QList<ImageLoader::Request>>> groups = {
+        {"cartas", Carta::imagenesPartida(skin)},
+        {"menu", MenuWindow::warmUpImages(screenSize)},
+        {"rangos", RanksWindow::warmUpImages()},
+        {"inventario", InventoryWindow::warmUpImages()}
+    };
+
+    // Contadores compartidos por los callbacks: se liberan con el último, aunque
+    // el orquestador se destruya antes y los callbacks no lleguen a ejecutarse
+    auto pendingGroups = std::make_shared<int>(groups.size());
+    auto groupDone = [this, pendingGroups, skin, dpr, cartasEnDisco](const QString &name, int total,
+                                                                      qint64 ms) {
+        qDebug().noquote() << QString("[STARTUP] recursos/%1: %2 imágenes en %3 ms")
+                                  .arg(name).arg(total).arg(ms);
+        if (name == "cartas" && total > 0 && !cartasEnDisco)
+            CardAtlas::instance().store(skin, dpr);
+        if (--*pendingGroups == 0)
+            endStage("recursos");
+    };
+
+    for (const auto &group : groups) {
+        const QString name = group.first;
+        const int total = group.second.size();
+        // Un grupo vacío no tiene callbacks que lo cierren
+        if (total == 0) {
+            groupDone(name, 0, 0);
+            continue;
+        }
+
+        auto pending = std::make_shared<int>(total);
+        QElapsedTimer timer;
+        timer.start();
+        for (const ImageLoader::Request &request : group.second) {
+            ImageLoader::instance().load(request, this,
+                                         [name, total, pending, timer, groupDone](const QPixmap &) {
+                if (--*pending == 0)
+                    groupDone(name, total, timer.elapsed());
+            });
+        }
+    }
+}
@@ -0,0 +1,102 @@
+/**
+ * @file startuporchestrator.h
+ * @brief Declaración de la clase StartupOrchestrator.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * La clase StartupOrchestrator coordina el trabajo de arranque (login automático,
+ * estadísticas, objetos equipados, solicitudes de amistad y decodificación de
+ * recursos) mientras se muestra la pantalla de carga.
+ */
+
+#ifndef STARTUPORCHESTRATOR_H
+#define STARTUPORCHESTRATOR_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QMap>
+
+class QNetworkAccessManager;
+
+/**
+ * @class StartupOrchestrator
+ * @brief Lanza en paralelo las etapas de arranque y avisa cuando todas han terminado.
+ *
+ * Cada etapa registra el tiempo transcurrido desde el inicio del proceso. Las
+ * respuestas HTTP se guardan en HttpCache, de modo que las ventanas que las piden
+ * después (menú, inventario, amigos) las obtienen al instante. Las imágenes se
+ * decodifican y escalan en hilos de trabajo y se dejan en QPixmapCache.
+ */
+class StartupOrchestrator : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor.
+     * @param userKey Clave del usuario (nombre o correo).
+     * @param parent Objeto padre.
+     */
+    explicit StartupOrchestrator(const QString &userKey, QObject *parent = nullptr);
+
+    /**
+     * @brief Arranca con login automático a partir de credenciales guardadas.
+     * @param user Nombre de usuario o correo.
+     * @param pass Contraseña.
+     */
+    void startWithLogin(const QString &user, const QString &pass);
+
+    /**
+     * @brief Arranca con un token ya obtenido (login manual).
+     * @param token Token de autenticación.
+     */
+    void startWithToken(const QString &token);
+
+    /** @brief true cuando todas las etapas han terminado. */
+    bool isFinished() const { return finishedEmitted; }
+
+    /** @brief Milisegundos desde el arranque en que terminó cada etapa. */
+    QMap<QString, qint64> timings() const { return done; }
+
+    /**
+     * @brief Registra el primer fotograma interactivo (menú visible) y vuelca el resumen.
+     */
+    void markInteractive();
+
+signals:
+    /**
+     * @brief Una etapa ha terminado.
+     * @param stage Nombre de la etapa.
+     * @param elapsedMs Milisegundos desde el arranque.
+     */
+    void stageFinished(const QString &stage, qint64 elapsedMs);
+
+    /** @brief El login automático ha fallado; hay que mostrar el login manual. */
+    void loginFailed();
+
+    /** @brief Todas las etapas han terminado. */
+    void finished();
+
+private:
+    void login(const QString &user, const QString &pass);
+    void runTokenStages();
+    void fetchStats();
+    void fetchEquipped(const QString &nombre);
+    void fetchFriendRequests();
+    void decodeAssets();
+
+    void beginStage(const QString &stage);
+    void endStage(const QString &stage);
+
+    QString userKey;                  ///< Clave del usuario.
+    QString token;                    ///< Token de autenticación.
+    QNetworkAccessManager *manager;   ///< Gestor HTTP para el login.
+    QElapsedTimer clock;              ///< Reloj desde el arranque.
+    QStringList running;              ///< Etapas en curso.
+    QMap<QString, qint64> done;       ///< Etapas terminadas y su instante.
+    bool loggedIn = false;            ///< Login completado.
+    bool finishedEmitted = false;     ///< finished() ya emitida.
+};
+
+#endif // STARTUPORCHESTRATOR_H
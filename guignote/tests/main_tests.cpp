@@ -10,6 +10,32 @@
 #include "test_myprofilewindow.h"
 #include "test_inventorywindow.h"
 #include "test_friendswindow.h"
+#include "test_httpcache.h"
+#include "test_avatarservice.h"
+#include "test_rejoinmonitor.h"
+#include "test_startuporchestrator.h"
+#include "test_chathistoryloader.h"
+#include "test_chatstore.h"
+#include "test_chatmodel.h"
+#include "test_userlistmodel.h"
+#include "test_searchprefixcache.h"
+#include "test_roomcarddelegate.h"
+#include "test_rankingmodel.h"
+#include "test_session.h"
+#include "test_chatoutbox.h"
+#include "test_chathub.h"
+#include "test_audioengine.h"
+#include "test_scorelabel.h"
+#include "test_messagebanner.h"
+#include "test_playerprofiles.h"
+#include "test_backdropservice.h"
+#include "test_theme.h"
+#include "test_imageloader.h"
+#include "test_pixmapshadoweffect.h"
+#include "test_loadinganimation.h"
+#include "test_cardatlas.h"
+#include "test_roomwatcher.h"
+#include "test_estadopartida.h"
 
 
 int main(int argc, char *argv[])
@@ -46,5 +72,83 @@ int main(int argc, char *argv[])
     // Ejecutar tests de FriendsWindow
     QTest::qExec(new TestFriendsWindow,   argc, argv);
 
+    // Ejecutar tests de HttpCache
+    status |= QTest::qExec(new TestHttpCache,   argc, argv);
+
+    // Ejecutar tests de AvatarService
+    status |= QTest::qExec(new TestAvatarService,   argc, argv);
+
+    // Ejecutar tests de RejoinMonitor
+    status |= QTest::qExec(new TestRejoinMonitor,   argc, argv);
+
+    // Ejecutar tests de StartupOrchestrator
+    status |= QTest::qExec(new TestStartupOrchestrator,   argc, argv);
+
+    // Ejecutar tests de ChatHistoryLoader
+    status |= QTest::qExec(new TestChatHistoryLoader,   argc, argv);
+
+    // Ejecutar tests de ChatStore
+    status |= QTest::qExec(new TestChatStore,   argc, argv);
+
+    // Ejecutar tests de ChatModel y ChatBubbleDelegate
+    status |= QTest::qExec(new TestChatModel,   argc, argv);
+
+    // Ejecutar tests de UserListModel
+    status |= QTest::qExec(new TestUserListModel,   argc, argv);
+
+    // Ejecutar tests de SearchPrefixCache
+    status |= QTest::qExec(new TestSearchPrefixCache,   argc, argv);
+
+    // Ejecutar tests de RoomCardDelegate
+    status |= QTest::qExec(new TestRoomCardDelegate,   argc, argv);
+
+    // Ejecutar tests de RankingModel
+    status |= QTest::qExec(new TestRankingModel,   argc, argv);
+
+    // Ejecutar tests de Session
+    status |= QTest::qExec(new TestSession,   argc, argv);
+
+    // Ejecutar tests de ChatOutbox
+    status |= QTest::qExec(new TestChatOutbox,   argc, argv);
+
+    // Ejecutar tests de ChatHub
+    status |= QTest::qExec(new TestChatHub,   argc, argv);
+
+    // Ejecutar tests de AudioEngine
+    status |= QTest::qExec(new TestAudioEngine,   argc, argv);
+
+    // Ejecutar tests de ScoreLabel
+    status |= QTest::qExec(new TestScoreLabel,   argc, argv);
+
+    // Ejecutar tests de MessageBanner
+    status |= QTest::qExec(new TestMessageBanner,   argc, argv);
+
+    // Ejecutar tests de PlayerProfiles
+    status |= QTest::qExec(new TestPlayerProfiles,   argc, argv);
+
+    // Ejecutar tests de BackdropService
+    status |= QTest::qExec(new TestBackdropService,   argc, argv);
+
+    // Ejecutar tests (y benchmarks de creación de widgets) de Theme
+    status |= QTest::qExec(new TestTheme,   argc, argv);
+
+    // Ejecutar tests de ImageLoader
+    status |= QTest::qExec(new TestImageLoader,   argc, argv);
+
+    // Ejecutar tests de PixmapShadowEffect
+    status |= QTest::qExec(new TestPixmapShadowEffect,   argc, argv);
+
+    // Ejecutar tests de LoadingAnimation
+    status |= QTest::qExec(new TestLoadingAnimation,   argc, argv);
+
+    // Ejecutar tests de CardAtlas
+    status |= QTest::qExec(new TestCardAtlas,   argc, argv);
+
+    // Ejecutar tests de RoomWatcher
+    status |= QTest::qExec(new TestRoomWatcher,   argc, argv);
+
+    // Ejecutar tests de EstadoPartida
+    status |= QTest::qExec(new TestEstadoPartida,   argc, argv);
+
     return status;
 }
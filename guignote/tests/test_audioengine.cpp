@@ -0,0 +1,65 @@
+#include "test_audioengine.h"
+
+#include <QtTest/QtTest>
+#include "audioengine.h"
+#include <algorithm>
+
+// Efecto de prueba: `count` muestras de 16 bits con el mismo valor
+static QByteArray constantPcm(qint16 value, int count)
+{
+    QByteArray pcm(count * int(sizeof(qint16)), Qt::Uninitialized);
+    qint16 *samples = reinterpret_cast<qint16 *>(pcm.data());
+    for (int i = 0; i < count; ++i)
+        samples[i] = value;
+    return pcm;
+}
+
+static QList<qint16> readSamples(EffectMixer &mixer, int count)
+{
+    QByteArray out = mixer.read(count * qint64(sizeof(qint16)));
+    const qint16 *samples = reinterpret_cast<const qint16 *>(out.constData());
+    return QList<qint16>(samples, samples + out.size() / int(sizeof(qint16)));
+}
+
+void TestAudioEngine::test_mixer_outputs_silence_without_voices()
+{
+    EffectMixer mixer(4);
+    mixer.open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+
+    QList<qint16> out = readSamples(mixer, 8);
+    QCOMPARE(out.size(), 8);
+    QVERIFY(std::all_of(out.cbegin(), out.cend(), [](qint16 s) { return s == 0; }));
+}
+
+void TestAudioEngine::test_mixer_sums_overlapping_voices()
+{
+    EffectMixer mixer(4);
+    mixer.open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+
+    mixer.trigger(constantPcm(1000, 4));
+    mixer.trigger(constantPcm(1000, 8), 0.5);
+    QCOMPARE(mixer.activeVoices(), 2);
+
+    QList<qint16> out = readSamples(mixer, 6);
+    QCOMPARE(out.at(0), qint16(1500));   // las dos voces
+    QCOMPARE(out.at(4), qint16(500));    // la primera ya terminó
+    QCOMPARE(mixer.activeVoices(), 1);
+
+    readSamples(mixer, 6);
+    QCOMPARE(mixer.activeVoices(), 0);
+}
+
+void TestAudioEngine::test_mixer_saturates_and_steals_oldest_voice()
+{
+    EffectMixer mixer(2);
+    mixer.open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+
+    mixer.trigger(constantPcm(30000, 4));
+    mixer.trigger(constantPcm(30000, 4));
+    QCOMPARE(readSamples(mixer, 1).at(0), qint16(32767));
+
+    // Con las dos voces ocupadas, la tercera sustituye a la más antigua
+    mixer.trigger(constantPcm(-100, 4));
+    QCOMPARE(mixer.activeVoices(), 2);
+    QCOMPARE(readSamples(mixer, 1).at(0), qint16(29900));
+}
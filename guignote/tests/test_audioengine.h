@@ -0,0 +1,16 @@
+#ifndef TEST_AUDIOENGINE_H
+#define TEST_AUDIOENGINE_H
+
+#include <QObject>
+
+class TestAudioEngine : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_mixer_outputs_silence_without_voices();
+    void test_mixer_sums_overlapping_voices();
+    void test_mixer_saturates_and_steals_oldest_voice();
+};
+
+#endif // TEST_AUDIOENGINE_H
@@ -0,0 +1,113 @@
+#include "test_avatarservice.h"
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+
+// ------------------------------------------------------------------
+// Igual que en test_httpcache: acceso a los miembros privados
+// ------------------------------------------------------------------
+#define private public
+#include "avatarservice.h"
+#undef private
+// ------------------------------------------------------------------
+
+static const QString kUrl = "http://188.165.76.134:8000/media/avatar.png";
+
+void TestAvatarService::test_circular_image_masks_corners()
+{
+    QImage src(300, 150, QImage::Format_ARGB32);
+    src.fill(Qt::red);
+
+    QImage circ = AvatarService::circularImage(src, 100);
+    QCOMPARE(circ.size(), QSize(100, 100));
+    QVERIFY(qAlpha(circ.pixel(50, 50)) > 200);
+    QCOMPARE(qAlpha(circ.pixel(1, 1)), 0);
+    QCOMPARE(qAlpha(circ.pixel(98, 98)), 0);
+}
+
+void TestAvatarService::test_memory_hit_is_synchronous()
+{
+    QTemporaryDir dir;
+    AvatarService service(dir.path());
+    QPixmap avatar(64, 64);
+    avatar.fill(Qt::blue);
+    service.memory.insert(service.keyFor(kUrl, 64), new QPixmap(avatar), 16);
+
+    bool delivered = false;
+    service.request(kUrl, 64, nullptr, [&](const QPixmap &p) {
+        delivered = true;
+        QCOMPARE(p.size(), QSize(64, 64));
+    });
+    QVERIFY(delivered);
+    QVERIFY(service.pending.isEmpty());
+}
+
+void TestAvatarService::test_invalidate_drops_every_size()
+{
+    QTemporaryDir dir;
+    AvatarService service(dir.path());
+    service.memory.insert(service.keyFor(kUrl, 100), new QPixmap(100, 100), 40);
+    service.memory.insert(service.keyFor(kUrl, 200), new QPixmap(200, 200), 160);
+    service.memory.insert(service.keyFor("http://otra/url.png", 100), new QPixmap(100, 100), 40);
+
+    QFile file(service.pathFor(kUrl));
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("png");
+    file.close();
+
+    service.invalidate(kUrl);
+    QVERIFY(!service.memory.contains(service.keyFor(kUrl, 100)));
+    QVERIFY(!service.memory.contains(service.keyFor(kUrl, 200)));
+    QVERIFY(service.memory.contains(service.keyFor("http://otra/url.png", 100)));
+    QVERIFY(!QFile::exists(service.pathFor(kUrl)));
+}
+
+void TestAvatarService::test_sizes_share_one_load()
+{
+    QTemporaryDir dir;
+    AvatarService service(dir.path());
+    // Servidor inexistente: la revalidación falla y la copia de disco sigue valiendo
+    const QString url = "http://127.0.0.1:1/avatar.png";
+    QImage original(64, 64, QImage::Format_ARGB32);
+    original.fill(Qt::red);
+    QVERIFY(original.save(service.pathFor(url), "PNG"));
+
+    QList<QSize> recibidos;
+    auto handler = [&recibidos](const QPixmap &p) { recibidos.append(p.size()); };
+    service.request(url, 40, nullptr, handler);
+    service.request(url, 80, nullptr, handler);
+    QCOMPARE(service.pending.size(), 1);
+    QCOMPARE(service.pending.value(url).size(), 2);
+
+    QTRY_COMPARE(recibidos.size(), 2);
+    QVERIFY(recibidos.contains(QSize(40, 40)));
+    QVERIFY(recibidos.contains(QSize(80, 80)));
+    QVERIFY(service.pending.isEmpty());
+    QTRY_VERIFY(service.watchers.isEmpty());
+}
+
+void TestAvatarService::test_changed_avatar_is_delivered_again()
+{
+    QTemporaryDir dir;
+    AvatarService service(dir.path());
+    QPixmap vieja(40, 40);
+    vieja.fill(Qt::red);
+    service.memory.insert(service.keyFor(kUrl, 40), new QPixmap(vieja), 6);
+    service.watchers.insert(kUrl, {});   // revalidación en curso
+
+    QList<QRgb> colores;
+    service.request(kUrl, 40, nullptr, [&colores](const QPixmap &p) {
+        colores.append(p.toImage().pixel(20, 20));
+    });
+    QCOMPARE(colores.size(), 1);
+
+    // El servidor devuelve otra foto
+    QImage nueva(64, 64, QImage::Format_ARGB32);
+    nueva.fill(Qt::green);
+    service.refresh(kUrl, nueva, {});
+
+    QCOMPARE(colores.size(), 2);
+    QCOMPARE(qGreen(colores.last()), 255);
+    QCOMPARE(qGreen(service.cached(kUrl, 40).toImage().pixel(20, 20)), 255);
+    QVERIFY(service.watchers.isEmpty());
+}
@@ -0,0 +1,18 @@
+#ifndef TEST_AVATARSERVICE_H
+#define TEST_AVATARSERVICE_H
+
+#include <QObject>
+
+class TestAvatarService : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_circular_image_masks_corners();
+    void test_memory_hit_is_synchronous();
+    void test_invalidate_drops_every_size();
+    void test_sizes_share_one_load();
+    void test_changed_avatar_is_delivered_again();
+};
+
+#endif // TEST_AVATARSERVICE_H
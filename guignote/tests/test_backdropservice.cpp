@@ -0,0 +1,62 @@
+#include "test_backdropservice.h"
+
+#include <QtTest/QtTest>
+#include <QPixmapCache>
+#include "backdropservice.h"
+
+static bool cerca(QRgb a, const QColor &b, int tolerancia = 3)
+{
+    return qAbs(qRed(a) - b.red()) <= tolerancia
+        && qAbs(qGreen(a) - b.green()) <= tolerancia
+        && qAbs(qBlue(a) - b.blue()) <= tolerancia;
+}
+
+void TestBackdropService::test_unknown_tapete_renders_nothing()
+{
+    QVERIFY(BackdropService::render(0, QSize(100, 100)).isNull());
+    QVERIFY(BackdropService::render(1, QSize()).isNull());
+    QVERIFY(BackdropService::instance().pixmap(7, QSize(100, 100)).isNull());
+}
+
+void TestBackdropService::test_gradient_matches_stylesheet_colors()
+{
+    // Más grande que los cuatro ornamentos juntos: el centro es solo gradiente
+    const QImage verde = BackdropService::render(1, QSize(800, 700));
+    QCOMPARE(verde.size(), QSize(800, 700));
+    QVERIFY(cerca(verde.pixel(400, 350), QColor("#1f5a1f")));
+
+    const QImage rojo = BackdropService::render(2, QSize(800, 700), 2.0);
+    QCOMPARE(rojo.size(), QSize(1600, 1400));
+    QCOMPARE(rojo.devicePixelRatio(), 2.0);
+    QVERIFY(cerca(rojo.pixel(800, 700), QColor("#5a1f1f")));
+}
+
+void TestBackdropService::test_pixmap_is_composed_once_per_size()
+{
+    QPixmapCache::clear();
+    BackdropService &service = BackdropService::instance();
+
+    const QPixmap a = service.pixmap(3, QSize(640, 480));
+    const QPixmap b = service.pixmap(3, QSize(640, 480));
+    QVERIFY(!a.isNull());
+    QCOMPARE(a.cacheKey(), b.cacheKey());
+
+    const QPixmap c = service.pixmap(3, QSize(800, 600));
+    QVERIFY(c.cacheKey() != a.cacheKey());
+    QCOMPARE(c.size(), QSize(800, 600));
+}
+
+void TestBackdropService::test_prerender_fills_cache()
+{
+    QPixmapCache::clear();
+    BackdropService service;
+    QSignalSpy spy(&service, &BackdropService::ready);
+
+    service.prerender(4, QSize(320, 240));
+    service.prerender(4, QSize(320, 240));  // ya en curso: no se repite
+    QTRY_COMPARE(spy.count(), 1);
+
+    QPixmap cached;
+    QVERIFY(QPixmapCache::find(QStringLiteral("backdrop:4:320x240@1"), &cached));
+    QCOMPARE(service.pixmap(4, QSize(320, 240)).cacheKey(), cached.cacheKey());
+}
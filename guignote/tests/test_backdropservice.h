@@ -0,0 +1,17 @@
+#ifndef TEST_BACKDROPSERVICE_H
+#define TEST_BACKDROPSERVICE_H
+
+#include <QObject>
+
+class TestBackdropService : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_unknown_tapete_renders_nothing();
+    void test_gradient_matches_stylesheet_colors();
+    void test_pixmap_is_composed_once_per_size();
+    void test_prerender_fills_cache();
+};
+
+#endif // TEST_BACKDROPSERVICE_H
@@ -0,0 +1,132 @@
+#include "test_cardatlas.h"
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include <QPixmapCache>
+#include "cardatlas.h"
+#include "carta.h"
+
+// Deja en QPixmapCache todas las imágenes de partida del skin, como hace el arranque
+static void prepararSkin(int skin)
+{
+    for (const ImageLoader::Request &r : Carta::imagenesPartida(skin))
+        ImageLoader::instance().pixmap(r.path, r.size, r.mode, r.filter);
+}
+
+// Guarda el skin y espera a la escritura (el destructor espera al hilo)
+static void guardarSkin(const QString &dir, int skin, qreal dpr)
+{
+    prepararSkin(skin);
+    CardAtlas atlas(dir);
+    atlas.store(skin, dpr);
+}
+
+void TestCardAtlas::test_restore_without_decoding()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QPixmapCache::clear();
+    guardarSkin(dir.path(), 0, 1.0);
+
+    CardAtlas atlas(dir.path());
+    QVERIFY(QFile::exists(atlas.pathFor(0)));
+
+    QPixmapCache::clear();
+    const int antes = ImageLoader::instance().stats().decoded;
+    QVERIFY(atlas.restore(0, 1.0));
+    QCOMPARE(ImageLoader::instance().stats().decoded, antes);
+
+    {
+        const QList<ImageLoader::Request> peticiones = Carta::imagenesPartida(0);
+        for (const ImageLoader::Request &r : peticiones) {
+            QPixmap p;
+            QVERIFY(QPixmapCache::find(ImageLoader::keyFor(r.path, r.size, r.mode, r.filter.name), &p));
+        }
+
+        // Mismos píxeles que una decodificación nueva
+        const ImageLoader::Request &r = peticiones.first();
+        QPixmap p;
+        QPixmapCache::find(ImageLoader::keyFor(r.path, r.size, r.mode), &p);
+        QCOMPARE(p.toImage(), ImageLoader::decode(r.path, r.size, r.mode));
+
+        // Una carta creada ahora no decodifica nada
+        Carta carta("Copas", "7");
+        carta.setOrientacion(Orientacion::LEFT);
+        QCOMPARE(ImageLoader::instance().stats().decoded, antes);
+    }
+
+    // Los QPixmap pueden apuntar a la proyección: se sueltan antes que el atlas
+    QPixmapCache::clear();
+}
+
+void TestCardAtlas::test_evicted_images_come_from_atlas()
+{
+    QTemporaryDir dir;
+    QPixmapCache::clear();
+    guardarSkin(dir.path(), 0, 1.0);
+
+    const ImageLoader::Request r = Carta::imagenesPartida(0).first();
+    const int antes = ImageLoader::instance().stats().decoded;
+    {
+        CardAtlas atlas(dir.path());
+        QVERIFY(atlas.restore(0, 1.0));
+
+        // QPixmapCache la ha expulsado, pero sigue en la proyección
+        QPixmapCache::clear();
+        QVERIFY(!ImageLoader::instance().pixmap(r.path, r.size, r.mode, r.filter).isNull());
+        QCOMPARE(ImageLoader::instance().stats().decoded, antes);
+        QPixmapCache::clear();
+    }
+
+    // Sin atlas vuelve a decodificarse
+    QVERIFY(!ImageLoader::instance().pixmap(r.path, r.size, r.mode, r.filter).isNull());
+    QCOMPARE(ImageLoader::instance().stats().decoded, antes + 1);
+}
+
+void TestCardAtlas::test_invalidated_on_screen_change()
+{
+    QTemporaryDir dir;
+    QPixmapCache::clear();
+    guardarSkin(dir.path(), 0, 1.0);
+
+    CardAtlas atlas(dir.path());
+    QVERIFY(QFile::exists(atlas.pathFor(0)));
+    QVERIFY(!atlas.restore(0, 2.0));
+    QVERIFY(!QFile::exists(atlas.pathFor(0)));
+
+    // Otro skin es otro archivo
+    QVERIFY(!atlas.restore(1, 1.0));
+    QVERIFY(CardAtlas::fingerprint(Carta::imagenesPartida(0), 1.0)
+            != CardAtlas::fingerprint(Carta::imagenesPartida(1), 1.0));
+}
+
+void TestCardAtlas::test_damaged_file_is_discarded()
+{
+    QTemporaryDir dir;
+    QPixmapCache::clear();
+    guardarSkin(dir.path(), 0, 1.0);
+
+    CardAtlas atlas(dir.path());
+    QFile file(atlas.pathFor(0));
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.resize(file.size() / 2));
+    file.close();
+
+    QPixmapCache::clear();
+    QVERIFY(!atlas.restore(0, 1.0));
+    QVERIFY(!QFile::exists(atlas.pathFor(0)));
+    QPixmap p;
+    const ImageLoader::Request r = Carta::imagenesPartida(0).first();
+    QVERIFY(!QPixmapCache::find(ImageLoader::keyFor(r.path, r.size, r.mode), &p));
+}
+
+void TestCardAtlas::test_incomplete_cache_is_not_stored()
+{
+    QTemporaryDir dir;
+    QPixmapCache::clear();
+    {
+        CardAtlas atlas(dir.path());
+        atlas.store(0, 1.0);
+    }
+    QVERIFY(!QFile::exists(CardAtlas(dir.path()).pathFor(0)));
+}
@@ -0,0 +1,18 @@
+#ifndef TEST_CARDATLAS_H
+#define TEST_CARDATLAS_H
+
+#include <QObject>
+
+class TestCardAtlas : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_restore_without_decoding();
+    void test_evicted_images_come_from_atlas();
+    void test_invalidated_on_screen_change();
+    void test_damaged_file_is_discarded();
+    void test_incomplete_cache_is_not_stored();
+};
+
+#endif // TEST_CARDATLAS_H
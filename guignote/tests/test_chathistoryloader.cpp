@@ -0,0 +1,88 @@
+#include "test_chathistoryloader.h"
+
+#include <QtTest/QtTest>
+#include <QSignalSpy>
+
+// ------------------------------------------------------------------
+// Igual que en test_httpcache: acceso a los miembros privados
+// ------------------------------------------------------------------
+#define private public
+#include "chathistoryloader.h"
+#undef private
+// ------------------------------------------------------------------
+
+// Mensaje en el formato del servidor
+static QByteArray messageJson(int id, int emisor, const QString &contenido)
+{
+    return QString(R"({"id": %1, "emisor": %2, "contenido": "%3", "fecha_envio": "2025-05-01 10:00:00"})")
+        .arg(id).arg(emisor).arg(contenido).toUtf8();
+}
+
+void TestChatHistoryLoader::test_parser_handles_split_chunks()
+{
+    QByteArray body = "{\"mensajes\": [" + messageJson(1, 7, "hola") + ", "
+                      + messageJson(2, 8, "adios") + "]}";
+
+    // Se entrega byte a byte: cada mensaje sale en cuanto se cierra su objeto
+    ChatStreamParser parser;
+    QList<ChatMessage> all;
+    for (int i = 0; i < body.size(); ++i)
+        all += parser.feed(body.mid(i, 1));
+
+    QVERIFY(parser.isDone());
+    QCOMPARE(all.size(), 2);
+    QCOMPARE(all[0].id, QString("1"));
+    QCOMPARE(all[0].senderId, QString("7"));
+    QCOMPARE(all[0].content, QString("hola"));
+    QCOMPARE(all[1].content, QString("adios"));
+}
+
+void TestChatHistoryLoader::test_parser_ignores_braces_inside_strings()
+{
+    QByteArray body = R"({"mensajes": [{"emisor": {"id": 3}, "contenido": "a } \" { b"}]})";
+
+    ChatStreamParser parser;
+    QList<ChatMessage> all = parser.feed(body.left(30));
+    all += parser.feed(body.mid(30));
+
+    QCOMPARE(all.size(), 1);
+    QCOMPARE(all[0].senderId, QString("3"));
+    QCOMPARE(all[0].content, QString("a } \" { b"));
+}
+
+void TestChatHistoryLoader::test_pages_are_chronological_and_on_demand()
+{
+    ChatHistoryLoader loader(QNetworkRequest(), true, 2);
+    QSignalSpy spy(&loader, &ChatHistoryLoader::pageReady);
+
+    // El servidor entrega del más reciente (5) al más antiguo (1)
+    QList<ChatMessage> received;
+    for (int i = 5; i >= 1; --i) {
+        ChatMessage m;
+        m.id = QString::number(i);
+        received.append(m);
+    }
+    loader.onParsed(received);
+
+    // La primera página sale sola y en orden cronológico
+    QCOMPARE(spy.count(), 1);
+    auto page = spy.at(0).at(0).value<QList<ChatMessage>>();
+    QCOMPARE(page.size(), 2);
+    QCOMPARE(page[0].id, QString("4"));
+    QCOMPARE(page[1].id, QString("5"));
+    QVERIFY(spy.at(0).at(1).toBool());
+
+    // Las anteriores solo al pedirlas
+    loader.onDownloadFinished();
+    QCOMPARE(spy.count(), 1);
+    loader.fetchOlder();
+    QCOMPARE(spy.count(), 2);
+    page = spy.at(1).at(0).value<QList<ChatMessage>>();
+    QCOMPARE(page[0].id, QString("2"));
+    QCOMPARE(page[1].id, QString("3"));
+    QVERIFY(!spy.at(1).at(1).toBool());
+
+    loader.fetchOlder();
+    QCOMPARE(spy.count(), 3);
+    QVERIFY(!loader.hasMore());
+}
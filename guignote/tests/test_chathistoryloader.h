@@ -0,0 +1,16 @@
+#ifndef TEST_CHATHISTORYLOADER_H
+#define TEST_CHATHISTORYLOADER_H
+
+#include <QObject>
+
+class TestChatHistoryLoader : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_parser_handles_split_chunks();
+    void test_parser_ignores_braces_inside_strings();
+    void test_pages_are_chronological_and_on_demand();
+};
+
+#endif // TEST_CHATHISTORYLOADER_H
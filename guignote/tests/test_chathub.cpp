@@ -0,0 +1,68 @@
+#include "test_chathub.h"
+
+#include <QtTest/QtTest>
+#include <QSignalSpy>
+
+// ------------------------------------------------------------------
+// Igual que en test_httpcache: acceso a los miembros privados
+// ------------------------------------------------------------------
+#define private public
+#include "chathub.h"
+#undef private
+
+// Usuario sin token: open() registra el canal pero no llega a conectar
+static const QString kUserKey = QStringLiteral("testchathub");
+
+void TestChatHub::test_channel_paths()
+{
+    QCOMPARE(ChatHub::friendChannel("7"), QString("/ws/chat/7/"));
+    QCOMPARE(ChatHub::gameChannel("12"), QString("/ws/chat_partida/12/"));
+}
+
+void TestChatHub::test_messages_without_view_count_as_unread()
+{
+    ChatHub &hub = ChatHub::forUser(kUserKey);
+    const QString channel = ChatHub::friendChannel("7");
+    hub.open(channel);
+    QVERIFY(!hub.isConnected(channel));
+
+    QSignalSpy received(&hub, &ChatHub::messageReceived);
+    QSignalSpy unread(&hub, &ChatHub::unreadChanged);
+
+    hub.route(channel, R"({"emisor": 7, "contenido": "hola"})");
+    hub.route(channel, R"({"emisor": {"id": 7}, "contenido": "otra"})");
+    hub.route(channel, "no es json");
+
+    QCOMPARE(received.count(), 2);
+    QCOMPARE(received.at(0).at(0).toString(), channel);
+    QCOMPARE(hub.unread(channel), 2);
+    QCOMPARE(hub.totalUnread(), 2);
+    QCOMPARE(unread.last().at(1).toInt(), 2);
+
+    // Al abrir la ventana se marca como leído
+    hub.attach(channel);
+    QCOMPARE(hub.unread(channel), 0);
+    QCOMPARE(unread.last().at(1).toInt(), 0);
+    hub.detach(channel);
+}
+
+void TestChatHub::test_attached_channel_does_not_count_unread()
+{
+    ChatHub &hub = ChatHub::forUser(kUserKey);
+    const QString channel = ChatHub::gameChannel("12");
+    hub.attach(channel);
+
+    QSignalSpy received(&hub, &ChatHub::messageReceived);
+    hub.route(channel, R"({"emisor": {"id": 3}, "contenido": "hola"})");
+    QCOMPARE(received.count(), 1);
+    QCOMPARE(hub.unread(channel), 0);
+
+    // Cerrada la ventana, el canal sigue recibiendo y cuenta no leídos
+    hub.detach(channel);
+    hub.route(channel, R"({"emisor": {"id": 3}, "contenido": "sigues?"})");
+    QCOMPARE(received.count(), 2);
+    QCOMPARE(hub.unread(channel), 1);
+
+    hub.closeAll();
+    QCOMPARE(hub.totalUnread(), 0);
+}
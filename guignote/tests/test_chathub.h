@@ -0,0 +1,16 @@
+#ifndef TEST_CHATHUB_H
+#define TEST_CHATHUB_H
+
+#include <QObject>
+
+class TestChatHub : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_channel_paths();
+    void test_messages_without_view_count_as_unread();
+    void test_attached_channel_does_not_count_unread();
+};
+
+#endif // TEST_CHATHUB_H
@@ -0,0 +1,84 @@
+#include "test_chatmodel.h"
+
+#include <QtTest/QtTest>
+#include <QStyleOptionViewItem>
+
+#include "chatmodel.h"
+
+// ------------------------------------------------------------------
+// Igual que en test_httpcache: acceso a los miembros privados
+// ------------------------------------------------------------------
+#define private public
+#include "chatbubbledelegate.h"
+#undef private
+// ------------------------------------------------------------------
+
+static ChatMessage message(const QString &sender, const QString &content)
+{
+    ChatMessage m;
+    m.senderId = sender;
+    m.content = content;
+    return m;
+}
+
+void TestChatModel::test_prepend_keeps_chronological_order()
+{
+    ChatModel model("1");
+    model.append("2", "tercero");
+    model.prepend({message("1", "primero"), message("2", "segundo")});
+    model.append({message("1", "cuarto")});
+
+    QCOMPARE(model.rowCount(), 4);
+    QCOMPARE(model.index(0).data().toString(), QString("primero"));
+    QCOMPARE(model.index(1).data().toString(), QString("segundo"));
+    QCOMPARE(model.index(3).data().toString(), QString("cuarto"));
+    QVERIFY(model.index(0).data(ChatModel::OwnRole).toBool());
+    QVERIFY(!model.index(1).data(ChatModel::OwnRole).toBool());
+}
+
+void TestChatModel::test_delegate_caches_layout_per_width()
+{
+    ChatModel model("1");
+    model.append("2", QString("palabra ").repeated(60));
+
+    ChatBubbleDelegate delegate;
+    QStyleOptionViewItem option;
+    option.rect = QRect(0, 0, 560, 0);
+
+    QSize wide = delegate.sizeHint(option, model.index(0));
+    QCOMPARE(delegate.layouts.size(), 1);
+    delegate.sizeHint(option, model.index(0));
+    QCOMPARE(delegate.layouts.size(), 1);
+
+    // Más estrecho: nueva medida y burbuja más alta
+    option.rect = QRect(0, 0, 200, 0);
+    QSize narrow = delegate.sizeHint(option, model.index(0));
+    QCOMPARE(delegate.layouts.size(), 2);
+    QVERIFY(narrow.height() > wide.height());
+}
+
+void TestChatModel::test_outgoing_failed_and_retried()
+{
+    ChatModel model("1");
+    model.appendOutgoing("hola", "c1");
+    QVERIFY(model.index(0).data(ChatModel::OwnRole).toBool());
+    QVERIFY(!model.index(0).data(ChatModel::FailedRole).toBool());
+
+    ChatBubbleDelegate delegate;
+    QStyleOptionViewItem option;
+    option.rect = QRect(0, 0, 560, 0);
+    QSize sent = delegate.sizeHint(option, model.index(0));
+
+    // Sin confirmación: la burbuja lleva el aviso y crece
+    QVERIFY(model.setFailed("c1", true));
+    QVERIFY(!model.setFailed("otro", true));
+    QVERIFY(model.index(0).data(ChatModel::FailedRole).toBool());
+    QVERIFY(delegate.sizeHint(option, model.index(0)).height() > sent.height());
+
+    // Reintento: nuevo identificador y vuelve a estar pendiente
+    model.markRetried(0, "c2");
+    QCOMPARE(model.index(0).data(ChatModel::ClientIdRole).toString(), QString("c2"));
+    QVERIFY(!model.index(0).data(ChatModel::FailedRole).toBool());
+    QVERIFY(!model.setFailed("c1", true));
+    QCOMPARE(model.rowCount(), 1);
+}
@@ -0,0 +1,16 @@
+#ifndef TEST_CHATMODEL_H
+#define TEST_CHATMODEL_H
+
+#include <QObject>
+
+class TestChatModel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_prepend_keeps_chronological_order();
+    void test_delegate_caches_layout_per_width();
+    void test_outgoing_failed_and_retried();
+};
+
+#endif // TEST_CHATMODEL_H
@@ -0,0 +1,89 @@
+#include "test_chatoutbox.h"
+
+#include <QtTest/QtTest>
+#include <QSignalSpy>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+// ------------------------------------------------------------------
+// Igual que en test_httpcache: acceso a los miembros privados
+// ------------------------------------------------------------------
+#define private public
+#include "chatoutbox.h"
+#undef private
+
+void TestChatOutbox::test_recent_ids_are_bounded()
+{
+    RecentIds ids(3);
+    QVERIFY(ids.insert("a"));
+    QVERIFY(!ids.insert("a"));
+    ids.insert("b");
+    ids.insert("c");
+    ids.insert("d");
+
+    QCOMPARE(ids.size(), 3);
+    QVERIFY(!ids.contains("a"));   // el más antiguo se olvida
+    QVERIFY(ids.contains("d"));
+}
+
+void TestChatOutbox::test_echo_acknowledges_pending()
+{
+    QStringList frames;
+    ChatOutbox outbox([&frames](const QString &frame) { frames.append(frame); return true; });
+    QSignalSpy delivered(&outbox, &ChatOutbox::delivered);
+
+    QString id = outbox.enqueue("hola");
+    QCOMPARE(frames.size(), 1);
+    QJsonObject sent = QJsonDocument::fromJson(frames.first().toUtf8()).object();
+    QCOMPARE(sent["contenido"].toString(), QString("hola"));
+    QCOMPARE(sent["client_id"].toString(), id);
+
+    // Un eco ajeno no confirma nada; el propio sí (aunque no devuelva client_id)
+    QVERIFY(!outbox.acknowledge(QJsonObject{{"contenido", "otra cosa"}}));
+    QVERIFY(outbox.acknowledge(QJsonObject{{"contenido", "hola"}}));
+    QCOMPARE(outbox.pendingCount(), 0);
+    QCOMPARE(delivered.count(), 1);
+    QCOMPARE(delivered.at(0).at(0).toString(), id);
+
+    // Un segundo eco (reenvío) ya no corresponde a nada
+    QVERIFY(!outbox.acknowledge(QJsonObject{{"contenido", "hola"}}));
+}
+
+void TestChatOutbox::test_offline_messages_are_sent_on_flush()
+{
+    bool online = false;
+    int sent = 0;
+    ChatOutbox outbox([&](const QString &) { if (online) ++sent; return online; });
+
+    outbox.enqueue("uno");
+    outbox.enqueue("dos");
+    QCOMPARE(sent, 0);
+    QCOMPARE(outbox.pendingCount(), 2);
+
+    online = true;
+    outbox.flush();
+    QCOMPARE(sent, 2);
+}
+
+void TestChatOutbox::test_unacknowledged_message_is_retried()
+{
+    int sent = 0;
+    ChatOutbox outbox([&](const QString &) { ++sent; return true; });
+    QSignalSpy failed(&outbox, &ChatOutbox::failed);
+
+    outbox.enqueue("hola");
+    QCOMPARE(sent, 1);
+
+    // Simula que ha pasado el plazo de confirmación
+    for (int attempt = 1; attempt < ChatOutbox::kMaxAttempts; ++attempt) {
+        outbox.pending[0].sentAt -= ChatOutbox::kAckTimeoutMs;
+        outbox.checkTimeouts();
+        QCOMPARE(sent, attempt + 1);
+    }
+
+    outbox.pending[0].sentAt -= ChatOutbox::kAckTimeoutMs;
+    outbox.checkTimeouts();
+    QCOMPARE(sent, ChatOutbox::kMaxAttempts);
+    QCOMPARE(failed.count(), 1);
+    QCOMPARE(outbox.pendingCount(), 0);
+}
@@ -0,0 +1,17 @@
+#ifndef TEST_CHATOUTBOX_H
+#define TEST_CHATOUTBOX_H
+
+#include <QObject>
+
+class TestChatOutbox : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_recent_ids_are_bounded();
+    void test_echo_acknowledges_pending();
+    void test_offline_messages_are_sent_on_flush();
+    void test_unacknowledged_message_is_retried();
+};
+
+#endif // TEST_CHATOUTBOX_H
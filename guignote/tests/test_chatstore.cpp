@@ -0,0 +1,84 @@
+#include "test_chatstore.h"
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+
+#include "chatstore.h"
+
+static const QString kConversation = "1_2";
+
+static ChatMessage message(const QString &sender, const QString &content, const QString &sentAt)
+{
+    ChatMessage m;
+    m.senderId = sender;
+    m.content = content;
+    m.sentAt = sentAt;
+    return m;
+}
+
+void TestChatStore::test_merge_returns_only_new_messages()
+{
+    QTemporaryDir dir;
+    ChatStore store(dir.path());
+
+    QByteArray first = R"({"mensajes": [
+        {"emisor": 2, "contenido": "hola", "fecha_envio": "2025-05-01 10:00:00"},
+        {"emisor": 1, "contenido": "buenas", "fecha_envio": "2025-05-01 10:01:00"}]})";
+    QList<ChatMessage> fresh;
+    bool done = false;
+    store.merge(kConversation, first, nullptr, [&](const QList<ChatMessage> &m) { fresh = m; done = true; });
+    QTRY_VERIFY(done);
+    QCOMPARE(fresh.size(), 2);
+
+    // La segunda sincronización solo trae el mensaje que faltaba
+    QByteArray second = R"({"mensajes": [
+        {"emisor": 2, "contenido": "partida?", "fecha_envio": "2025-05-01 10:02:00"},
+        {"emisor": 1, "contenido": "buenas", "fecha_envio": "2025-05-01 10:01:00"},
+        {"emisor": 2, "contenido": "hola", "fecha_envio": "2025-05-01 10:00:00"}]})";
+    done = false;
+    store.merge(kConversation, second, nullptr, [&](const QList<ChatMessage> &m) { fresh = m; done = true; });
+    QTRY_VERIFY(done);
+    QCOMPARE(fresh.size(), 1);
+    QCOMPARE(fresh[0].content, QString("partida?"));
+}
+
+void TestChatStore::test_load_is_chronological_and_deduplicated()
+{
+    QTemporaryDir dir;
+    {
+        ChatStore store(dir.path());
+        store.append(kConversation, message("1", "segundo", "2025-05-01 10:05:00"));
+        store.append(kConversation, message("2", "primero", "2025-05-01 10:00:00"));
+        store.append(kConversation, message("1", "segundo", "2025-05-01 10:05:00"));
+    }
+
+    // Otra instancia (como en el siguiente arranque) lee lo guardado
+    ChatStore store(dir.path());
+    QList<ChatMessage> loaded;
+    bool done = false;
+    store.load(kConversation, nullptr, [&](const QList<ChatMessage> &m) { loaded = m; done = true; });
+    QTRY_VERIFY(done);
+    QCOMPARE(loaded.size(), 2);
+    QCOMPARE(loaded[0].content, QString("primero"));
+    QCOMPARE(loaded[1].content, QString("segundo"));
+}
+
+void TestChatStore::test_destroyed_context_drops_result()
+{
+    QTemporaryDir dir;
+    ChatStore store(dir.path());
+    store.append(kConversation, message("1", "hola", "2025-05-01 10:00:00"));
+
+    // La ventana se cierra antes de que el hilo io devuelva la conversación
+    bool called = false;
+    auto *context = new QObject;
+    store.load(kConversation, context, [&](const QList<ChatMessage> &) { called = true; });
+    store.merge(kConversation, R"({"mensajes": []})", context, [&](const QList<ChatMessage> &) { called = true; });
+    delete context;
+
+    // Una carga sin contexto posterior marca cuándo ya se han entregado las anteriores
+    bool done = false;
+    store.load(kConversation, nullptr, [&](const QList<ChatMessage> &) { done = true; });
+    QTRY_VERIFY(done);
+    QVERIFY(!called);
+}
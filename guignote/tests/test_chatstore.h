@@ -0,0 +1,16 @@
+#ifndef TEST_CHATSTORE_H
+#define TEST_CHATSTORE_H
+
+#include <QObject>
+
+class TestChatStore : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_merge_returns_only_new_messages();
+    void test_load_is_chronological_and_deduplicated();
+    void test_destroyed_context_drops_result();
+};
+
+#endif // TEST_CHATSTORE_H
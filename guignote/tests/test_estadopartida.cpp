@@ -0,0 +1,44 @@
+#include "test_estadopartida.h"
+
+#include <QtTest/QtTest>
+#include <QJsonObject>
+
+// ------------------------------------------------------------------
+// Igual que en test_httpcache: acceso a los miembros privados
+// ------------------------------------------------------------------
+#define private public
+#include "estadopartida.h"
+#undef private
+// ------------------------------------------------------------------
+#include "mano.h"
+
+void TestEstadoPartida::test_round_result_collects_cards_before_next_event()
+{
+    EstadoPartida partida("yo", "", "ws://localhost");
+
+    auto *jugador = new Jugador{"rival", 2, 2, new Mano(Orientacion::TOP, &partida, &partida), 0, nullptr};
+    jugador->mano->actualizarCartaJugada("Copas", "7", 0);
+    partida.jugadores.append(jugador);
+    partida.mapJugadores.insert(jugador->id, jugador);
+
+    // La baza y, detrás, el siguiente evento ya en cola
+    QJsonObject ganador{{"equipo", 1}, {"nombre", "yo"}};
+    QJsonObject resultado{{"type", "round_result"},
+                          {"data", QJsonObject{{"ganador", ganador},
+                                               {"puntos_equipo_1", 11},
+                                               {"puntos_equipo_2", 0}}}};
+    partida.colaEventos.enqueue(resultado);
+    partida.colaEventos.enqueue(QJsonObject{{"type", "siguiente"}});
+    partida.procesarSiguienteEvento();
+
+    // La baza está recogida y puntuada, y el siguiente aún no ha empezado
+    QCOMPARE(jugador->mano->jugada()->getPalo(), QString("area"));
+    QCOMPARE(partida.puntosEquipo1, 11);
+    QCOMPARE(partida.colaEventos.size(), 1);
+    QCOMPARE(partida.eventosProcesados, 0);
+
+    // En la siguiente vuelta del bucle se libera la cola
+    QTRY_VERIFY(partida.colaEventos.isEmpty());
+    QTRY_COMPARE(partida.eventosProcesados, 2);
+    QVERIFY(!partida.enEjecucion);
+}
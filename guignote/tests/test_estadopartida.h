@@ -0,0 +1,14 @@
+#ifndef TEST_ESTADOPARTIDA_H
+#define TEST_ESTADOPARTIDA_H
+
+#include <QObject>
+
+class TestEstadoPartida : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_round_result_collects_cards_before_next_event();
+};
+
+#endif // TEST_ESTADOPARTIDA_H
@@ -3,7 +3,7 @@
 
 #include <QtTest/QtTest>
 #include <QTabWidget>
-#include <QListWidget>
+#include <QListView>
 #include <QPushButton>
 #include <QLineEdit>
 #include <QLabel>
@@ -56,16 +56,16 @@ void TestFriendsWindow::test_tab_count_and_titles()
     QCOMPARE(tabs->tabText(1), QStringLiteral("Solicitudes"));
     QCOMPARE(tabs->tabText(2), QStringLiteral("Buscar"));
 
-    // Cada pestaña contiene su QListWidget o QLineEdit
+    // Cada pestaña contiene su QListView o QLineEdit
     QWidget *friendsTab = tabs->widget(0);
-    QVERIFY(friendsTab->findChild<QListWidget*>());
+    QVERIFY(friendsTab->findChild<QListView*>());
 
     QWidget *reqTab = tabs->widget(1);
-    QVERIFY(reqTab->findChild<QListWidget*>());
+    QVERIFY(reqTab->findChild<QListView*>());
 
     QWidget *searchTab = tabs->widget(2);
     QVERIFY(searchTab->findChild<QLineEdit*>());
-    QVERIFY(searchTab->findChild<QListWidget*>());
+    QVERIFY(searchTab->findChild<QListView*>());
 
     delete w; w = nullptr;
 }
@@ -80,12 +80,12 @@ void TestFriendsWindow::test_friend_request_search_tab()
     QLineEdit *edit = w->findChild<QLineEdit*>();
     QVERIFY(edit);
     // Al cambiar texto, debe invocar searchUsers y limpiar la lista
-    QListWidget *results = w->findChild<QListWidget*>("", Qt::FindChildrenRecursively);
+    QListView *results = w->findChild<QListView*>("", Qt::FindChildrenRecursively);
     QVERIFY(results);
     edit->setText("foo");
     QTest::qWait(100);
     // Como no hay backend en test, la lista seguirá vacía
-    QCOMPARE(results->count(), 0);
+    QCOMPARE(results->model()->rowCount(), 0);
 
     delete w; w = nullptr;
 }
@@ -0,0 +1,169 @@
+#include "test_httpcache.h"
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include <QNetworkRequest>
+
+// ------------------------------------------------------------------
+// Igual que en test_rankingwindow: acceso a los miembros privados
+// ------------------------------------------------------------------
+#define private public
+#include "httpcache.h"
+#undef private
+// ------------------------------------------------------------------
+
+static QNetworkRequest requestFor(const QString &path, const QByteArray &token = "tok")
+{
+    QNetworkRequest req(QUrl("http://188.165.76.134:8000" + path));
+    req.setRawHeader("Auth", token);
+    return req;
+}
+
+static HttpCache::Entry entryWith(const QByteArray &body, const QUrl &url)
+{
+    HttpCache::Entry e;
+    e.url = url;
+    e.etag = "\"v1\"";
+    e.storedAt = QDateTime::currentDateTimeUtc();
+    e.body = body;
+    e.valid = true;
+    return e;
+}
+
+void TestHttpCache::test_freshness_longest_prefix_wins()
+{
+    QTemporaryDir dir;
+    HttpCache cache(dir.path());
+    cache.setFreshness("/usuarios/", 10);
+    cache.setFreshness("/usuarios/top_elo", 300);
+
+    QCOMPARE(cache.freshnessFor(QUrl("http://x/usuarios/top_elo_amigos/")), 300);
+    QCOMPARE(cache.freshnessFor(QUrl("http://x/usuarios/elo/")), 10);
+    QCOMPARE(cache.freshnessFor(QUrl("http://x/salas/disponibles/")), 0);
+
+    // Redefinir un prefijo sustituye la regla anterior
+    cache.setFreshness("/usuarios/", 20);
+    QCOMPARE(cache.freshnessFor(QUrl("http://x/usuarios/elo/")), 20);
+}
+
+void TestHttpCache::test_entries_persist_between_instances()
+{
+    QTemporaryDir dir;
+    QNetworkRequest req = requestFor("/usuarios/elo/");
+    {
+        HttpCache cache(dir.path());
+        cache.store(cache.keyFor(req), entryWith("{\"elo\":1500}", req.url()));
+    }
+
+    HttpCache reopened(dir.path());
+    HttpCache::Entry e = reopened.lookup(reopened.keyFor(req));
+    QVERIFY(e.valid);
+    QCOMPARE(e.body, QByteArray("{\"elo\":1500}"));
+    QCOMPARE(e.etag, QByteArray("\"v1\""));
+}
+
+void TestHttpCache::test_entries_are_scoped_by_token()
+{
+    QTemporaryDir dir;
+    HttpCache cache(dir.path());
+    QNetworkRequest mine = requestFor("/usuarios/estadisticas/", "a");
+    QNetworkRequest other = requestFor("/usuarios/estadisticas/", "b");
+
+    QVERIFY(cache.keyFor(mine) != cache.keyFor(other));
+    cache.store(cache.keyFor(mine), entryWith("yo", mine.url()));
+    QVERIFY(!cache.lookup(cache.keyFor(other)).valid);
+}
+
+void TestHttpCache::test_fresh_entry_is_served_without_network()
+{
+    QTemporaryDir dir;
+    HttpCache cache(dir.path());
+    cache.setFreshness("/usuarios/elo/", 60);
+    QNetworkRequest req = requestFor("/usuarios/elo/");
+    cache.store(cache.keyFor(req), entryWith("{\"elo\":1200}", req.url()));
+
+    int calls = 0;
+    bool fromCache = false;
+    cache.get(req, nullptr, [&](const QByteArray &body, bool cached) {
+        ++calls;
+        fromCache = cached;
+        QCOMPARE(body, QByteArray("{\"elo\":1200}"));
+    });
+
+    QCOMPARE(calls, 1);
+    QVERIFY(fromCache);
+    QCOMPARE(cache.stats().fresh, 1);
+    QCOMPARE(cache.stats().misses, 0);
+    QCOMPARE(cache.stats().hitRate(), 1.0);
+}
+
+void TestHttpCache::test_invalidate_removes_entries()
+{
+    QTemporaryDir dir;
+    HttpCache cache(dir.path());
+    QNetworkRequest ranking = requestFor("/usuarios/top_elo/");
+    QNetworkRequest elo = requestFor("/usuarios/elo/");
+    cache.store(cache.keyFor(ranking), entryWith("r", ranking.url()));
+    cache.store(cache.keyFor(elo), entryWith("e", elo.url()));
+
+    cache.invalidate("/usuarios/top_elo");
+
+    QVERIFY(!cache.lookup(cache.keyFor(ranking)).valid);
+    QVERIFY(cache.lookup(cache.keyFor(elo)).valid);
+}
+
+void TestHttpCache::test_invalidate_reaches_unread_disk_entries()
+{
+    QTemporaryDir dir;
+    QNetworkRequest equipped = requestFor("/usuarios/get_equipped_items/");
+    QNetworkRequest elo = requestFor("/usuarios/elo/");
+    {
+        HttpCache cache(dir.path());
+        cache.store(cache.keyFor(equipped), entryWith("viejo", equipped.url()));
+        cache.store(cache.keyFor(elo), entryWith("e", elo.url()));
+    }
+
+    // Otra sesión: nada leído todavía
+    HttpCache reopened(dir.path());
+    QVERIFY(reopened.memory.isEmpty());
+    reopened.invalidate("/usuarios/get_equipped_items/");
+
+    QVERIFY(!QFile::exists(reopened.pathFor(reopened.keyFor(equipped))));
+    QVERIFY(!reopened.lookup(reopened.keyFor(equipped)).valid);
+    QVERIFY(reopened.lookup(reopened.keyFor(elo)).valid);
+}
+
+// Cambia la fecha de modificación de una entrada en disco
+static void touch(const QString &path, const QDateTime &when)
+{
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.setFileTime(when, QFileDevice::FileModificationTime));
+}
+
+void TestHttpCache::test_prune_drops_old_and_oversized_entries()
+{
+    QTemporaryDir dir;
+    HttpCache cache(dir.path());
+    const QString paths[] = {"/usuarios/elo/", "/usuarios/estadisticas/", "/usuarios/top_elo/"};
+    QStringList files;
+    for (const QString &path : paths) {
+        QNetworkRequest req = requestFor(path);
+        cache.store(cache.keyFor(req), entryWith(QByteArray(1000, 'x'), req.url()));
+        files.append(cache.pathFor(cache.keyFor(req)));
+    }
+    const QDateTime now = QDateTime::currentDateTime();
+    touch(files[0], now.addDays(-40));
+    touch(files[1], now.addSecs(-60));
+    touch(files[2], now);
+
+    // Caducada por edad
+    cache.prune(HttpCache::kMaxDiskBytes, 30);
+    QVERIFY(!QFile::exists(files[0]));
+    QVERIFY(QFile::exists(files[1]));
+
+    // Por tamaño se conserva la más reciente
+    cache.prune(QFileInfo(files[2]).size(), 30);
+    QVERIFY(!QFile::exists(files[1]));
+    QVERIFY(QFile::exists(files[2]));
+}
@@ -0,0 +1,20 @@
+#ifndef TEST_HTTPCACHE_H
+#define TEST_HTTPCACHE_H
+
+#include <QObject>
+
+class TestHttpCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_freshness_longest_prefix_wins();
+    void test_entries_persist_between_instances();
+    void test_entries_are_scoped_by_token();
+    void test_fresh_entry_is_served_without_network();
+    void test_invalidate_removes_entries();
+    void test_invalidate_reaches_unread_disk_entries();
+    void test_prune_drops_old_and_oversized_entries();
+};
+
+#endif // TEST_HTTPCACHE_H
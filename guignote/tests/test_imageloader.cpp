@@ -0,0 +1,143 @@
+#include "test_imageloader.h"
+
+#include <QtTest/QtTest>
+#include <QImageIOHandler>
+#include <QImageReader>
+#include <QPixmapCache>
+#include "imageloader.h"
+#include "carta.h"
+
+static const char *kCarta = ":/decks/base/1Oros.png";
+static const char *kTile  = ":/tiles/base.png";
+
+void TestImageLoader::test_decode_at_target_size()
+{
+    const QSize original = QImageReader(kCarta).size();
+    QVERIFY(original.isValid());
+
+    QSize source;
+    const QImage carta = ImageLoader::decode(kCarta, QSize(60, 90), Qt::KeepAspectRatioByExpanding, &source);
+    QCOMPARE(source, original);
+    QCOMPARE(carta.size(), original.scaled(QSize(60, 90), Qt::KeepAspectRatioByExpanding));
+
+    // Mismo resultado de tamaño que el antiguo QPixmap(ruta).scaled(...)
+    const QImage icono = ImageLoader::decode(kTile, QSize(32, 32));
+    QCOMPARE(icono.size(), QImage(kTile).scaled(32, 32, Qt::KeepAspectRatio).size());
+
+    // Sin tamaño de destino se decodifica entera
+    QCOMPARE(ImageLoader::decode(kCarta).size(), original);
+}
+
+void TestImageLoader::test_missing_image_is_null()
+{
+    QVERIFY(ImageLoader::decode(":/no/existe.png", QSize(10, 10)).isNull());
+    QVERIFY(ImageLoader::instance().pixmap(":/no/existe.png", QSize(10, 10)).isNull());
+}
+
+void TestImageLoader::test_pixmap_is_decoded_once()
+{
+    QPixmapCache::clear();
+    ImageLoader loader;
+
+    const QPixmap a = loader.pixmap(kCarta, QSize(40, 60));
+    const QPixmap b = loader.pixmap(kCarta, QSize(40, 60));
+    QVERIFY(!a.isNull());
+    QCOMPARE(a.cacheKey(), b.cacheKey());
+    QCOMPARE(loader.stats().decoded, 1);
+
+    QPixmap cached;
+    QVERIFY(QPixmapCache::find(ImageLoader::keyFor(kCarta, QSize(40, 60)), &cached));
+
+    // Otro modo de proporción es otra entrada
+    loader.pixmap(kCarta, QSize(40, 60), Qt::KeepAspectRatioByExpanding);
+    QCOMPARE(loader.stats().decoded, 2);
+}
+
+void TestImageLoader::test_load_coalesces_requests()
+{
+    QPixmapCache::clear();
+    ImageLoader loader;
+    QObject context;
+
+    QList<QPixmap> recibidas;
+    auto handler = [&recibidas](const QPixmap &p) { recibidas.append(p); };
+    loader.load(kTile, QSize(140, 100), Qt::KeepAspectRatioByExpanding, &context, handler);
+    loader.load(kTile, QSize(140, 100), Qt::KeepAspectRatioByExpanding, &context, handler);
+    QTRY_COMPARE(recibidas.size(), 2);
+    QCOMPARE(recibidas[0].cacheKey(), recibidas[1].cacheKey());
+    QCOMPARE(loader.stats().decoded, 1);
+
+    // Ya en caché: respuesta inmediata
+    loader.load(kTile, QSize(140, 100), Qt::KeepAspectRatioByExpanding, &context, handler);
+    QCOMPARE(recibidas.size(), 3);
+
+    // Un fallo también avisa, con imagen nula
+    bool avisado = false;
+    loader.load(":/no/existe.png", QSize(10, 10), Qt::KeepAspectRatio, nullptr,
+                [&avisado](const QPixmap &p) { avisado = p.isNull(); });
+    QTRY_VERIFY(avisado);
+}
+
+void TestImageLoader::test_stats_measure_decode_memory()
+{
+    QPixmapCache::clear();
+    ImageLoader loader;
+
+    loader.pixmap(kCarta, QSize(40, 60), Qt::KeepAspectRatioByExpanding);
+    loader.pixmap(kTile, QSize(140, 100), Qt::KeepAspectRatioByExpanding);
+
+    const ImageLoader::Stats stats = loader.stats();
+    QCOMPARE(stats.decoded, 2);
+    QVERIFY(stats.bytes > 0);
+    QVERIFY(stats.workBytes > stats.bytes);
+    QVERIFY(stats.livePeakBytes >= stats.peakBytes);
+
+    // El lector de PNG no escala al leer: el pico incluye la imagen completa
+    qint64 work = 0;
+    const QImage carta = ImageLoader::decode(kCarta, QSize(40, 60), Qt::KeepAspectRatioByExpanding,
+                                             nullptr, &work);
+    QVERIFY(!QImageReader(kCarta).supportsOption(QImageIOHandler::ScaledSize));
+    QVERIFY(work >= QImage(kCarta).sizeInBytes() + carta.sizeInBytes());
+}
+
+void TestImageLoader::test_filter_is_its_own_variant()
+{
+    QPixmapCache::clear();
+    ImageLoader loader;
+    const QSize size(40, 60);
+
+    const QPixmap normal = loader.pixmap(kCarta, size, Qt::KeepAspectRatioByExpanding);
+    const QPixmap girada = loader.pixmap(kCarta, size, Qt::KeepAspectRatioByExpanding, Carta::girada());
+    QCOMPARE(loader.stats().decoded, 2);
+    QCOMPARE(girada.size(), normal.size().transposed());
+
+    // La variante se guarda con su propio nombre y no pisa la normal
+    QVERIFY(ImageLoader::keyFor(kCarta, size, Qt::KeepAspectRatioByExpanding, "girada")
+            != ImageLoader::keyFor(kCarta, size, Qt::KeepAspectRatioByExpanding));
+    QPixmap cached;
+    QVERIFY(QPixmapCache::find(ImageLoader::keyFor(kCarta, size, Qt::KeepAspectRatioByExpanding, "girada"), &cached));
+    QCOMPARE(cached.cacheKey(), girada.cacheKey());
+}
+
+void TestImageLoader::test_warm_up_matches_carta()
+{
+    // 40 caras, reverso y zona, en dos orientaciones; con otro skin también las del base
+    QCOMPARE(Carta::imagenesPartida(0).size(), 42 * 2);
+    QCOMPARE(Carta::imagenesPartida(1).size(), 42 * 2 * 2);
+
+    QPixmapCache::clear();
+    ImageLoader &loader = ImageLoader::instance();
+    QObject context;
+    const QList<ImageLoader::Request> peticiones = Carta::imagenesPartida(1);
+    int listas = 0;
+    for (const ImageLoader::Request &peticion : peticiones)
+        loader.load(peticion, &context, [&listas](const QPixmap &p) { if (!p.isNull()) ++listas; });
+    QTRY_COMPARE(listas, peticiones.size());
+
+    // Una carta creada después ya no decodifica nada
+    const int antes = loader.stats().decoded;
+    Carta carta("Oros", "1");
+    carta.setSkin(1);
+    carta.setOrientacion(Orientacion::DOWN);
+    QCOMPARE(loader.stats().decoded, antes);
+}
@@ -0,0 +1,20 @@
+#ifndef TEST_IMAGELOADER_H
+#define TEST_IMAGELOADER_H
+
+#include <QObject>
+
+class TestImageLoader : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_decode_at_target_size();
+    void test_missing_image_is_null();
+    void test_pixmap_is_decoded_once();
+    void test_load_coalesces_requests();
+    void test_stats_measure_decode_memory();
+    void test_filter_is_its_own_variant();
+    void test_warm_up_matches_carta();
+};
+
+#endif // TEST_IMAGELOADER_H
@@ -0,0 +1,76 @@
+#include "test_loadinganimation.h"
+
+#include <QtTest/QtTest>
+
+// Igual que en test_httpcache: acceso a los miembros privados
+#define private public
+#include "loadinganimation.h"
+#undef private
+
+void TestLoadingAnimation::test_composes_once_per_size()
+{
+    LoadingAnimation animation;
+    animation.resize(1280, 720);
+    animation.show();  // un widget oculto no recibe resizeEvent hasta mostrarse
+    QVERIFY(QTest::qWaitForWindowExposed(&animation));
+    animation.stop();
+
+    QVERIFY(!animation.logo.isNull());
+    QVERIFY(!animation.title.isNull());
+    QVERIFY(!animation.caption.isNull());
+    const qint64 logoKey = animation.logo.cacheKey();
+
+    // Todo cabe en pantalla y en columna
+    const QRect area = animation.rect();
+    QVERIFY(area.contains(animation.logoRect));
+    QVERIFY(area.contains(animation.titleRect));
+    QVERIFY(animation.logoRect.bottom() < animation.titleRect.top());
+    QVERIFY(animation.titleRect.bottom() < animation.captionRect.top());
+    QVERIFY(animation.captionRect.bottom() < animation.dotsRect.top());
+
+    // Un fotograma no recompone nada
+    animation.nextFrame();
+    QCOMPARE(animation.logo.cacheKey(), logoKey);
+
+    animation.resize(1920, 1080);
+    QTRY_VERIFY(animation.logo.cacheKey() != logoKey);
+    QVERIFY(animation.logoRect.height() > 0);
+}
+
+void TestLoadingAnimation::test_runs_only_while_visible()
+{
+    LoadingAnimation animation;
+    animation.resize(640, 360);
+    QVERIFY(!animation.isRunning());
+
+    animation.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&animation));
+    QVERIFY(animation.isRunning());
+
+    animation.hide();
+    QVERIFY(!animation.isRunning());
+
+    animation.show();
+    QVERIFY(animation.isRunning());
+    animation.stop();
+    QVERIFY(!animation.isRunning());
+}
+
+void TestLoadingAnimation::test_intro_then_only_dots_repaint()
+{
+    LoadingAnimation animation;
+    animation.resize(640, 360);
+    animation.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&animation));
+    QVERIFY(!animation.introDone);
+
+    QTRY_VERIFY_WITH_TIMEOUT(animation.introDone, LoadingAnimation::kIntroMs + 1000);
+    QCOMPARE(animation.introProgress(), 1.0);
+
+    // Terminada la entrada, la imagen fuera de los puntos ya no cambia
+    const QImage antes = animation.grab().toImage();
+    QTest::qWait(LoadingAnimation::kFrameMs * 4);
+    const QImage despues = animation.grab().toImage();
+    const QRect fuera(0, 0, animation.width(), animation.dotsRect.top());
+    QCOMPARE(antes.copy(fuera), despues.copy(fuera));
+}
@@ -0,0 +1,16 @@
+#ifndef TEST_LOADINGANIMATION_H
+#define TEST_LOADINGANIMATION_H
+
+#include <QObject>
+
+class TestLoadingAnimation : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_composes_once_per_size();
+    void test_runs_only_while_visible();
+    void test_intro_then_only_dots_repaint();
+};
+
+#endif // TEST_LOADINGANIMATION_H
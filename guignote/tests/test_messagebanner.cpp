@@ -0,0 +1,58 @@
+#include "test_messagebanner.h"
+
+#include <QtTest/QtTest>
+#include <QLabel>
+#include "messagebanner.h"
+
+void TestMessageBanner::test_post_does_not_block()
+{
+    QWidget parent;
+    parent.resize(400, 300);
+    MessageBanner banner(&parent);
+
+    bool seen = false;
+    banner.post("Es tu turno", [&seen]() { seen = true; });
+
+    // La llamada vuelve al momento; el aviso se ve después
+    QVERIFY(banner.isShowing());
+    QVERIFY(!seen);
+    QCOMPARE(banner.findChild<QLabel *>()->text(), QString("Es tu turno"));
+    QCOMPARE(banner.geometry(), parent.rect());
+
+    QTRY_VERIFY_WITH_TIMEOUT(seen, 2 * MessageBanner::kFadeMs + MessageBanner::kHoldMs + 1000);
+    QVERIFY(!banner.isShowing());
+}
+
+void TestMessageBanner::test_repeated_and_keyed_messages_are_coalesced()
+{
+    QWidget parent;
+    MessageBanner banner(&parent);
+
+    int seen = 0;
+    auto count = [&seen]() { ++seen; };
+
+    banner.post("Baza");                              // en pantalla
+    banner.post("Turno de Ana", count, "turno");
+    banner.post("Turno de Ana", count, "turno");      // repetido
+    banner.post("Turno de Luis", count, "turno");     // sustituye al anterior
+    QCOMPARE(banner.pendingCount(), 1);
+
+    // Todos los que esperaban se avisan cuando se ve el aviso fusionado
+    QTRY_COMPARE_WITH_TIMEOUT(seen, 3, 2 * (2 * MessageBanner::kFadeMs + MessageBanner::kHoldMs) + 1000);
+}
+
+void TestMessageBanner::test_clear_drops_pending_messages()
+{
+    QWidget parent;
+    MessageBanner banner(&parent);
+
+    bool seen = false;
+    banner.post("Uno");
+    banner.post("Dos", [&seen]() { seen = true; });
+    banner.clear();
+
+    QVERIFY(!banner.isShowing());
+    QCOMPARE(banner.pendingCount(), 0);
+    QTest::qWait(2 * MessageBanner::kFadeMs);
+    QVERIFY(!seen);
+}
@@ -0,0 +1,16 @@
+#ifndef TEST_MESSAGEBANNER_H
+#define TEST_MESSAGEBANNER_H
+
+#include <QObject>
+
+class TestMessageBanner : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_post_does_not_block();
+    void test_repeated_and_keyed_messages_are_coalesced();
+    void test_clear_drops_pending_messages();
+};
+
+#endif // TEST_MESSAGEBANNER_H
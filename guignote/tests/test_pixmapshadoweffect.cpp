@@ -0,0 +1,70 @@
+#include "test_pixmapshadoweffect.h"
+
+#include <QtTest/QtTest>
+#include <QPixmapCache>
+#include <QWidget>
+#include "pixmapshadoweffect.h"
+
+static const QColor kSombra(0, 0, 0, 160);
+
+void TestPixmapShadowEffect::test_shadow_is_blurred_once()
+{
+    QPixmapCache::clear();
+    const QPixmap a = PixmapShadowEffect::shadow(QSize(150, 110), 12, 18, kSombra);
+    const QPixmap b = PixmapShadowEffect::shadow(QSize(150, 110), 12, 18, kSombra);
+    QCOMPARE(a.size(), QSize(150 + 36, 110 + 36));
+    QCOMPARE(a.cacheKey(), b.cacheKey());
+
+    // Otro desenfoque es otra sombra
+    const QPixmap c = PixmapShadowEffect::shadow(QSize(150, 110), 12, 28, kSombra);
+    QCOMPARE(c.size(), QSize(150 + 56, 110 + 56));
+    QVERIFY(c.cacheKey() != a.cacheKey());
+}
+
+void TestPixmapShadowEffect::test_shadow_fades_towards_edges()
+{
+    const QImage sombra = PixmapShadowEffect::shadow(QSize(150, 110), 12, 18, kSombra).toImage();
+    const int y = sombra.height() / 2;
+
+    QVERIFY(qAbs(qAlpha(sombra.pixel(sombra.width() / 2, y)) - kSombra.alpha()) <= 2);
+    QCOMPARE(qAlpha(sombra.pixel(0, 0)), 0);
+
+    // Del borde al centro la sombra solo puede oscurecerse
+    int anterior = -1;
+    for (int x = 0; x <= sombra.width() / 2; ++x) {
+        const int alpha = qAlpha(sombra.pixel(x, y));
+        QVERIFY(alpha >= anterior);
+        anterior = alpha;
+    }
+    // En el contorno del rectángulo queda más o menos la mitad
+    const int borde = qAlpha(sombra.pixel(18, y));
+    QVERIFY(borde > 40 && borde < 120);
+}
+
+void TestPixmapShadowEffect::test_bounding_rect_covers_raised_shadow()
+{
+    QWidget w;
+    w.resize(150, 110);
+    auto *efecto = new PixmapShadowEffect(12, {18, 4}, {28, 6}, kSombra, &w);
+    w.setGraphicsEffect(efecto);
+
+    QCOMPARE(efecto->boundingRect(), QRectF(-28, -24, 150 + 56, 110 + 24 + 34));
+}
+
+void TestPixmapShadowEffect::test_elevation_animates_and_clamps()
+{
+    PixmapShadowEffect efecto(12, {18, 4}, {28, 6}, kSombra);
+    QCOMPARE(efecto.elevation(), 0.0);
+
+    efecto.animateTo(1.0, 50);
+    QTRY_COMPARE(efecto.elevation(), 1.0);
+
+    efecto.animateTo(0.0, 50);
+    efecto.animateTo(1.0, 50);  // la nueva sustituye a la anterior
+    QTRY_COMPARE(efecto.elevation(), 1.0);
+
+    efecto.setElevation(3.0);
+    QCOMPARE(efecto.elevation(), 1.0);
+    efecto.setElevation(-1.0);
+    QCOMPARE(efecto.elevation(), 0.0);
+}
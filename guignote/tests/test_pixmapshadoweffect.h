@@ -0,0 +1,17 @@
+#ifndef TEST_PIXMAPSHADOWEFFECT_H
+#define TEST_PIXMAPSHADOWEFFECT_H
+
+#include <QObject>
+
+class TestPixmapShadowEffect : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_shadow_is_blurred_once();
+    void test_shadow_fades_towards_edges();
+    void test_bounding_rect_covers_raised_shadow();
+    void test_elevation_animates_and_clamps();
+};
+
+#endif // TEST_PIXMAPSHADOWEFFECT_H
@@ -0,0 +1,78 @@
+#include "test_playerprofiles.h"
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+
+// ------------------------------------------------------------------
+// Igual que en test_httpcache: acceso a los miembros privados
+// ------------------------------------------------------------------
+#define private public
+#include "playerprofiles.h"
+#undef private
+// ------------------------------------------------------------------
+
+static void seed(PlayerProfiles &profiles, const QString &name, int id, int skin, int tapete)
+{
+    profiles.remember(name, id);
+    profiles.updateEquipped(id, skin, tapete);
+}
+
+void TestPlayerProfiles::test_fresh_profiles_resolve_without_network()
+{
+    QTemporaryDir dir;
+    PlayerProfiles profiles(dir.path());
+    seed(profiles, "ana", 7, 2, 3);
+    seed(profiles, "luis", 9, 3, 1);
+
+    int calls = 0;
+    QHash<QString, PlayerProfiles::Profile> result;
+    profiles.resolveAll({{"ana", 7}, {"luis", 9}}, nullptr,
+                        [&](const QHash<QString, PlayerProfiles::Profile> &p) {
+        ++calls;
+        result = p;
+    });
+
+    // Todo estaba fresco: respuesta inmediata y ninguna consulta en curso
+    QCOMPARE(calls, 1);
+    QVERIFY(profiles.inFlight.isEmpty());
+    QCOMPARE(result.value("ana").skinId, 2);
+    QCOMPARE(result.value("luis").tapeteId, 1);
+}
+
+void TestPlayerProfiles::test_changing_id_discards_items()
+{
+    QTemporaryDir dir;
+    PlayerProfiles profiles(dir.path());
+    seed(profiles, "ana", 7, 2, 3);
+    QVERIFY(PlayerProfiles::isFresh(profiles.cached("ana")));
+
+    profiles.remember("ana", 7);
+    QVERIFY(PlayerProfiles::isFresh(profiles.cached("ana")));
+
+    profiles.remember("ana", 8);
+    QVERIFY(!profiles.cached("ana").hasItems());
+    QCOMPARE(profiles.names.value(8), QString("ana"));
+    QVERIFY(!profiles.names.contains(7));
+
+    PlayerProfiles::Profile old = profiles.cached("ana");
+    old.fetchedAt = QDateTime::currentDateTimeUtc().addSecs(-PlayerProfiles::kTtlSecs - 1);
+    QVERIFY(!PlayerProfiles::isFresh(old));
+}
+
+void TestPlayerProfiles::test_profiles_survive_restart()
+{
+    QTemporaryDir dir;
+    {
+        PlayerProfiles profiles(dir.path());
+        seed(profiles, "ana", 7, 2, 3);
+        profiles.save();
+    }
+
+    PlayerProfiles reloaded(dir.path());
+    const PlayerProfiles::Profile ana = reloaded.cached("ana");
+    QCOMPARE(ana.id, 7);
+    QCOMPARE(ana.skinId, 2);
+    QCOMPARE(ana.tapeteId, 3);
+    QVERIFY(PlayerProfiles::isFresh(ana));
+    QCOMPARE(reloaded.names.value(7), QString("ana"));
+}
@@ -0,0 +1,16 @@
+#ifndef TEST_PLAYERPROFILES_H
+#define TEST_PLAYERPROFILES_H
+
+#include <QObject>
+
+class TestPlayerProfiles : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_fresh_profiles_resolve_without_network();
+    void test_changing_id_discards_items();
+    void test_profiles_survive_restart();
+};
+
+#endif // TEST_PLAYERPROFILES_H
@@ -0,0 +1,66 @@
+#include "test_rankingmodel.h"
+
+#include <QtTest/QtTest>
+#include <QSignalSpy>
+#include <QJsonObject>
+
+#include "rankingmodel.h"
+
+static QJsonArray jugadores(int n)
+{
+    QJsonArray arr;
+    for (int i = 0; i < n; ++i)
+        arr.append(QJsonObject{{"nombre", QString("jugador%1").arg(i)}, {"elo", 2000 - i}});
+    return arr;
+}
+
+void TestRankingModel::test_rows_are_revealed_by_pages()
+{
+    RankingModel model("nadie");
+    model.setPlayers(jugadores(120), "elo");
+
+    QCOMPARE(model.totalCount(), 120);
+    QCOMPARE(model.rowCount(), int(RankingModel::kPageSize));
+    QVERIFY(model.canFetchMore(QModelIndex()));
+
+    model.fetchMore(QModelIndex());
+    QCOMPARE(model.rowCount(), 2 * RankingModel::kPageSize);
+    model.fetchMore(QModelIndex());
+    QCOMPARE(model.rowCount(), 120);
+    QVERIFY(!model.canFetchMore(QModelIndex()));
+
+    QCOMPARE(model.index(0).data().toString(), QString("1º  jugador0 - Elo: 2000"));
+}
+
+void TestRankingModel::test_search_and_reveal()
+{
+    RankingModel model("jugador110");
+    model.setPlayers(jugadores(120), "elo");
+
+    // El usuario local está fuera de la primera página: reveal() la carga
+    int row = model.currentUserRow();
+    QCOMPARE(row, 110);
+    QModelIndex index = model.reveal(row);
+    QVERIFY(index.isValid());
+    QCOMPARE(model.rowCount(), 120);
+    QVERIFY(index.data(RankingModel::CurrentUserRole).toBool());
+    QCOMPARE(index.data(RankingModel::PositionRole).toInt(), 111);
+
+    QCOMPARE(model.indexOf("JUGADOR7"), 7);
+    QCOMPARE(model.indexOf("jugador11"), 11);
+    QCOMPARE(model.indexOf("zzz"), -1);
+    QCOMPARE(model.indexOf(""), -1);
+}
+
+void TestRankingModel::test_same_players_do_not_reset()
+{
+    RankingModel model("nadie");
+    model.setPlayers(jugadores(10), "elo");
+
+    QSignalSpy reset(&model, &QAbstractItemModel::modelReset);
+    model.setPlayers(jugadores(10), "elo");
+    QCOMPARE(reset.count(), 0);
+
+    model.setPlayers(jugadores(11), "elo");
+    QCOMPARE(reset.count(), 1);
+}
@@ -0,0 +1,16 @@
+#ifndef TEST_RANKINGMODEL_H
+#define TEST_RANKINGMODEL_H
+
+#include <QObject>
+
+class TestRankingModel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_rows_are_revealed_by_pages();
+    void test_search_and_reveal();
+    void test_same_players_do_not_reset();
+};
+
+#endif // TEST_RANKINGMODEL_H
@@ -4,7 +4,7 @@
 #include <QLabel>
 #include <QPushButton>
 #include <QCheckBox>
-#include <QListWidget>
+#include <QListView>
 #include <QJsonArray>
 #include <QJsonObject>
 
@@ -54,7 +54,7 @@ void TestRankingWindow::test_basic_widgets_exist()
     QCOMPARE(chk->text(), QStringLiteral("Solo amigos"));
 
     // -- Lista de rankings --
-    QListWidget *list = w.findChild<QListWidget*>();
+    QListView *list = w.findChild<QListView*>();
     QVERIFY(list);
     QVERIFY(list->model());
 }
@@ -87,12 +87,12 @@ void TestRankingWindow::test_update_ranking_list_individual()
     w.updateRankingList(arr, /*type=*/1);
 
     // Verificamos
-    QListWidget *list = w.findChild<QListWidget*>();
-    QCOMPARE(list->count(), 2);
-    QVERIFY(list->item(0)->text().contains("Alice"));
-    QVERIFY(list->item(0)->text().contains("1500"));
-    QVERIFY(list->item(1)->text().contains("Bob"));
-    QVERIFY(list->item(1)->text().contains("1400"));
+    QListView *list = w.findChild<QListView*>();
+    QCOMPARE(list->model()->rowCount(), 2);
+    QVERIFY(list->model()->index(0, 0).data().toString().contains("Alice"));
+    QVERIFY(list->model()->index(0, 0).data().toString().contains("1500"));
+    QVERIFY(list->model()->index(1, 0).data().toString().contains("Bob"));
+    QVERIFY(list->model()->index(1, 0).data().toString().contains("1400"));
 }
 
 void TestRankingWindow::test_update_ranking_list_parejas()
@@ -109,10 +109,29 @@ void TestRankingWindow::test_update_ranking_list_parejas()
     w.updateRankingList(arr, /*type=*/2);
 
     // Verificamos
-    QListWidget *list = w.findChild<QListWidget*>();
-    QCOMPARE(list->count(), 2);
-    QVERIFY(list->item(0)->text().contains("Carol"));
-    QVERIFY(list->item(0)->text().contains("1300"));
-    QVERIFY(list->item(1)->text().contains("Dave"));
-    QVERIFY(list->item(1)->text().contains("1200"));
+    QListView *list = w.findChild<QListView*>();
+    QCOMPARE(list->model()->rowCount(), 2);
+    QVERIFY(list->model()->index(0, 0).data().toString().contains("Carol"));
+    QVERIFY(list->model()->index(0, 0).data().toString().contains("1300"));
+    QVERIFY(list->model()->index(1, 0).data().toString().contains("Dave"));
+    QVERIFY(list->model()->index(1, 0).data().toString().contains("1200"));
+}
+
+void TestRankingWindow::test_switching_ranking_uses_cached_list()
+{
+    RankingWindow w(kUserKey, nullptr);
+
+    QJsonArray ind;
+    QJsonObject p1; p1["nombre"] = "Alice"; p1["elo"] = 1500; ind.append(p1);
+    w.updateRankingList(ind, /*type=*/1);
+
+    QJsonArray par;
+    QJsonObject p2; p2["nombre"] = "Carol"; p2["elo_parejas"] = 1300; par.append(p2);
+    w.updateRankingList(par, /*type=*/2);
+
+    // Volver a "Individual" pinta la lista recordada sin esperar al servidor
+    w.fetchIndividualRanking();
+    QListView *list = w.findChild<QListView*>();
+    QCOMPARE(list->model()->rowCount(), 1);
+    QVERIFY(list->model()->index(0, 0).data().toString().contains("Alice"));
 }
@@ -14,6 +14,7 @@ private slots:
     void test_close_button_closes();
     void test_update_ranking_list_individual();
     void test_update_ranking_list_parejas();
+    void test_switching_ranking_uses_cached_list();
 };
 
 #endif // TEST_RANKINGWINDOW_H
@@ -0,0 +1,104 @@
+#include "test_rejoinmonitor.h"
+
+#include <QtTest/QtTest>
+#include <QSignalSpy>
+#include <QTimer>
+
+// ------------------------------------------------------------------
+// Igual que en test_httpcache: acceso a los miembros privados
+// ------------------------------------------------------------------
+#define private public
+#include "rejoinmonitor.h"
+#include "roomwatcher.h"
+#undef private
+// ------------------------------------------------------------------
+
+// Simula el final de una ronda de consultas (dos endpoints)
+static void finishRound(RejoinMonitor &monitor, bool changed)
+{
+    RoomWatcher *watcher = monitor.watcher;
+    watcher->running = true;
+    watcher->pending = 2;
+    watcher->roundChanged = false;
+    watcher->onFetchDone(changed);
+    watcher->onFetchDone(false);
+}
+
+void TestRejoinMonitor::test_backoff_doubles_while_unchanged()
+{
+    RejoinMonitor monitor(QString());
+    RoomWatcher *watcher = monitor.watcher;
+    QCOMPARE(watcher->pollInterval, RejoinMonitor::kMinPollMs);
+
+    finishRound(monitor, false);
+    QCOMPARE(watcher->pollInterval, RejoinMonitor::kMinPollMs * 2);
+    finishRound(monitor, false);
+    QCOMPARE(watcher->pollInterval, RejoinMonitor::kMinPollMs * 4);
+
+    for (int i = 0; i < 20; ++i)
+        finishRound(monitor, false);
+    QCOMPARE(watcher->pollInterval, RejoinMonitor::kMaxPollMs);
+    QVERIFY(watcher->pollTimer->isActive());
+}
+
+void TestRejoinMonitor::test_change_resets_interval_and_notifies()
+{
+    RejoinMonitor monitor(QString());
+    QSignalSpy spy(&monitor, &RejoinMonitor::roomsChanged);
+
+    finishRound(monitor, false);
+    finishRound(monitor, false);
+    QCOMPARE(spy.count(), 0);
+
+    finishRound(monitor, true);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(monitor.watcher->pollInterval, RejoinMonitor::kMinPollMs);
+}
+
+void TestRejoinMonitor::test_no_polling_while_push_is_active()
+{
+    RejoinMonitor monitor(QString());
+    monitor.watcher->pushActive = true;
+
+    finishRound(monitor, true);
+    QVERIFY(!monitor.watcher->pollTimer->isActive());
+}
+
+void TestRejoinMonitor::test_push_during_round_repeats_it()
+{
+    RejoinMonitor monitor(QStringLiteral("token"));
+    RoomWatcher *watcher = monitor.watcher;
+    watcher->running = true;
+    watcher->pushActive = true;
+
+    // Llega un aviso mientras la ronda anterior sigue en curso
+    watcher->pending = 2;
+    monitor.refresh();
+    QVERIFY(watcher->refreshAgain);
+    QCOMPARE(watcher->pending, 2);
+
+    // Al cerrar la ronda se lanza otra en lugar de esperar al siguiente aviso
+    watcher->onFetchDone(false);
+    watcher->onFetchDone(false);
+    QVERIFY(!watcher->refreshAgain);
+    QCOMPARE(watcher->pending, 2);
+}
+
+void TestRejoinMonitor::test_failed_reconnect_keeps_backoff()
+{
+    RejoinMonitor monitor(QString());
+    RoomWatcher *watcher = monitor.watcher;
+    finishRound(monitor, false);
+    finishRound(monitor, false);
+    const int interval = watcher->pollInterval;
+
+    // El servidor de avisos sigue caído: el reintento fallido no reinicia el sondeo
+    watcher->onPushDisconnected();
+    QCOMPARE(watcher->pollInterval, interval);
+
+    // Perder un canal activo sí vuelve al mínimo
+    watcher->pushActive = true;
+    watcher->onPushDisconnected();
+    QCOMPARE(watcher->pollInterval, RejoinMonitor::kMinPollMs);
+    QVERIFY(watcher->pollTimer->isActive());
+}
@@ -0,0 +1,18 @@
+#ifndef TEST_REJOINMONITOR_H
+#define TEST_REJOINMONITOR_H
+
+#include <QObject>
+
+class TestRejoinMonitor : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_backoff_doubles_while_unchanged();
+    void test_change_resets_interval_and_notifies();
+    void test_no_polling_while_push_is_active();
+    void test_push_during_round_repeats_it();
+    void test_failed_reconnect_keeps_backoff();
+};
+
+#endif // TEST_REJOINMONITOR_H
@@ -0,0 +1,51 @@
+#include "test_roomcarddelegate.h"
+
+#include <QtTest/QtTest>
+#include <QSignalSpy>
+#include <QListView>
+#include <QMouseEvent>
+
+#include "roomcarddelegate.h"
+#include "userlistmodel.h"
+
+static QJsonObject sala(int id, const QString &nombre, int jugadores, int capacidad)
+{
+    return QJsonObject{{"id", id}, {"nombre", nombre},
+                       {"num_jugadores", jugadores}, {"capacidad", capacidad}};
+}
+
+void TestRoomCardDelegate::test_texts()
+{
+    QJsonObject s = sala(7, "Mesa", 1, 4);
+    QCOMPARE(RoomCardDelegate::titleText(s), QString("Mesa  —  1/4"));
+    QVERIFY(RoomCardDelegate::detailsText(s).isEmpty());
+
+    s["personalizacion"] = QJsonObject{{"tiempo_turno", 30}, {"reglas_arrastre", true},
+                                       {"permitir_revueltas", false}, {"solo_amigos", true}};
+    QCOMPARE(RoomCardDelegate::detailsText(s),
+             QString("Tiempo Turno: 30s, Reglas Arrastre: Sí, Revueltas: No, Solo Amigos: Sí"));
+}
+
+void TestRoomCardDelegate::test_join_uses_row_capacity()
+{
+    // Cada fila debe unirse con su propia capacidad, no con la de la última sala recibida
+    QListView view;
+    view.resize(800, 400);
+    UserListModel model;
+    model.setItems({sala(1, "Duelo", 1, 2), sala(2, "Parejas", 3, 4)});
+    view.setModel(&model);
+    auto *delegate = new RoomCardDelegate(&view);
+    view.setItemDelegate(delegate);
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    QSignalSpy spy(delegate, &RoomCardDelegate::joinRequested);
+
+    QRect row = view.visualRect(model.index(0));
+    QPoint button(row.right() - 10 - 45, row.center().y());
+    QTest::mouseClick(view.viewport(), Qt::LeftButton, Qt::NoModifier, button);
+
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.at(0).at(0).toString(), QString("1"));
+    QCOMPARE(spy.at(0).at(1).toInt(), 2);
+}
@@ -0,0 +1,15 @@
+#ifndef TEST_ROOMCARDDELEGATE_H
+#define TEST_ROOMCARDDELEGATE_H
+
+#include <QObject>
+
+class TestRoomCardDelegate : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_texts();
+    void test_join_uses_row_capacity();
+};
+
+#endif // TEST_ROOMCARDDELEGATE_H
@@ -0,0 +1,62 @@
+#include "test_roomwatcher.h"
+
+#include <QtTest/QtTest>
+#include <QSignalSpy>
+#include <QTimer>
+#include <QJsonObject>
+
+// ------------------------------------------------------------------
+// Igual que en test_httpcache: acceso a los miembros privados
+// ------------------------------------------------------------------
+#define private public
+#include "roomwatcher.h"
+#undef private
+// ------------------------------------------------------------------
+
+void TestRoomWatcher::test_change_notifies_and_resets_backoff()
+{
+    RoomWatcher watcher(QString(), {"/salas/disponibles/"}, "[TEST]", 1000, 8000);
+    QSignalSpy spy(&watcher, &RoomWatcher::changed);
+    watcher.running = true;
+
+    watcher.pending = 1;
+    watcher.onFetchDone(true);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(watcher.pollInterval, 1000);
+
+    watcher.pending = 1;
+    watcher.onFetchDone(false);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(watcher.pollInterval, 2000);
+}
+
+void TestRoomWatcher::test_set_path_resets_list()
+{
+    RoomWatcher watcher(QString(), {"/salas/disponibles/"}, "[TEST]", 1000, 8000);
+    watcher.endpoints[0].etag = "\"v1\"";
+    watcher.endpoints[0].salas = QJsonArray{QJsonObject{{"id", 1}}};
+    watcher.endpoints[0].delivered = true;
+
+    watcher.setPath(0, "/salas/disponibles/amigos/");
+    QCOMPARE(watcher.endpoints[0].path, QString("/salas/disponibles/amigos/"));
+    QVERIFY(watcher.endpoints[0].etag.isEmpty());
+    QVERIFY(watcher.salas(0).isEmpty());
+    QVERIFY(!watcher.endpoints[0].delivered);
+}
+
+void TestRoomWatcher::test_stop_disables_polling()
+{
+    RoomWatcher watcher(QStringLiteral("token"), {"/a/", "/b/"}, "[TEST]", 1000, 8000);
+    watcher.running = true;
+
+    watcher.pending = 2;
+    watcher.refresh();
+    QVERIFY(watcher.refreshAgain);
+
+    watcher.stop();
+    QVERIFY(!watcher.refreshAgain);
+    watcher.onFetchDone(false);
+    watcher.onFetchDone(false);
+    QVERIFY(!watcher.pollTimer->isActive());
+    QCOMPARE(watcher.pending, 0);
+}
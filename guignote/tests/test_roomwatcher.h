@@ -0,0 +1,16 @@
+#ifndef TEST_ROOMWATCHER_H
+#define TEST_ROOMWATCHER_H
+
+#include <QObject>
+
+class TestRoomWatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_change_notifies_and_resets_backoff();
+    void test_set_path_resets_list();
+    void test_stop_disables_polling();
+};
+
+#endif // TEST_ROOMWATCHER_H
@@ -0,0 +1,48 @@
+#include "test_scorelabel.h"
+
+#include <QtTest/QtTest>
+#include <QElapsedTimer>
+#include "scorelabel.h"
+
+void TestScoreLabel::test_score_is_updated_immediately()
+{
+    ScoreLabel label;
+    label.animateTo(5);
+
+    QCOMPARE(label.score(), 5);          // el valor real no espera al recuento
+    QVERIFY(label.isAnimating());
+    QTRY_COMPARE(label.displayed(), 5);
+    QCOMPARE(label.text(), QString("5"));
+}
+
+void TestScoreLabel::test_large_delta_is_bounded_by_max_duration()
+{
+    ScoreLabel label;
+    label.setMaxDuration(200);
+
+    QElapsedTimer clock;
+    clock.start();
+    label.animateTo(30);                 // a 1 punto / 100 ms serían 3 s
+    QTRY_VERIFY_WITH_TIMEOUT(!label.isAnimating(), 1000);
+
+    QVERIFY(clock.elapsed() < 1000);
+    QCOMPARE(label.displayed(), 30);
+
+    // Sin animación: el número cambia al momento
+    label.setMaxDuration(0);
+    label.animateTo(42);
+    QCOMPARE(label.displayed(), 42);
+}
+
+void TestScoreLabel::test_set_score_keeps_running_animation_to_same_value()
+{
+    ScoreLabel label;
+    label.animateTo(20);
+    label.setScore(20);                  // redibujado durante el recuento
+    QVERIFY(label.isAnimating());
+
+    label.setScore(7);                   // otro valor: se muestra sin animar
+    QVERIFY(!label.isAnimating());
+    QCOMPARE(label.displayed(), 7);
+    QCOMPARE(label.score(), 7);
+}
@@ -0,0 +1,16 @@
+#ifndef TEST_SCORELABEL_H
+#define TEST_SCORELABEL_H
+
+#include <QObject>
+
+class TestScoreLabel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_score_is_updated_immediately();
+    void test_large_delta_is_bounded_by_max_duration();
+    void test_set_score_keeps_running_animation_to_same_value();
+};
+
+#endif // TEST_SCORELABEL_H
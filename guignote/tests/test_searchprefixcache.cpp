@@ -0,0 +1,50 @@
+#include "test_searchprefixcache.h"
+
+#include <QtTest/QtTest>
+
+#include "searchprefixcache.h"
+
+static QJsonObject usuario(int id, const QString &nombre)
+{
+    return QJsonObject{{"id", id}, {"nombre", nombre}};
+}
+
+void TestSearchPrefixCache::test_refinement_is_filtered_locally()
+{
+    SearchPrefixCache cache;
+    cache.insert("ana", {usuario(1, "Ana"), usuario(2, "Anabel"), usuario(3, "Mariana")});
+
+    QList<QJsonObject> results;
+    QVERIFY(cache.lookup("ANAB", &results));
+    QCOMPARE(results.size(), 1);
+    QCOMPARE(results[0]["nombre"].toString(), QString("Anabel"));
+
+    QVERIFY(cache.lookup(" ana ", &results));
+    QCOMPARE(results.size(), 3);
+}
+
+void TestSearchPrefixCache::test_unrelated_query_misses()
+{
+    SearchPrefixCache cache;
+    cache.insert("ana", {usuario(1, "Ana")});
+
+    QList<QJsonObject> results;
+    QVERIFY(!cache.lookup("an", &results));
+    QVERIFY(!cache.lookup("luis", &results));
+
+    cache.clear();
+    QVERIFY(!cache.lookup("ana", &results));
+}
+
+void TestSearchPrefixCache::test_oldest_entry_is_evicted()
+{
+    SearchPrefixCache cache(60, 2);
+    cache.insert("a", {usuario(1, "Ana")});
+    cache.insert("l", {usuario(2, "Luis")});
+    cache.insert("p", {usuario(3, "Pepe")});
+
+    QList<QJsonObject> results;
+    QVERIFY(!cache.lookup("a", &results));
+    QVERIFY(cache.lookup("lu", &results));
+    QVERIFY(cache.lookup("p", &results));
+}
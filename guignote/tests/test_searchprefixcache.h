@@ -0,0 +1,16 @@
+#ifndef TEST_SEARCHPREFIXCACHE_H
+#define TEST_SEARCHPREFIXCACHE_H
+
+#include <QObject>
+
+class TestSearchPrefixCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_refinement_is_filtered_locally();
+    void test_unrelated_query_misses();
+    void test_oldest_entry_is_evicted();
+};
+
+#endif // TEST_SEARCHPREFIXCACHE_H
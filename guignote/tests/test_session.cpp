@@ -0,0 +1,83 @@
+#include "test_session.h"
+
+#include <QtTest/QtTest>
+#include <QSignalSpy>
+#include <QSettings>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "session.h"
+
+static const QString kUserKey = QStringLiteral("testsession");
+
+// JWT sin firma válida: al cliente solo le interesa el payload
+static QString makeToken(const QJsonObject &payload)
+{
+    const auto opts = QByteArray::Base64UrlEncoding | QByteArray::OmitTrailingEquals;
+    QByteArray header = QByteArray("{\"alg\":\"HS256\"}").toBase64(opts);
+    QByteArray body = QJsonDocument(payload).toJson(QJsonDocument::Compact).toBase64(opts);
+    return QString::fromLatin1(header + "." + body + ".firma");
+}
+
+void TestSession::cleanupTestCase()
+{
+    Session::forUser(kUserKey).clear();
+    Session::forUser(kUserKey).flush();
+}
+
+void TestSession::test_decode_claims()
+{
+    const qint64 exp = QDateTime::currentSecsSinceEpoch() + 3600;
+    Session::Claims claims = Session::decode(makeToken({{"user_id", 42}, {"exp", exp}}));
+    QCOMPARE(claims.userId, QString("42"));
+    QCOMPARE(claims.expiresAt.toSecsSinceEpoch(), exp);
+
+    QVERIFY(Session::decode("no-es-un-jwt").userId.isEmpty());
+    QVERIFY(!Session::decode("no-es-un-jwt").expiresAt.isValid());
+}
+
+void TestSession::test_token_is_persisted_in_background()
+{
+    Session &session = Session::forUser(kUserKey);
+    const QString token = makeToken({{"id", 7}, {"exp", QDateTime::currentSecsSinceEpoch() + 3600}});
+    session.setToken(token);
+
+    // En memoria al instante...
+    QCOMPARE(session.token(), token);
+    QCOMPARE(session.userId(), QString("7"));
+    QVERIFY(!session.isExpired());
+
+    // ...y en disco cuando termina la escritura diferida
+    session.flush();
+    QSettings settings("Grace Hopper", QString("Sota, Caballo y Rey_%1").arg(kUserKey));
+    QCOMPARE(settings.value("auth/token").toString(), token);
+}
+
+void TestSession::test_expired_is_emitted_before_expiry()
+{
+    Session &session = Session::forUser(kUserKey);
+    QSignalSpy spy(&session, &Session::expired);
+
+    // Caduca dentro del margen: se avisa sin esperar a un 401
+    session.setToken(makeToken({{"id", 7}, {"exp", QDateTime::currentSecsSinceEpoch() + 10}}));
+    QVERIFY(session.isExpired());
+    QTRY_COMPARE(spy.count(), 1);
+}
+
+void TestSession::test_profile_change_is_notified()
+{
+    Session &session = Session::forUser(kUserKey);
+    QSignalSpy changed(&session, &Session::profileChanged);
+
+    const QJsonObject perfil{{"nombre", "prueba"}, {"elo", 1500}};
+    session.setProfile(perfil);
+    QCOMPARE(changed.count(), 1);
+    QCOMPARE(session.profile(), perfil);
+
+    // El mismo perfil (p. ej. la revalidación sin cambios) no repinta nada
+    session.setProfile(perfil);
+    QCOMPARE(changed.count(), 1);
+
+    session.setProfile(QJsonObject{{"nombre", "prueba"}, {"elo", 1520}});
+    QCOMPARE(changed.count(), 2);
+}
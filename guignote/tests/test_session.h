@@ -0,0 +1,18 @@
+#ifndef TEST_SESSION_H
+#define TEST_SESSION_H
+
+#include <QObject>
+
+class TestSession : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void cleanupTestCase();
+    void test_decode_claims();
+    void test_token_is_persisted_in_background();
+    void test_expired_is_emitted_before_expiry();
+    void test_profile_change_is_notified();
+};
+
+#endif // TEST_SESSION_H
@@ -0,0 +1,49 @@
+#include "test_startuporchestrator.h"
+
+#include <QtTest/QtTest>
+#include <QSignalSpy>
+
+// ------------------------------------------------------------------
+// Igual que en test_httpcache: acceso a los miembros privados
+// ------------------------------------------------------------------
+#define private public
+#include "startuporchestrator.h"
+#undef private
+// ------------------------------------------------------------------
+
+void TestStartupOrchestrator::test_finished_after_last_stage()
+{
+    StartupOrchestrator orch("testuser");
+    QSignalSpy finished(&orch, &StartupOrchestrator::finished);
+    QSignalSpy stages(&orch, &StartupOrchestrator::stageFinished);
+
+    orch.loggedIn = true;
+    orch.beginStage("estadisticas");
+    orch.beginStage("recursos");
+
+    orch.endStage("estadisticas");
+    QCOMPARE(finished.count(), 0);
+    QVERIFY(!orch.isFinished());
+
+    orch.endStage("recursos");
+    QCOMPARE(finished.count(), 1);
+    QCOMPARE(stages.count(), 2);
+    QVERIFY(orch.isFinished());
+    QVERIFY(orch.timings().contains("estadisticas"));
+    QVERIFY(orch.timings().contains("recursos"));
+
+    // Terminar una etapa desconocida o repetida no vuelve a emitir
+    orch.endStage("recursos");
+    QCOMPARE(finished.count(), 1);
+    QCOMPARE(stages.count(), 2);
+}
+
+void TestStartupOrchestrator::test_not_finished_without_login()
+{
+    StartupOrchestrator orch("testuser");
+    QSignalSpy finished(&orch, &StartupOrchestrator::finished);
+
+    orch.beginStage("recursos");
+    orch.endStage("recursos");
+    QCOMPARE(finished.count(), 0);
+}
@@ -0,0 +1,15 @@
+#ifndef TEST_STARTUPORCHESTRATOR_H
+#define TEST_STARTUPORCHESTRATOR_H
+
+#include <QObject>
+
+class TestStartupOrchestrator : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_finished_after_last_stage();
+    void test_not_finished_without_login();
+};
+
+#endif // TEST_STARTUPORCHESTRATOR_H
@@ -0,0 +1,140 @@
+#include "test_theme.h"
+
+#include <QtTest/QtTest>
+#include <QApplication>
+#include <QLabel>
+#include <QLineEdit>
+#include <QListView>
+#include <QPushButton>
+#include <memory>
+#include "theme.h"
+
+namespace {
+const char *kPanelInline   = "background-color: #171718; border-radius: 30px; padding: 20px;";
+const char *kTitleInline   = "color: white; font-size: 28px; font-weight: bold;";
+const char *kCloseInline   = "QPushButton { background-color: #c2c2c3; border: none; border-radius: 17px; }"
+                             "QPushButton:hover { background-color: #9b9b9b; }";
+const char *kChatInline    = "background-color: #292A2D; color: white; font-size: 16px; padding: 10px; "
+                             "border-radius: 10px; border: 1px solid #444;";
+const char *kSendInline    = "QPushButton { background-color: #1D4536; color: #F9F9F4; font-size: 16px;"
+                             "padding: 8px 15px; border-radius: 10px; }"
+                             "QPushButton:hover { background-color: #2A5C45; }";
+const char *kNameInline    = "QLabel { color: white; font-size: 16px; background-color: rgba(0, 0, 0, 128);"
+                             " border-radius: 4px; padding: 2px 6px; }";
+
+/// Panel de chat como lo montan FriendsMessageWindow y GameMessageWindow.
+QWidget *chatPanel(bool themed)
+{
+    auto *panel = new QWidget;
+    themed ? Theme::setRole(panel, "panel") : panel->setStyleSheet(kPanelInline);
+
+    auto *title = new QLabel("Chat", panel);
+    title->setObjectName("title");
+    themed ? Theme::setRole(title, "title") : title->setStyleSheet(kTitleInline);
+
+    auto *close = new QPushButton(panel);
+    close->setObjectName("close");
+    themed ? Theme::setRole(close, "close") : close->setStyleSheet(kCloseInline);
+
+    auto *view = new QListView(panel);
+    view->setObjectName("view");
+    themed ? Theme::setRole(view, "chatView") : view->setStyleSheet(kChatInline);
+
+    auto *input = new QLineEdit(panel);
+    input->setObjectName("input");
+    themed ? Theme::setRole(input, "chatInput") : input->setStyleSheet(kChatInline);
+
+    auto *send = new QPushButton("Enviar", panel);
+    send->setObjectName("send");
+    themed ? Theme::setRole(send, "send") : send->setStyleSheet(kSendInline);
+
+    auto *plain = new QLabel("sin rol", panel);
+    plain->setObjectName("plain");
+    return panel;
+}
+
+/// Etiquetas de nombre de una mesa de cuatro jugadores, repetida varias veces.
+void playerNames(bool themed)
+{
+    QWidget mesa;
+    for (int i = 0; i < 40; ++i) {
+        auto *label = new QLabel(QString("Jugador %1").arg(i), &mesa);
+        themed ? Theme::setRole(label, "playerName") : label->setStyleSheet(kNameInline);
+        label->adjustSize();
+    }
+}
+}
+
+void TestTheme::initTestCase()
+{
+    previousStyleSheet = qApp->styleSheet();
+    Theme::apply();
+}
+
+void TestTheme::cleanupTestCase()
+{
+    qApp->setStyleSheet(previousStyleSheet);
+}
+
+void TestTheme::test_roles_match_inline_styles()
+{
+    std::unique_ptr<QWidget> inlinePanel(chatPanel(false));
+    std::unique_ptr<QWidget> themedPanel(chatPanel(true));
+    inlinePanel->ensurePolished();
+    themedPanel->ensurePolished();
+
+    const QStringList names = {"title", "close", "view", "input", "send", "plain"};
+    for (const QString &name : names) {
+        auto *a = inlinePanel->findChild<QWidget *>(name);
+        auto *b = themedPanel->findChild<QWidget *>(name);
+        QVERIFY2(a && b, qPrintable(name));
+        QCOMPARE(b->font().pixelSize(), a->font().pixelSize());
+        QCOMPARE(b->font().bold(), a->font().bold());
+        QCOMPARE(b->palette().color(QPalette::WindowText), a->palette().color(QPalette::WindowText));
+        QCOMPARE(b->palette().color(QPalette::Window), a->palette().color(QPalette::Window));
+        QCOMPARE(b->palette().color(QPalette::Button), a->palette().color(QPalette::Button));
+        QCOMPARE(b->contentsRect(), a->contentsRect());
+    }
+
+    auto *title = themedPanel->findChild<QLabel *>("title");
+    QCOMPARE(title->font().pixelSize(), 28);
+    QCOMPARE(title->palette().color(QPalette::WindowText), QColor(Qt::white));
+}
+
+void TestTheme::test_set_role_repolishes_visible_widget()
+{
+    QLabel label("12");
+    label.ensurePolished();
+    const int before = label.font().pixelSize();
+
+    Theme::setRole(&label, "scoreValue");
+    QCOMPARE(label.font().pixelSize(), 64);
+    QVERIFY(label.font().pixelSize() != before);
+    QCOMPARE(label.property(Theme::kRoleProperty).toString(), QString("scoreValue"));
+}
+
+void TestTheme::benchmark_player_names_inline()
+{
+    QBENCHMARK { playerNames(false); }
+}
+
+void TestTheme::benchmark_player_names_theme()
+{
+    QBENCHMARK { playerNames(true); }
+}
+
+void TestTheme::benchmark_chat_panel_inline()
+{
+    QBENCHMARK {
+        std::unique_ptr<QWidget> panel(chatPanel(false));
+        panel->ensurePolished();
+    }
+}
+
+void TestTheme::benchmark_chat_panel_theme()
+{
+    QBENCHMARK {
+        std::unique_ptr<QWidget> panel(chatPanel(true));
+        panel->ensurePolished();
+    }
+}
@@ -0,0 +1,28 @@
+#ifndef TEST_THEME_H
+#define TEST_THEME_H
+
+#include <QObject>
+#include <QString>
+
+class TestTheme : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void test_roles_match_inline_styles();
+    void test_set_role_repolishes_visible_widget();
+
+    // Coste de crear y pulir widgets: hoja propia frente a rol
+    void benchmark_player_names_inline();
+    void benchmark_player_names_theme();
+    void benchmark_chat_panel_inline();
+    void benchmark_chat_panel_theme();
+
+private:
+    QString previousStyleSheet;
+};
+
+#endif // TEST_THEME_H
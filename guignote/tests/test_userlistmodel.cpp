@@ -0,0 +1,53 @@
+#include "test_userlistmodel.h"
+
+#include <QtTest/QtTest>
+#include <QSignalSpy>
+
+#include "userlistmodel.h"
+
+static QJsonObject amigo(int id, const QString &nombre, int victorias = 0)
+{
+    return QJsonObject{{"id", id}, {"nombre", nombre}, {"victorias", victorias}};
+}
+
+void TestUserListModel::test_unchanged_payload_emits_nothing()
+{
+    UserListModel model;
+    model.setItems({amigo(1, "ana"), amigo(2, "luis")});
+
+    QSignalSpy inserted(&model, &QAbstractItemModel::rowsInserted);
+    QSignalSpy removed(&model, &QAbstractItemModel::rowsRemoved);
+    QSignalSpy changed(&model, &QAbstractItemModel::dataChanged);
+    QSignalSpy reset(&model, &QAbstractItemModel::modelReset);
+
+    model.setItems({amigo(1, "ana"), amigo(2, "luis")});
+    QCOMPARE(inserted.count(), 0);
+    QCOMPARE(removed.count(), 0);
+    QCOMPARE(changed.count(), 0);
+    QCOMPARE(reset.count(), 0);
+}
+
+void TestUserListModel::test_diff_applies_only_changes()
+{
+    UserListModel model;
+    model.setItems({amigo(1, "ana"), amigo(2, "luis"), amigo(3, "eva")});
+
+    QSignalSpy inserted(&model, &QAbstractItemModel::rowsInserted);
+    QSignalSpy removed(&model, &QAbstractItemModel::rowsRemoved);
+    QSignalSpy moved(&model, &QAbstractItemModel::rowsMoved);
+    QSignalSpy changed(&model, &QAbstractItemModel::dataChanged);
+
+    // Se va "luis", llega "pepe", "eva" sube y "ana" cambia sus estadísticas
+    model.setItems({amigo(3, "eva"), amigo(1, "ana", 5), amigo(4, "pepe")});
+
+    QCOMPARE(removed.count(), 1);
+    QCOMPARE(inserted.count(), 1);
+    QCOMPARE(moved.count(), 1);
+    QCOMPARE(changed.count(), 1);
+
+    QCOMPARE(model.rowCount(), 3);
+    QCOMPARE(model.index(0).data(UserListModel::KeyRole).toString(), QString("3"));
+    QCOMPARE(model.index(1).data(Qt::DisplayRole).toString(), QString("ana"));
+    QCOMPARE(model.payload(1)["victorias"].toInt(), 5);
+    QCOMPARE(model.index(2).data(Qt::DisplayRole).toString(), QString("pepe"));
+}
@@ -0,0 +1,15 @@
+#ifndef TEST_USERLISTMODEL_H
+#define TEST_USERLISTMODEL_H
+
+#include <QObject>
+
+class TestUserListModel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_unchanged_payload_emits_nothing();
+    void test_diff_applies_only_changes();
+};
+
+#endif // TEST_USERLISTMODEL_H
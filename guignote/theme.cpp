@@ -0,0 +1,162 @@
+/**
+ * @file theme.cpp
+ * @brief Implementación de la clase Theme.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * Contiene la hoja de estilo común. Los valores son los mismos que antes se
+ * repetían en cada setStyleSheet(); solo cambia el selector.
+ */
+
+#include "theme.h"
+#include <QApplication>
+#include <QStyle>
+#include <QVariant>
+#include <QWidget>
+
+/**
+ * @brief Hoja de estilo global.
+ *
+ * Un setStyleSheet() sin selector sobre un diálogo se aplicaba también a todos
+ * sus hijos; el rol "panel" lo reproduce con el selector de descendientes. Los
+ * roles de los hijos llevan un tipo más en el selector, así que son más
+ * específicos que el del panel y ganan igual que antes ganaba su propia hoja.
+ */
+QString Theme::styleSheet() {
+    return QStringLiteral(R"(
+/* ——— Paneles (amigos, salas, chat) ——— */
+*[role="panel"], *[role="panel"] * {
+    background-color: #171718;
+    border-radius: 30px;
+    padding: 20px;
+}
+QLabel[role="title"] {
+    color: white;
+    font-size: 28px;
+    font-weight: bold;
+}
+QPushButton[role="close"] {
+    background-color: #c2c2c3;
+    border: none;
+    border-radius: 17px;
+}
+QPushButton[role="close"]:hover {
+    background-color: #9b9b9b;
+}
+
+/* ——— Chat ——— */
+QListView[role="chatView"], QListView[role="chatView"] *, QLineEdit[role="chatInput"] {
+    background-color: #292A2D;
+    color: white;
+    font-size: 16px;
+    padding: 10px;
+    border-radius: 10px;
+    border: 1px solid #444;
+}
+QPushButton[role="send"] {
+    background-color: #1D4536;
+    color: #F9F9F4;
+    font-size: 16px;
+    padding: 8px 15px;
+    border-radius: 10px;
+}
+QPushButton[role="send"]:hover {
+    background-color: #2A5C45;
+}
+
+/* ——— Salas ——— */
+QPushButton[role="create"] {
+    background-color: #4CAF50;
+    color: white;
+    border: none;
+    padding: 8px 16px;
+    border-radius: 5px;
+}
+QPushButton[role="create"]:hover {
+    background-color: #45A049;
+}
+QListView[role="plainList"] {
+    background: transparent;
+    border: none;
+    padding: 0px;
+}
+
+/* ——— Mesa ——— */
+QLabel[role="playerName"] {
+    color: white;
+    font-size: 16px;
+    background-color: rgba(0, 0, 0, 128);
+    border-radius: 4px;
+    padding: 2px 6px;
+}
+QLabel[role="timer"] {
+    font-size: 48px;
+    font-weight: bold;
+    color: gold;
+    background-color: rgba(0, 0, 0, 128);
+    border-radius: 12px;
+    padding: 8px 16px;
+}
+QLabel[role="timerCaption"] {
+    font-size: 24px;
+    color: white;
+    background-color: transparent;
+}
+QLabel[role="scoreTitle"] {
+    font-size: 32px;
+    color: white;
+    background-color: transparent;
+    border: none;
+}
+QLabel[role="scoreValue"] {
+    font-size: 64px;
+    font-weight: bold;
+    color: white;
+    background-color: transparent;
+    border: none;
+}
+QLabel[role="turn"] {
+    font-size: 24px;
+    color: white;
+    background-color: rgba(0, 0, 0, 150);
+    padding: 4px 8px;
+    border-radius: 4px;
+}
+QLabel[role="pauseCounter"] {
+    background-color: #1f1f1f;
+    color: white;
+    border-radius: 34px;
+    font-size: 24px;
+    border: 2px solid #666;
+}
+QLabel[role="errorPopup"] {
+    background: rgba(50, 50, 50, 220);
+    color: white;
+    font-size: 18px;
+    padding: 6px 12px;
+    border-radius: 6px;
+    border: 1px solid #888;
+}
+)");
+}
+
+/**
+ * @brief Instala la hoja de estilo en la aplicación.
+ */
+void Theme::apply() {
+    qApp->setStyleSheet(styleSheet());
+}
+
+/**
+ * @brief Asigna un rol; solo se vuelve a pulir si el widget ya lo estaba.
+ */
+void Theme::setRole(QWidget *widget, const char *role) {
+    if (!widget)
+        return;
+    widget->setProperty(kRoleProperty, QString::fromLatin1(role));
+    if (widget->testAttribute(Qt::WA_WState_Polished)) {
+        widget->style()->unpolish(widget);
+        widget->style()->polish(widget);
+    }
+}
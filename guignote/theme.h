@@ -0,0 +1,55 @@
+/**
+ * @file theme.h
+ * @brief Declaración de la clase Theme, hoja de estilo común de la aplicación.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * Los estilos que se repiten en muchas ventanas (paneles oscuros, títulos,
+ * botón de cerrar, chat, etiquetas de la mesa) viven en una sola hoja de estilo
+ * que se instala en la aplicación al arrancar. Cada widget indica qué aspecto
+ * quiere con la propiedad dinámica "role" en lugar de llamar a setStyleSheet():
+ * Qt analiza la hoja una vez, y crear y pulir el widget es mucho más barato.
+ */
+
+#ifndef THEME_H
+#define THEME_H
+
+#include <QString>
+
+class QWidget;
+
+/**
+ * @class Theme
+ * @brief Hoja de estilo global y roles de los widgets.
+ *
+ * Roles disponibles:
+ * - Paneles: "panel" (diálogo oscuro; se hereda en todos sus hijos, igual que
+ *   la antigua hoja sin selector), "title", "close".
+ * - Chat y salas: "chatView", "chatInput", "send", "create", "plainList".
+ * - Mesa: "playerName", "timer", "timerCaption", "scoreTitle", "scoreValue",
+ *   "turn", "pauseCounter", "errorPopup".
+ */
+class Theme {
+public:
+    /** @brief Nombre de la propiedad dinámica que selecciona el estilo. */
+    static constexpr const char *kRoleProperty = "role";
+
+    /** @brief Hoja de estilo completa de la aplicación. */
+    static QString styleSheet();
+
+    /** @brief Instala la hoja de estilo en la aplicación (una vez, al arrancar). */
+    static void apply();
+
+    /**
+     * @brief Asigna un rol a un widget.
+     * @param widget Widget destino.
+     * @param role Nombre del rol.
+     *
+     * Si el widget ya estaba pulido (visible), se vuelve a pulir para que el
+     * cambio se note; antes de mostrarse basta con fijar la propiedad.
+     */
+    static void setRole(QWidget *widget, const char *role);
+};
+
+#endif // THEME_H
@@ -0,0 +1,145 @@
+/**
+ * @file userlistmodel.cpp
+ * @brief Implementación de la clase UserListModel.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ */
+
+#include "userlistmodel.h"
+#include <QSet>
+
+/**
+ * @brief Constructor de UserListModel.
+ * @param parent Objeto padre.
+ */
+UserListModel::UserListModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+/**
+ * @brief Id de un objeto; el servidor usa "id" o "ID" según el endpoint.
+ */
+QString UserListModel::keyFor(const QJsonObject &item) {
+    if (item.contains("id"))
+        return QString::number(item["id"].toInt());
+    if (item.contains("ID"))
+        return QString::number(item["ID"].toInt());
+    return QString();
+}
+
+/**
+ * @brief Nombre a mostrar, probando los campos que usa cada endpoint.
+ */
+QString UserListModel::displayName(const QJsonObject &item) {
+    if (item.contains("nombre"))
+        return item["nombre"].toString();
+    if (item.contains("Nombre"))
+        return item["Nombre"].toString();
+    if (item.contains("username"))
+        return item["username"].toString();
+    if (item.contains("solicitante"))
+        return item["solicitante"].toString();
+    return "Nombre no disponible";
+}
+
+/**
+ * @brief Número de filas.
+ */
+int UserListModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : rows.size();
+}
+
+/**
+ * @brief Datos de una fila según el rol pedido.
+ */
+QVariant UserListModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= rows.size())
+        return QVariant();
+
+    const Row &r = rows.at(index.row());
+    switch (role) {
+    case Qt::DisplayRole: return displayName(r.payload);
+    case KeyRole:         return r.key;
+    case PayloadRole:     return r.payload;
+    default:              return QVariant();
+    }
+}
+
+/**
+ * @brief Objeto JSON de una fila.
+ */
+QJsonObject UserListModel::payload(int row) const {
+    return (row >= 0 && row < rows.size()) ? rows.at(row).payload : QJsonObject();
+}
+
+/**
+ * @brief Posición de una clave a partir de una fila dada, o -1.
+ */
+int UserListModel::findRow(const QString &key, int from) const {
+    for (int i = from; i < rows.size(); ++i)
+        if (rows.at(i).key == key)
+            return i;
+    return -1;
+}
+
+/**
+ * @brief Aplica la nueva lista como diff por clave.
+ *
+ * 1) Se eliminan las filas cuya clave ya no aparece.
+ * 2) Se recorre la lista nueva: las filas en su sitio solo se actualizan si
+ *    cambian, las que están más abajo se mueven y las desconocidas se insertan.
+ */
+void UserListModel::setItems(const QList<QJsonObject> &items) {
+    QList<Row> next;
+    QSet<QString> keys;
+    for (const QJsonObject &item : items) {
+        Row r{keyFor(item), item};
+        if (r.key.isEmpty())
+            r.key = displayName(item);
+        if (keys.contains(r.key)) continue;
+        keys.insert(r.key);
+        next.append(r);
+    }
+
+    // 1) Eliminaciones
+    for (int i = rows.size() - 1; i >= 0; --i) {
+        if (keys.contains(rows.at(i).key)) continue;
+        beginRemoveRows(QModelIndex(), i, i);
+        rows.removeAt(i);
+        endRemoveRows();
+    }
+
+    // 2) Cambios, movimientos e inserciones
+    for (int i = 0; i < next.size(); ++i) {
+        const Row &wanted = next.at(i);
+        if (i >= rows.size() || rows.at(i).key != wanted.key) {
+            int j = findRow(wanted.key, i + 1);
+            if (j < 0) {
+                beginInsertRows(QModelIndex(), i, i);
+                rows.insert(i, wanted);
+                endInsertRows();
+                continue;
+            }
+            beginMoveRows(QModelIndex(), j, j, QModelIndex(), i);
+            rows.move(j, i);
+            endMoveRows();
+        }
+
+        if (rows.at(i).payload != wanted.payload) {
+            rows[i].payload = wanted.payload;
+            emit dataChanged(index(i), index(i));
+        }
+    }
+}
+
+/**
+ * @brief Sustituye el objeto de una fila y avisa a la vista.
+ */
+void UserListModel::updateItem(const QString &key, const QJsonObject &payload) {
+    int row = findRow(key);
+    if (row < 0) return;
+    rows[row].payload = payload;
+    emit dataChanged(index(row), index(row));
+}
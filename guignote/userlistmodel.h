@@ -0,0 +1,84 @@
+/**
+ * @file userlistmodel.h
+ * @brief Declaración de la clase UserListModel, modelo de listas de usuarios.
+ *
+ * Este archivo forma parte del Proyecto de Software 2024/2025
+ * del Grado en Ingeniería Informática en la Universidad de Zaragoza.
+ *
+ * UserListModel respalda las pestañas de amigos, solicitudes y búsqueda de
+ * friendswindow y la lista de salas de CustomGamesWindow. Cada refresco se aplica como un diff por clave frente a la
+ * respuesta anterior.
+ */
+
+#ifndef USERLISTMODEL_H
+#define USERLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QJsonObject>
+#include <QList>
+
+/**
+ * @class UserListModel
+ * @brief Lista de objetos JSON (amigos, solicitudes, usuarios o salas) indexados por su id.
+ *
+ * setItems() compara la nueva respuesta con la actual y emite solo las
+ * inserciones, eliminaciones, movimientos y cambios necesarios, de modo que la
+ * vista conserva la selección y el desplazamiento y no repinta filas intactas.
+ */
+class UserListModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    /** @brief Roles adicionales de cada fila. */
+    enum Roles {
+        KeyRole = Qt::UserRole + 1,  ///< Id de la fila.
+        PayloadRole                  ///< Objeto JSON completo.
+    };
+
+    /**
+     * @brief Constructor.
+     * @param parent Objeto padre.
+     */
+    explicit UserListModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    /**
+     * @brief Sustituye el contenido aplicando un diff por clave.
+     * @param items Nueva lista, en el orden en que debe mostrarse.
+     */
+    void setItems(const QList<QJsonObject> &items);
+
+    /**
+     * @brief Actualiza el objeto de una fila (p. ej. tras enviar una solicitud).
+     * @param key Id de la fila.
+     * @param payload Nuevo objeto.
+     */
+    void updateItem(const QString &key, const QJsonObject &payload);
+
+    /** @brief Objeto JSON de una fila. */
+    QJsonObject payload(int row) const;
+
+    /** @brief Id de un objeto ("id" o "ID"). */
+    static QString keyFor(const QJsonObject &item);
+
+    /** @brief Nombre a mostrar de un objeto. */
+    static QString displayName(const QJsonObject &item);
+
+private:
+    /**
+     * @struct Row
+     * @brief Fila del modelo.
+     */
+    struct Row {
+        QString key;          ///< Id de la fila.
+        QJsonObject payload;  ///< Datos recibidos.
+    };
+
+    int findRow(const QString &key, int from = 0) const;
+
+    QList<Row> rows;          ///< Filas mostradas.
+};
+
+#endif // USERLISTMODEL_H
@@ -12,16 +12,17 @@
  */
 
 #include "userprofilewindow.h"
+#include "session.h"
 #include <QHBoxLayout>
 #include <QVBoxLayout>
 #include <QPixmap>
-#include <QPainter>
-#include <QPainterPath>
 #include <QTimer>
 #include "mainwindow.h"
 #include <QDebug>
 #include <QSettings>
 #include "icon.h"
+#include "httpcache.h"
+#include "avatarservice.h"
 #include <QNetworkAccessManager>
 #include <QNetworkRequest>
 #include <QNetworkReply>
@@ -159,12 +160,9 @@ QVBoxLayout* UserProfileWindow::createProfileLayout() {
     profileLayout->addStretch();
 
     int pfpSize = 200;
-    QString imagePath = ":/icons/profile.png";
-    QPixmap circularImage = createCircularImage(imagePath, pfpSize);
-
     fotoPerfil = new Icon(this);
     fotoPerfil->setHoverEnabled(false);
-    fotoPerfil->setPixmapImg(circularImage, pfpSize, pfpSize);
+    fotoPerfil->setPixmapImg(AvatarService::instance().placeholder(pfpSize), pfpSize, pfpSize);
     profileLayout->addWidget(fotoPerfil, 0, Qt::AlignCenter);
 
     // userLabel se actualizará con nombre y ELO desde el backend.
@@ -187,147 +185,64 @@ QVBoxLayout* UserProfileWindow::createProfileLayout() {
 
 
 
-/**
- * @brief Convierte un QPixmap rectangular en uno circular.
- * @param src Imagen original a recortar.
- * @param size Diámetro deseado para la imagen circular.
- * @return QPixmap resultante con recorte circular.
- */
-QPixmap UserProfileWindow::createCircularImage(const QPixmap &src, int size) {
-    // Escalamos a un cuadrado de “size × size” y recortamos el exceso
-    QPixmap scaled = src.scaled(size, size,
-                                Qt::KeepAspectRatioByExpanding,
-                                Qt::SmoothTransformation);
-    QPixmap circular(size, size);
-    circular.fill(Qt::transparent);
-
-    QPainter painter(&circular);
-    painter.setRenderHint(QPainter::Antialiasing);
-    QPainterPath path;
-    path.addEllipse(0, 0, size, size);
-    painter.setClipPath(path);
-    painter.drawPixmap(0, 0, size, size, scaled);
-
-    return circular;
-}
-
-/**
- * @brief Extrae el token de autenticación almacenado en QSettings.
- * @param userKey Clave del usuario cuyo token se desea recuperar.
- * @return Token como QString, o cadena vacía si no se encuentra.
- */
-QString UserProfileWindow::loadAuthToken(const QString &userKey) {
-    // Usa la misma organización y nombre de aplicación/grupo que en LoginWindow
-    QSettings settings("Grace Hopper", QString("Sota, Caballo y Rey_%1").arg(userKey));
-
-    // Lee el valor usando la clave correcta
-    QString token = settings.value("auth/token").toString();
-
-    if (token.isEmpty()) {
-        qWarning() << "No se encontró el token para userKey:" << userKey << "en la configuración.";
-        // Mantén o ajusta tu diálogo de error si es necesario
-        createDialog(this, "No se encontró el token en la configuración.")->show();
-        return ""; // Devuelve vacío si no se encuentra
-    }
-
-    qDebug() << "Token cargado para userKey:" << userKey;
-    return token;
-}
-
 /**
  * @brief Solicita al servidor nombre, ELO y estadísticas del usuario,
  *        actualiza las etiquetas userLabel y statsLabel, y descarga la foto de perfil.
  * @param userKey Clave del usuario para la petición.
  */
 void UserProfileWindow::loadNameAndStats(const QString &userKey) {
-    QString token = loadAuthToken(userKey);
+    QString token = Session::forUser(userKey).token();
     if (token.isEmpty()) {
         createDialog(this, "No se encontró el token de autenticación.")->show();
         return;
     }
-    QNetworkAccessManager *manager = new QNetworkAccessManager(this);
     QString url = QString("http://188.165.76.134:8000/usuarios/estadisticas/%1").arg(friendId);
     QNetworkRequest request{QUrl(url)};
     request.setRawHeader("Auth", token.toUtf8());
-    QNetworkReply *reply = manager->get(request);
-    connect(reply, &QNetworkReply::finished, this, [this, reply, manager]() {
-        int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    HttpCache::instance().get(request, this, [this](const QByteArray &response, bool) {
+        QJsonDocument doc = QJsonDocument::fromJson(response);
+        if (!doc.isObject()) return;
+        QJsonObject obj = doc.object();
+        // Actualiza userLabel con nombre y ELO.
+        QString nombre = obj.value("nombre").toString();
+        int elo = obj.value("elo").toInt();
+        QString updatedText = QString(
+                                  "<span style='font-size: 24px; font-weight: bold; color: white;'>%1 (%2)</span><br>"
+                                  "<span style='font-size: 20px; font-weight: normal; color: white;'>Rango</span>"
+                                  ).arg(nombre).arg(elo);
+        userLabel->setText(updatedText);
+
+        // Extrae y actualiza las estadísticas.
+        int victorias = obj.value("victorias").toInt();
+        int derrotas = obj.value("derrotas").toInt();
+        int racha = obj.value("racha_victorias").toInt();
+        int mayorRacha = obj.value("mayor_racha_victorias").toInt();
+        int totalPartidas = obj.value("total_partidas").toInt();
+        double porcentajeVictorias = obj.value("porcentaje_victorias").toDouble();
+        double porcentajeDerrotas = obj.value("porcentaje_derrotas").toDouble();
+        QString statsText = QString("Victorias: %1\nDerrotas: %2\nRacha: %3\nMejor Racha: %4\nPartidas: %5\n"
+                                    "%% Victorias: %6%\n%% Derrotas: %7%")
+                                .arg(victorias)
+                                .arg(derrotas)
+                                .arg(racha)
+                                .arg(mayorRacha)
+                                .arg(totalPartidas)
+                                .arg(porcentajeVictorias, 0, 'f', 1)
+                                .arg(porcentajeDerrotas, 0, 'f', 1);
+        statsLabel->setText(statsText);
+
+        // La copia en caché y la respuesta fresca suelen traer la misma foto: solo se descarga una vez
+        QString imageUrl = obj.value("imagen").toString();
+        if (imageUrl.isEmpty() || imageUrl == shownImageUrl) return;
+        shownImageUrl = imageUrl;
+        qDebug() << "URL de la imagen de perfil:" << imageUrl;
+        int diam = fotoPerfil->width();
+        AvatarService::instance().setAvatar(fotoPerfil, imageUrl, diam);
+    }, [this](int statusCode, const QString &) {
         if (statusCode == 401) {
             createDialog(this, "Su sesión ha caducado, por favor, vuelva a iniciar sesión.", true)->show();
             return;
         }
-        if (reply->error() == QNetworkReply::NoError) {
-            QByteArray response = reply->readAll();
-            QJsonDocument doc = QJsonDocument::fromJson(response);
-            if (doc.isObject()) {
-                QJsonObject obj = doc.object();
-                // Actualiza userLabel con nombre y ELO.
-                QString nombre = obj.value("nombre").toString();
-                int elo = obj.value("elo").toInt();
-                QString updatedText = QString(
-                                          "<span style='font-size: 24px; font-weight: bold; color: white;'>%1 (%2)</span><br>"
-                                          "<span style='font-size: 20px; font-weight: normal; color: white;'>Rango</span>"
-                                          ).arg(nombre).arg(elo);
-                userLabel->setText(updatedText);
-
-                // Extrae y actualiza las estadísticas.
-                int victorias = obj.value("victorias").toInt();
-                int derrotas = obj.value("derrotas").toInt();
-                int racha = obj.value("racha_victorias").toInt();
-                int mayorRacha = obj.value("mayor_racha_victorias").toInt();
-                int totalPartidas = obj.value("total_partidas").toInt();
-                double porcentajeVictorias = obj.value("porcentaje_victorias").toDouble();
-                double porcentajeDerrotas = obj.value("porcentaje_derrotas").toDouble();
-                QString statsText = QString("Victorias: %1\nDerrotas: %2\nRacha: %3\nMejor Racha: %4\nPartidas: %5\n"
-                                            "%% Victorias: %6%\n%% Derrotas: %7%")
-                                        .arg(victorias)
-                                        .arg(derrotas)
-                                        .arg(racha)
-                                        .arg(mayorRacha)
-                                        .arg(totalPartidas)
-                                        .arg(porcentajeVictorias, 0, 'f', 1)
-                                        .arg(porcentajeDerrotas, 0, 'f', 1);
-                statsLabel->setText(statsText);
-
-                QString imageUrl = obj.value("imagen").toString();
-                qDebug() << "URL de la imagen de perfil:" << imageUrl;
-                QUrl url(imageUrl);
-                QNetworkRequest imgRequest(url);
-                QNetworkReply *imgReply = manager->get(imgRequest);
-                connect(imgReply, &QNetworkReply::finished, this, [this, imgReply]() {
-                    if (imgReply->error() == QNetworkReply::NoError) {
-                        QByteArray imgData = imgReply->readAll();
-                        qDebug() << "[ImgDownload] Tamaño de imgData:" << imgData.size();
-
-                        QPixmap pixmap;
-                        bool loaded = pixmap.loadFromData(imgData);
-                        qDebug() << "[ImgDownload] loadFromData() =" << loaded
-                                 << ", pixmap.isNull() =" << pixmap.isNull()
-                                 << ", tamaño pixmap =" << pixmap.size();
-
-                        if (!pixmap.loadFromData(imgData)) {
-                            qDebug() << "❌ No se pudo cargar pixmap de los datos. Tamaño de imgData:" << imgData.size();
-                            imgReply->deleteLater();
-                            return;
-                        }
-                        if (pixmap.isNull()) {
-                            qDebug() << "❌ El pixmap sigue siendo nulo después de loadFromData.";
-                            imgReply->deleteLater();
-                            return;
-                        }
-
-                        int diam = fotoPerfil->width();
-                        QPixmap circular = createCircularImage(pixmap, diam);
-                        fotoPerfil->setPixmapImg(circular, diam, diam);
-                    } else {
-                        qDebug() << "Error al descargar la imagen:" << imgReply->errorString();
-                    }
-                    imgReply->deleteLater();
-                });
-            }
-        } else {
-            createDialog(this, "Error al cargar el perfil de usuario.")->show();
-        }
-        reply->deleteLater();
+        createDialog(this, "Error al cargar el perfil de usuario.")->show();
     });
 }
@@ -52,11 +52,8 @@ private:
     void setupUI();
     QHBoxLayout* createHeaderLayout();
     QVBoxLayout* createProfileLayout();
-    QPixmap createCircularImage(const QPixmap &src, int size);
 
     // --- Backend y lógica ---
-    QString loadAuthToken(const QString &userKey);
-
     /**
      * @brief Carga el nombre, ELO y estadísticas del usuario desde el backend.
      * @param userKey Clave del usuario.
@@ -64,6 +61,7 @@ private:
     void loadNameAndStats(const QString &userKey);
 
     QString friendId;
+    QString shownImageUrl;         ///< URL de la foto ya descargada (evita repetirla al refrescar).
 };
 
 #endif // USERPROFILEWINDOW_H